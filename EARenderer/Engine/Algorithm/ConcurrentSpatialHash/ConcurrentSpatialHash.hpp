@@ -0,0 +1,86 @@
+//
+//  ConcurrentSpatialHash.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef ConcurrentSpatialHash_hpp
+#define ConcurrentSpatialHash_hpp
+
+#include "AxisAlignedBox3D.hpp"
+
+#include <unordered_map>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <stdexcept>
+
+#include <glm/vec3.hpp>
+
+namespace EARenderer {
+
+    /// Spatial hash that accepts insertions and neighbourhood queries from multiple threads at once.
+    /// Cells are distributed over a fixed number of shards, each guarded by its own mutex,
+    /// so threads only contend when they touch cells living in the same shard.
+    template<class T>
+    class ConcurrentSpatialHash {
+    private:
+
+#pragma mark - Nested types
+
+        using Objects = std::vector<T>;
+
+        struct Shard {
+            mutable std::mutex mutex;
+            std::unordered_map<uint64_t, Objects> cells;
+        };
+
+#pragma mark - Member variables
+
+        AxisAlignedBox3D mBoundaries;
+        uint16_t mResolution;
+        std::vector<std::unique_ptr<Shard>> mShards;
+        std::atomic<size_t> mSize;
+
+#pragma mark - Private helpers
+
+        int32_t cellIndex(int32_t axis, float positionOnAxis) const;
+
+        glm::ivec3 cell(const glm::vec3 &position) const;
+
+        bool isCellValid(const glm::ivec3 &cell) const;
+
+        static uint64_t CellHash(const glm::ivec3 &cell);
+
+        Shard &shard(uint64_t cellHash) const;
+
+    public:
+
+#pragma mark - Lifecycle
+
+        ConcurrentSpatialHash(const AxisAlignedBox3D &boundaries, uint32_t resolution, size_t shardCount = 64);
+
+#pragma mark - Modifiers
+
+        /// Thread-safe insertion of an object into a cell corresponding to the position
+        void insert(const T &object, const glm::vec3 &position);
+
+#pragma mark - Queries
+
+        /// Thread-safe test of objects located in the 27 cells surrounding the position
+        /// @param predicate callable taking const T & and returning true when an object satisfies the query
+        /// @return true if predicate returned true for at least one object
+        template<class Predicate>
+        bool anyNeighbour(const glm::vec3 &position, Predicate &&predicate) const;
+
+        size_t size() const;
+    };
+
+}
+
+#include "ConcurrentSpatialHashImpl.hpp"
+
+#endif /* ConcurrentSpatialHash_hpp */
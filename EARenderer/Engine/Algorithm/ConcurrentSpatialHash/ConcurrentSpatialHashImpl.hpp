@@ -0,0 +1,140 @@
+//
+//  ConcurrentSpatialHashImpl.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef ConcurrentSpatialHashImpl_h
+#define ConcurrentSpatialHashImpl_h
+
+#include <cmath>
+
+namespace EARenderer {
+
+#pragma mark - Lifecycle
+
+    template<typename T>
+    ConcurrentSpatialHash<T>::ConcurrentSpatialHash(const AxisAlignedBox3D &boundaries, uint32_t resolution, size_t shardCount)
+            :
+            mBoundaries(boundaries),
+            mResolution(resolution),
+            mSize(0) {
+        shardCount = std::max(shardCount, (size_t) 1);
+        mShards.reserve(shardCount);
+        for (size_t i = 0; i < shardCount; i++) {
+            mShards.emplace_back(std::make_unique<Shard>());
+        }
+    }
+
+#pragma mark - Private helpers
+
+    template<typename T>
+    int32_t
+    ConcurrentSpatialHash<T>::cellIndex(int32_t axis, float positionOnAxis) const {
+        float delta = mBoundaries.max[axis] - mBoundaries.min[axis];
+        if (fabs(delta) < 1e-09) {
+            return 0;
+        }
+        // Queries may come from outside of the boundaries, which must end up in invalid cells instead of wrapping around
+        return (int32_t) std::floor((positionOnAxis - mBoundaries.min[axis]) / delta * (mResolution - 1));
+    }
+
+    template<typename T>
+    glm::ivec3
+    ConcurrentSpatialHash<T>::cell(const glm::vec3 &position) const {
+        return {cellIndex(0, position.x), cellIndex(1, position.y), cellIndex(2, position.z)};
+    }
+
+    template<typename T>
+    bool
+    ConcurrentSpatialHash<T>::isCellValid(const glm::ivec3 &cell) const {
+        return (cell.x >= 0 && cell.x < mResolution) &&
+                (cell.y >= 0 && cell.y < mResolution) &&
+                (cell.z >= 0 && cell.z < mResolution);
+    }
+
+    template<typename T>
+    uint64_t
+    ConcurrentSpatialHash<T>::CellHash(const glm::ivec3 &cell) {
+        // Same 16 bits per axis layout as SpatialHash::Cell
+        uint64_t hash = 0;
+        hash |= (uint64_t) (cell.x & 0xFFFF);
+        hash |= (uint64_t) (cell.y & 0xFFFF) << 16;
+        hash |= (uint64_t) (cell.z & 0xFFFF) << 32;
+        return hash;
+    }
+
+    template<typename T>
+    typename ConcurrentSpatialHash<T>::Shard &
+    ConcurrentSpatialHash<T>::shard(uint64_t cellHash) const {
+        // Mix the bits so that neighbouring cells end up in different shards
+        uint64_t mixed = cellHash * 0x9E3779B97F4A7C15ull;
+        return *mShards[(mixed >> 32) % mShards.size()];
+    }
+
+#pragma mark - Modifiers
+
+    template<typename T>
+    void
+    ConcurrentSpatialHash<T>::insert(const T &object, const glm::vec3 &position) {
+        if (!mBoundaries.contains(position)) {
+            throw std::out_of_range("Attempt to insert an object outside of spatial hash's boundaries");
+        }
+
+        uint64_t hash = CellHash(cell(position));
+        Shard &s = shard(hash);
+
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.cells[hash].push_back(object);
+        mSize++;
+    }
+
+#pragma mark - Queries
+
+    template<typename T>
+    template<class Predicate>
+    bool
+    ConcurrentSpatialHash<T>::anyNeighbour(const glm::vec3 &position, Predicate &&predicate) const {
+        glm::ivec3 center = cell(position);
+
+        for (int32_t x = -1; x <= 1; ++x) {
+            for (int32_t y = -1; y <= 1; ++y) {
+                for (int32_t z = -1; z <= 1; ++z) {
+                    glm::ivec3 neighbour = center + glm::ivec3(x, y, z);
+
+                    if (!isCellValid(neighbour)) {
+                        continue;
+                    }
+
+                    uint64_t hash = CellHash(neighbour);
+                    Shard &s = shard(hash);
+
+                    std::lock_guard<std::mutex> lock(s.mutex);
+                    auto it = s.cells.find(hash);
+                    if (it == s.cells.end()) {
+                        continue;
+                    }
+
+                    for (const T &object : it->second) {
+                        if (predicate(object)) {
+                            return true;
+                        }
+                    }
+                }
+            }
+        }
+
+        return false;
+    }
+
+    template<typename T>
+    size_t
+    ConcurrentSpatialHash<T>::size() const {
+        return mSize;
+    }
+
+}
+
+#endif /* ConcurrentSpatialHashImpl_h */
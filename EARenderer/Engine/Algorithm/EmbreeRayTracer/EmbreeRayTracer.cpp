@@ -9,55 +9,113 @@
 #include "EmbreeRayTracer.hpp"
 
 #include <stdio.h>
+#include <stdexcept>
+#include <algorithm>
+#include <limits>
+
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/mat3x3.hpp>
+#include <glm/matrix.hpp>
 
 namespace EARenderer {
 
+#pragma mark - Ray batch
+
+    size_t EmbreeRayTracer::RayBatch::size() const {
+        return originsX.size();
+    }
+
+    void EmbreeRayTracer::RayBatch::reserve(size_t capacity) {
+        for (auto array : {&originsX, &originsY, &originsZ, &directionsX, &directionsY, &directionsZ, &tNear, &tFar}) {
+            array->reserve(capacity);
+        }
+    }
+
+    void EmbreeRayTracer::RayBatch::clear() {
+        for (auto array : {&originsX, &originsY, &originsZ, &directionsX, &directionsY, &directionsZ, &tNear, &tFar}) {
+            array->clear();
+        }
+    }
+
+    void EmbreeRayTracer::RayBatch::addRay(const Ray3D &ray, float near, float far) {
+        originsX.push_back(ray.origin.x);
+        originsY.push_back(ray.origin.y);
+        originsZ.push_back(ray.origin.z);
+        directionsX.push_back(ray.direction.x);
+        directionsY.push_back(ray.direction.y);
+        directionsZ.push_back(ray.direction.z);
+        tNear.push_back(near);
+        tFar.push_back(far);
+    }
+
+    void EmbreeRayTracer::RayBatch::addSegment(const glm::vec3 &p0, const glm::vec3 &p1, float p0OffsetFactor, float p1OffsetFactor) {
+        p0OffsetFactor = std::clamp(p0OffsetFactor, 0.0f, 1.0f);
+        p1OffsetFactor = std::clamp(p1OffsetFactor, 0.0f, 1.0f);
+
+        // Direction is not normalized (as Ray3D would do), so that tNear and tFar stay fractions of the segment
+        glm::vec3 direction = p1 - p0;
+        originsX.push_back(p0.x);
+        originsY.push_back(p0.y);
+        originsZ.push_back(p0.z);
+        directionsX.push_back(direction.x);
+        directionsY.push_back(direction.y);
+        directionsZ.push_back(direction.z);
+        tNear.push_back(p0OffsetFactor);
+        tFar.push_back(1.0f - p1OffsetFactor);
+    }
+
 #pragma mark - Lifecycle
 
+    EmbreeRayTracer::IntersectContext::IntersectContext(FaceFilter faceFilter, RTCIntersectContextFlags flags)
+            :
+            faceFilter(faceFilter) {
+        rtcInitIntersectContext(&rtcContext);
+        rtcContext.flags = flags;
+    }
+
     EmbreeRayTracer::EmbreeRayTracer(const std::vector<Triangle3D> &triangles)
+            :
+            EmbreeRayTracer(std::vector<MeshTriangles>{MeshTriangles{triangles}}, {Instance{0, glm::mat4(1.0)}}) {
+    }
+
+    EmbreeRayTracer::EmbreeRayTracer(const std::vector<MeshTriangles> &meshes, const std::vector<Instance> &instances)
             : mDevice(rtcNewDevice(nullptr)), mScene(rtcNewScene(mDevice)) {
 
-        RTCGeometry geometry = rtcNewGeometry(mDevice, RTC_GEOMETRY_TYPE_TRIANGLE);
+        deviceErrorCallback(this, rtcGetDeviceError(mDevice), "");
+        rtcSetDeviceErrorFunction(mDevice, deviceErrorCallback, this);
 
-        glm::vec3 *vertexBuffer = (glm::vec3 *) rtcSetNewGeometryBuffer(geometry,
-                RTC_BUFFER_TYPE_VERTEX,
-                0,
-                RTC_FORMAT_FLOAT3,
-                sizeof(glm::vec3),
-                triangles.size() * 3);
+        // Bottom level: one scene per mesh with a geometry per sub mesh
+        for (const auto &mesh : meshes) {
+            addMesh(mesh);
+        }
 
-        glm::uvec3 *indexBuffer = (glm::uvec3 *) rtcSetNewGeometryBuffer(geometry,
-                RTC_BUFFER_TYPE_INDEX,
-                0,
-                RTC_FORMAT_UINT3,
-                sizeof(glm::uvec3),
-                triangles.size());
+        // Top level: instances referencing mesh scenes
+        rtcSetSceneFlags(mScene, RTC_SCENE_FLAG_ROBUST);
 
-        if (vertexBuffer && indexBuffer) {
-            for (uint32_t i = 0; i < triangles.size(); ++i) {
-                uint32_t index = i * 3;
-                vertexBuffer[index] = glm::vec3(triangles[i].p1);
-                vertexBuffer[index + 1] = glm::vec3(triangles[i].p2);
-                vertexBuffer[index + 2] = glm::vec3(triangles[i].p3);
+        for (const auto &instance : instances) {
+            if (instance.meshIndex >= mMeshScenes.size()) {
+                throw std::out_of_range("Instance refers to a mesh that doesn't exist");
+            }
 
-                indexBuffer[i].x = index;
-                indexBuffer[i].y = index + 1;
-                indexBuffer[i].z = index + 2;
+            RTCGeometry geometry = rtcNewGeometry(mDevice, RTC_GEOMETRY_TYPE_INSTANCE);
+            rtcSetGeometryInstancedScene(geometry, mMeshScenes[instance.meshIndex]);
+            rtcSetGeometryTransform(geometry, 0, RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR, glm::value_ptr(instance.modelMatrix));
+            rtcCommitGeometry(geometry);
+            uint32_t geometryID = rtcAttachGeometry(mScene, geometry);
+            rtcReleaseGeometry(geometry);
+
+            if (geometryID >= mInstanceDeterminantSigns.size()) {
+                mInstanceDeterminantSigns.resize(geometryID + 1, 1.0f);
             }
+            mInstanceDeterminantSigns[geometryID] = DeterminantSign(instance.modelMatrix);
         }
 
-        rtcSetGeometryUserData(geometry, this);
-        rtcSetGeometryIntersectFilterFunction(geometry, intersectionFilter);
-        rtcSetGeometryOccludedFilterFunction(geometry, intersectionFilter);
-
-        rtcCommitGeometry(geometry);
-        rtcAttachGeometry(mScene, geometry);
         rtcCommitScene(mScene);
-        rtcReleaseGeometry(geometry);
 
-        rtcSetSceneFlags(mScene, RTC_SCENE_FLAG_ROBUST);
-        deviceErrorCallback(this, rtcGetDeviceError(mDevice), "");
-        rtcSetDeviceErrorFunction(mDevice, deviceErrorCallback, this);
+        mDynamicScene = rtcNewScene(mDevice);
+        rtcSetSceneFlags(mDynamicScene, RTC_SCENE_FLAG_DYNAMIC | RTC_SCENE_FLAG_ROBUST);
+        rtcSetSceneBuildQuality(mDynamicScene, RTC_BUILD_QUALITY_LOW);
+        rtcCommitScene(mDynamicScene);
     }
 
     EmbreeRayTracer::EmbreeRayTracer(EmbreeRayTracer &&that) {
@@ -65,6 +123,12 @@ namespace EARenderer {
     }
 
     EmbreeRayTracer::~EmbreeRayTracer() {
+        for (RTCScene meshScene : mMeshScenes) {
+            rtcReleaseScene(meshScene);
+        }
+        if (mDynamicScene) {
+            rtcReleaseScene(mDynamicScene);
+        }
         rtcReleaseScene(mScene);
         rtcReleaseDevice(mDevice);
     }
@@ -81,12 +145,137 @@ namespace EARenderer {
     void EmbreeRayTracer::swap(EmbreeRayTracer &that) {
         std::swap(mDevice, that.mDevice);
         std::swap(mScene, that.mScene);
+        std::swap(mMeshScenes, that.mMeshScenes);
+        std::swap(mInstanceDeterminantSigns, that.mInstanceDeterminantSigns);
+        std::swap(mDynamicScene, that.mDynamicScene);
+        std::swap(mDynamicInstances, that.mDynamicInstances);
+        std::swap(mDynamicInstanceDeterminantSigns, that.mDynamicInstanceDeterminantSigns);
+        std::swap(mDynamicInstancesChanged, that.mDynamicInstancesChanged);
     }
 
     void swap(EmbreeRayTracer &lhs, EmbreeRayTracer &rhs) {
         lhs.swap(rhs);
     }
 
+#pragma mark - Geometry management
+
+    size_t EmbreeRayTracer::addMesh(const MeshTriangles &mesh) {
+        RTCScene meshScene = rtcNewScene(mDevice);
+        rtcSetSceneFlags(meshScene, RTC_SCENE_FLAG_ROBUST);
+
+        for (const auto &subMeshTriangles : mesh) {
+            RTCGeometry geometry = createTriangleGeometry(subMeshTriangles);
+            rtcAttachGeometry(meshScene, geometry);
+            rtcReleaseGeometry(geometry);
+        }
+
+        rtcCommitScene(meshScene);
+        mMeshScenes.push_back(meshScene);
+
+        return mMeshScenes.size() - 1;
+    }
+
+    size_t EmbreeRayTracer::addDynamicInstance(const Instance &instance) {
+        if (instance.meshIndex >= mMeshScenes.size()) {
+            throw std::out_of_range("Instance refers to a mesh that doesn't exist");
+        }
+
+        RTCGeometry geometry = rtcNewGeometry(mDevice, RTC_GEOMETRY_TYPE_INSTANCE);
+        rtcSetGeometryInstancedScene(geometry, mMeshScenes[instance.meshIndex]);
+        rtcSetGeometryTransform(geometry, 0, RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR, glm::value_ptr(instance.modelMatrix));
+        // Only bounds of the instance change when it moves, so the top-level BVH can be refitted instead of rebuilt
+        rtcSetGeometryBuildQuality(geometry, RTC_BUILD_QUALITY_REFIT);
+        rtcCommitGeometry(geometry);
+
+        uint32_t geometryID = rtcAttachGeometry(mDynamicScene, geometry);
+        rtcReleaseGeometry(geometry);
+
+        if (geometryID >= mDynamicInstanceDeterminantSigns.size()) {
+            mDynamicInstanceDeterminantSigns.resize(geometryID + 1, 1.0f);
+        }
+        mDynamicInstanceDeterminantSigns[geometryID] = DeterminantSign(instance.modelMatrix);
+
+        mDynamicInstances.push_back({geometryID, instance.modelMatrix});
+        mDynamicInstancesChanged = true;
+
+        return mDynamicInstances.size() - 1;
+    }
+
+    void EmbreeRayTracer::setDynamicInstanceModelMatrix(size_t dynamicInstanceIndex, const glm::mat4 &modelMatrix) {
+        if (dynamicInstanceIndex >= mDynamicInstances.size()) {
+            throw std::out_of_range("Dynamic instance index is out of range");
+        }
+
+        DynamicInstance &instance = mDynamicInstances[dynamicInstanceIndex];
+        if (instance.modelMatrix == modelMatrix) {
+            return;
+        }
+
+        instance.modelMatrix = modelMatrix;
+
+        RTCGeometry geometry = rtcGetGeometry(mDynamicScene, instance.geometryID);
+        rtcSetGeometryTransform(geometry, 0, RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR, glm::value_ptr(modelMatrix));
+        rtcCommitGeometry(geometry);
+
+        mDynamicInstanceDeterminantSigns[instance.geometryID] = DeterminantSign(modelMatrix);
+        mDynamicInstancesChanged = true;
+    }
+
+    void EmbreeRayTracer::commitDynamicInstances() {
+        if (!mDynamicInstancesChanged) {
+            return;
+        }
+
+        rtcCommitScene(mDynamicScene);
+        mDynamicInstancesChanged = false;
+    }
+
+#pragma mark - Private helpers
+
+    float EmbreeRayTracer::DeterminantSign(const glm::mat4 &modelMatrix) {
+        return glm::determinant(glm::mat3(modelMatrix)) < 0.0f ? -1.0f : 1.0f;
+    }
+
+    RTCGeometry EmbreeRayTracer::createTriangleGeometry(const std::vector<Triangle3D> &triangles) const {
+        RTCGeometry geometry = rtcNewGeometry(mDevice, RTC_GEOMETRY_TYPE_TRIANGLE);
+
+        glm::vec3 *vertexBuffer = (glm::vec3 *) rtcSetNewGeometryBuffer(geometry,
+                RTC_BUFFER_TYPE_VERTEX,
+                0,
+                RTC_FORMAT_FLOAT3,
+                sizeof(glm::vec3),
+                triangles.size() * 3);
+
+        glm::uvec3 *indexBuffer = (glm::uvec3 *) rtcSetNewGeometryBuffer(geometry,
+                RTC_BUFFER_TYPE_INDEX,
+                0,
+                RTC_FORMAT_UINT3,
+                sizeof(glm::uvec3),
+                triangles.size());
+
+        if (vertexBuffer && indexBuffer) {
+            for (uint32_t i = 0; i < triangles.size(); ++i) {
+                uint32_t index = i * 3;
+                vertexBuffer[index] = glm::vec3(triangles[i].p1);
+                vertexBuffer[index + 1] = glm::vec3(triangles[i].p2);
+                vertexBuffer[index + 2] = glm::vec3(triangles[i].p3);
+
+                indexBuffer[i].x = index;
+                indexBuffer[i].y = index + 1;
+                indexBuffer[i].z = index + 2;
+            }
+        }
+
+        // Filters are invoked with the ray and hit in local space of the instanced mesh.
+        // Mirroring instance transforms flip the sign of the dot product between them, which the filter compensates for.
+        rtcSetGeometryIntersectFilterFunction(geometry, intersectionFilter);
+        rtcSetGeometryOccludedFilterFunction(geometry, intersectionFilter);
+
+        rtcCommitGeometry(geometry);
+
+        return geometry;
+    }
+
 #pragma mark - Callbacks
 
     void EmbreeRayTracer::deviceErrorCallback(void *userPtr, enum RTCError code, const char *str) {
@@ -95,30 +284,45 @@ namespace EARenderer {
     }
 
     void EmbreeRayTracer::intersectionFilter(const struct RTCFilterFunctionNArguments *args) {
-        EmbreeRayTracer *thisPtr = reinterpret_cast<EmbreeRayTracer *>(args->geometryUserPtr);
+        const IntersectContext *context = reinterpret_cast<const IntersectContext *>(args->context);
+
+        if (context->faceFilter == FaceFilter::None) return;
 
-        if (thisPtr->mFaceFilter == FaceFilter::None) return;
+        // Packet queries invoke the filter for several lanes at once
+        for (uint32_t lane = 0; lane < args->N; lane++) {
+            if (args->valid[lane] == 0) {
+                continue;
+            }
+
+            glm::vec3 triangleNormal(RTCHitN_Ng_x(args->hit, args->N, lane),
+                    RTCHitN_Ng_y(args->hit, args->N, lane),
+                    RTCHitN_Ng_z(args->hit, args->N, lane));
 
-        glm::vec3 triangleNormal(RTCHitN_Ng_x(args->hit, args->N, 0),
-                RTCHitN_Ng_y(args->hit, args->N, 0),
-                RTCHitN_Ng_z(args->hit, args->N, 0));
+            glm::vec3 rayDirection(RTCRayN_dir_x(args->ray, args->N, lane),
+                    RTCRayN_dir_y(args->ray, args->N, lane),
+                    RTCRayN_dir_z(args->ray, args->N, lane));
 
-        glm::vec3 rayDirection(RTCRayN_dir_x(args->ray, args->N, 0),
-                RTCRayN_dir_y(args->ray, args->N, 0),
-                RTCRayN_dir_z(args->ray, args->N, 0));
+            float dot = glm::dot(triangleNormal, rayDirection);
 
-        float dot = glm::dot(triangleNormal, rayDirection);
-        bool vectorsPointingInSameHemisphere = dot > 0.0;
+            // Hits of mirrored instances are reported with a reversed winding in the local space
+            uint32_t instanceID = RTCHitN_instID(args->hit, args->N, lane, 0);
+            const std::vector<float> &determinantSigns = *context->instanceDeterminantSigns;
+            if (instanceID < determinantSigns.size()) {
+                dot *= determinantSigns[instanceID];
+            }
 
-        switch (thisPtr->mFaceFilter) {
-            case FaceFilter::CullFront:
-                args->valid[0] = vectorsPointingInSameHemisphere ? -1 : 0;
-                break;
-            case FaceFilter::CullBack:
-                args->valid[0] = vectorsPointingInSameHemisphere ? 0 : -1;
-                break;
-            default:
-                break;
+            bool vectorsPointingInSameHemisphere = dot > 0.0;
+
+            switch (context->faceFilter) {
+                case FaceFilter::CullFront:
+                    args->valid[lane] = vectorsPointingInSameHemisphere ? -1 : 0;
+                    break;
+                case FaceFilter::CullBack:
+                    args->valid[lane] = vectorsPointingInSameHemisphere ? 0 : -1;
+                    break;
+                default:
+                    break;
+            }
         }
     }
 
@@ -129,12 +333,9 @@ namespace EARenderer {
             const glm::vec3 &p1,
             float p0OffsetFactor,
             float p1OffsetFactor,
-            FaceFilter faceFilter) {
-
-        RTCIntersectContext context;
-        rtcInitIntersectContext(&context);
+            FaceFilter faceFilter) const {
 
-        mFaceFilter = faceFilter;
+        IntersectContext context(faceFilter);
 
         p0OffsetFactor = std::clamp(p0OffsetFactor, 0.0f, 1.0f);
         p1OffsetFactor = std::clamp(p1OffsetFactor, 0.0f, 1.0f);
@@ -152,7 +353,13 @@ namespace EARenderer {
         ray.tfar = 1.0 - p1OffsetFactor;
         ray.flags = 0;
 
-        rtcOccluded1(mScene, &context, &ray);
+        context.instanceDeterminantSigns = &mInstanceDeterminantSigns;
+        rtcOccluded1(mScene, &context.rtcContext, &ray);
+        if (!mDynamicInstances.empty()) {
+            // Rays occluded by static geometry have tfar < tnear and are skipped by Embree
+            context.instanceDeterminantSigns = &mDynamicInstanceDeterminantSigns;
+            rtcOccluded1(mDynamicScene, &context.rtcContext, &ray);
+        }
 
         // When no intersection is found, the ray data is not updated.
         // In case a hit was found, the tfar component of the ray is set to -inf.
@@ -160,11 +367,8 @@ namespace EARenderer {
         return ray.tfar < 0.0;
     }
 
-    bool EmbreeRayTracer::rayHit(const Ray3D &ray, float &distance, FaceFilter faceFilter) {
-        RTCIntersectContext context;
-        rtcInitIntersectContext(&context);
-
-        mFaceFilter = faceFilter;
+    bool EmbreeRayTracer::rayHit(const Ray3D &ray, float &distance, FaceFilter faceFilter) const {
+        IntersectContext context(faceFilter);
 
         RTCRayHit rayHit;
 
@@ -182,11 +386,177 @@ namespace EARenderer {
         rayHit.hit.instID[0] = RTC_INVALID_GEOMETRY_ID;
         rayHit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
 
-        rtcIntersect1(mScene, &context, &rayHit);
+        context.instanceDeterminantSigns = &mInstanceDeterminantSigns;
+        rtcIntersect1(mScene, &context.rtcContext, &rayHit);
+        if (!mDynamicInstances.empty()) {
+            // tfar is already clamped to the closest static hit, so only closer dynamic hits are recorded
+            context.instanceDeterminantSigns = &mDynamicInstanceDeterminantSigns;
+            rtcIntersect1(mDynamicScene, &context.rtcContext, &rayHit);
+        }
 
         distance = rayHit.ray.tfar;
 
         return rayHit.hit.geomID != RTC_INVALID_GEOMETRY_ID;
     }
 
+#pragma mark - Packets
+
+    EmbreeRayTracer::PacketMask EmbreeRayTracer::raysOccluded(const glm::vec3 &origin, const std::array<glm::vec3, PacketSize> &directions, size_t rayCount, FaceFilter faceFilter) const {
+        if (rayCount > PacketSize) {
+            throw std::invalid_argument("Ray count exceeds packet size");
+        }
+
+        static_assert(PacketSize == 16, "Packet size must match the rtcOccluded16 call below");
+
+        IntersectContext context(faceFilter, RTC_INTERSECT_CONTEXT_FLAG_COHERENT);
+
+        alignas(64) int valid[PacketSize];
+        alignas(64) RTCRay16 packet;
+
+        for (size_t i = 0; i < PacketSize; i++) {
+            valid[i] = i < rayCount ? -1 : 0;
+
+            packet.org_x[i] = origin.x;
+            packet.org_y[i] = origin.y;
+            packet.org_z[i] = origin.z;
+            packet.dir_x[i] = directions[i].x;
+            packet.dir_y[i] = directions[i].y;
+            packet.dir_z[i] = directions[i].z;
+            packet.tnear[i] = 0.0f;
+            packet.tfar[i] = std::numeric_limits<float>::max();
+            packet.time[i] = 0.0f;
+            packet.mask[i] = -1;
+            packet.flags[i] = 0;
+        }
+
+        context.instanceDeterminantSigns = &mInstanceDeterminantSigns;
+        rtcOccluded16(valid, mScene, &context.rtcContext, &packet);
+        if (!mDynamicInstances.empty()) {
+            context.instanceDeterminantSigns = &mDynamicInstanceDeterminantSigns;
+            rtcOccluded16(valid, mDynamicScene, &context.rtcContext, &packet);
+        }
+
+        // Same as with single rays, tfar of occluded rays is set to -inf
+        PacketMask occluded;
+        for (size_t i = 0; i < rayCount; i++) {
+            occluded[i] = packet.tfar[i] < 0.0f;
+        }
+
+        return occluded;
+    }
+
+#pragma mark - Streams
+
+    void EmbreeRayTracer::raysOccluded(const RayBatch &rays, std::vector<bool> &occluded, FaceFilter faceFilter) const {
+        IntersectContext context(faceFilter);
+
+        occluded.assign(rays.size(), false);
+
+        alignas(64) RTCRay16 packets[StreamPacketCount];
+        constexpr size_t ChunkSize = StreamPacketCount * PacketSize;
+
+        for (size_t chunkStart = 0; chunkStart < rays.size(); chunkStart += ChunkSize) {
+            size_t rayCount = std::min(ChunkSize, rays.size() - chunkStart);
+            size_t packetCount = (rayCount + PacketSize - 1) / PacketSize;
+
+            for (size_t i = 0; i < packetCount * PacketSize; i++) {
+                RTCRay16 &packet = packets[i / PacketSize];
+                size_t lane = i % PacketSize;
+                size_t ray = chunkStart + i;
+
+                packet.time[lane] = 0.0f;
+                packet.mask[lane] = -1;
+                packet.flags[lane] = 0;
+
+                if (i >= rayCount) {
+                    // Stream API has no validity mask, rays with tnear > tfar are skipped instead.
+                    // The rest of the lane is zeroed so that no stale stack data gets into the traversal.
+                    packet.org_x[lane] = packet.org_y[lane] = packet.org_z[lane] = 0.0f;
+                    packet.dir_x[lane] = packet.dir_y[lane] = packet.dir_z[lane] = 0.0f;
+                    packet.tnear[lane] = 0.0f;
+                    packet.tfar[lane] = -1.0f;
+                    continue;
+                }
+
+                packet.org_x[lane] = rays.originsX[ray];
+                packet.org_y[lane] = rays.originsY[ray];
+                packet.org_z[lane] = rays.originsZ[ray];
+                packet.dir_x[lane] = rays.directionsX[ray];
+                packet.dir_y[lane] = rays.directionsY[ray];
+                packet.dir_z[lane] = rays.directionsZ[ray];
+                packet.tnear[lane] = rays.tNear[ray];
+                packet.tfar[lane] = rays.tFar[ray];
+            }
+
+            context.instanceDeterminantSigns = &mInstanceDeterminantSigns;
+            rtcOccludedNM(mScene, &context.rtcContext, reinterpret_cast<RTCRayN *>(packets), PacketSize, packetCount, sizeof(RTCRay16));
+            if (!mDynamicInstances.empty()) {
+                context.instanceDeterminantSigns = &mDynamicInstanceDeterminantSigns;
+                rtcOccludedNM(mDynamicScene, &context.rtcContext, reinterpret_cast<RTCRayN *>(packets), PacketSize, packetCount, sizeof(RTCRay16));
+            }
+
+            for (size_t i = 0; i < rayCount; i++) {
+                occluded[chunkStart + i] = packets[i / PacketSize].tfar[i % PacketSize] < 0.0f;
+            }
+        }
+    }
+
+    void EmbreeRayTracer::raysHit(const RayBatch &rays, std::vector<bool> &hits, std::vector<float> &distances, FaceFilter faceFilter) const {
+        IntersectContext context(faceFilter);
+
+        hits.assign(rays.size(), false);
+        distances.assign(rays.size(), std::numeric_limits<float>::max());
+
+        alignas(64) RTCRayHit16 packets[StreamPacketCount];
+        constexpr size_t ChunkSize = StreamPacketCount * PacketSize;
+
+        for (size_t chunkStart = 0; chunkStart < rays.size(); chunkStart += ChunkSize) {
+            size_t rayCount = std::min(ChunkSize, rays.size() - chunkStart);
+            size_t packetCount = (rayCount + PacketSize - 1) / PacketSize;
+
+            for (size_t i = 0; i < packetCount * PacketSize; i++) {
+                RTCRayHit16 &packet = packets[i / PacketSize];
+                size_t lane = i % PacketSize;
+                size_t ray = chunkStart + i;
+
+                packet.ray.time[lane] = 0.0f;
+                packet.ray.mask[lane] = -1;
+                packet.ray.flags[lane] = 0;
+                packet.hit.geomID[lane] = RTC_INVALID_GEOMETRY_ID;
+                packet.hit.instID[0][lane] = RTC_INVALID_GEOMETRY_ID;
+
+                if (i >= rayCount) {
+                    packet.ray.org_x[lane] = packet.ray.org_y[lane] = packet.ray.org_z[lane] = 0.0f;
+                    packet.ray.dir_x[lane] = packet.ray.dir_y[lane] = packet.ray.dir_z[lane] = 0.0f;
+                    packet.ray.tnear[lane] = 0.0f;
+                    packet.ray.tfar[lane] = -1.0f;
+                    continue;
+                }
+
+                packet.ray.org_x[lane] = rays.originsX[ray];
+                packet.ray.org_y[lane] = rays.originsY[ray];
+                packet.ray.org_z[lane] = rays.originsZ[ray];
+                packet.ray.dir_x[lane] = rays.directionsX[ray];
+                packet.ray.dir_y[lane] = rays.directionsY[ray];
+                packet.ray.dir_z[lane] = rays.directionsZ[ray];
+                packet.ray.tnear[lane] = rays.tNear[ray];
+                packet.ray.tfar[lane] = rays.tFar[ray];
+            }
+
+            context.instanceDeterminantSigns = &mInstanceDeterminantSigns;
+            rtcIntersectNM(mScene, &context.rtcContext, reinterpret_cast<RTCRayHitN *>(packets), PacketSize, packetCount, sizeof(RTCRayHit16));
+            if (!mDynamicInstances.empty()) {
+                context.instanceDeterminantSigns = &mDynamicInstanceDeterminantSigns;
+                rtcIntersectNM(mDynamicScene, &context.rtcContext, reinterpret_cast<RTCRayHitN *>(packets), PacketSize, packetCount, sizeof(RTCRayHit16));
+            }
+
+            for (size_t i = 0; i < rayCount; i++) {
+                const RTCRayHit16 &packet = packets[i / PacketSize];
+                size_t lane = i % PacketSize;
+                hits[chunkStart + i] = packet.hit.geomID[lane] != RTC_INVALID_GEOMETRY_ID;
+                distances[chunkStart + i] = packet.ray.tfar[lane];
+            }
+        }
+    }
+
 }
@@ -13,32 +13,110 @@
 #include "Triangle3D.hpp"
 
 #include <vector>
+#include <array>
+#include <bitset>
+#include <limits>
 #include <glm/vec3.hpp>
+#include <glm/mat4x4.hpp>
 #include <rtcore.h>
 
 namespace EARenderer {
 
+    /// All queries are safe to be issued from multiple threads at once,
+    /// as long as no meshes or dynamic instances are being modified at the same time
     class EmbreeRayTracer {
     public:
         enum class FaceFilter {
             None, CullFront, CullBack
         };
 
+        static constexpr size_t PacketSize = 16;
+
+        using PacketMask = std::bitset<PacketSize>;
+
+        /// Triangles of every sub mesh of a mesh, in mesh's local space
+        using MeshTriangles = std::vector<std::vector<Triangle3D>>;
+
+        struct Instance {
+            size_t meshIndex;
+            glm::mat4 modelMatrix;
+        };
+
+        /// Arbitrary number of rays laid out as a structure of arrays
+        struct RayBatch {
+            std::vector<float> originsX;
+            std::vector<float> originsY;
+            std::vector<float> originsZ;
+            std::vector<float> directionsX;
+            std::vector<float> directionsY;
+            std::vector<float> directionsZ;
+            std::vector<float> tNear;
+            std::vector<float> tFar;
+
+            size_t size() const;
+
+            void reserve(size_t capacity);
+
+            void clear();
+
+            void addRay(const Ray3D &ray, float tNear = 0.0f, float tFar = std::numeric_limits<float>::max());
+
+            /// Adds a line segment with the same parametrization as in lineSegmentOccluded:
+            /// direction is p1 - p0 and the segment spans [p0OffsetFactor; 1 - p1OffsetFactor]
+            void addSegment(const glm::vec3 &p0, const glm::vec3 &p1, float p0OffsetFactor = 0.0f, float p1OffsetFactor = 0.0f);
+        };
+
     private:
+        // Number of packets handed over to Embree's stream API in one call.
+        // Packets live on the stack, since over-aligned heap allocations are unavailable on macOS 10.12.
+        static constexpr size_t StreamPacketCount = 16;
+
+        // Per-query state handed over to filter callbacks.
+        // Embree passes the context pointer through, so RTCIntersectContext must stay the first member.
+        struct IntersectContext {
+            RTCIntersectContext rtcContext;
+            FaceFilter faceFilter;
+            // Signs of instance transform determinants of the scene being traversed, indexed by instance geometry ID
+            const std::vector<float> *instanceDeterminantSigns = nullptr;
+
+            IntersectContext(FaceFilter faceFilter, RTCIntersectContextFlags flags = RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT);
+        };
+
+        struct DynamicInstance {
+            uint32_t geometryID;
+            glm::mat4 modelMatrix;
+        };
+
         RTCDevice mDevice = nullptr;
         RTCScene mScene = nullptr;
+        std::vector<RTCScene> mMeshScenes;
+        std::vector<float> mInstanceDeterminantSigns;
+
+        // Instances that move around are kept in a separate top-level BVH,
+        // so that updating them never forces a rebuild of the static one
+        RTCScene mDynamicScene = nullptr;
+        std::vector<DynamicInstance> mDynamicInstances;
+        std::vector<float> mDynamicInstanceDeterminantSigns;
+        bool mDynamicInstancesChanged = false;
+
+        static float DeterminantSign(const glm::mat4 &modelMatrix);
 
-        FaceFilter mFaceFilter;
+        RTCGeometry createTriangleGeometry(const std::vector<Triangle3D> &triangles) const;
 
         static void deviceErrorCallback(void *userPtr, enum RTCError code, const char *str);
 
         static void intersectionFilter(const struct RTCFilterFunctionNArguments *args);
 
-        static void occlusionFilter(const struct RTCFilterFunctionNArguments *args);
-
     public:
         EmbreeRayTracer(const std::vector<Triangle3D> &triangles);
 
+        ///
+        /// Builds a two-level hierarchy: a bottom-level BVH per mesh, which is shared by all of its instances,
+        /// and a top-level BVH over the instances
+        /// @param meshes geometry of every unique mesh
+        /// @param instances placements of meshes in the world
+        EmbreeRayTracer(const std::vector<MeshTriangles> &meshes, const std::vector<Instance> &instances);
+
         EmbreeRayTracer(const EmbreeRayTracer &that) = delete;
 
         EmbreeRayTracer(EmbreeRayTracer &&that);
@@ -49,6 +127,28 @@ namespace EARenderer {
 
         void swap(EmbreeRayTracer &that);
 
+        ///
+        /// Builds a bottom-level BVH for a mesh, which can be referenced by dynamic instances afterwards
+        /// @param mesh geometry of a mesh in its local space
+        /// @return index of the mesh
+        size_t addMesh(const MeshTriangles &mesh);
+
+        ///
+        /// Places a mesh into the dynamic BVH layer. Takes effect after commitDynamicInstances() is called.
+        /// @param instance placement of the mesh
+        /// @return index of the dynamic instance
+        size_t addDynamicInstance(const Instance &instance);
+
+        ///
+        /// Moves a dynamic instance. Takes effect after commitDynamicInstances() is called.
+        /// @param dynamicInstanceIndex index returned by addDynamicInstance()
+        /// @param modelMatrix new transformation of the instance
+        void setDynamicInstanceModelMatrix(size_t dynamicInstanceIndex, const glm::mat4 &modelMatrix);
+
+        ///
+        /// Refits the dynamic BVH layer if any dynamic instance was added or moved. Static geometry is not touched.
+        void commitDynamicInstances();
+
         ///
         /// @param p0 line segment start
         /// @param p1 line segment end
@@ -66,9 +166,38 @@ namespace EARenderer {
                 float p0OffsetFactor = 0.0f,
                 float p1OffsetFactor = 0.0f,
                 FaceFilter faceFilter = FaceFilter::None
-        );
+        ) const;
+
+        bool rayHit(const Ray3D &ray, float &distance, FaceFilter faceFilter = FaceFilter::None) const;
 
-        bool rayHit(const Ray3D &ray, float &distance, FaceFilter faceFilter = FaceFilter::None);
+        ///
+        /// Traces a packet of rays of unlimited length sharing the same origin in one go
+        /// @param origin origin of all rays in the packet
+        /// @param directions ray directions
+        /// @param rayCount number of leading directions in the array that are actually traced, up to PacketSize
+        /// @param FaceFilter indicates which faces should be ignored during ray tracing
+        /// @return mask with bits set for rays that hit any geometry
+        PacketMask raysOccluded(
+                const glm::vec3 &origin,
+                const std::array<glm::vec3, PacketSize> &directions,
+                size_t rayCount = PacketSize,
+                FaceFilter faceFilter = FaceFilter::None
+        ) const;
+
+        ///
+        /// Traces a batch of rays or line segments through Embree's ray stream API
+        /// @param rays rays to be traced
+        /// @param occluded output array receiving a flag per ray indicating whether it hit any geometry
+        /// @param FaceFilter indicates which faces should be ignored during ray tracing
+        void raysOccluded(const RayBatch &rays, std::vector<bool> &occluded, FaceFilter faceFilter = FaceFilter::None) const;
+
+        ///
+        /// Finds closest hits for a batch of rays through Embree's ray stream API
+        /// @param rays rays to be traced
+        /// @param hits output array receiving a flag per ray indicating whether it hit any geometry
+        /// @param distances output array receiving distances to the closest hits, in units of ray direction length
+        /// @param FaceFilter indicates which faces should be ignored during ray tracing
+        void raysHit(const RayBatch &rays, std::vector<bool> &hits, std::vector<float> &distances, FaceFilter faceFilter = FaceFilter::None) const;
     };
 
     void swap(EmbreeRayTracer &lhs, EmbreeRayTracer &rhs);
@@ -0,0 +1,199 @@
+//
+//  FlatSpatialHash.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef FlatSpatialHash_hpp
+#define FlatSpatialHash_hpp
+
+#include "AxisAlignedBox3D.hpp"
+#include "MortonCode.hpp"
+
+#include <vector>
+#include <array>
+#include <utility>
+#include <stdexcept>
+
+#include <glm/vec3.hpp>
+
+namespace EARenderer {
+
+    /// Drop-in alternative to SpatialHash without per-cell heap allocations.
+    /// Cell headers live in a flat open-addressed table and objects of every cell occupy
+    /// a contiguous span of a single payload array. After build() or compact() the spans
+    /// are laid out in Morton order of their cells, so neighbouring cells are close in memory.
+    /// Any insertion invalidates iterators and ranges.
+    ///
+    /// T must be default constructible.
+    template<class T>
+    class FlatSpatialHash {
+    private:
+
+#pragma mark - Nested types
+#pragma mark Cell header
+
+        struct CellHeader {
+            // Morton code of the cell plus one, zero marks an unoccupied slot
+            uint64_t key = 0;
+            uint32_t offset = 0;
+            uint32_t count = 0;
+            uint32_t capacity = 0;
+        };
+
+        using Span = std::pair<T *, T *>;
+
+    public:
+
+#pragma mark Forward iterator
+
+        class ForwardIterator {
+        private:
+            friend FlatSpatialHash;
+
+            FlatSpatialHash *mHash = nullptr;
+            size_t mSlot = 0;
+            uint32_t mIndexInCell = 0;
+
+            ForwardIterator(FlatSpatialHash *hash, size_t slot);
+
+            void skipEmptySlots();
+
+        public:
+            ForwardIterator &operator++();
+
+            T &operator*();
+
+            T *operator->();
+
+            const T &operator*() const;
+
+            const T *operator->() const;
+
+            bool operator!=(const ForwardIterator &other) const;
+        };
+
+#pragma mark Range
+
+        class Range {
+        public:
+            class Iterator {
+            private:
+                friend Range;
+
+                const Range *mRange = nullptr;
+                size_t mSpanIndex = 0;
+                T *mCurrent = nullptr;
+
+                Iterator(const Range *range, size_t spanIndex);
+
+            public:
+                Iterator &operator++();
+
+                T &operator*();
+
+                T *operator->();
+
+                const T &operator*() const;
+
+                const T *operator->() const;
+
+                bool operator!=(const Iterator &other) const;
+            };
+
+        private:
+            friend FlatSpatialHash;
+
+            std::array<Span, 27> mSpans;
+            size_t mSpanCount = 0;
+
+            Range() = default;
+
+        public:
+            Iterator begin() const;
+
+            Iterator end() const;
+        };
+
+    private:
+
+#pragma mark - Member variables
+
+        std::vector<CellHeader> mCells;
+        std::vector<T> mObjects;
+        AxisAlignedBox3D mBoundaries;
+        uint16_t mResolution;
+        size_t mOccupiedCellCount = 0;
+        size_t mSize = 0;
+
+#pragma mark - Private helpers
+
+        int32_t cellIndex(int32_t axis, float positionOnAxis) const;
+
+        glm::ivec3 cell(const glm::vec3 &position) const;
+
+        bool isCellValid(const glm::ivec3 &cell) const;
+
+        static uint64_t CellKey(const glm::ivec3 &cell);
+
+        size_t slotForKey(uint64_t key) const;
+
+        const CellHeader *findCell(uint64_t key) const;
+
+        CellHeader &findOrCreateCell(uint64_t key);
+
+        void rehash(size_t cellTableSize);
+
+        void grow(CellHeader &header);
+
+    public:
+
+#pragma mark - Lifecycle
+
+        FlatSpatialHash(const AxisAlignedBox3D &boundaries, uint32_t resolution);
+
+#pragma mark - Modifiers
+
+        void insert(const T &object, const glm::vec3 &position);
+
+        /**
+         Replaces contents of the hash with the objects, placing them in Morton order in one pass.
+         Much faster than inserting objects one by one.
+
+         @param objects objects to be stored
+         @param position callable taking const T & and returning object's glm::vec3 position
+         */
+        template<class PositionFunctor>
+        void build(const std::vector<T> &objects, PositionFunctor &&position);
+
+        /**
+         Rearranges cell spans in Morton order and removes unused payload slots left by insertions
+         */
+        void compact();
+
+        void erase(const ForwardIterator &it);
+
+#pragma mark - Queries
+
+        /**
+         @return objects located in the cell of the position and in its 26 neighbour cells
+         */
+        Range neighbours(const glm::vec3 &position);
+
+        size_t size() const;
+
+#pragma mark - Iteration
+
+        ForwardIterator begin();
+
+        ForwardIterator end();
+    };
+
+}
+
+#include "FlatSpatialHashImpl.hpp"
+#include "FlatSpatialHashIteratorImpl.hpp"
+
+#endif /* FlatSpatialHash_hpp */
@@ -0,0 +1,304 @@
+//
+//  FlatSpatialHashImpl.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef FlatSpatialHashImpl_h
+#define FlatSpatialHashImpl_h
+
+#include <algorithm>
+#include <cmath>
+
+namespace EARenderer {
+
+#pragma mark - Lifecycle
+
+    template<typename T>
+    FlatSpatialHash<T>::FlatSpatialHash(const AxisAlignedBox3D &boundaries, uint32_t resolution)
+            :
+            mBoundaries(boundaries),
+            mResolution(resolution) {
+    }
+
+#pragma mark - Private helpers
+
+    template<typename T>
+    int32_t
+    FlatSpatialHash<T>::cellIndex(int32_t axis, float positionOnAxis) const {
+        float delta = mBoundaries.max[axis] - mBoundaries.min[axis];
+        if (fabs(delta) < 1e-09) {
+            return 0;
+        }
+        // Queries may come from outside of the boundaries, which must end up in invalid cells instead of being truncated into the first one
+        return (int32_t) std::floor((positionOnAxis - mBoundaries.min[axis]) / delta * (mResolution - 1));
+    }
+
+    template<typename T>
+    glm::ivec3
+    FlatSpatialHash<T>::cell(const glm::vec3 &position) const {
+        return {cellIndex(0, position.x), cellIndex(1, position.y), cellIndex(2, position.z)};
+    }
+
+    template<typename T>
+    bool
+    FlatSpatialHash<T>::isCellValid(const glm::ivec3 &cell) const {
+        return (cell.x >= 0 && cell.x < mResolution) &&
+                (cell.y >= 0 && cell.y < mResolution) &&
+                (cell.z >= 0 && cell.z < mResolution);
+    }
+
+    template<typename T>
+    uint64_t
+    FlatSpatialHash<T>::CellKey(const glm::ivec3 &cell) {
+        return MortonCode::Encode(cell.x, cell.y, cell.z) + 1;
+    }
+
+    template<typename T>
+    size_t
+    FlatSpatialHash<T>::slotForKey(uint64_t key) const {
+        // Table size is always a power of two, linear probing
+        size_t mask = mCells.size() - 1;
+        uint64_t mixed = key * 0x9E3779B97F4A7C15ull;
+        size_t slot = (mixed ^ (mixed >> 32)) & mask;
+
+        while (mCells[slot].key != 0 && mCells[slot].key != key) {
+            slot = (slot + 1) & mask;
+        }
+
+        return slot;
+    }
+
+    template<typename T>
+    const typename FlatSpatialHash<T>::CellHeader *
+    FlatSpatialHash<T>::findCell(uint64_t key) const {
+        if (mCells.empty()) {
+            return nullptr;
+        }
+
+        const CellHeader &header = mCells[slotForKey(key)];
+        return header.key == key ? &header : nullptr;
+    }
+
+    template<typename T>
+    typename FlatSpatialHash<T>::CellHeader &
+    FlatSpatialHash<T>::findOrCreateCell(uint64_t key) {
+        // Keep load factor under 0.5 to keep probe sequences short
+        if ((mOccupiedCellCount + 1) * 2 > mCells.size()) {
+            rehash(std::max(mCells.size() * 2, (size_t) 16));
+        }
+
+        CellHeader &header = mCells[slotForKey(key)];
+        if (header.key == 0) {
+            header.key = key;
+            header.offset = (uint32_t) mObjects.size();
+            mOccupiedCellCount++;
+        }
+
+        return header;
+    }
+
+    template<typename T>
+    void
+    FlatSpatialHash<T>::rehash(size_t cellTableSize) {
+        std::vector<CellHeader> oldCells(cellTableSize);
+        std::swap(oldCells, mCells);
+
+        for (const CellHeader &header : oldCells) {
+            if (header.key != 0) {
+                mCells[slotForKey(header.key)] = header;
+            }
+        }
+    }
+
+    template<typename T>
+    void
+    FlatSpatialHash<T>::grow(CellHeader &header) {
+        // Cell's span is moved to the end of the payload with twice the capacity.
+        // The old span stays unused until the next compaction.
+        uint32_t capacity = std::max(header.capacity * 2, (uint32_t) 4);
+        uint32_t offset = (uint32_t) mObjects.size();
+
+        mObjects.resize(mObjects.size() + capacity);
+        std::move(mObjects.begin() + header.offset, mObjects.begin() + header.offset + header.count, mObjects.begin() + offset);
+
+        header.offset = offset;
+        header.capacity = capacity;
+    }
+
+#pragma mark - Modifiers
+
+    template<typename T>
+    void
+    FlatSpatialHash<T>::insert(const T &object, const glm::vec3 &position) {
+        if (!mBoundaries.contains(position)) {
+            throw std::out_of_range("Attempt to insert an object outside of spatial hash's boundaries");
+        }
+
+        CellHeader &header = findOrCreateCell(CellKey(cell(position)));
+        if (header.count == header.capacity) {
+            grow(header);
+        }
+
+        mObjects[header.offset + header.count] = object;
+        header.count++;
+        mSize++;
+
+        // Reclaim space left behind by grown spans once it outweighs the useful payload
+        if (mObjects.size() > mSize * 4 + 1024) {
+            compact();
+        }
+    }
+
+    template<typename T>
+    template<class PositionFunctor>
+    void
+    FlatSpatialHash<T>::build(const std::vector<T> &objects, PositionFunctor &&position) {
+        std::vector<std::pair<uint64_t, uint32_t>> keys;
+        keys.reserve(objects.size());
+
+        for (uint32_t i = 0; i < objects.size(); i++) {
+            glm::vec3 p = position(objects[i]);
+            if (!mBoundaries.contains(p)) {
+                throw std::out_of_range("Attempt to insert an object outside of spatial hash's boundaries");
+            }
+            keys.emplace_back(CellKey(cell(p)), i);
+        }
+
+        // Sorting by index as well keeps insertion order within cells
+        std::sort(keys.begin(), keys.end());
+
+        size_t distinctCellCount = 0;
+        for (size_t i = 0; i < keys.size(); i++) {
+            if (i == 0 || keys[i].first != keys[i - 1].first) {
+                distinctCellCount++;
+            }
+        }
+
+        size_t cellTableSize = 16;
+        while (cellTableSize < distinctCellCount * 2 + 1) {
+            cellTableSize *= 2;
+        }
+
+        mCells.assign(cellTableSize, CellHeader());
+        mObjects.clear();
+        mObjects.reserve(objects.size());
+        mOccupiedCellCount = 0;
+        mSize = objects.size();
+
+        for (size_t runStart = 0; runStart < keys.size();) {
+            size_t runEnd = runStart;
+            CellHeader &header = findOrCreateCell(keys[runStart].first);
+
+            while (runEnd < keys.size() && keys[runEnd].first == keys[runStart].first) {
+                mObjects.push_back(objects[keys[runEnd].second]);
+                runEnd++;
+            }
+
+            header.count = (uint32_t) (runEnd - runStart);
+            header.capacity = header.count;
+            runStart = runEnd;
+        }
+    }
+
+    template<typename T>
+    void
+    FlatSpatialHash<T>::compact() {
+        std::vector<CellHeader *> occupiedCells;
+        occupiedCells.reserve(mOccupiedCellCount);
+
+        for (CellHeader &header : mCells) {
+            if (header.key != 0) {
+                occupiedCells.push_back(&header);
+            }
+        }
+
+        std::sort(occupiedCells.begin(), occupiedCells.end(), [](const CellHeader *lhs, const CellHeader *rhs) {
+            return lhs->key < rhs->key;
+        });
+
+        std::vector<T> objects;
+        objects.reserve(mSize);
+
+        for (CellHeader *header : occupiedCells) {
+            uint32_t offset = (uint32_t) objects.size();
+            std::move(mObjects.begin() + header->offset, mObjects.begin() + header->offset + header->count, std::back_inserter(objects));
+            header->offset = offset;
+            header->capacity = header->count;
+        }
+
+        std::swap(mObjects, objects);
+    }
+
+    template<typename T>
+    void
+    FlatSpatialHash<T>::erase(const ForwardIterator &it) {
+        CellHeader &header = mCells[it.mSlot];
+        uint32_t index = header.offset + it.mIndexInCell;
+        uint32_t last = header.offset + header.count - 1;
+
+        if (index != last) {
+            mObjects[index] = std::move(mObjects[last]);
+        }
+
+        header.count--;
+        mSize--;
+    }
+
+#pragma mark - Queries
+
+    template<typename T>
+    typename FlatSpatialHash<T>::Range
+    FlatSpatialHash<T>::neighbours(const glm::vec3 &position) {
+        Range range;
+        glm::ivec3 center = cell(position);
+
+        for (int32_t x = -1; x <= 1; ++x) {
+            for (int32_t y = -1; y <= 1; ++y) {
+                for (int32_t z = -1; z <= 1; ++z) {
+                    glm::ivec3 neighbour = center + glm::ivec3(x, y, z);
+
+                    if (!isCellValid(neighbour)) {
+                        continue;
+                    }
+
+                    const CellHeader *header = findCell(CellKey(neighbour));
+                    if (!header || header->count == 0) {
+                        continue;
+                    }
+
+                    T *begin = mObjects.data() + header->offset;
+                    range.mSpans[range.mSpanCount] = std::make_pair(begin, begin + header->count);
+                    range.mSpanCount++;
+                }
+            }
+        }
+
+        return range;
+    }
+
+    template<typename T>
+    size_t
+    FlatSpatialHash<T>::size() const {
+        return mSize;
+    }
+
+#pragma mark - Iteration
+
+    template<typename T>
+    typename FlatSpatialHash<T>::ForwardIterator
+    FlatSpatialHash<T>::begin() {
+        return ForwardIterator(this, 0);
+    }
+
+    template<typename T>
+    typename FlatSpatialHash<T>::ForwardIterator
+    FlatSpatialHash<T>::end() {
+        return ForwardIterator(this, mCells.size());
+    }
+
+}
+
+#endif /* FlatSpatialHashImpl_h */
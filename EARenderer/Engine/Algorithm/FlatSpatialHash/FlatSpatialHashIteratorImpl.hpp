@@ -0,0 +1,156 @@
+//
+//  FlatSpatialHashIteratorImpl.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef FlatSpatialHashIteratorImpl_h
+#define FlatSpatialHashIteratorImpl_h
+
+namespace EARenderer {
+
+#pragma mark - Forward iterator
+
+    template<typename T>
+    FlatSpatialHash<T>::ForwardIterator::ForwardIterator(FlatSpatialHash *hash, size_t slot)
+            :
+            mHash(hash),
+            mSlot(slot) {
+        skipEmptySlots();
+    }
+
+    template<typename T>
+    void
+    FlatSpatialHash<T>::ForwardIterator::skipEmptySlots() {
+        while (mSlot < mHash->mCells.size() && mHash->mCells[mSlot].count == 0) {
+            mSlot++;
+        }
+    }
+
+    template<typename T>
+    typename FlatSpatialHash<T>::ForwardIterator &
+    FlatSpatialHash<T>::ForwardIterator::operator++() {
+        if (mSlot >= mHash->mCells.size()) {
+            throw std::out_of_range("Incrementing an iterator which had reached the end already");
+        }
+
+        mIndexInCell++;
+
+        if (mIndexInCell == mHash->mCells[mSlot].count) {
+            mIndexInCell = 0;
+            mSlot++;
+            skipEmptySlots();
+        }
+
+        return *this;
+    }
+
+    template<typename T>
+    T &
+    FlatSpatialHash<T>::ForwardIterator::operator*() {
+        return mHash->mObjects[mHash->mCells[mSlot].offset + mIndexInCell];
+    }
+
+    template<typename T>
+    T *
+    FlatSpatialHash<T>::ForwardIterator::operator->() {
+        return &(**this);
+    }
+
+    template<typename T>
+    const T &
+    FlatSpatialHash<T>::ForwardIterator::operator*() const {
+        return mHash->mObjects[mHash->mCells[mSlot].offset + mIndexInCell];
+    }
+
+    template<typename T>
+    const T *
+    FlatSpatialHash<T>::ForwardIterator::operator->() const {
+        return &(**this);
+    }
+
+    template<typename T>
+    bool
+    FlatSpatialHash<T>::ForwardIterator::operator!=(const ForwardIterator &other) const {
+        return mSlot != other.mSlot || mIndexInCell != other.mIndexInCell;
+    }
+
+#pragma mark - Range
+
+    template<typename T>
+    typename FlatSpatialHash<T>::Range::Iterator
+    FlatSpatialHash<T>::Range::begin() const {
+        return Iterator(this, 0);
+    }
+
+    template<typename T>
+    typename FlatSpatialHash<T>::Range::Iterator
+    FlatSpatialHash<T>::Range::end() const {
+        return Iterator(this, mSpanCount);
+    }
+
+#pragma mark - Range iterator
+
+    template<typename T>
+    FlatSpatialHash<T>::Range::Iterator::Iterator(const Range *range, size_t spanIndex)
+            :
+            mRange(range),
+            mSpanIndex(spanIndex) {
+        // Only non-empty spans make it into a range
+        if (spanIndex < range->mSpanCount) {
+            mCurrent = range->mSpans[spanIndex].first;
+        }
+    }
+
+    template<typename T>
+    typename FlatSpatialHash<T>::Range::Iterator &
+    FlatSpatialHash<T>::Range::Iterator::operator++() {
+        if (!mCurrent) {
+            throw std::out_of_range("Incrementing an iterator which had reached the end already");
+        }
+
+        mCurrent++;
+
+        if (mCurrent == mRange->mSpans[mSpanIndex].second) {
+            mSpanIndex++;
+            mCurrent = mSpanIndex < mRange->mSpanCount ? mRange->mSpans[mSpanIndex].first : nullptr;
+        }
+
+        return *this;
+    }
+
+    template<typename T>
+    T &
+    FlatSpatialHash<T>::Range::Iterator::operator*() {
+        return *mCurrent;
+    }
+
+    template<typename T>
+    T *
+    FlatSpatialHash<T>::Range::Iterator::operator->() {
+        return mCurrent;
+    }
+
+    template<typename T>
+    const T &
+    FlatSpatialHash<T>::Range::Iterator::operator*() const {
+        return *mCurrent;
+    }
+
+    template<typename T>
+    const T *
+    FlatSpatialHash<T>::Range::Iterator::operator->() const {
+        return mCurrent;
+    }
+
+    template<typename T>
+    bool
+    FlatSpatialHash<T>::Range::Iterator::operator!=(const Iterator &other) const {
+        return mCurrent != other.mCurrent;
+    }
+
+}
+
+#endif /* FlatSpatialHashIteratorImpl_h */
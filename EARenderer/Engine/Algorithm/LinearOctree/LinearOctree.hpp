@@ -0,0 +1,134 @@
+//
+//  LinearOctree.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef LinearOctree_hpp
+#define LinearOctree_hpp
+
+#include <vector>
+#include <array>
+#include <cstdint>
+
+#include <glm/vec3.hpp>
+
+#include "AxisAlignedBox3D.hpp"
+#include "Ray3D.hpp"
+
+namespace EARenderer {
+
+    /// Array-backed counterpart of SparseOctree.
+    /// Nodes are stored breadth first in a single vector with all children of a node adjacent,
+    /// so a node only needs the index of its first child and a child presence mask.
+    /// Objects are stored in one vector as well, every node referencing a contiguous range of it.
+    /// The tree is immutable after build(); all queries are const and keep traversal state on the
+    /// caller's stack, so any number of threads may raymarch the same tree simultaneously.
+    template<typename T>
+    class LinearOctree {
+    public:
+
+#pragma mark - Nested types
+
+        struct Node {
+        private:
+            friend LinearOctree;
+
+            uint32_t mFirstChildIndex = 0;
+            uint32_t mObjectsOffset = 0;
+            uint32_t mObjectCount = 0;
+            // Bit i is set when child in octant i is present.
+            // Octant bits: 1 - positive X half, 2 - positive Y half, 4 - positive Z half
+            uint8_t mChildMask = 0;
+
+            uint32_t childIndex(uint8_t octant) const;
+
+        public:
+            bool isLeaf() const;
+
+            uint32_t objectCount() const;
+        };
+
+    private:
+
+        struct StackFrame {
+            uint32_t nodeIndex;
+            uint32_t depth;
+            glm::vec3 min;
+        };
+
+        static constexpr size_t DepthCap = 10;
+        // Every popped frame pushes at most 8 children, leaving at most 7 more frames per level
+        static constexpr size_t TraversalStackSize = 7 * DepthCap + 8;
+
+#pragma mark - Private members
+
+        size_t mMaximumDepth;
+        AxisAlignedBox3D mBoundingBox;
+        std::vector<Node> mNodes;
+        std::vector<T> mObjects;
+        std::array<glm::vec3, DepthCap + 1> mNodeSizes;
+
+#pragma mark - Private functions
+
+        static AxisAlignedBox3D OctantBox(const glm::vec3 &parentMin, const glm::vec3 &childSize, uint8_t octant);
+
+        static bool SegmentIntersectsBox(const glm::vec3 &p0, const glm::vec3 &inverseDirection,
+                const glm::vec3 &boxMin, const glm::vec3 &boxMax, float &tEnter);
+
+    public:
+
+#pragma mark - Lifecycle
+
+        LinearOctree(const AxisAlignedBox3D &boundingBox, size_t maximumDepth);
+
+#pragma mark - Building
+
+        /**
+         Replaces contents of the tree. Every object ends up in the deepest node that fully contains it.
+
+         @param objects objects to be stored
+         @param containmentDetector callable bool(const T &object, const AxisAlignedBox3D &nodeBoundingBox)
+         */
+        template<class ContainmentDetector>
+        void build(const std::vector<T> &objects, ContainmentDetector &&containmentDetector);
+
+#pragma mark - Traversal
+
+        /**
+         Visits nodes pierced by the p0-p1 segment front to back, testing their objects for collision.
+         Objects straddling node boundaries stay in ancestor nodes and are tested before closer objects
+         of the descendants, so a detector searching for the closest object should record hits and return false.
+
+         @param collisionDetector callable bool(const T &object, const Ray3D &ray)
+         @return true as soon as the detector reports a collision with any object
+         */
+        template<class CollisionDetector>
+        bool raymarch(const glm::vec3 &p0, const glm::vec3 &p1, CollisionDetector &&collisionDetector) const;
+
+        template<class CollisionDetector>
+        bool raymarch(const Ray3D &ray, CollisionDetector &&collisionDetector) const;
+
+#pragma mark - Getters
+
+        const AxisAlignedBox3D &boundingBox() const;
+
+        size_t nodeCount() const;
+
+        size_t objectCount() const;
+
+        const std::vector<Node> &nodes() const;
+
+        /**
+         @return pointer to the first of node's node.objectCount() objects
+         */
+        const T *objects(const Node &node) const;
+    };
+
+}
+
+#include "LinearOctreeImpl.hpp"
+
+#endif /* LinearOctree_hpp */
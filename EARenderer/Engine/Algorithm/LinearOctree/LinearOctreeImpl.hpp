@@ -0,0 +1,321 @@
+//
+//  LinearOctreeImpl.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef LinearOctreeImpl_h
+#define LinearOctreeImpl_h
+
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <tuple>
+
+#include <glm/geometric.hpp>
+
+#include "StringUtils.hpp"
+
+namespace EARenderer {
+
+#pragma mark - Node
+
+    template<typename T>
+    uint32_t
+    LinearOctree<T>::Node::childIndex(uint8_t octant) const {
+        uint8_t precedingChildren = mChildMask & ((1 << octant) - 1);
+        return mFirstChildIndex + __builtin_popcount(precedingChildren);
+    }
+
+    template<typename T>
+    bool
+    LinearOctree<T>::Node::isLeaf() const {
+        return mChildMask == 0;
+    }
+
+    template<typename T>
+    uint32_t
+    LinearOctree<T>::Node::objectCount() const {
+        return mObjectCount;
+    }
+
+#pragma mark - Lifecycle
+
+    template<typename T>
+    LinearOctree<T>::LinearOctree(const AxisAlignedBox3D &boundingBox, size_t maximumDepth)
+            :
+            mMaximumDepth(maximumDepth),
+            mBoundingBox(boundingBox) {
+        if (maximumDepth > DepthCap) {
+            throw std::invalid_argument(string_format("Octree maximum depth is %d, you requested %d", DepthCap, maximumDepth));
+        }
+
+        mNodeSizes[0] = boundingBox.max - boundingBox.min;
+        for (size_t depth = 1; depth <= DepthCap; depth++) {
+            mNodeSizes[depth] = mNodeSizes[depth - 1] * 0.5f;
+        }
+
+        mNodes.emplace_back();
+    }
+
+#pragma mark - Private functions
+
+    template<typename T>
+    AxisAlignedBox3D
+    LinearOctree<T>::OctantBox(const glm::vec3 &parentMin, const glm::vec3 &childSize, uint8_t octant) {
+        glm::vec3 min = parentMin;
+        if (octant & 1) { min.x += childSize.x; }
+        if (octant & 2) { min.y += childSize.y; }
+        if (octant & 4) { min.z += childSize.z; }
+        return AxisAlignedBox3D(min, min + childSize);
+    }
+
+    template<typename T>
+    bool
+    LinearOctree<T>::SegmentIntersectsBox(const glm::vec3 &p0, const glm::vec3 &inverseDirection,
+            const glm::vec3 &boxMin, const glm::vec3 &boxMax, float &tEnter) {
+        tEnter = 0.f;
+        float tExit = 1.f;
+
+        for (glm::length_t axis = 0; axis < 3; axis++) {
+            // Zero direction component: the segment is parallel to the slab and either lies within it
+            // or misses the box. Slab distances would be 0 * inf = NaN when it lies on the boundary.
+            if (std::isinf(inverseDirection[axis])) {
+                if (p0[axis] < boxMin[axis] || p0[axis] > boxMax[axis]) {
+                    return false;
+                }
+                continue;
+            }
+
+            float t0 = (boxMin[axis] - p0[axis]) * inverseDirection[axis];
+            float t1 = (boxMax[axis] - p0[axis]) * inverseDirection[axis];
+            tEnter = std::max(tEnter, std::min(t0, t1));
+            tExit = std::min(tExit, std::max(t0, t1));
+        }
+
+        return tEnter <= tExit;
+    }
+
+#pragma mark - Building
+
+    template<typename T>
+    template<class ContainmentDetector>
+    void
+    LinearOctree<T>::build(const std::vector<T> &objects, ContainmentDetector &&containmentDetector) {
+        // Path of an object is a sequence of 3-bit octants from the root to its node.
+        // Aligning paths to the maximum depth and sorting by (path, depth) orders objects
+        // depth first, with objects of every node preceding objects of its descendants.
+        using PathKey = std::tuple<uint32_t, uint32_t, uint32_t>; // Aligned path, depth, object index
+        std::vector<PathKey> keys;
+        keys.reserve(objects.size());
+
+        for (uint32_t i = 0; i < objects.size(); i++) {
+            uint32_t path = 0;
+            uint32_t depth = 0;
+            glm::vec3 nodeMin = mBoundingBox.min;
+
+            while (depth < mMaximumDepth) {
+                bool anyChildContainsObject = false;
+
+                for (uint8_t octant = 0; octant < 8; octant++) {
+                    AxisAlignedBox3D childBox = OctantBox(nodeMin, mNodeSizes[depth + 1], octant);
+                    if (containmentDetector(objects[i], childBox)) {
+                        path = (path << 3) | octant;
+                        nodeMin = childBox.min;
+                        anyChildContainsObject = true;
+                        break;
+                    }
+                }
+
+                if (!anyChildContainsObject) {
+                    break;
+                }
+
+                depth++;
+            }
+
+            keys.emplace_back(path << (3 * (mMaximumDepth - depth)), depth, i);
+        }
+
+        std::sort(keys.begin(), keys.end());
+
+        mNodes.clear();
+        mObjects.clear();
+        mObjects.reserve(objects.size());
+        for (auto &key : keys) {
+            mObjects.push_back(objects[std::get<2>(key)]);
+        }
+
+        // Lay nodes out breadth first, processing one contiguous range of sorted keys per node
+        struct PendingNode {
+            uint32_t nodeIndex;
+            uint32_t depth;
+            size_t begin;
+            size_t end;
+        };
+
+        std::queue<PendingNode> pendingNodes;
+        mNodes.emplace_back();
+        pendingNodes.push({0, 0, 0, keys.size()});
+
+        while (!pendingNodes.empty()) {
+            PendingNode pending = pendingNodes.front();
+            pendingNodes.pop();
+
+            size_t childrenBegin = pending.begin;
+            while (childrenBegin < pending.end && std::get<1>(keys[childrenBegin]) == pending.depth) {
+                childrenBegin++;
+            }
+
+            Node &node = mNodes[pending.nodeIndex];
+            node.mObjectsOffset = (uint32_t) pending.begin;
+            node.mObjectCount = (uint32_t) (childrenBegin - pending.begin);
+            node.mFirstChildIndex = (uint32_t) mNodes.size();
+
+            uint32_t octantShift = 3 * (uint32_t) (mMaximumDepth - pending.depth - 1);
+            std::array<PendingNode, 8> children;
+            size_t childCount = 0;
+
+            for (size_t rangeBegin = childrenBegin; rangeBegin < pending.end;) {
+                uint8_t octant = (std::get<0>(keys[rangeBegin]) >> octantShift) & 0b111;
+                size_t rangeEnd = rangeBegin;
+                while (rangeEnd < pending.end && ((std::get<0>(keys[rangeEnd]) >> octantShift) & 0b111) == octant) {
+                    rangeEnd++;
+                }
+
+                node.mChildMask |= 1 << octant;
+                children[childCount] = {(uint32_t) (mNodes.size() + childCount), pending.depth + 1, rangeBegin, rangeEnd};
+                childCount++;
+                rangeBegin = rangeEnd;
+            }
+
+            // 'node' is invalidated past this point
+            mNodes.resize(mNodes.size() + childCount);
+            for (size_t i = 0; i < childCount; i++) {
+                pendingNodes.push(children[i]);
+            }
+        }
+
+        mNodes.shrink_to_fit();
+    }
+
+#pragma mark - Traversal
+
+    template<typename T>
+    template<class CollisionDetector>
+    bool
+    LinearOctree<T>::raymarch(const glm::vec3 &p0, const glm::vec3 &p1, CollisionDetector &&collisionDetector) const {
+        if (p0 == p1) {
+            return false;
+        }
+
+        glm::vec3 inverseDirection = 1.f / (p1 - p0);
+        Ray3D ray(p0, p1 - p0);
+
+        float tEnter = 0.f;
+        if (!SegmentIntersectsBox(p0, inverseDirection, mBoundingBox.min, mBoundingBox.max, tEnter)) {
+            return false;
+        }
+
+        std::array<StackFrame, TraversalStackSize> stack;
+        size_t stackSize = 0;
+        stack[stackSize++] = {0, 0, mBoundingBox.min};
+
+        while (stackSize > 0) {
+            StackFrame frame = stack[--stackSize];
+            const Node &node = mNodes[frame.nodeIndex];
+
+            const T *objects = mObjects.data() + node.mObjectsOffset;
+            for (uint32_t i = 0; i < node.mObjectCount; i++) {
+                if (collisionDetector(objects[i], ray)) {
+                    return true;
+                }
+            }
+
+            if (node.isLeaf()) {
+                continue;
+            }
+
+            const glm::vec3 &childSize = mNodeSizes[frame.depth + 1];
+            std::array<std::pair<float, StackFrame>, 8> hitChildren;
+            size_t hitChildCount = 0;
+
+            for (uint8_t octant = 0; octant < 8; octant++) {
+                if (!(node.mChildMask & (1 << octant))) {
+                    continue;
+                }
+
+                AxisAlignedBox3D childBox = OctantBox(frame.min, childSize, octant);
+                if (!SegmentIntersectsBox(p0, inverseDirection, childBox.min, childBox.max, tEnter)) {
+                    continue;
+                }
+
+                // Insertion keeps children ordered farthest first, so that the nearest child is pushed last and visited next
+                size_t position = hitChildCount++;
+                while (position > 0 && hitChildren[position - 1].first < tEnter) {
+                    hitChildren[position] = hitChildren[position - 1];
+                    position--;
+                }
+                hitChildren[position] = {tEnter, {node.childIndex(octant), frame.depth + 1, childBox.min}};
+            }
+
+            for (size_t i = 0; i < hitChildCount; i++) {
+                stack[stackSize++] = hitChildren[i].second;
+            }
+        }
+
+        return false;
+    }
+
+    template<typename T>
+    template<class CollisionDetector>
+    bool
+    LinearOctree<T>::raymarch(const Ray3D &ray, CollisionDetector &&collisionDetector) const {
+        // Extend ray's end point to ensure that it reaches all across the bounding box,
+        // including the case of the origin being outside of it
+        float t1 = glm::distance(ray.origin, mBoundingBox.min) + mBoundingBox.diagonal();
+        glm::vec3 a = ray.origin;
+        glm::vec3 b = ray.origin + ray.direction * t1;
+
+        return raymarch(a, b, std::forward<CollisionDetector>(collisionDetector));
+    }
+
+#pragma mark - Getters
+
+    template<typename T>
+    const AxisAlignedBox3D &
+    LinearOctree<T>::boundingBox() const {
+        return mBoundingBox;
+    }
+
+    template<typename T>
+    size_t
+    LinearOctree<T>::nodeCount() const {
+        return mNodes.size();
+    }
+
+    template<typename T>
+    size_t
+    LinearOctree<T>::objectCount() const {
+        return mObjects.size();
+    }
+
+    template<typename T>
+    const std::vector<typename LinearOctree<T>::Node> &
+    LinearOctree<T>::nodes() const {
+        return mNodes;
+    }
+
+    template<typename T>
+    const T *
+    LinearOctree<T>::objects(const Node &node) const {
+        return mObjects.data() + node.mObjectsOffset;
+    }
+
+}
+
+#endif /* LinearOctreeImpl_h */
@@ -12,6 +12,8 @@
 #include <unordered_set>
 #include <unordered_map>
 #include <random>
+#include <vector>
+#include <limits>
 
 #include "StringUtils.hpp"
 #include "PackedLookupTable.hpp"
@@ -22,15 +24,34 @@ namespace EARenderer {
 
     template<class T>
     class LogarithmicBin {
-    private:
+    public:
 
 #pragma mark - Nested types
 
+        enum class SamplingMode {
+            /// Picks a bin by linear search and an object in it by rejection sampling.
+            /// Samples exactly in proportion to current weights.
+            Rejection,
+
+            /// Samples from an alias table (Vose's method) built over a snapshot of the contents in constant time.
+            /// Erased objects are rejected and resampled. Objects inserted after the snapshot was taken
+            /// are picked by rejection sampling instead, with probability of their share of the total weight,
+            /// so every object is still sampled exactly in proportion to its current weight.
+            /// The table is lazily rebuilt as soon as less than half of the snapshot's weight is still alive
+            /// or the snapshot covers less than half of the total weight.
+            AliasTable
+        };
+
+    private:
+
         using Index = uint64_t;
 
+        static constexpr uint32_t NotInSnapshot = std::numeric_limits<uint32_t>::max();
+
         struct BinObject {
             T object;
             float weight = 0.0f;
+            uint32_t snapshotIndex = NotInSnapshot;
 
             BinObject(const T &object, float weight) : object(object), weight(weight) {
             }
@@ -39,9 +60,13 @@ namespace EARenderer {
         struct Bin {
             PackedLookupTable<BinObject> objects;
             float totalWeight = 0.0f;
+        };
 
-            Bin() : objects(1000) {
-            }
+        struct SnapshotEntry {
+            Index binIndex;
+            ID objectID;
+            float weight;
+            bool alive;
         };
 
         using BinsIterator = typename std::unordered_map<Index, Bin>::iterator;
@@ -88,17 +113,41 @@ namespace EARenderer {
         float mTotalWeight = 0.0f;
         uint64_t mSize = 0;
 
+        SamplingMode mSamplingMode = SamplingMode::Rejection;
+        std::vector<SnapshotEntry> mSnapshotEntries;
+        std::vector<float> mAliasProbabilities;
+        std::vector<uint32_t> mAliases;
+        float mSnapshotWeight = 0.0f;
+        float mSnapshotAliveWeight = 0.0f;
+        size_t mSnapshotAliveCount = 0;
+        // Objects inserted since the snapshot was taken
+        float mPendingWeight = 0.0f;
+        size_t mPendingCount = 0;
+
         int32_t index(float weight);
 
         float binMinWeight(Index index);
 
         float binMaxWeight(Index index);
 
+        bool isSnapshotStale() const;
+
+        void rebuildAliasTable();
+
+        Iterator randomByRejection();
+
+        Iterator randomFromAliasTable();
+
+        Iterator randomPending();
+
 #pragma mark - Public members
 
     public:
         LogarithmicBin(float minWeight, float maxWeight);
 
+        /// Creates a bin whose random selection is reproducible for the same seed and insertion sequence
+        LogarithmicBin(float minWeight, float maxWeight, uint32_t seed);
+
         LogarithmicBin(float maxWeight);
 
         float minWeight() const;
@@ -111,6 +160,10 @@ namespace EARenderer {
 
         bool empty() const;
 
+        SamplingMode samplingMode() const;
+
+        void setSamplingMode(SamplingMode mode);
+
         void insert(const T &object, float weight);
 
         void erase(const Iterator &it);
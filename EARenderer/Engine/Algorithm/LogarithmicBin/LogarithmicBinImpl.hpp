@@ -15,10 +15,16 @@ namespace EARenderer {
 
     template<typename T>
     LogarithmicBin<T>::LogarithmicBin::LogarithmicBin(float minWeight, float maxWeight)
+            :
+            LogarithmicBin(minWeight, maxWeight, std::random_device()()) {
+    }
+
+    template<typename T>
+    LogarithmicBin<T>::LogarithmicBin::LogarithmicBin(float minWeight, float maxWeight, uint32_t seed)
             :
             mMinWeight(minWeight),
             mMaxWeight(maxWeight),
-            mEngine(std::random_device()()),
+            mEngine(seed),
             mDistribution(0.0f, 1.0f) {
         if (maxWeight < minWeight) {
             throw std::invalid_argument(string_format("Maximum weight (%f) in LogarithmicBin must be larger than minimum weight (%f)!\n", maxWeight, minWeight));
@@ -83,6 +89,18 @@ namespace EARenderer {
         return mSize == 0;
     }
 
+    template<typename T>
+    typename LogarithmicBin<T>::SamplingMode
+    LogarithmicBin<T>::samplingMode() const {
+        return mSamplingMode;
+    }
+
+    template<typename T>
+    void
+    LogarithmicBin<T>::setSamplingMode(SamplingMode mode) {
+        mSamplingMode = mode;
+    }
+
     template<typename T>
     void
     LogarithmicBin<T>::insert(const T &object, float weight) {
@@ -96,6 +114,8 @@ namespace EARenderer {
         bin.totalWeight += weight;
         mTotalWeight += weight;
         mSize++;
+        mPendingWeight += weight;
+        mPendingCount++;
     }
 
     template<typename T>
@@ -105,6 +125,15 @@ namespace EARenderer {
         Bin &bin = it.mBinsIterator->second;
         BinObject &binObject = bin.objects[idToDelete];
 
+        if (binObject.snapshotIndex != NotInSnapshot) {
+            mSnapshotEntries[binObject.snapshotIndex].alive = false;
+            mSnapshotAliveWeight -= binObject.weight;
+            mSnapshotAliveCount--;
+        } else {
+            mPendingWeight = std::max(mPendingWeight - binObject.weight, 0.0f);
+            mPendingCount--;
+        }
+
         mTotalWeight -= binObject.weight;
         bin.totalWeight -= binObject.weight;
         mSize--;
@@ -120,9 +149,136 @@ namespace EARenderer {
         }
     }
 
+#pragma mark - Alias table
+
+    template<typename T>
+    bool
+    LogarithmicBin<T>::isSnapshotStale() const {
+        return mSnapshotAliveCount == 0 ||
+                mSnapshotAliveWeight < mSnapshotWeight * 0.5f ||
+                mSnapshotAliveWeight < mTotalWeight * 0.5f;
+    }
+
+    template<typename T>
+    void
+    LogarithmicBin<T>::rebuildAliasTable() {
+        mSnapshotEntries.clear();
+        mSnapshotEntries.reserve(mSize);
+        mSnapshotWeight = 0.0f;
+
+        for (auto &binPair : mBins) {
+            Bin &bin = binPair.second;
+            for (ID id : bin.objects) {
+                BinObject &binObject = bin.objects[id];
+                binObject.snapshotIndex = (uint32_t) mSnapshotEntries.size();
+                mSnapshotEntries.push_back({binPair.first, id, binObject.weight, true});
+                mSnapshotWeight += binObject.weight;
+            }
+        }
+
+        mSnapshotAliveWeight = mSnapshotWeight;
+        mSnapshotAliveCount = mSnapshotEntries.size();
+        mPendingWeight = 0.0f;
+        mPendingCount = 0;
+
+        size_t n = mSnapshotEntries.size();
+        mAliasProbabilities.assign(n, 1.0f);
+        mAliases.resize(n);
+
+        if (n == 0 || mSnapshotWeight <= 0.0f) {
+            return;
+        }
+
+        // Vose's alias method: split columns into those under and over the average weight,
+        // then fill every underfull column with a portion of an overfull one
+        std::vector<float> scaledWeights(n);
+        std::vector<uint32_t> small;
+        std::vector<uint32_t> large;
+
+        for (uint32_t i = 0; i < n; i++) {
+            mAliases[i] = i;
+            scaledWeights[i] = mSnapshotEntries[i].weight * n / mSnapshotWeight;
+            (scaledWeights[i] < 1.0f ? small : large).push_back(i);
+        }
+
+        while (!small.empty() && !large.empty()) {
+            uint32_t s = small.back();
+            small.pop_back();
+            uint32_t l = large.back();
+
+            mAliasProbabilities[s] = scaledWeights[s];
+            mAliases[s] = l;
+
+            scaledWeights[l] = (scaledWeights[l] + scaledWeights[s]) - 1.0f;
+            if (scaledWeights[l] < 1.0f) {
+                large.pop_back();
+                small.push_back(l);
+            }
+        }
+
+        // Leftovers differ from 1 only due to rounding errors
+        for (uint32_t i : small) { mAliasProbabilities[i] = 1.0f; }
+        for (uint32_t i : large) { mAliasProbabilities[i] = 1.0f; }
+    }
+
+    template<typename T>
+    typename LogarithmicBin<T>::Iterator
+    LogarithmicBin<T>::randomFromAliasTable() {
+        if (isSnapshotStale()) {
+            rebuildAliasTable();
+        }
+
+        // Pending objects are sampled in proportion to their share of the weight, which keeps the whole distribution exact
+        if (mPendingCount > 0 && mDistribution(mEngine) * (mSnapshotAliveWeight + mPendingWeight) >= mSnapshotAliveWeight) {
+            return randomPending();
+        }
+
+        size_t n = mSnapshotEntries.size();
+
+        // Staleness check guarantees that at least half of snapshot's weight is alive,
+        // so on average it takes no more than two attempts to hit an alive entry
+        while (true) {
+            size_t column = std::min((size_t) (mDistribution(mEngine) * n), n - 1);
+            size_t entryIndex = mDistribution(mEngine) < mAliasProbabilities[column] ? column : mAliases[column];
+            const SnapshotEntry &entry = mSnapshotEntries[entryIndex];
+
+            if (entry.alive) {
+                auto binIterator = mBins.find(entry.binIndex);
+                return Iterator(binIterator, mBins.end(), binIterator->second.objects.find(entry.objectID));
+            }
+        }
+    }
+
+    template<typename T>
+    typename LogarithmicBin<T>::Iterator
+    LogarithmicBin<T>::randomPending() {
+        // Rejection sampling over all objects yields pending ones in proportion to their weights.
+        // Staleness check guarantees that pending objects carry at most half of the total weight,
+        // and this branch is taken with probability of their share, so it costs one rejection sample per sample on average.
+        while (true) {
+            Iterator it = randomByRejection();
+            const BinObject &binObject = it.mBinsIterator->second.objects[*it.mBinObjectsIterator];
+            if (binObject.snapshotIndex == NotInSnapshot) {
+                return it;
+            }
+        }
+    }
+
+#pragma mark - Sampling
+
     template<typename T>
     typename LogarithmicBin<T>::Iterator
     LogarithmicBin<T>::random() {
+        if (mSize == 0) {
+            return end();
+        }
+
+        return mSamplingMode == SamplingMode::AliasTable ? randomFromAliasTable() : randomByRejection();
+    }
+
+    template<typename T>
+    typename LogarithmicBin<T>::Iterator
+    LogarithmicBin<T>::randomByRejection() {
         float randomWeight = mDistribution(mEngine);
         float accumulatedWeight = 0.0f;
 
@@ -156,7 +312,7 @@ namespace EARenderer {
         //
         while (true) {
             auto &binObjects = randomBinIterator->second.objects;
-            randomBinObjectIndex = mDistribution(mEngine) * (binObjects.size() - 1);
+            randomBinObjectIndex = std::min((Index) (mDistribution(mEngine) * binObjects.size()), (Index) binObjects.size() - 1);
             randomWeight = mDistribution(mEngine);
 
             binObjectsIterator = binObjects.begin() + randomBinObjectIndex;
@@ -25,7 +25,8 @@ namespace EARenderer {
     LogarithmicBin<T>::Iterator::Iterator(BinsIterator endIterator)
             :
             mBinsIterator(endIterator),
-            mBinsEndIterator(endIterator) {
+            mBinsEndIterator(endIterator),
+            mBinObjectsIterator(nullptr) {
     }
 
 #pragma mark - Operators
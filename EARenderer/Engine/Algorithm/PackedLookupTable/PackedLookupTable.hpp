@@ -14,6 +14,8 @@
 #include <assert.h>
 #include <stdexcept>
 #include <limits>
+#include <vector>
+#include <memory>
 
 #include "StringUtils.hpp"
 
@@ -21,6 +23,8 @@
 
 namespace EARenderer {
 
+    /// 32 MSB - generation of the slot, 32 LSB - slot index.
+    /// Generations start at 1, so IDNotFound never refers to an object.
     typedef uint64_t ID;
     static ID IDNotFound = 0;
 
@@ -30,51 +34,78 @@ namespace EARenderer {
 
 #pragma mark - Private
 
-        struct Allocation {
-            ID objectID;
-            uint64_t objectIndex;
-            uint64_t nextAllocationIndex;
+        // Used to mark a slot as owning no object
+        static const uint32_t DeadObjectIndex = std::numeric_limits<uint32_t>::max();
+
+        // Used to terminate the free slot list
+        static const uint32_t NotAnIndex = std::numeric_limits<uint32_t>::max();
+
+        struct Slot {
+            uint32_t generation = 1;
+            uint32_t objectIndex = DeadObjectIndex;
+            uint32_t nextFreeSlotIndex = NotAnIndex;
         };
 
-        // Used to mark an allocation as owning no object
-        static const uint64_t DeadObjectIndex = -1;
+        static constexpr size_t ChunkCapacityFor(size_t objectSize) {
+            // Aim for ~16 KB chunks, but keep capacity a power of two within reasonable bounds
+            size_t capacity = 16;
+            while (capacity < 4096 && capacity * 2 * objectSize <= 16384) {
+                capacity *= 2;
+            }
+            return capacity;
+        }
 
-        // Used to mark an allocation as owning no object
-        static const uint64_t NotAnIndex = -1;
+        // Objects are stored in fixed size chunks which are never reallocated,
+        // so growth doesn't invalidate object addresses
+        static constexpr size_t ChunkCapacity = ChunkCapacityFor(sizeof(T));
 
         // Storage for objects
-        // Objects are contiguous, and always packed to the start of the storage.
-        // Objects can be relocated in this storage thanks to the separate list of allocations.
+        // Objects are contiguous within chunks, and always packed to the start of the storage.
+        // Objects can be relocated in this storage thanks to the separate list of slots.
         size_t mObjectsCount = 0;
-        uint64_t mCapacity = 0;
-        uint64_t mMaxCapacity = std::numeric_limits<uint64_t>::max();
-        T *mObjects = nullptr;
+        std::vector<T *> mChunks;
+
+        // The ID of each object in the object array (1-1 mapping)
+        std::vector<ID> mObjectIDs;
+
+        // Indirection from IDs to objects
+        std::vector<Slot> mSlots;
+
+        // FIFO queue of free slots. Reusing slots as late as possible makes generations wrap slower.
+        uint32_t mFirstFreeSlotIndex = NotAnIndex;
+        uint32_t mLastFreeSlotIndex = NotAnIndex;
+
+        static ID MakeID(uint32_t slotIndex, uint32_t generation);
 
-        // The allocation ID of each object in the object array (1-1 mapping)
-        ID *mObjectIDs = nullptr;
+        static uint32_t SlotIndex(ID id);
 
-        // FIFO queue to allocate objects
-        Allocation *mAllocations = nullptr;
+        static uint32_t Generation(ID id);
 
-        // Last possible free allocation slot
-        uint64_t mLastAllocationIndex = NotAnIndex;
+        T *objectAt(size_t objectIndex) const;
 
-        // The next index struct to use for an allocation
-        uint64_t mNextAllocationIndex = NotAnIndex;
+        uint32_t popFreeSlot();
 
-        Allocation *popFreeAllocation();
+        void pushFreeSlot(uint32_t slotIndex);
+
+        T *allocateObject(ID &id);
+
+        void destroyAll();
 
     public:
 
 #pragma mark - Public
 #pragma mark Iterator
 
+        /// Walks over IDs of objects in storage order.
+        /// Iterators point into the table's array of IDs, so, just like std::vector iterators, they are invalidated
+        /// by insert() and emplace(), which may reallocate that array, and by erase(), which moves the last ID into the erased one's place.
+        /// Objects themselves stay in place on insertion, IDs are the stable way to refer to them.
         struct Iterator {
         private:
-            ID *mCurrentObjectID;
+            const ID *mCurrentObjectID;
 
         public:
-            Iterator(ID *in);
+            Iterator(const ID *in);
 
             Iterator &operator++();
 
@@ -89,6 +120,11 @@ namespace EARenderer {
 
 #pragma mark - Lifecycle
 
+        PackedLookupTable() = default;
+
+        /**
+         @param capacity number of objects to reserve memory for. The table grows past it on demand.
+         */
         PackedLookupTable(size_t capacity);
 
         PackedLookupTable(const PackedLookupTable &other);
@@ -103,8 +139,10 @@ namespace EARenderer {
 
         PackedLookupTable &operator=(PackedLookupTable rhs);
 
+        /// Throws std::invalid_argument for IDs of erased objects
         T &operator[](ID id);
 
+        /// Throws std::invalid_argument for IDs of erased objects
         const T &operator[](ID id) const;
 
 #pragma mark - Modifiers
@@ -116,8 +154,16 @@ namespace EARenderer {
         template<class... Args>
         ID emplace(Args &&... args);
 
+        /**
+         @return true if the ID refers to an object in the table. IDs of erased objects are rejected
+         even after their slots have been reused.
+         */
         bool contains(ID id) const;
 
+        /**
+         Erases the object. The last object of the table is moved into its place,
+         so this is the only operation that changes addresses of objects.
+         */
         void erase(ID id);
 
         void reserve(uint64_t capacity);
@@ -130,13 +176,31 @@ namespace EARenderer {
 
         size_t capacity() const;
 
-        const T *data() const;
-
 #pragma mark - Iteration
 
         Iterator begin() const;
 
         Iterator end() const;
+
+        /**
+         @return iterator pointing to the object with the given ID or end() if there is no such object,
+         valid until the table is modified (see Iterator)
+         */
+        Iterator find(ID id) const;
+
+        /**
+         Sweeps over all objects in storage order, one contiguous chunk after another
+
+         @param function callable taking T &
+         */
+        template<class Function>
+        void forEach(Function &&function);
+
+        /**
+         @param function callable taking const T &
+         */
+        template<class Function>
+        void forEach(Function &&function) const;
     };
 
     template<typename T>
@@ -1,4 +1,3 @@
-
 //
 //  PackedLookupTableImpl.h
 //  EARenderer
@@ -12,117 +11,145 @@
 
 namespace EARenderer {
 
-    template<typename T>
-    typename PackedLookupTable<T>::Allocation *
-    PackedLookupTable<T>::popFreeAllocation() {
-        // Reserve more memory if needed
-        if (mNextAllocationIndex == NotAnIndex) {
-            reserve(mCapacity * 2);
-        }
-
-        assert(mObjectsCount < mCapacity);
-
-        // pop an allocation from the FIFO
-        Allocation *allocation = &mAllocations[mNextAllocationIndex];
-        mNextAllocationIndex = allocation->nextAllocationIndex;
+#pragma mark - Private helpers
 
-        // always allocate the object at the end of the storage
-        allocation->objectIndex = mObjectsCount;
-        mObjectsCount++;
-
-        // update reverse-lookup so objects can know their ID
-        mObjectIDs[allocation->objectIndex] = allocation->objectID;
-
-        return allocation;
+    template<typename T>
+    ID
+    PackedLookupTable<T>::MakeID(uint32_t slotIndex, uint32_t generation) {
+        return (static_cast<ID>(generation) << 32) | slotIndex;
     }
 
-#pragma mark - Lifecycle
-
     template<typename T>
-    PackedLookupTable<T>::PackedLookupTable(size_t capacity) {
-        mObjectsCount = 0;
-        mCapacity = capacity;
+    uint32_t
+    PackedLookupTable<T>::SlotIndex(ID id) {
+        return static_cast<uint32_t>(id & 0xFFFFFFFF);
+    }
 
-        mObjects = reinterpret_cast<T *>(new char[capacity * sizeof(T)]);
-        assert(mObjects);
+    template<typename T>
+    uint32_t
+    PackedLookupTable<T>::Generation(ID id) {
+        return static_cast<uint32_t>(id >> 32);
+    }
 
-        mObjectIDs = new ID[mCapacity];
-        assert(mObjectIDs);
+    template<typename T>
+    T *
+    PackedLookupTable<T>::objectAt(size_t objectIndex) const {
+        return mChunks[objectIndex / ChunkCapacity] + objectIndex % ChunkCapacity;
+    }
 
-        mAllocations = new Allocation[mCapacity];
-        assert(mAllocations);
+    template<typename T>
+    uint32_t
+    PackedLookupTable<T>::popFreeSlot() {
+        if (mFirstFreeSlotIndex == NotAnIndex) {
+            if (mSlots.size() >= NotAnIndex) {
+                throw std::length_error(string_format("Cannot allocate more than %u objects\n", NotAnIndex));
+            }
+            mSlots.emplace_back();
+            return static_cast<uint32_t>(mSlots.size() - 1);
+        }
 
-        for (size_t i = 0; i < mCapacity; i++) {
-            mAllocations[i].objectID = static_cast<ID>(i);
-            mAllocations[i].objectIndex = DeadObjectIndex;
-            mAllocations[i].nextAllocationIndex = static_cast<uint64_t>(i + 1);
+        uint32_t slotIndex = mFirstFreeSlotIndex;
+        mFirstFreeSlotIndex = mSlots[slotIndex].nextFreeSlotIndex;
+        if (mFirstFreeSlotIndex == NotAnIndex) {
+            mLastFreeSlotIndex = NotAnIndex;
         }
+        return slotIndex;
+    }
+
+    template<typename T>
+    void
+    PackedLookupTable<T>::pushFreeSlot(uint32_t slotIndex) {
+        mSlots[slotIndex].nextFreeSlotIndex = NotAnIndex;
 
-        if (mCapacity > 0) {
-            mAllocations[mCapacity - 1].nextAllocationIndex = NotAnIndex;
+        if (mLastFreeSlotIndex == NotAnIndex) {
+            mFirstFreeSlotIndex = slotIndex;
+        } else {
+            mSlots[mLastFreeSlotIndex].nextFreeSlotIndex = slotIndex;
         }
 
-        mLastAllocationIndex = mCapacity - 1;
-        mNextAllocationIndex = 0;
+        mLastFreeSlotIndex = slotIndex;
     }
 
     template<typename T>
-    PackedLookupTable<T>::PackedLookupTable(const PackedLookupTable &other) {
+    T *
+    PackedLookupTable<T>::allocateObject(ID &id) {
+        // Allocate one more chunk if needed. Not through reserve(), which would grow
+        // the ID and slot arrays to the exact capacity and copy them on every new chunk
+        if (mObjectsCount == capacity()) {
+            mChunks.push_back(std::allocator<T>().allocate(ChunkCapacity));
+        }
 
-        mObjectsCount = other.mObjectsCount;
-        mCapacity = other.mCapacity;
+        uint32_t slotIndex = popFreeSlot();
+        Slot &slot = mSlots[slotIndex];
 
-        mObjects = reinterpret_cast<T *>(new char[other.mCapacity * sizeof(T)]);
-        assert(mObjects);
+        // always allocate the object at the end of the storage
+        slot.objectIndex = static_cast<uint32_t>(mObjectsCount);
+        id = MakeID(slotIndex, slot.generation);
 
-        mObjectIDs = new ID[other.mCapacity];
-        assert(mObjectIDs);
+        // update reverse-lookup so objects can know their ID
+        mObjectIDs.push_back(id);
+        mObjectsCount++;
 
-        mAllocations = new Allocation[other.mCapacity];
-        assert(mAllocations);
+        return objectAt(slot.objectIndex);
+    }
 
-        for (size_t i = 0; i < other.mCapacity; i++) {
-            new(mObjects + i) T(*(other.mObjects + i));
-            mObjectIDs[i] = other.mObjectIDs[i];
+    template<typename T>
+    void
+    PackedLookupTable<T>::destroyAll() {
+        for (size_t i = 0; i < mObjectsCount; i++) {
+            objectAt(i)->~T();
         }
 
-        for (size_t i = 0; i < other.mCapacity; i++) {
-            mAllocations[i] = other.mAllocations[i];
+        std::allocator<T> allocator;
+        for (T *chunk : mChunks) {
+            allocator.deallocate(chunk, ChunkCapacity);
         }
 
-        mLastAllocationIndex = other.mLastAllocationIndex;
-        mNextAllocationIndex = other.mNextAllocationIndex;
+        mChunks.clear();
+        mObjectsCount = 0;
+    }
+
+#pragma mark - Lifecycle
+
+    template<typename T>
+    PackedLookupTable<T>::PackedLookupTable(size_t capacity) {
+        reserve(capacity);
+    }
+
+    template<typename T>
+    PackedLookupTable<T>::PackedLookupTable(const PackedLookupTable &other)
+            :
+            mObjectIDs(other.mObjectIDs),
+            mSlots(other.mSlots),
+            mFirstFreeSlotIndex(other.mFirstFreeSlotIndex),
+            mLastFreeSlotIndex(other.mLastFreeSlotIndex) {
+        reserve(other.capacity());
+
+        for (size_t i = 0; i < other.mObjectsCount; i++) {
+            new(objectAt(i)) T(*other.objectAt(i));
+            mObjectsCount++;
+        }
     }
 
     template<typename T>
     PackedLookupTable<T>::PackedLookupTable(PackedLookupTable &&other) {
         swap(other);
-
-        other.mObjects = nullptr;
-        other.mObjectIDs = nullptr;
-        other.mAllocations = nullptr;
     }
 
     template<typename T>
     PackedLookupTable<T>::~PackedLookupTable() {
-        for (size_t i = 0; i < mObjectsCount; i++) {
-            mObjects[i].~T();
-        }
-        delete[] ((char *) mObjects);
-        delete[] mObjectIDs;
-        delete[] mAllocations;
+        destroyAll();
     }
 
     template<typename T>
     void
     PackedLookupTable<T>::swap(PackedLookupTable &other) {
         std::swap(mObjectsCount, other.mObjectsCount);
-        std::swap(mCapacity, other.mCapacity);
-        std::swap(mObjects, other.mObjects);
+        std::swap(mChunks, other.mChunks);
         std::swap(mObjectIDs, other.mObjectIDs);
-        std::swap(mAllocations, other.mAllocations);
-        std::swap(mLastAllocationIndex, other.mLastAllocationIndex);
-        std::swap(mNextAllocationIndex, other.mNextAllocationIndex);
+        std::swap(mSlots, other.mSlots);
+        std::swap(mFirstFreeSlotIndex, other.mFirstFreeSlotIndex);
+        std::swap(mLastFreeSlotIndex, other.mLastFreeSlotIndex);
     }
 
 #pragma mark - Operators
@@ -137,21 +164,19 @@ namespace EARenderer {
     template<typename T>
     T &
     PackedLookupTable<T>::operator[](ID id) {
-        // grab the allocation corresponding to this ID
-        Allocation *allocation = &mAllocations[id];
-
-        // grab the object associated with the allocation
-        return *(mObjects + allocation->objectIndex);
+        if (!contains(id)) {
+            throw std::invalid_argument(string_format("There is no object with ID %llu\n", id));
+        }
+        return *objectAt(mSlots[SlotIndex(id)].objectIndex);
     }
 
     template<typename T>
     const T &
     PackedLookupTable<T>::operator[](ID id) const {
-        // grab the allocation corresponding to this ID
-        Allocation *allocation = &mAllocations[id];
-
-        // grab the object associated with the allocation
-        return *(mObjects + allocation->objectIndex);
+        if (!contains(id)) {
+            throw std::invalid_argument(string_format("There is no object with ID %llu\n", id));
+        }
+        return *objectAt(mSlots[SlotIndex(id)].objectIndex);
     }
 
 #pragma mark - Modifiers
@@ -159,125 +184,93 @@ namespace EARenderer {
     template<typename T>
     ID
     PackedLookupTable<T>::insert(const T &object) {
-        Allocation *allocation = popFreeAllocation();
-        T *insertionPointer = mObjects + allocation->objectIndex;
-        new(insertionPointer) T(object);
-        return allocation->objectID;
+        ID id;
+        new(allocateObject(id)) T(object);
+        return id;
     }
 
     template<typename T>
     ID
     PackedLookupTable<T>::insert(T &&object) {
-        Allocation *allocation = popFreeAllocation();
-        T *insertionPointer = mObjects + allocation->objectIndex;
-        new(insertionPointer) T(std::move(object));
-        return allocation->objectID;
+        ID id;
+        new(allocateObject(id)) T(std::move(object));
+        return id;
     }
 
     template<typename T>
     template<class... Args>
     ID
     PackedLookupTable<T>::emplace(Args &&... args) {
-        Allocation *allocation = popFreeAllocation();
-        T *o = mObjects + allocation->objectIndex;
-        new(o) T(std::forward<Args>(args)...);
-        return allocation->objectID;
+        ID id;
+        new(allocateObject(id)) T(std::forward<Args>(args)...);
+        return id;
     }
 
     template<typename T>
     bool
     PackedLookupTable<T>::contains(ID id) const {
-        Allocation *allocation = &mAllocations[id];
-        bool contains = allocation->objectID == id && allocation->objectIndex != DeadObjectIndex;
-        return contains;
+        uint32_t slotIndex = SlotIndex(id);
+        if (slotIndex >= mSlots.size()) {
+            return false;
+        }
+
+        const Slot &slot = mSlots[slotIndex];
+        return slot.generation == Generation(id) && slot.objectIndex != DeadObjectIndex;
     }
 
     template<typename T>
     void
     PackedLookupTable<T>::erase(ID id) {
         if (!contains(id)) {
-            throw std::invalid_argument(string_format("There is no object with ID %d\n", id));
+            throw std::invalid_argument(string_format("There is no object with ID %llu\n", id));
         }
 
-        // grab the allocation to delete
-        ID eresableAllocationIndex = id;
-        Allocation *allocation = &mAllocations[eresableAllocationIndex];
+        uint32_t slotIndex = SlotIndex(id);
+        Slot &slot = mSlots[slotIndex];
 
-        // grab the object for this allocation
-        T *object = mObjects + allocation->objectIndex;
+        // grab the object for this slot
+        T *object = objectAt(slot.objectIndex);
 
         // if necessary, move (aka swap) the last object into the location of the object to erase, then unconditionally delete the last object
-        if (allocation->objectIndex != mObjectsCount - 1) {
-            T *last = mObjects + mObjectsCount - 1;
+        if (slot.objectIndex != mObjectsCount - 1) {
+            T *last = objectAt(mObjectsCount - 1);
             *object = std::move(*last);
             object = last;
 
             // since the last object was moved into the deleted location, the associated object ID array's value must also be moved similarly
-            ID lastObjectID = mObjectIDs[mObjectsCount - 1];
-            mObjectIDs[allocation->objectIndex] = lastObjectID;
+            ID lastObjectID = mObjectIDs.back();
+            mObjectIDs[slot.objectIndex] = lastObjectID;
 
-            // since the last object has changed location, its allocation needs to be updated to the new location.
-            uint64_t lastAllocationIndex = lastObjectID;
-            mAllocations[lastAllocationIndex].objectIndex = allocation->objectIndex;
+            // since the last object has changed location, its slot needs to be updated to the new location.
+            mSlots[SlotIndex(lastObjectID)].objectIndex = slot.objectIndex;
         }
 
         // destroy the removed object and pop it from the array
         object->~T();
         mObjectsCount--;
-
-        uint64_t deletedAllocationIndex = allocation->objectID;
-
-        if (mNextAllocationIndex == NotAnIndex) {
-            mNextAllocationIndex = deletedAllocationIndex;
+        mObjectIDs.pop_back();
+
+        // put a tombstone where the slot used to point to an object index
+        // and invalidate all outstanding IDs referring to this slot
+        slot.objectIndex = DeadObjectIndex;
+        slot.generation++;
+        if (slot.generation == 0) {
+            slot.generation = 1;
         }
 
-        // push the deleted allocation onto the FIFO
-        mAllocations[mLastAllocationIndex].nextAllocationIndex = deletedAllocationIndex;
-        mLastAllocationIndex = deletedAllocationIndex;
-
-        // put a tombstone where the allocation used to point to an object index
-        allocation->objectIndex = DeadObjectIndex;
-        allocation->nextAllocationIndex = NotAnIndex;
+        pushFreeSlot(slotIndex);
     }
 
     template<typename T>
     void
     PackedLookupTable<T>::reserve(uint64_t capacity) {
-        if (mCapacity == mMaxCapacity) {
-            throw std::length_error(string_format("Cannot reserve more memory. Maximum capacity (%d) has already been reached\n", mMaxCapacity));
+        std::allocator<T> allocator;
+        while (this->capacity() < capacity) {
+            mChunks.push_back(allocator.allocate(ChunkCapacity));
         }
 
-        uint64_t newCapacity = std::min(capacity, mMaxCapacity);
-
-        T *objects = reinterpret_cast<T *>(new char[newCapacity * sizeof(T)]);
-        ID *objectIDs = new ID[newCapacity];
-        Allocation *allocations = new Allocation[newCapacity];
-
-        memcpy((char *) objects, (char *) mObjects, mObjectsCount * sizeof(T));
-        memcpy(allocations, mAllocations, mCapacity * sizeof(Allocation));
-        memcpy(objectIDs, mObjectIDs, mCapacity * sizeof(ID));
-
-        for (size_t i = mCapacity; i < newCapacity; ++i) {
-            allocations[i].objectID = static_cast<ID>(i);
-            allocations[i].objectIndex = DeadObjectIndex;
-            allocations[i].nextAllocationIndex = static_cast<uint64_t>(i + 1);
-        }
-
-        // Link last allocation to the new memory chunk
-        allocations[mLastAllocationIndex].nextAllocationIndex = mObjectsCount;
-        allocations[newCapacity - 1].nextAllocationIndex = NotAnIndex;
-        mNextAllocationIndex = mObjectsCount;
-        mLastAllocationIndex = newCapacity - 1;
-
-        delete[] (char *) mObjects;
-        delete[] mObjectIDs;
-        delete[] mAllocations;
-
-        mObjects = objects;
-        mObjectIDs = objectIDs;
-        mAllocations = allocations;
-
-        mCapacity = newCapacity;
+        mObjectIDs.reserve(this->capacity());
+        mSlots.reserve(this->capacity());
     }
 
 #pragma mark - Accessors
@@ -297,13 +290,7 @@ namespace EARenderer {
     template<typename T>
     size_t
     PackedLookupTable<T>::capacity() const {
-        return mCapacity;
-    }
-
-    template<typename T>
-    const T *
-    PackedLookupTable<T>::data() const {
-        return mObjects;
+        return mChunks.size() * ChunkCapacity;
     }
 
 #pragma mark - Iteration
@@ -311,13 +298,48 @@ namespace EARenderer {
     template<typename T>
     typename PackedLookupTable<T>::Iterator
     PackedLookupTable<T>::begin() const {
-        return Iterator{mObjectIDs};
+        return Iterator{mObjectIDs.data()};
     }
 
     template<typename T>
     typename PackedLookupTable<T>::Iterator
     PackedLookupTable<T>::end() const {
-        return Iterator{mObjectIDs + mObjectsCount};
+        return Iterator{mObjectIDs.data() + mObjectsCount};
+    }
+
+    template<typename T>
+    typename PackedLookupTable<T>::Iterator
+    PackedLookupTable<T>::find(ID id) const {
+        if (!contains(id)) {
+            return end();
+        }
+        return Iterator{mObjectIDs.data() + mSlots[SlotIndex(id)].objectIndex};
+    }
+
+    template<typename T>
+    template<class Function>
+    void
+    PackedLookupTable<T>::forEach(Function &&function) {
+        for (size_t chunkStart = 0; chunkStart < mObjectsCount; chunkStart += ChunkCapacity) {
+            T *chunk = mChunks[chunkStart / ChunkCapacity];
+            size_t count = std::min(ChunkCapacity, mObjectsCount - chunkStart);
+            for (size_t i = 0; i < count; i++) {
+                function(chunk[i]);
+            }
+        }
+    }
+
+    template<typename T>
+    template<class Function>
+    void
+    PackedLookupTable<T>::forEach(Function &&function) const {
+        for (size_t chunkStart = 0; chunkStart < mObjectsCount; chunkStart += ChunkCapacity) {
+            const T *chunk = mChunks[chunkStart / ChunkCapacity];
+            size_t count = std::min(ChunkCapacity, mObjectsCount - chunkStart);
+            for (size_t i = 0; i < count; i++) {
+                function(chunk[i]);
+            }
+        }
     }
 
 }
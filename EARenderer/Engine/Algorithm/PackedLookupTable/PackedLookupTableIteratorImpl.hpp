@@ -12,7 +12,7 @@
 namespace EARenderer {
 
     template<typename T>
-    PackedLookupTable<T>::Iterator::Iterator(ID *in)
+    PackedLookupTable<T>::Iterator::Iterator(const ID *in)
             :
             mCurrentObjectID(in) {
     }
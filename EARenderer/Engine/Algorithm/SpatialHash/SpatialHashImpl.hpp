@@ -11,6 +11,8 @@
 
 #include "Collision.hpp"
 
+#include <cmath>
+
 namespace EARenderer {
 
 #pragma mark Lifecycle
@@ -28,7 +30,9 @@ namespace EARenderer {
         if (fabs(delta) < 1e-09) {
             return 0;
         }
-        int32_t index = (positionOnAxis - mBoundaries.min[axis]) / delta * (mResolution - 1);
+        // Queries may come from outside of the boundaries. Positions below the minimum must land in negative
+        // cells, which wrap around to invalid ones, instead of being truncated into the first cell.
+        int32_t index = (int32_t) std::floor((positionOnAxis - mBoundaries.min[axis]) / delta * (mResolution - 1));
         return index;
     }
 
@@ -57,7 +61,7 @@ namespace EARenderer {
         uint16_t cy = cell.decodeY();
         uint16_t cz = cell.decodeZ();
 
-        int32_t neighbourIndex = -1;
+        int32_t neighbourIndex = 0;
 
         for (int8_t x = -1; x <= 1; ++x) {
             for (int8_t y = -1; y <= 1; ++y) {
@@ -80,8 +84,8 @@ namespace EARenderer {
             }
         }
 
-        if (neighbourIndex < (int32_t) neighbours.max_size() - 1) {
-            neighbours[neighbourIndex + 1] = Cell::InvalidCell();
+        if (neighbourIndex < (int32_t) neighbours.max_size()) {
+            neighbours[neighbourIndex] = Cell::InvalidCell();
         }
 
         return neighbours;
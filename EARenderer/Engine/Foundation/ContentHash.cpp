@@ -0,0 +1,43 @@
+//
+//  ContentHash.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "ContentHash.hpp"
+
+#include <cstring>
+
+namespace EARenderer {
+
+    void ContentHash::append(const void *bytes, size_t size) {
+        auto data = reinterpret_cast<const uint8_t *>(bytes);
+        size_t i = 0;
+
+        for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+            uint64_t word;
+            std::memcpy(&word, data + i, sizeof(uint64_t));
+            mValue ^= word;
+            mValue *= Prime;
+            // Multiplication only propagates entropy upwards, fold high bits back
+            mValue ^= mValue >> 32;
+        }
+
+        for (; i < size; i++) {
+            mValue ^= data[i];
+            mValue *= Prime;
+        }
+    }
+
+    void ContentHash::append(const std::string &string) {
+        append(string.size());
+        append(string.data(), string.size());
+    }
+
+    uint64_t ContentHash::value() const {
+        return mValue;
+    }
+
+}
@@ -0,0 +1,52 @@
+//
+//  ContentHash.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef ContentHash_hpp
+#define ContentHash_hpp
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <type_traits>
+
+namespace EARenderer {
+
+    /// Incremental 64-bit hash of arbitrary data based on FNV-1a.
+    /// Bulk data is consumed 8 bytes per round, which makes hashing of whole files affordable.
+    /// Used to fingerprint inputs of expensive computations, not for security purposes.
+    class ContentHash {
+    private:
+        static constexpr uint64_t OffsetBasis = 0xCBF29CE484222325ull;
+        static constexpr uint64_t Prime = 0x100000001B3ull;
+
+        uint64_t mValue = OffsetBasis;
+
+    public:
+        void append(const void *bytes, size_t size);
+
+        void append(const std::string &string);
+
+        template<class T>
+        void append(const T &value) {
+            static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be hashed bytewise");
+            append(&value, sizeof(T));
+        }
+
+        template<class T>
+        void append(const std::vector<T> &values) {
+            static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be hashed bytewise");
+            append(values.size());
+            append(values.data(), values.size() * sizeof(T));
+        }
+
+        uint64_t value() const;
+    };
+
+}
+
+#endif /* ContentHash_hpp */
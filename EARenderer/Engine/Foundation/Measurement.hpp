@@ -34,6 +34,19 @@ namespace EARenderer {
 
             return duration;
         }
+
+        /**
+         Prints a measured quantity other than time, such as statistics of processed data
+
+         @param printPrefix what was measured
+         @param value measured quantity, already formatted
+         */
+        static void Value(const std::string &printPrefix, const std::string &value) {
+            if (printPrefix.length()) {
+                printf("%s ", printPrefix.c_str());
+            }
+            printf("%s\n", value.c_str());
+        }
     };
 
 }
@@ -0,0 +1,83 @@
+//
+//  RingBufferAllocator.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "RingBufferAllocator.hpp"
+#include "MemoryUtils.hpp"
+#include "StringUtils.hpp"
+
+#include <stdexcept>
+
+namespace EARenderer {
+
+#pragma mark - Lifecycle
+
+    RingBufferAllocator::RingBufferAllocator(size_t segmentSize, size_t segmentCount, size_t alignment)
+            :
+            mSegmentCount(segmentCount),
+            mAlignment(alignment) {
+
+        if (segmentSize == 0 || segmentCount == 0 || alignment == 0) {
+            throw std::invalid_argument("Ring buffer segment size, segment count and alignment must be greater than 0");
+        }
+
+        mSegmentSize = segmentSize + Utils::Memory::Padding(segmentSize, alignment);
+        mCurrentSegment = segmentCount - 1;
+    }
+
+#pragma mark - Getters
+
+    size_t RingBufferAllocator::segmentSize() const {
+        return mSegmentSize;
+    }
+
+    size_t RingBufferAllocator::segmentCount() const {
+        return mSegmentCount;
+    }
+
+    size_t RingBufferAllocator::alignment() const {
+        return mAlignment;
+    }
+
+    size_t RingBufferAllocator::capacity() const {
+        return mSegmentSize * mSegmentCount;
+    }
+
+    size_t RingBufferAllocator::currentSegment() const {
+        return mCurrentSegment;
+    }
+
+    size_t RingBufferAllocator::segmentOffset(size_t segment) const {
+        return mSegmentSize * segment;
+    }
+
+    size_t RingBufferAllocator::usedBytes() const {
+        return mUsedBytes;
+    }
+
+#pragma mark - Allocation
+
+    size_t RingBufferAllocator::nextSegment() {
+        mCurrentSegment = (mCurrentSegment + 1) % mSegmentCount;
+        mUsedBytes = 0;
+        return mCurrentSegment;
+    }
+
+    size_t RingBufferAllocator::allocate(size_t byteCount) {
+        // Segment offsets are aligned, so aligning the local offset is enough
+        size_t localOffset = mUsedBytes + Utils::Memory::Padding(mUsedBytes, mAlignment);
+
+        if (byteCount > mSegmentSize || localOffset > mSegmentSize - byteCount) {
+            throw std::range_error(string_format("Ring buffer segment of %zu bytes can't fit %zu more bytes, %zu are already used",
+                    mSegmentSize, byteCount, mUsedBytes));
+        }
+
+        mUsedBytes = localOffset + byteCount;
+        return segmentOffset(mCurrentSegment) + localOffset;
+    }
+
+}
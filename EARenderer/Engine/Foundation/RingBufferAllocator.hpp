@@ -0,0 +1,74 @@
+//
+//  RingBufferAllocator.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef RingBufferAllocator_hpp
+#define RingBufferAllocator_hpp
+
+#include <cstdlib>
+#include <cstdint>
+
+namespace EARenderer {
+
+    /// Bookkeeping of a buffer split into equal segments which are used in turn, one per frame.
+    /// Allocations of a frame are linear within its segment, offsets are absolute (counted from the start of the buffer)
+    /// and aligned. Segment sizes are rounded up to the alignment, so that every segment starts aligned as well.
+    /// Knows nothing about GPU, making sure the GPU is done with a segment before it's reused is up to the owner.
+    class RingBufferAllocator {
+    private:
+        size_t mSegmentSize = 0;
+        size_t mSegmentCount = 0;
+        size_t mAlignment = 1;
+        size_t mCurrentSegment = 0;
+        size_t mUsedBytes = 0;
+
+    public:
+        /**
+         @param segmentSize minimum size of a segment in bytes
+         @param segmentCount number of frames that can be in flight at once
+         @param alignment alignment of every allocation in bytes
+         @throws std::invalid_argument if any of the parameters is 0
+         */
+        RingBufferAllocator(size_t segmentSize, size_t segmentCount, size_t alignment);
+
+        /// Size of a segment after rounding up to the alignment
+        size_t segmentSize() const;
+
+        size_t segmentCount() const;
+
+        size_t alignment() const;
+
+        /// Total size of the buffer the allocator manages
+        size_t capacity() const;
+
+        size_t currentSegment() const;
+
+        /// Offset of the segment's first byte from the start of the buffer
+        size_t segmentOffset(size_t segment) const;
+
+        /// Bytes allocated in the current segment, padding included
+        size_t usedBytes() const;
+
+        /**
+         Moves on to the next segment, wrapping around after the last one, and discards all allocations made in it before.
+         The allocator starts at the last segment, so the first call moves on to segment 0.
+
+         @return index of the new current segment
+         */
+        size_t nextSegment();
+
+        /**
+         @param byteCount size of the allocation
+         @return aligned offset of the allocation from the start of the buffer
+         @throws std::range_error if the rest of the current segment can't hold the allocation
+         */
+        size_t allocate(size_t byteCount);
+    };
+
+}
+
+#endif /* RingBufferAllocator_hpp */
@@ -0,0 +1,25 @@
+//
+//  StbImage.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#define STB_IMAGE_IMPLEMENTATION
+
+#include "StbImage.hpp"
+
+#include <mutex>
+
+namespace EARenderer {
+
+    void StbImage::EnableVerticalFlip() {
+        // call_once also makes the write visible to every thread that gets past it
+        static std::once_flag flag;
+        std::call_once(flag, []() {
+            stbi_set_flip_vertically_on_load(true);
+        });
+    }
+
+}
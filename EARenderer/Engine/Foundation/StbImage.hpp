@@ -0,0 +1,31 @@
+//
+//  StbImage.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef StbImage_hpp
+#define StbImage_hpp
+
+#include <stb/stb_image.h>
+
+namespace EARenderer {
+
+    /// stb_image keeps its vertical flip flag in a global variable and the bundled v2.15 has no per-thread
+    /// alternative (stbi_set_flip_vertically_on_load_thread only appeared in v2.23).
+    /// Images are decoded on the GL thread and on worker threads at the same time, so rather than having
+    /// every loader set the flag, it's set once before the first image is decoded and never changes afterwards.
+    class StbImage {
+    public:
+        /**
+         Makes stb_image flip every image vertically on load, so that the first pixel is the bottom left one, as GL expects.
+         Has to be called before decoding an image. Safe to be called from any thread.
+         */
+        static void EnableVerticalFlip();
+    };
+
+}
+
+#endif /* StbImage_hpp */
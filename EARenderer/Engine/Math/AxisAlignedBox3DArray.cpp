@@ -0,0 +1,39 @@
+//
+//  AxisAlignedBox3DArray.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "AxisAlignedBox3DArray.hpp"
+
+namespace EARenderer {
+
+    size_t AxisAlignedBox3DArray::size() const {
+        return minX.size();
+    }
+
+    void AxisAlignedBox3DArray::clear() {
+        minX.clear();
+        minY.clear();
+        minZ.clear();
+        maxX.clear();
+        maxY.clear();
+        maxZ.clear();
+    }
+
+    void AxisAlignedBox3DArray::push_back(const glm::vec3 &min, const glm::vec3 &max) {
+        minX.push_back(min.x);
+        minY.push_back(min.y);
+        minZ.push_back(min.z);
+        maxX.push_back(max.x);
+        maxY.push_back(max.y);
+        maxZ.push_back(max.z);
+    }
+
+    AxisAlignedBox3D AxisAlignedBox3DArray::box(size_t index) const {
+        return AxisAlignedBox3D({minX[index], minY[index], minZ[index]}, {maxX[index], maxY[index], maxZ[index]});
+    }
+
+}
@@ -0,0 +1,38 @@
+//
+//  AxisAlignedBox3DArray.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef AxisAlignedBox3DArray_hpp
+#define AxisAlignedBox3DArray_hpp
+
+#include "AxisAlignedBox3D.hpp"
+
+#include <vector>
+
+namespace EARenderer {
+
+    /// Boxes laid out as separate arrays of components, so that loops over one component turn into SIMD code
+    struct AxisAlignedBox3DArray {
+        std::vector<float> minX;
+        std::vector<float> minY;
+        std::vector<float> minZ;
+        std::vector<float> maxX;
+        std::vector<float> maxY;
+        std::vector<float> maxZ;
+
+        size_t size() const;
+
+        void clear();
+
+        void push_back(const glm::vec3 &min, const glm::vec3 &max);
+
+        AxisAlignedBox3D box(size_t index) const;
+    };
+
+}
+
+#endif /* AxisAlignedBox3DArray_hpp */
@@ -0,0 +1,146 @@
+//
+//  CompressedSphericalHarmonics.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "CompressedSphericalHarmonics.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+#include <glm/common.hpp>
+
+namespace EARenderer {
+
+    static constexpr uint32_t LumaBits = 10;
+    static constexpr uint32_t ChromaBits = 8;
+    static constexpr size_t ChromaCoefficientCount = SphericalHarmonics::CoefficientCount * 2;
+
+#pragma mark - Quantization
+
+    // Smallest power of two exponent covering the magnitude, biased by 128. Zero marks an all-zero set.
+    static uint32_t SharedExponent(float maximumMagnitude) {
+        if (maximumMagnitude <= 0.0f) {
+            return 0;
+        }
+        int exponent = 0;
+        std::frexp(maximumMagnitude, &exponent);
+        return (uint32_t) std::max(std::min(exponent + 128, 255), 1);
+    }
+
+    static float ExponentScale(uint32_t biasedExponent) {
+        return biasedExponent == 0 ? 0.0f : std::ldexp(1.0f, (int) biasedExponent - 128);
+    }
+
+    static uint32_t QuantizeSnorm(float value, float scale, uint32_t bits) {
+        if (scale == 0.0f) {
+            return 0;
+        }
+        float maximum = (float) ((1 << (bits - 1)) - 1);
+        float quantized = std::round(glm::clamp(value / scale, -1.0f, 1.0f) * maximum);
+        return (uint32_t) (int32_t) quantized & ((1u << bits) - 1);
+    }
+
+    static float DequantizeSnorm(uint32_t word, uint32_t offset, uint32_t bits, float scale) {
+        // Shift the field to the top of the word and back to sign extend it
+        int32_t value = (int32_t) (word << (32 - offset - bits)) >> (32 - bits);
+        float maximum = (float) ((1 << (bits - 1)) - 1);
+        return (float) value / maximum * scale;
+    }
+
+#pragma mark - Luma
+
+    static void EncodeLuma(const std::array<glm::vec3, SphericalHarmonics::CoefficientCount> &coefficients, uint32_t *words) {
+        float maximum = 0.0f;
+        for (auto &c : coefficients) {
+            maximum = std::max(maximum, std::fabs(c.r));
+        }
+
+        uint32_t exponent = SharedExponent(maximum);
+        float scale = ExponentScale(exponent);
+
+        for (size_t i = 0; i < coefficients.size(); i++) {
+            words[i / 3] |= QuantizeSnorm(coefficients[i].r, scale, LumaBits) << (i % 3 * LumaBits);
+        }
+
+        words[3] |= exponent;
+    }
+
+    static void DecodeLuma(const uint32_t *words, std::array<glm::vec3, SphericalHarmonics::CoefficientCount> &coefficients) {
+        float scale = ExponentScale(words[3] & 0xFF);
+        for (size_t i = 0; i < coefficients.size(); i++) {
+            coefficients[i].r = DequantizeSnorm(words[i / 3], i % 3 * LumaBits, LumaBits, scale);
+        }
+    }
+
+#pragma mark - Chroma
+
+    // Chroma coefficient with index 0 and 1 live in the upper half of word 3, the rest in words 4-7
+    static std::pair<size_t, uint32_t> ChromaLocation(size_t index) {
+        if (index < 2) {
+            return {3, 16 + index * ChromaBits};
+        }
+        return {4 + (index - 2) / 4, (index - 2) % 4 * ChromaBits};
+    }
+
+#pragma mark - CompressedSphericalHarmonics
+
+    CompressedSphericalHarmonics::CompressedSphericalHarmonics(const SphericalHarmonics &sh) {
+        auto coefficients = sh.coefficients();
+        EncodeLuma(coefficients, words.data());
+
+        float maximum = 0.0f;
+        for (auto &c : coefficients) {
+            maximum = std::max({maximum, std::fabs(c.g), std::fabs(c.b)});
+        }
+
+        uint32_t exponent = SharedExponent(maximum);
+        float scale = ExponentScale(exponent);
+
+        for (size_t i = 0; i < ChromaCoefficientCount; i++) {
+            const glm::vec3 &c = coefficients[i % SphericalHarmonics::CoefficientCount];
+            float value = i < SphericalHarmonics::CoefficientCount ? c.g : c.b;
+            auto location = ChromaLocation(i);
+            words[location.first] |= QuantizeSnorm(value, scale, ChromaBits) << location.second;
+        }
+
+        words[3] |= exponent << 8;
+    }
+
+    SphericalHarmonics CompressedSphericalHarmonics::decompressed() const {
+        std::array<glm::vec3, SphericalHarmonics::CoefficientCount> coefficients{};
+        DecodeLuma(words.data(), coefficients);
+
+        float scale = ExponentScale((words[3] >> 8) & 0xFF);
+
+        for (size_t i = 0; i < ChromaCoefficientCount; i++) {
+            auto location = ChromaLocation(i);
+            float value = DequantizeSnorm(words[location.first], location.second, ChromaBits, scale);
+            glm::vec3 &c = coefficients[i % SphericalHarmonics::CoefficientCount];
+            (i < SphericalHarmonics::CoefficientCount ? c.g : c.b) = value;
+        }
+
+        return SphericalHarmonics(coefficients);
+    }
+
+#pragma mark - CompressedLumaSphericalHarmonics
+
+    CompressedLumaSphericalHarmonics::CompressedLumaSphericalHarmonics(const SphericalHarmonics &sh) {
+        EncodeLuma(sh.coefficients(), words.data());
+    }
+
+    SphericalHarmonics CompressedLumaSphericalHarmonics::decompressed() const {
+        std::array<glm::vec3, SphericalHarmonics::CoefficientCount> coefficients{};
+        DecodeLuma(words.data(), coefficients);
+
+        for (auto &c : coefficients) {
+            c = glm::vec3(c.r);
+        }
+
+        return SphericalHarmonics(coefficients);
+    }
+
+}
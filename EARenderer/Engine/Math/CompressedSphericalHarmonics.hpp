@@ -0,0 +1,59 @@
+//
+//  CompressedSphericalHarmonics.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef CompressedSphericalHarmonics_hpp
+#define CompressedSphericalHarmonics_hpp
+
+#include "SphericalHarmonics.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace EARenderer {
+
+    /// Spherical harmonics with YCoCg coefficients (Y in red, Co in green, Cg in blue channel)
+    /// packed into two RGBA32UI texels: 32 bytes instead of 108.
+    ///
+    /// Luma and chroma are quantized relative to their own power of two scale (shared exponent):
+    /// word 0-2: 9 luma coefficients, 10-bit snorm, 3 per word
+    /// word 3:   luma exponent (8 bits), chroma exponent (8 bits), first two chroma coefficients (8-bit snorm)
+    /// word 4-7: remaining 16 chroma coefficients, 8-bit snorm, 4 per word
+    /// Chroma coefficients go in order Co L00..L22, then Cg L00..L22.
+    ///
+    /// Decoded by DecodeCompressedSH() in SphericalHarmonics.glsl
+    struct CompressedSphericalHarmonics {
+        std::array<uint32_t, 8> words{};
+
+        CompressedSphericalHarmonics() = default;
+
+        explicit CompressedSphericalHarmonics(const SphericalHarmonics &sh);
+
+        SphericalHarmonics decompressed() const;
+    };
+
+    /// Single channel spherical harmonics packed into one RGBA32UI texel: 16 bytes instead of 108.
+    /// Layout matches the first texel of CompressedSphericalHarmonics with chroma left out.
+    /// Meant for data that is the same in all color channels, such as sky visibility. Only the red channel is encoded.
+    ///
+    /// Decoded by DecodeCompressedLumaSH() in SphericalHarmonics.glsl
+    struct CompressedLumaSphericalHarmonics {
+        std::array<uint32_t, 4> words{};
+
+        CompressedLumaSphericalHarmonics() = default;
+
+        explicit CompressedLumaSphericalHarmonics(const SphericalHarmonics &sh);
+
+        /**
+         @return spherical harmonics with the decoded channel replicated to all three channels
+         */
+        SphericalHarmonics decompressed() const;
+    };
+
+}
+
+#endif /* CompressedSphericalHarmonics_hpp */
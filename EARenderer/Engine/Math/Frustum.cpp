@@ -0,0 +1,98 @@
+//
+//  Frustum.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "Frustum.hpp"
+
+#include <glm/geometric.hpp>
+#include <algorithm>
+
+namespace EARenderer {
+
+#pragma mark - Helpers
+
+    static glm::vec4 Row(const glm::mat4 &m, size_t index) {
+        return {m[0][index], m[1][index], m[2][index], m[3][index]};
+    }
+
+    static Plane ClipPlane(const glm::vec4 &coefficients) {
+        // Coefficients describe ax + by + cz + d >= 0 half-space
+        glm::vec3 normal(coefficients);
+        float length = glm::length(normal);
+        return Plane(-coefficients.w / length, normal / length);
+    }
+
+#pragma mark - Lifecycle
+
+    Frustum::Frustum(const glm::mat4 &viewProjection) {
+        glm::vec4 w = Row(viewProjection, 3);
+
+        for (size_t axis = 0; axis < 3; axis++) {
+            glm::vec4 row = Row(viewProjection, axis);
+            planes[axis * 2] = ClipPlane(w + row);
+            planes[axis * 2 + 1] = ClipPlane(w - row);
+        }
+    }
+
+#pragma mark - Intersection
+
+    bool Frustum::contains(const glm::vec3 &point) const {
+        for (auto &plane : planes) {
+            if (glm::dot(plane.normal, point) < plane.distance) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool Frustum::intersects(const AxisAlignedBox3D &box) const {
+        for (auto &plane : planes) {
+            // Box corner farthest along the plane's normal
+            glm::vec3 positiveVertex(plane.normal.x >= 0.0f ? box.max.x : box.min.x,
+                    plane.normal.y >= 0.0f ? box.max.y : box.min.y,
+                    plane.normal.z >= 0.0f ? box.max.z : box.min.z);
+
+            if (glm::dot(plane.normal, positiveVertex) < plane.distance) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void Frustum::intersectingBoxes(const AxisAlignedBox3DArray &boxes, std::vector<size_t> &intersectingIndices) const {
+        constexpr size_t BatchSize = 64;
+
+        intersectingIndices.clear();
+        size_t boxCount = boxes.size();
+
+        for (size_t batchStart = 0; batchStart < boxCount; batchStart += BatchSize) {
+            size_t batchSize = std::min(BatchSize, boxCount - batchStart);
+            uint8_t visibility[BatchSize];
+            std::fill(visibility, visibility + batchSize, 1);
+
+            for (auto &plane : planes) {
+                // Only the box corner farthest along the normal has to be tested.
+                // Normal's signs are the same for the whole batch, so corner selection boils down to picking arrays.
+                const float *x = (plane.normal.x >= 0.0f ? boxes.maxX : boxes.minX).data() + batchStart;
+                const float *y = (plane.normal.y >= 0.0f ? boxes.maxY : boxes.minY).data() + batchStart;
+                const float *z = (plane.normal.z >= 0.0f ? boxes.maxZ : boxes.minZ).data() + batchStart;
+
+                for (size_t i = 0; i < batchSize; i++) {
+                    float distance = plane.normal.x * x[i] + plane.normal.y * y[i] + plane.normal.z * z[i];
+                    visibility[i] &= uint8_t(distance >= plane.distance);
+                }
+            }
+
+            for (size_t i = 0; i < batchSize; i++) {
+                if (visibility[i]) {
+                    intersectingIndices.push_back(batchStart + i);
+                }
+            }
+        }
+    }
+
+}
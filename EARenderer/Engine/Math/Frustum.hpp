@@ -0,0 +1,58 @@
+//
+//  Frustum.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef Frustum_hpp
+#define Frustum_hpp
+
+#include "Plane.hpp"
+#include "AxisAlignedBox3D.hpp"
+#include "AxisAlignedBox3DArray.hpp"
+
+#include <glm/vec3.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <array>
+#include <vector>
+
+namespace EARenderer {
+
+    struct Frustum {
+        /// Left, right, bottom, top, near and far planes.
+        /// Normals are unit length and point inside, so that inner points satisfy dot(normal, point) >= distance.
+        std::array<Plane, 6> planes;
+
+        Frustum() = default;
+
+        /**
+         Extracts planes bounding the clip space volume of the matrix (Gribb-Hartmann method)
+
+         @param viewProjection matrix transforming world space into the clip space with OpenGL's [-1; 1] depth range
+         */
+        Frustum(const glm::mat4 &viewProjection);
+
+        bool contains(const glm::vec3 &point) const;
+
+        /**
+         Conservative test, boxes near the frustum's corners may be reported as intersecting while lying outside
+
+         @return false only if the box lies entirely outside of one of the planes
+         */
+        bool intersects(const AxisAlignedBox3D &box) const;
+
+        /**
+         Same test as intersects(), run for batches of boxes one plane at a time
+
+         @param boxes boxes to test
+         @param intersectingIndices receives indices of the boxes intersecting the frustum in ascending order, cleared beforehand
+         */
+        void intersectingBoxes(const AxisAlignedBox3DArray &boxes, std::vector<size_t> &intersectingIndices) const;
+    };
+
+}
+
+#endif /* Frustum_hpp */
@@ -0,0 +1,60 @@
+//
+//  MortonCode.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef MortonCode_hpp
+#define MortonCode_hpp
+
+#include <cstdint>
+
+namespace EARenderer {
+
+    /// Z-order curve encoding of 3D integer coordinates (16 bits per axis) into a single 48-bit key.
+    /// Keys of spatially close cells tend to be numerically close, which is used to lay out spatial data linearly.
+    class MortonCode {
+    private:
+        static uint64_t SpreadBits(uint64_t value) {
+            value &= 0xFFFF;
+            value = (value | (value << 32)) & 0x001F00000000FFFFull;
+            value = (value | (value << 16)) & 0x001F0000FF0000FFull;
+            value = (value | (value << 8)) & 0x100F00F00F00F00Full;
+            value = (value | (value << 4)) & 0x10C30C30C30C30C3ull;
+            value = (value | (value << 2)) & 0x1249249249249249ull;
+            return value;
+        }
+
+        static uint16_t CompactBits(uint64_t value) {
+            value &= 0x1249249249249249ull;
+            value = (value | (value >> 2)) & 0x10C30C30C30C30C3ull;
+            value = (value | (value >> 4)) & 0x100F00F00F00F00Full;
+            value = (value | (value >> 8)) & 0x001F0000FF0000FFull;
+            value = (value | (value >> 16)) & 0x001F00000000FFFFull;
+            value = (value | (value >> 32)) & 0xFFFF;
+            return (uint16_t) value;
+        }
+
+    public:
+        static uint64_t Encode(uint16_t x, uint16_t y, uint16_t z) {
+            return SpreadBits(x) | (SpreadBits(y) << 1) | (SpreadBits(z) << 2);
+        }
+
+        static uint16_t DecodeX(uint64_t code) {
+            return CompactBits(code);
+        }
+
+        static uint16_t DecodeY(uint64_t code) {
+            return CompactBits(code >> 1);
+        }
+
+        static uint16_t DecodeZ(uint64_t code) {
+            return CompactBits(code >> 2);
+        }
+    };
+
+}
+
+#endif /* MortonCode_hpp */
@@ -0,0 +1,58 @@
+//
+//  OctahedralEncoding.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef OctahedralEncoding_hpp
+#define OctahedralEncoding_hpp
+
+#include <cmath>
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/geometric.hpp>
+
+// A Survey of Efficient Representations for Independent Unit Vectors
+// http://jcgt.org/published/0003/02/01/
+
+namespace EARenderer {
+
+    /// Maps unit vectors onto the [-1, 1] square by projecting them on an octahedron
+    /// and unfolding its lower half. Distributes precision much more evenly than spherical coordinates.
+    class OctahedralEncoding {
+    private:
+        static float SignNotZero(float value) {
+            return value >= 0.0f ? 1.0f : -1.0f;
+        }
+
+    public:
+        static glm::vec2 Encode(const glm::vec3 &unitVector) {
+            glm::vec3 v = unitVector / (std::fabs(unitVector.x) + std::fabs(unitVector.y) + std::fabs(unitVector.z));
+            glm::vec2 encoded(v.x, v.y);
+
+            if (v.z < 0.0f) {
+                encoded = glm::vec2((1.0f - std::fabs(v.y)) * SignNotZero(v.x),
+                        (1.0f - std::fabs(v.x)) * SignNotZero(v.y));
+            }
+
+            return encoded;
+        }
+
+        static glm::vec3 Decode(const glm::vec2 &encoded) {
+            glm::vec3 v(encoded.x, encoded.y, 1.0f - std::fabs(encoded.x) - std::fabs(encoded.y));
+
+            if (v.z < 0.0f) {
+                v.x = (1.0f - std::fabs(encoded.y)) * SignNotZero(encoded.x);
+                v.y = (1.0f - std::fabs(encoded.x)) * SignNotZero(encoded.y);
+            }
+
+            return glm::normalize(v);
+        }
+    };
+
+}
+
+#endif /* OctahedralEncoding_hpp */
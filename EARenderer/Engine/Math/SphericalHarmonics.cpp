@@ -19,6 +19,19 @@ namespace EARenderer {
         contribute(direction, color, 4.0 * M_PI);
     }
 
+    SphericalHarmonics::SphericalHarmonics(const std::array<glm::vec3, CoefficientCount> &coefficients)
+            :
+            mL00(coefficients[0]),
+            mL11(coefficients[1]),
+            mL10(coefficients[2]),
+            mL1_1(coefficients[3]),
+            mL21(coefficients[4]),
+            mL2_1(coefficients[5]),
+            mL2_2(coefficients[6]),
+            mL20(coefficients[7]),
+            mL22(coefficients[8]) {
+    }
+
 #pragma mark - Getters
 
     const glm::vec3 &SphericalHarmonics::L00() const {
@@ -57,6 +70,10 @@ namespace EARenderer {
         return mL22;
     }
 
+    std::array<glm::vec3, SphericalHarmonics::CoefficientCount> SphericalHarmonics::coefficients() const {
+        return {mL00, mL11, mL10, mL1_1, mL21, mL2_1, mL2_2, mL20, mL22};
+    }
+
 #pragma mark -
 
     float SphericalHarmonics::magnitude() const {
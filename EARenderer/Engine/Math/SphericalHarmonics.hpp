@@ -14,6 +14,7 @@
 #include <glm/vec3.hpp>
 #include <glm/gtc/constants.hpp>
 #include <cmath>
+#include <array>
 #include <bitsery/bitsery.h>
 #include <bitsery/adapter/stream.h>
 
@@ -37,6 +38,8 @@ namespace EARenderer {
         static constexpr float Y20 = 0.31539156525252000603f; // 1/4 * sqrt(5/pi)
         static constexpr float Y22 = 0.54627421529603953527f; // 1/4 * sqrt(15/pi)
 
+        static constexpr size_t CoefficientCount = 9;
+
         static constexpr float CosineLobeBandFactors[] = {
                 M_PI,
                 2.0f * M_PI / 3.0f, 2.0f * M_PI / 3.0f, 2.0f * M_PI / 3.0f,
@@ -59,6 +62,11 @@ namespace EARenderer {
 
         SphericalHarmonics(const glm::vec3 &direction, const Color &color);
 
+        /**
+         @param coefficients coefficients in storage order: L00, L11, L10, L1_1, L21, L2_1, L2_2, L20, L22
+         */
+        SphericalHarmonics(const std::array<glm::vec3, CoefficientCount> &coefficients);
+
         const glm::vec3 &L00() const;
 
         const glm::vec3 &L11() const;
@@ -77,6 +85,11 @@ namespace EARenderer {
 
         const glm::vec3 &L22() const;
 
+        /**
+         @return coefficients in storage order: L00, L11, L10, L1_1, L21, L2_1, L2_2, L20, L22
+         */
+        std::array<glm::vec3, CoefficientCount> coefficients() const;
+
         void convolve();
 
         float magnitude() const;
@@ -0,0 +1,98 @@
+//
+//  PackedVertex1P1N2UV1T1BT.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "PackedVertex1P1N2UV1T1BT.hpp"
+#include "OctahedralEncoding.hpp"
+
+#include <cmath>
+
+#include <glm/gtc/packing.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/geometric.hpp>
+
+namespace EARenderer {
+
+    static_assert(sizeof(PackedVertex1P1N2UV1T1BT) == 24, "Packed vertex is expected to be tightly packed");
+
+#pragma mark - Helpers
+
+    static glm::vec3 QuantizationExtent(const AxisAlignedBox3D &bounds) {
+        // Flat boxes would make quantization divide by zero
+        return glm::max(bounds.max - bounds.min, glm::vec3(0.0));
+    }
+
+    static std::array<int16_t, 2> PackUnitVector(const glm::vec3 &vector) {
+        glm::vec2 encoded = OctahedralEncoding::Encode(vector);
+        return {(int16_t) glm::packSnorm1x16(encoded.x), (int16_t) glm::packSnorm1x16(encoded.y)};
+    }
+
+    static glm::vec3 UnpackUnitVector(const std::array<int16_t, 2> &packed) {
+        return OctahedralEncoding::Decode(glm::vec2(glm::unpackSnorm1x16((uint16_t) packed[0]), glm::unpackSnorm1x16((uint16_t) packed[1])));
+    }
+
+    static glm::vec3 AnyPerpendicular(const glm::vec3 &vector) {
+        glm::vec3 axis = std::fabs(vector.x) < 0.9f ? glm::vec3(1.0, 0.0, 0.0) : glm::vec3(0.0, 1.0, 0.0);
+        return glm::normalize(glm::cross(vector, axis));
+    }
+
+#pragma mark - Lifecycle
+
+    PackedVertex1P1N2UV1T1BT::PackedVertex1P1N2UV1T1BT(const Vertex1P1N2UV1T1BT &vertex, const AxisAlignedBox3D &bounds) {
+        glm::vec3 extent = QuantizationExtent(bounds);
+        for (glm::length_t i = 0; i < 3; i++) {
+            float normalized = extent[i] > 0.0f ? (vertex.position[i] - bounds.min[i]) / extent[i] : 0.0f;
+            position[i] = glm::packUnorm1x16(normalized);
+        }
+
+        textureCoords = {glm::packHalf1x16(vertex.textureCoords.x), glm::packHalf1x16(vertex.textureCoords.y)};
+        lightmapCoords = {glm::packHalf1x16(vertex.lightmapCoords.x), glm::packHalf1x16(vertex.lightmapCoords.y)};
+
+        // Some meshes come without normals or texture coordinates, so their TBN might be degenerate
+        glm::vec3 n = glm::length(vertex.normal) > 0.0f ? glm::normalize(vertex.normal) : glm::vec3(0.0, 0.0, 1.0);
+        glm::vec3 t = vertex.tangent - n * glm::dot(n, vertex.tangent);
+        t = glm::length(t) > 1e-6f ? glm::normalize(t) : AnyPerpendicular(n);
+
+        float bitangentSign = glm::dot(glm::cross(n, t), vertex.bitangent) < 0.0f ? -1.0f : 1.0f;
+        position[3] = glm::packUnorm1x16(bitangentSign * 0.5f + 0.5f);
+
+        normal = PackUnitVector(n);
+        tangent = PackUnitVector(t);
+    }
+
+#pragma mark - Unpacking
+
+    Vertex1P1N2UV1T1BT PackedVertex1P1N2UV1T1BT::unpacked(const AxisAlignedBox3D &bounds) const {
+        glm::vec3 normalized(glm::unpackUnorm1x16(position[0]), glm::unpackUnorm1x16(position[1]), glm::unpackUnorm1x16(position[2]));
+        float bitangentSign = glm::unpackUnorm1x16(position[3]) * 2.0f - 1.0f;
+
+        glm::vec3 n = UnpackUnitVector(normal);
+        glm::vec3 t = UnpackUnitVector(tangent);
+
+        return Vertex1P1N2UV1T1BT(glm::vec4(bounds.min + normalized * QuantizationExtent(bounds), 1.0),
+                glm::vec3(glm::unpackHalf1x16(textureCoords[0]), glm::unpackHalf1x16(textureCoords[1]), 0.0),
+                glm::vec2(glm::unpackHalf1x16(lightmapCoords[0]), glm::unpackHalf1x16(lightmapCoords[1])),
+                n, t, glm::cross(n, t) * bitangentSign);
+    }
+
+    glm::mat4 PackedVertex1P1N2UV1T1BT::DequantizationMatrix(const AxisAlignedBox3D &bounds) {
+        return glm::scale(glm::translate(glm::mat4(1.0), bounds.min), QuantizationExtent(bounds));
+    }
+
+#pragma mark - Attributes
+
+    std::array<GLVertexAttribute, 5> PackedVertex1P1N2UV1T1BT::Attributes() {
+        return {
+                GLVertexAttribute::UniqueAttribute(sizeof(position), 4, GL_UNSIGNED_SHORT, GL_TRUE),
+                GLVertexAttribute::UniqueAttribute(sizeof(textureCoords), 2, GL_HALF_FLOAT, GL_FALSE),
+                GLVertexAttribute::UniqueAttribute(sizeof(lightmapCoords), 2, GL_HALF_FLOAT, GL_FALSE),
+                GLVertexAttribute::UniqueAttribute(sizeof(normal), 2, GL_SHORT, GL_TRUE),
+                GLVertexAttribute::UniqueAttribute(sizeof(tangent), 2, GL_SHORT, GL_TRUE)
+        };
+    }
+
+}
@@ -0,0 +1,62 @@
+//
+//  PackedVertex1P1N2UV1T1BT.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef PackedVertex1P1N2UV1T1BT_hpp
+#define PackedVertex1P1N2UV1T1BT_hpp
+
+#include "Vertex1P1N2UV1T1BT.hpp"
+#include "AxisAlignedBox3D.hpp"
+#include "GLVertexAttribute.hpp"
+
+#include <array>
+#include <cstdint>
+
+#include <glm/mat4x4.hpp>
+
+namespace EARenderer {
+
+    /**
+     Compact GPU counterpart of Vertex1P1N2UV1T1BT, 24 bytes instead of 72
+
+     1 position: 16-bit unorms relative to the sub mesh bounding box, w holds the bitangent sign (0 for -1, 1 for +1)
+     1 normal: octahedral, 2 16-bit snorms
+     2 uv channels: 2 halfs each
+     1 tangent vector: octahedral, 2 16-bit snorms, orthogonalized against the normal
+     bitangent is reconstructed as cross(normal, tangent) * sign
+     */
+    struct PackedVertex1P1N2UV1T1BT {
+        std::array<uint16_t, 4> position;
+        std::array<uint16_t, 2> textureCoords;
+        std::array<uint16_t, 2> lightmapCoords;
+        std::array<int16_t, 2> normal;
+        std::array<int16_t, 2> tangent;
+
+        PackedVertex1P1N2UV1T1BT() = default;
+
+        /**
+         @param vertex full precision vertex
+         @param bounds bounding box of the sub mesh the vertex belongs to
+         */
+        PackedVertex1P1N2UV1T1BT(const Vertex1P1N2UV1T1BT &vertex, const AxisAlignedBox3D &bounds);
+
+        Vertex1P1N2UV1T1BT unpacked(const AxisAlignedBox3D &bounds) const;
+
+        /**
+         @return matrix transforming normalized positions back into the mesh space
+         */
+        static glm::mat4 DequantizationMatrix(const AxisAlignedBox3D &bounds);
+
+        /**
+         @return attribute descriptions matching the layout, with integer attributes normalized
+         */
+        static std::array<GLVertexAttribute, 5> Attributes();
+    };
+
+}
+
+#endif /* PackedVertex1P1N2UV1T1BT_hpp */
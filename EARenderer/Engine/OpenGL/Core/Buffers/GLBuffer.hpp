@@ -102,6 +102,26 @@ namespace EARenderer {
             glBindBuffer(mBindingPoint, mName);
         }
 
+#pragma mark - Writing
+
+        /**
+         Replaces buffer contents starting from the first object. Storage is orphaned beforehand,
+         so that draws still reading the previous contents don't stall the write.
+         Objects are expected to be tightly packed (no per-object alignment).
+
+         @param data objects to write
+         @param count number of objects, must not exceed the buffer's capacity
+         */
+        void write(const DataType *data, size_t count) {
+            if (count > mCount) {
+                throw std::range_error("Attempt to write data outside of the buffer");
+            }
+
+            bind();
+            glBufferData(mBindingPoint, mSize, nullptr, mUsageMode);
+            glBufferSubData(mBindingPoint, 0, sizeof(DataType) * count, data);
+        }
+
 #pragma mark - Helpers
 
         auto createWritingSession() {
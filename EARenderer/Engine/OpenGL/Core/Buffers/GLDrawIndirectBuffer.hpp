@@ -0,0 +1,36 @@
+//
+//  GLDrawIndirectBuffer.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef GLDrawIndirectBuffer_hpp
+#define GLDrawIndirectBuffer_hpp
+
+#include <OpenGL/OpenGL.h>
+#include "GLBuffer.hpp"
+
+namespace EARenderer {
+
+    /// Layout of an indexed draw, as read by glDrawElementsIndirect and glMultiDrawElementsIndirect
+    struct GLDrawElementsIndirectCommand {
+        GLuint indexCount;
+        GLuint instanceCount;
+        GLuint firstIndex;
+        GLint baseVertex;
+        /// Ignored before GL 4.2, where it has to be 0
+        GLuint baseInstance;
+    };
+
+    /// Draw commands rewritten every frame
+    class GLDrawIndirectBuffer : public GLBuffer<GLDrawElementsIndirectCommand> {
+    public:
+        GLDrawIndirectBuffer(const GLDrawElementsIndirectCommand *commands, uint64_t count)
+                : GLBuffer<GLDrawElementsIndirectCommand>(commands, count, GL_DRAW_INDIRECT_BUFFER, GL_STREAM_DRAW) {}
+    };
+
+}
+
+#endif /* GLDrawIndirectBuffer_hpp */
@@ -14,15 +14,26 @@
 
 namespace EARenderer {
 
-    class GLElementArrayBuffer : public GLBuffer<GLushort> {
+    struct GLIBODataLocation {
+        /// Offset of the first index, measured in indices
+        size_t offset;
+        size_t indexCount;
+        /// Value added to every index before fetching the vertex, so that indices can stay local to their sub mesh
+        size_t baseVertex;
+        /// Number of vertices referenced by the indices, starting at the base vertex
+        size_t vertexCount;
+    };
+
+    /// 32-bit index buffer
+    class GLElementArrayBuffer : public GLBuffer<GLuint> {
     public:
         template<template<class...> class ContinuousContainer>
-        static auto Create(const ContinuousContainer<GLushort> &indices) {
+        static auto Create(const ContinuousContainer<GLuint> &indices) {
             return GLElementArrayBuffer(indices.data(), indices.size());
         }
 
-        GLElementArrayBuffer(const GLushort *indices, uint64_t count)
-                : GLBuffer<GLushort>(indices, count, GL_ELEMENT_ARRAY_BUFFER, GL_STATIC_DRAW) {}
+        GLElementArrayBuffer(const GLuint *indices, uint64_t count)
+                : GLBuffer<GLuint>(indices, count, GL_ELEMENT_ARRAY_BUFFER, GL_STATIC_DRAW) {}
     };
 
 }
@@ -24,8 +24,8 @@ namespace EARenderer {
             return GLTextureBuffer(data.data(), data.size(), internalFormat);
         }
 
-        GLTextureBuffer(const DataType *data, uint64_t count, GLenum internalFormat)
-                : GLBuffer<DataType>(data, count, GL_TEXTURE_BUFFER, GL_STATIC_DRAW),
+        GLTextureBuffer(const DataType *data, uint64_t count, GLenum internalFormat, GLenum usageMode = GL_STATIC_DRAW)
+                : GLBuffer<DataType>(data, count, GL_TEXTURE_BUFFER, usageMode),
                   mInternalFormat(internalFormat) {}
 
         void bind() const {
@@ -0,0 +1,226 @@
+//
+//  GLUniformRingBuffer.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "GLUniformRingBuffer.hpp"
+
+#include <cstring>
+#include <string>
+#include <stdexcept>
+
+namespace EARenderer {
+
+#pragma mark - Lifecycle
+
+    GLUniformRingBuffer::GLUniformRingBuffer()
+            : GLUniformRingBuffer(ObtainMaximumBlockSize()) {}
+
+    GLUniformRingBuffer::GLUniformRingBuffer(size_t segmentSize)
+            :
+            mAllocator(segmentSize, SegmentCount, ObtainMandatoryAlignment()),
+            mIsPersistentlyMapped(IsBufferStorageSupported()) {
+
+        glGenBuffers(1, &mName);
+        allocateStorage();
+    }
+
+    GLUniformRingBuffer::~GLUniformRingBuffer() {
+        for (GLsync fence : mFences) {
+            if (fence) {
+                glDeleteSync(fence);
+            }
+        }
+
+        if (mMappedStorage) {
+            bind();
+            glUnmapBuffer(GL_UNIFORM_BUFFER);
+        }
+
+        glDeleteBuffers(1, &mName);
+    }
+
+#pragma mark - Private helpers
+
+    GLint GLUniformRingBuffer::ObtainMandatoryAlignment() {
+        GLint alignment = 1;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        return alignment;
+    }
+
+    GLint GLUniformRingBuffer::ObtainMaximumBlockSize() {
+        GLint size = 1;
+        glGetIntegerv(GL_MAX_UNIFORM_BLOCK_SIZE, &size);
+        return size;
+    }
+
+    bool GLUniformRingBuffer::IsBufferStorageSupported() {
+#ifdef GL_VERSION_4_4
+        static bool isSupported = [] {
+            GLint major = 0;
+            GLint minor = 0;
+            glGetIntegerv(GL_MAJOR_VERSION, &major);
+            glGetIntegerv(GL_MINOR_VERSION, &minor);
+            if (major > 4 || (major == 4 && minor >= 4)) {
+                return true;
+            }
+
+            GLint extensionCount = 0;
+            glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+            for (GLint i = 0; i < extensionCount; i++) {
+                if (std::string(reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, i))) == "GL_ARB_buffer_storage") {
+                    return true;
+                }
+            }
+            return false;
+        }();
+        return isSupported;
+#else
+        // Headers of 4.1 platforms (macOS) don't declare buffer storage
+        return false;
+#endif
+    }
+
+    void GLUniformRingBuffer::allocateStorage() {
+        bind();
+
+#ifdef GL_VERSION_4_4
+        if (mIsPersistentlyMapped) {
+            GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            glBufferStorage(GL_UNIFORM_BUFFER, mAllocator.capacity(), nullptr, flags);
+            mMappedStorage = reinterpret_cast<std::byte *>(glMapBufferRange(GL_UNIFORM_BUFFER, 0, mAllocator.capacity(), flags));
+            return;
+        }
+#endif
+
+        glBufferData(GL_UNIFORM_BUFFER, mAllocator.capacity(), nullptr, GL_STREAM_DRAW);
+    }
+
+    void GLUniformRingBuffer::waitForSegment(size_t segment) {
+        GLsync fence = mFences[segment];
+        if (!fence) {
+            return;
+        }
+
+        GLenum status = glClientWaitSync(fence, 0, 0);
+        if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED) {
+            glDeleteSync(fence);
+            mFences[segment] = nullptr;
+            return;
+        }
+
+        mStallCount++;
+
+        if (mIsPersistentlyMapped) {
+            // Flushing makes sure the fence gets to the GPU at all, otherwise the wait could never end
+            const GLuint64 timeout = 1000000;
+            while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout) == GL_TIMEOUT_EXPIRED) {}
+            glDeleteSync(fence);
+            mFences[segment] = nullptr;
+            return;
+        }
+
+        // Fresh storage is not used by anything, none of the fences matter anymore
+        bind();
+        glBufferData(GL_UNIFORM_BUFFER, mAllocator.capacity(), nullptr, GL_STREAM_DRAW);
+
+        for (GLsync &segmentFence : mFences) {
+            if (segmentFence) {
+                glDeleteSync(segmentFence);
+                segmentFence = nullptr;
+            }
+        }
+    }
+
+    void GLUniformRingBuffer::mapSegment(size_t segment) {
+        // The fence guarantees the GPU is done with the segment, so GL doesn't have to synchronize the mapping
+        bind();
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+        void *storage = glMapBufferRange(GL_UNIFORM_BUFFER, mAllocator.segmentOffset(segment), mAllocator.segmentSize(), flags);
+
+        if (!storage) {
+            throw std::runtime_error("Failed to map uniform ring buffer segment");
+        }
+
+        mMappedStorage = reinterpret_cast<std::byte *>(storage);
+    }
+
+#pragma mark - Getters
+
+    size_t GLUniformRingBuffer::segmentSize() const {
+        return mAllocator.segmentSize();
+    }
+
+    bool GLUniformRingBuffer::isPersistentlyMapped() const {
+        return mIsPersistentlyMapped;
+    }
+
+    size_t GLUniformRingBuffer::frameCount() const {
+        return mFrameCount;
+    }
+
+    size_t GLUniformRingBuffer::stallCount() const {
+        return mStallCount;
+    }
+
+#pragma mark - Writing
+
+    void GLUniformRingBuffer::beginFrame() {
+        if (mIsWriting) {
+            finishWriting();
+        }
+
+        // Commands issued so far include every command of the previous frame
+        if (mFrameCount > 0) {
+            mFences[mAllocator.currentSegment()] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+
+        size_t segment = mAllocator.nextSegment();
+        waitForSegment(segment);
+
+        if (!mIsPersistentlyMapped) {
+            mapSegment(segment);
+        }
+
+        mFrameCount++;
+        mIsWriting = true;
+    }
+
+    GLUBODataLocation GLUniformRingBuffer::write(const void *data, size_t byteCount) {
+        if (!mIsWriting) {
+            throw std::logic_error("Uniform ring buffer can only be written between beginFrame() and finishWriting()");
+        }
+
+        size_t offset = mAllocator.allocate(byteCount);
+
+        // Persistent mapping covers the whole buffer, the temporary one only covers the current segment
+        size_t mappedOffset = mIsPersistentlyMapped ? offset : offset - mAllocator.segmentOffset(mAllocator.currentSegment());
+        std::memcpy(mMappedStorage + mappedOffset, data, byteCount);
+
+        return {offset, byteCount};
+    }
+
+    void GLUniformRingBuffer::finishWriting() {
+        if (!mIsWriting) {
+            return;
+        }
+
+        if (!mIsPersistentlyMapped) {
+            bind();
+            glUnmapBuffer(GL_UNIFORM_BUFFER);
+            mMappedStorage = nullptr;
+        }
+
+        mIsWriting = false;
+    }
+
+#pragma mark - Binding
+
+    void GLUniformRingBuffer::bind() const {
+        glBindBuffer(GL_UNIFORM_BUFFER, mName);
+    }
+
+}
@@ -0,0 +1,114 @@
+//
+//  GLUniformRingBuffer.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef GLUniformRingBuffer_hpp
+#define GLUniformRingBuffer_hpp
+
+#include "GLNamedObject.hpp"
+#include "GLUniformBuffer.hpp"
+#include "RingBufferAllocator.hpp"
+
+#include <array>
+#include <cstddef>
+
+namespace EARenderer {
+
+    /// Uniform data streamed every frame, triple buffered so that the CPU writes one segment while the GPU reads the others.
+    ///
+    /// Where ARB_buffer_storage is available (GL 4.4+) the buffer is mapped once, persistently and coherently.
+    /// Otherwise (GL 4.1 on macOS) the current segment is mapped unsynchronized for the duration of writing.
+    /// Every segment gets a fence once the frame that wrote it is over. A segment whose fence hasn't been signaled
+    /// by the time it comes around again counts as a stall: persistent storage waits for the fence,
+    /// the fallback orphans the whole buffer instead, leaving the old storage to the commands still reading it.
+    class GLUniformRingBuffer : public GLNamedObject {
+    public:
+        static constexpr size_t SegmentCount = 3;
+
+    private:
+        RingBufferAllocator mAllocator;
+        std::array<GLsync, SegmentCount> mFences{};
+        bool mIsPersistentlyMapped = false;
+        // Whole buffer if it's persistently mapped, current segment while it's being written otherwise
+        std::byte *mMappedStorage = nullptr;
+        bool mIsWriting = false;
+        size_t mFrameCount = 0;
+        size_t mStallCount = 0;
+
+        static GLint ObtainMandatoryAlignment();
+
+        static GLint ObtainMaximumBlockSize();
+
+        void allocateStorage();
+
+        void waitForSegment(size_t segment);
+
+        void mapSegment(size_t segment);
+
+    public:
+        /**
+         @return true if the current context supports immutable, persistently mapped buffer storage, checked once
+         */
+        static bool IsBufferStorageSupported();
+
+        /**
+         Segments are as large as a single uniform block can be
+         */
+        GLUniformRingBuffer();
+
+        /**
+         @param segmentSize bytes available for a single frame, rounded up to the uniform buffer offset alignment
+         */
+        GLUniformRingBuffer(size_t segmentSize);
+
+        ~GLUniformRingBuffer() override;
+
+        GLUniformRingBuffer(const GLUniformRingBuffer &that) = delete;
+
+        GLUniformRingBuffer &operator=(const GLUniformRingBuffer &rhs) = delete;
+
+#pragma mark - Getters
+
+        size_t segmentSize() const;
+
+        bool isPersistentlyMapped() const;
+
+        size_t frameCount() const;
+
+        /// Frames that found their segment still in use by the GPU
+        size_t stallCount() const;
+
+#pragma mark - Writing
+
+        /**
+         Fences the segment written during the previous frame and moves on to the next one,
+         previous contents of which are no longer valid. Has to be called once per frame, before any writes.
+         */
+        void beginFrame();
+
+        /**
+         @param data bytes to copy into the current segment
+         @param byteCount number of bytes, the allocation is aligned for glBindBufferRange
+         @return location of the data in the buffer, valid until the segment is reused
+         @throws std::logic_error if called outside of beginFrame() / finishWriting()
+         @throws std::range_error if the current segment is full
+         */
+        GLUBODataLocation write(const void *data, size_t byteCount);
+
+        /**
+         Makes the current segment's data visible to GL, has to be called before issuing commands that read it
+         */
+        void finishWriting();
+
+#pragma mark - Binding
+
+        void bind() const;
+    };
+
+}
+
+#endif /* GLUniformRingBuffer_hpp */
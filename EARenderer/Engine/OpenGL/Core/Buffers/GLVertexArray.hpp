@@ -39,7 +39,7 @@ namespace EARenderer {
             for (GLuint location = 0; location < attributeCount; location++) {
                 glEnableVertexAttribArray(location);
                 const GLVertexAttribute &attribute = attributes[location];
-                glVertexAttribPointer(location, attribute.components, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void *>(offset));
+                glVertexAttribPointer(location, attribute.components, attribute.type, attribute.normalized, sizeof(Vertex), reinterpret_cast<void *>(offset));
                 glVertexAttribDivisor(location, attribute.divisor);
                 offset += attribute.bytes;
             }
@@ -62,7 +62,7 @@ namespace EARenderer {
                 template<class...> class IndexContainer,
                 template<class...> class AttributeContainer
         >
-        static auto Create(const VertexContainer<Vertex> &vertices, const IndexContainer<GLushort> &indices, const AttributeContainer<GLVertexAttribute> &attributes) {
+        static auto Create(const VertexContainer<Vertex> &vertices, const IndexContainer<GLuint> &indices, const AttributeContainer<GLVertexAttribute> &attributes) {
             return GLVertexArray(vertices.data(), vertices.size(), indices.data(), indices.size(), attributes.data(), attributes.size());
         }
 
@@ -73,7 +73,7 @@ namespace EARenderer {
             hookUpBuffers(attributes, attributeCount);
         }
 
-        GLVertexArray(const Vertex *vertices, size_t vertexCount, const GLushort *indices, size_t indexCount, const GLVertexAttribute *attributes, size_t attributeCount)
+        GLVertexArray(const Vertex *vertices, size_t vertexCount, const GLuint *indices, size_t indexCount, const GLVertexAttribute *attributes, size_t attributeCount)
                 : mVertexBuffer(std::make_unique<GLVertexArrayBuffer<Vertex>>(vertices, vertexCount)),
                   mIndexBuffer(std::make_unique<GLElementArrayBuffer>(indices, indexCount)) {
 
@@ -107,7 +107,7 @@ namespace EARenderer {
                 }
 
                 glEnableVertexAttribArray(attribute.location);
-                glVertexAttribPointer(attribute.location, attribute.components, GL_FLOAT, GL_FALSE, sizeof(T), reinterpret_cast<void *>(offset));
+                glVertexAttribPointer(attribute.location, attribute.components, attribute.type, attribute.normalized, sizeof(T), reinterpret_cast<void *>(offset));
                 glVertexAttribDivisor(attribute.location, attribute.divisor);
                 offset += attribute.bytes;
             }
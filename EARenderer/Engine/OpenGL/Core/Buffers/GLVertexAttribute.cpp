@@ -30,10 +30,24 @@ namespace EARenderer {
             location(location) {
     }
 
+    GLVertexAttribute::GLVertexAttribute(GLint sizeInBytes, GLint componentCount, GLenum type, GLboolean normalized, GLint divisor, GLint location)
+            :
+            bytes(sizeInBytes),
+            components(componentCount),
+            divisor(divisor),
+            location(location),
+            type(type),
+            normalized(normalized) {
+    }
+
     GLVertexAttribute GLVertexAttribute::UniqueAttribute(GLint sizeInBytes, GLint componentCount, GLint location) {
         return GLVertexAttribute(sizeInBytes, componentCount, 0, location);
     }
 
+    GLVertexAttribute GLVertexAttribute::UniqueAttribute(GLint sizeInBytes, GLint componentCount, GLenum type, GLboolean normalized, GLint location) {
+        return GLVertexAttribute(sizeInBytes, componentCount, type, normalized, 0, location);
+    }
+
     GLVertexAttribute GLVertexAttribute::SharedAttribute(GLint sizeInBytes, GLint componentCount, GLint location) {
         return GLVertexAttribute(sizeInBytes, componentCount, 1, location);
     }
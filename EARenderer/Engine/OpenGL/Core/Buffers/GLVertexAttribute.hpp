@@ -10,6 +10,7 @@
 #define GLVertexAttribute_hpp
 
 #include <OpenGL/OpenGL.h>
+#include <OpenGL/gl3.h>
 
 namespace EARenderer {
 
@@ -20,11 +21,17 @@ namespace EARenderer {
         GLint bytes;
         GLint components;
         GLint divisor;
+        /// Type of components as they are stored in the buffer
+        GLenum type = GL_FLOAT;
+        /// Whether integer components are mapped to [0, 1] or [-1, 1] floats when fetched
+        GLboolean normalized = GL_FALSE;
 
         GLVertexAttribute(GLint sizeInBytes, GLint componentCount);
 
         GLVertexAttribute(GLint sizeInBytes, GLint componentCount, GLint divisor, GLint location);
 
+        GLVertexAttribute(GLint sizeInBytes, GLint componentCount, GLenum type, GLboolean normalized, GLint divisor, GLint location);
+
         /**
          Factory function providing attribute unique for every vertex (default OpenGL behaviour)
 
@@ -34,6 +41,17 @@ namespace EARenderer {
          */
         static GLVertexAttribute UniqueAttribute(GLint sizeInBytes, GLint componentCount, GLint location = LocationAutomatic);
 
+        /**
+         Factory function providing attribute unique for every vertex, stored in a compact form
+
+         @param sizeInBytes attribute's size in bytes
+         @param componentCount number of attribute's components
+         @param type type of attribute's components, e.g. GL_SHORT or GL_HALF_FLOAT
+         @param normalized whether integer components should be normalized when fetched by the shader
+         @return attribute with divisor parameter set to 0
+         */
+        static GLVertexAttribute UniqueAttribute(GLint sizeInBytes, GLint componentCount, GLenum type, GLboolean normalized, GLint location = LocationAutomatic);
+
         /**
          Factory function providing attribute which will be shared between vertices of the same instance in instanced rendering mode
 
@@ -39,6 +39,12 @@ namespace EARenderer {
             throw std::invalid_argument(string_format("Texture unit %d exceeds maximum texture unit index %d", unit, mMaximumTextureUnits - 1));
         }
 
+        // Rebinding the same material keeps hitting the same units, switching the active unit for nothing is avoided
+        auto it = mBoundTextures.find(unit);
+        if (it != mBoundTextures.end() && it->second.first == texture.name() && it->second.second == texture.bindingPoint()) {
+            return;
+        }
+
         if (mActiveTextureUnit != unit) {
             activateUnit(unit);
         }
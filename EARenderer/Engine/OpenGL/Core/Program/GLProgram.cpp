@@ -232,6 +232,11 @@ namespace EARenderer {
         glBindBufferRange(GL_UNIFORM_BUFFER, block.binding(), UBO.name(), location.offset, location.dataSize);
     }
 
+    void GLProgram::setUniformBuffer(CRC32 uniformNameCRC32, const GLUniformRingBuffer &UBO, const GLUBODataLocation& location) {
+        const GLUniformBlock& block = uniformBlockByNameCRC32(uniformNameCRC32);
+        glBindBufferRange(GL_UNIFORM_BUFFER, block.binding(), UBO.name(), location.offset, location.dataSize);
+    }
+
 #pragma mark - Public
 
     void GLProgram::ensureSamplerValidity(UniformModifierClosure closure) {
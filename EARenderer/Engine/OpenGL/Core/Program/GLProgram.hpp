@@ -33,6 +33,7 @@
 #include "GLTexture2DArray.hpp"
 #include "GLBufferTexture.hpp"
 #include "GLUniformBuffer.hpp"
+#include "GLUniformRingBuffer.hpp"
 #include "CRC32.hpp"
 
 namespace EARenderer {
@@ -117,6 +118,8 @@ namespace EARenderer {
         void ensureSamplerValidity(UniformModifierClosure closure);
 
         void setUniformBuffer(CRC32 uniformNameCRC32, const GLUniformBuffer& UBO, const GLUBODataLocation& location);
+
+        void setUniformBuffer(CRC32 uniformNameCRC32, const GLUniformRingBuffer& UBO, const GLUBODataLocation& location);
     };
 
     void swap(GLProgram &, GLProgram &);
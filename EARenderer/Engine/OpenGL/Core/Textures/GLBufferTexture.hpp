@@ -21,8 +21,11 @@ namespace EARenderer {
         GLTextureBuffer<BufferDataType> mBuffer;
 
     public:
-        GLBufferTexture(const BufferDataType *data, uint64_t count)
-                : mBuffer(data, count, GLTexture::glFormat(Format).internalFormat) {
+        /**
+         @param usageMode usage hint of the underlying buffer, GL_STREAM_DRAW for contents rewritten every frame
+         */
+        GLBufferTexture(const BufferDataType *data, uint64_t count, GLenum usageMode = GL_STATIC_DRAW)
+                : mBuffer(data, count, GLTexture::glFormat(Format).internalFormat, usageMode) {
             glGenTextures(1, &mName);
         }
 
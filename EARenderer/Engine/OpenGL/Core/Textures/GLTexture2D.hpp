@@ -11,6 +11,7 @@
 
 #include "GLTexture.hpp"
 #include "GLTexture2DSampler.hpp"
+#include "GLTextureUnitManager.hpp"
 
 namespace EARenderer {
 
@@ -39,6 +40,36 @@ namespace EARenderer {
         auto sampleTexels(uint8_t mipLevel = 0) const {
             return GLTexture2DSampler<TextureFormat, Format>(*this, mipLevel);
         }
+
+        /**
+         Uploads one level of a mip chain which is streamed level by level, from the smallest one to the base one.
+         Sampling is restricted to the levels uploaded so far, so the texture stays complete and sharpens as finer levels arrive.
+
+         @param size size of the base level
+         @param level level to upload, finer than all previously uploaded ones
+         @param levelCount number of levels in the whole chain
+         @param pixelData tightly packed texels of the level
+         @param inputPixelFormat layout of the texels, allows to upload fewer channels than the format's input expects
+         */
+        void uploadMipLevel(const Size2D &size, uint16_t level, uint16_t levelCount, const void *pixelData,
+                GLenum inputPixelFormat = glFormat(Format).inputPixelFormat) {
+            constexpr GLTextureFormat f = glFormat(Format);
+            GLsizei width = std::max(GLsizei(size.width) >> level, 1);
+            GLsizei height = std::max(GLsizei(size.height) >> level, 1);
+
+            GLTextureUnitManager::Shared().bindTextureToActiveUnit(*this);
+
+            // Rows of single channel levels are not necessarily 4-byte aligned
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            glTexImage2D(GL_TEXTURE_2D, level, f.internalFormat, width, height, 0, inputPixelFormat, f.inputPixelType, pixelData);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+
+            mSize = size;
+            mMipMapsCount = levelCount - 1;
+        }
     };
 
     template<class TextureFormat, TextureFormat Format>
@@ -7,7 +7,3 @@
 //
 
 #include "GLTextureFactory.hpp"
-
-#define STB_IMAGE_IMPLEMENTATION
-
-#include "stb_image.h"
@@ -12,13 +12,12 @@
 #include "GLTexture2D.hpp"
 #include "GLTextureCubemap.hpp"
 #include "StringUtils.hpp"
+#include "StbImage.hpp"
 
 #include <string>
 #include <memory>
 #include <array>
 
-#include "stb_image.h"
-
 namespace EARenderer {
 
     class GLTextureFactory {
@@ -30,7 +29,7 @@ namespace EARenderer {
             int32_t width = 0;
             int32_t height = 0;
             int32_t components = 0;
-            stbi_set_flip_vertically_on_load(true);
+            StbImage::EnableVerticalFlip();
             stbi_uc *pixelData = stbi_load(imagePath.c_str(), &width, &height, &components, STBI_rgb_alpha);
 
             if (!pixelData) {
@@ -50,7 +49,7 @@ namespace EARenderer {
             int32_t height = 0;
             int32_t components = 0;
 
-            stbi_set_flip_vertically_on_load(true);
+            StbImage::EnableVerticalFlip();
             float *pixelData = stbi_loadf(imagePath.c_str(), &width, &height, &components, STBI_default);
 
             if (!pixelData) {
@@ -76,7 +75,7 @@ namespace EARenderer {
             int32_t width = 0;
             int32_t height = 0;
             int32_t components = 0;
-            stbi_set_flip_vertically_on_load(true);
+            StbImage::EnableVerticalFlip();
 
             std::array<std::string, 6> imagePaths{
                     positiveXImagePath, negativeXImagePath, positiveYImagePath,
@@ -0,0 +1,31 @@
+// Per-draw transformations.
+// On contexts with multi-draw-indirect they are written by DrawCommandBuilder into uDrawData, 8 texels per draw:
+// mesh space to world space matrix (position dequantization included) followed by the normal matrix.
+// Otherwise they are set as uniforms before every draw. Uniforms start out as 0, so uUseDrawData is only set along with uDrawData.
+
+const int kDrawDataTexelCount = 8;
+
+layout (location = 5) in float iDrawIndex;
+
+uniform bool uUseDrawData;
+uniform samplerBuffer uDrawData;
+
+uniform mat4 uModelMat;
+uniform mat4 uPositionDequantizationMat;
+uniform mat4 uNormalMat;
+
+mat4 DrawDataMatrix(int firstTexel) {
+    int base = int(iDrawIndex) * kDrawDataTexelCount + firstTexel;
+    return mat4(texelFetch(uDrawData, base),
+                texelFetch(uDrawData, base + 1),
+                texelFetch(uDrawData, base + 2),
+                texelFetch(uDrawData, base + 3));
+}
+
+mat4 DrawPositionMatrix() {
+    return uUseDrawData ? DrawDataMatrix(0) : uModelMat * uPositionDequantizationMat;
+}
+
+mat4 DrawNormalMatrix() {
+    return uUseDrawData ? DrawDataMatrix(4) : uNormalMat;
+}
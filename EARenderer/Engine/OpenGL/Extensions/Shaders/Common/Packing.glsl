@@ -65,3 +65,12 @@ uint Encode8888(vec4 vector) {
     uint(vector.w * 255.0);
     return rgba;
 }
+
+// Inverse of the octahedral mapping of unit vectors onto the [-1, 1] square
+vec3 DecodeOctahedral(vec2 encoded) {
+    vec3 v = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    if (v.z < 0.0) {
+        v.xy = (1.0 - abs(v.yx)) * vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+    }
+    return normalize(v);
+}
@@ -321,3 +321,84 @@ float EvaluateSH(SH sh, vec3 direction, int component) {
 
     return result;
 }
+
+////////////////////////////////////////////////////////////
+/////////////////////// Compression ////////////////////////
+////////////////////////////////////////////////////////////
+
+// Layouts are described in CompressedSphericalHarmonics.hpp
+
+float SHExponentScale(uint biasedExponent) {
+    return biasedExponent == 0u ? 0.0 : exp2(float(biasedExponent) - 128.0);
+}
+
+float DecodeSHSnorm(uint word, int offset, int bits, float scale) {
+    // Integer overload of bitfieldExtract sign-extends the field
+    int value = bitfieldExtract(int(word), offset, bits);
+    return float(value) / float((1 << (bits - 1)) - 1) * scale;
+}
+
+void DecodeSHLuma(uvec4 texel, out float luma[9]) {
+    float scale = SHExponentScale(texel.w & 0xFFu);
+    for (int i = 0; i < 9; ++i) {
+        luma[i] = DecodeSHSnorm(texel[i / 3], (i % 3) * 10, 10, scale);
+    }
+}
+
+SH SHFromCoefficients(vec3 c[9]) {
+    SH sh;
+    sh.L00  = c[0];
+    sh.L11  = c[1];
+    sh.L10  = c[2];
+    sh.L1_1 = c[3];
+    sh.L21  = c[4];
+    sh.L2_1 = c[5];
+    sh.L2_2 = c[6];
+    sh.L20  = c[7];
+    sh.L22  = c[8];
+    return sh;
+}
+
+//
+// Decodes YCoCg spherical harmonics stored as 2 RGBA32UI texels per entry
+//
+SH DecodeCompressedSH(usamplerBuffer buffer, int index) {
+    uvec4 texel0 = texelFetch(buffer, index * 2);
+    uvec4 texel1 = texelFetch(buffer, index * 2 + 1);
+
+    float luma[9];
+    DecodeSHLuma(texel0, luma);
+
+    float chromaScale = SHExponentScale((texel0.w >> 8) & 0xFFu);
+
+    // 18 chroma coefficients: Co of all 9 coefficients followed by Cg
+    float chroma[18];
+    chroma[0] = DecodeSHSnorm(texel0.w, 16, 8, chromaScale);
+    chroma[1] = DecodeSHSnorm(texel0.w, 24, 8, chromaScale);
+    for (int i = 2; i < 18; ++i) {
+        chroma[i] = DecodeSHSnorm(texel1[(i - 2) / 4], ((i - 2) % 4) * 8, 8, chromaScale);
+    }
+
+    vec3 c[9];
+    for (int i = 0; i < 9; ++i) {
+        c[i] = vec3(luma[i], chroma[i], chroma[i + 9]);
+    }
+
+    return SHFromCoefficients(c);
+}
+
+//
+// Decodes single channel spherical harmonics stored as 1 RGBA32UI texel per entry,
+// replicating the channel to all three components
+//
+SH DecodeCompressedLumaSH(usamplerBuffer buffer, int index) {
+    float luma[9];
+    DecodeSHLuma(texelFetch(buffer, index), luma);
+
+    vec3 c[9];
+    for (int i = 0; i < 9; ++i) {
+        c[i] = vec3(luma[i]);
+    }
+
+    return SHFromCoefficients(c);
+}
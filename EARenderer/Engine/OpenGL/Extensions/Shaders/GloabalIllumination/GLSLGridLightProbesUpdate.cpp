@@ -26,11 +26,11 @@ namespace EARenderer {
         setUniformTexture(ctcrc32("uSurfelClustersLuminanceMap"), luminanceMap);
     }
 
-    void GLSLGridLightProbesUpdate::setProjectionClusterSphericalHarmonics(const GLFloatBufferTexture<GLTexture::Float::RGB32F, SphericalHarmonics> &SH) {
+    void GLSLGridLightProbesUpdate::setProjectionClusterSphericalHarmonics(const GLIntegerBufferTexture<GLTexture::Integer::RGBA32UI, CompressedSphericalHarmonics> &SH) {
         setBufferTexture(ctcrc32("uProjectionClusterSphericalHarmonics"), SH);
     }
 
-    void GLSLGridLightProbesUpdate::setSkySphericalHarmonics(const GLFloatBufferTexture<GLTexture::Float::RGB32F, SphericalHarmonics> &SH) {
+    void GLSLGridLightProbesUpdate::setSkySphericalHarmonics(const GLIntegerBufferTexture<GLTexture::Integer::RGBA32UI, CompressedLumaSphericalHarmonics> &SH) {
         setBufferTexture(ctcrc32("uSkySphericalHarmonics"), SH);
     }
 
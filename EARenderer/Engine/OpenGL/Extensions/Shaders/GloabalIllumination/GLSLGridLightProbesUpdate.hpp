@@ -13,6 +13,7 @@
 #include "GLTextureBuffer.hpp"
 #include "GLTexture2D.hpp"
 #include "SphericalHarmonics.hpp"
+#include "CompressedSphericalHarmonics.hpp"
 
 namespace EARenderer {
 
@@ -24,9 +25,9 @@ namespace EARenderer {
 
         void setSurfelClustersLuminaceMap(const GLFloatTexture2D<GLTexture::Float::R16F> &luminanceMap);
 
-        void setProjectionClusterSphericalHarmonics(const GLFloatBufferTexture<GLTexture::Float::RGB32F, SphericalHarmonics> &SH);
+        void setProjectionClusterSphericalHarmonics(const GLIntegerBufferTexture<GLTexture::Integer::RGBA32UI, CompressedSphericalHarmonics> &SH);
 
-        void setSkySphericalHarmonics(const GLFloatBufferTexture<GLTexture::Float::RGB32F, SphericalHarmonics> &SH);
+        void setSkySphericalHarmonics(const GLIntegerBufferTexture<GLTexture::Integer::RGBA32UI, CompressedLumaSphericalHarmonics> &SH);
 
         void setProjectionClusterIndices(const GLIntegerBufferTexture<GLTexture::Integer::R32UI, uint32_t> &indices);
 
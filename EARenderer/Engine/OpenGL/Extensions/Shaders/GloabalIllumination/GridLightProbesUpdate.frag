@@ -21,8 +21,8 @@ in float vLayer;
 
 uniform ivec3 uProbesGridResolution;
 
-uniform samplerBuffer uProjectionClusterSphericalHarmonics;
-uniform samplerBuffer uSkySphericalHarmonics;
+uniform usamplerBuffer uProjectionClusterSphericalHarmonics;
+uniform usamplerBuffer uSkySphericalHarmonics;
 uniform usamplerBuffer uProjectionClusterIndices;
 uniform usamplerBuffer uProbeProjectionsMetadata;
 uniform sampler2D uSurfelClustersLuminanceMap;
@@ -46,28 +46,6 @@ float MaxSHCoefficient(SH sh) {
     return maximum;
 }
 
-//
-// Unpacks spherical harmonics coefficients
-// from the corresponding sample buffer
-//
-SH UnpackSH(samplerBuffer buffer, int index) {
-    SH sh;
-
-    index *= 9;
-
-    sh.L00  = vec3(texelFetch(buffer, index + 0).rgb);
-    sh.L11  = vec3(texelFetch(buffer, index + 1).rgb);
-    sh.L10  = vec3(texelFetch(buffer, index + 2).rgb);
-    sh.L1_1 = vec3(texelFetch(buffer, index + 3).rgb);
-    sh.L21  = vec3(texelFetch(buffer, index + 4).rgb);
-    sh.L2_1 = vec3(texelFetch(buffer, index + 5).rgb);
-    sh.L2_2 = vec3(texelFetch(buffer, index + 6).rgb);
-    sh.L20  = vec3(texelFetch(buffer, index + 7).rgb);
-    sh.L22  = vec3(texelFetch(buffer, index + 8).rgb);
-
-    return sh;
-}
-
 // Packing scheme:
 //                         Y    Y      Y    Y       Y    Y       Y     Y      Y   Co
 // 9 Luma coefficients  [(L00, L11), (L10, L1_1), (L21, L2_1), (L2_2, L20), (L22, L00),
@@ -142,14 +120,14 @@ void main() {
 
         float surfelClusterLuminance = texelFetch(uSurfelClustersLuminanceMap, luminanceUV, 0).r;
 
-        SH surfelClusterPrecomputedSH = UnpackSH(uProjectionClusterSphericalHarmonics, int(i));
+        SH surfelClusterPrecomputedSH = DecodeCompressedSH(uProjectionClusterSphericalHarmonics, int(i));
         SH luminanceSH = ScaleSH(surfelClusterPrecomputedSH, vec3(surfelClusterLuminance));
 
         resultingSH = Sum2SH(resultingSH, luminanceSH);
     }
 
     // Update and add sky light
-    SH skySH = UnpackSH(uSkySphericalHarmonics, probeIndex);
+    SH skySH = DecodeCompressedLumaSH(uSkySphericalHarmonics, probeIndex);
     skySH = SHProduct(skySH, uSkyColorSphericalHarmonics);
 
     resultingSH = Sum2SH(resultingSH, skySH);
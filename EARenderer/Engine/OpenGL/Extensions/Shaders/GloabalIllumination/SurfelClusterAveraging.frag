@@ -23,7 +23,7 @@ uint UnpackSurfelOffset(uint encoded) {
 }
 
 uint UnpackSurfelCount(uint encoded) {
-    uint count = encoded & 0xFFu;
+    uint count = (encoded & 0xFFu) + 1u;
     return count;
 }
 
@@ -1,23 +1,24 @@
 #version 400 core
 
 #include "CameraUBO.glsl"
+#include "Packing.glsl"
+#include "DrawData.glsl"
 
 // Constants
 const int kMaxCascades = 4;
 
 // Attributes
 
+// Packed vertex: position is normalized to the sub mesh bounds and carries bitangent sign in w,
+// normal and tangent are octahedral encoded
 layout (location = 0) in vec4 iPosition;
-layout (location = 1) in vec3 iTexCoords;
+layout (location = 1) in vec2 iTexCoords;
 layout (location = 2) in vec2 iLightmapCoords;
-layout (location = 3) in vec3 iNormal;
-layout (location = 4) in vec3 iTangent;
-layout (location = 5) in vec3 iBitangent;
+layout (location = 3) in vec2 iNormal;
+layout (location = 4) in vec2 iTangent;
 
 // Uniforms
 
-uniform mat4 uModelMat;
-uniform mat4 uNormalMat;
 uniform mat4 uCameraViewMat;
 uniform mat4 uCameraProjectionMat;
 uniform mat4 uCSMSplitSpaceMat;
@@ -34,29 +35,24 @@ out vec3 vCameraPosInTangentSpace;
 
 // Functions
 
-// Build TBN matrix as-is
-mat3 TBN() {
-    vec3 T = normalize(uNormalMat * vec4(iTangent, 0.0)).xyz;
-    vec3 B = normalize(uNormalMat * vec4(iBitangent, 0.0)).xyz;
-    vec3 N = normalize(uNormalMat * vec4(iNormal, 0.0)).xyz;
-    return mat3(T, B, N);
-}
+// Tangent is orthogonalized against the normal offline, bitangent is reconstructed
+mat3 TBN(mat4 normalMatrix) {
+    vec3 localNormal = DecodeOctahedral(iNormal);
+    vec3 localTangent = DecodeOctahedral(iTangent);
+    vec3 localBitangent = cross(localNormal, localTangent) * (iPosition.w * 2.0 - 1.0);
 
-mat3 OrthogonalTBN() {
-    vec3 T = normalize(uNormalMat * vec4(iTangent, 0.0)).xyz;
-    vec3 N = normalize(uNormalMat * vec4(iNormal, 0.0)).xyz;
-    // re-orthogonalize T with respect to N
-    T = normalize(T - dot(T, N) * N);
-    vec3 B = cross(N, T);
+    vec3 T = normalize(normalMatrix * vec4(localTangent, 0.0)).xyz;
+    vec3 B = normalize(normalMatrix * vec4(localBitangent, 0.0)).xyz;
+    vec3 N = normalize(normalMatrix * vec4(localNormal, 0.0)).xyz;
     return mat3(T, B, N);
 }
 
 void main() {
-    vec4 worldPosition = uModelMat * iPosition;
+    vec4 worldPosition = DrawPositionMatrix() * vec4(iPosition.xyz, 1.0);
 
-    mat3 TBN = TBN();
+    mat3 TBN = TBN(DrawNormalMatrix());
 
-    vTexCoords = vec3(iTexCoords.s, iTexCoords.t, iTexCoords.r);
+    vTexCoords = vec3(iTexCoords.s, iTexCoords.t, 0.0);
     vWorldPosition = worldPosition.xyz;
     vTBN = TBN;
     vPosInCSMSplitSpace = uCSMSplitSpaceMat * worldPosition;
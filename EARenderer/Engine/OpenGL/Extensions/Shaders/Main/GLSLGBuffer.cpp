@@ -14,6 +14,9 @@ namespace EARenderer {
 
     GLSLGBuffer::GLSLGBuffer()
             : GLProgram("GBuffer.vert", "GBuffer.frag", "") {
+        mModelMatrixLocation = uniformByNameCRC32(ctcrc32("uModelMat")).location();
+        mNormalMatrixLocation = uniformByNameCRC32(ctcrc32("uNormalMat")).location();
+        mPositionDequantizationMatrixLocation = uniformByNameCRC32(ctcrc32("uPositionDequantizationMat")).location();
     }
 
 #pragma mark - Setters
@@ -24,9 +27,18 @@ namespace EARenderer {
         glUniformMatrix4fv(uniformByNameCRC32(ctcrc32("uCameraProjectionMat")).location(), 1, GL_FALSE, glm::value_ptr(camera.projectionMatrix()));
     }
 
+    void GLSLGBuffer::setDrawData(const GLFloatBufferTexture<GLTexture::Float::RGBA32F, glm::vec4> &drawData) {
+        setBufferTexture(ctcrc32("uDrawData"), drawData);
+        glUniform1i(uniformByNameCRC32(ctcrc32("uUseDrawData")).location(), GL_TRUE);
+    }
+
     void GLSLGBuffer::setModelMatrix(const glm::mat4 &matrix) {
-        glUniformMatrix4fv(uniformByNameCRC32(ctcrc32("uModelMat")).location(), 1, GL_FALSE, glm::value_ptr(matrix));
-        glUniformMatrix4fv(uniformByNameCRC32(ctcrc32("uNormalMat")).location(), 1, GL_FALSE, glm::value_ptr(glm::transpose(glm::inverse(matrix))));
+        glUniformMatrix4fv(mModelMatrixLocation, 1, GL_FALSE, glm::value_ptr(matrix));
+        glUniformMatrix4fv(mNormalMatrixLocation, 1, GL_FALSE, glm::value_ptr(glm::transpose(glm::inverse(matrix))));
+    }
+
+    void GLSLGBuffer::setPositionDequantizationMatrix(const glm::mat4 &matrix) {
+        glUniformMatrix4fv(mPositionDequantizationMatrixLocation, 1, GL_FALSE, glm::value_ptr(matrix));
     }
 
     void GLSLGBuffer::setMaterial(const CookTorranceMaterial &material) {
@@ -14,10 +14,17 @@
 #include "EmissiveMaterial.hpp"
 #include "Camera.hpp"
 #include "RenderingSettings.hpp"
+#include "GLBufferTexture.hpp"
 
 namespace EARenderer {
 
     class GLSLGBuffer : public GLProgram {
+    private:
+        // Per-draw uniforms are set thousands of times a frame without multi-draw-indirect, their locations are resolved once
+        GLint mModelMatrixLocation = -1;
+        GLint mNormalMatrixLocation = -1;
+        GLint mPositionDequantizationMatrixLocation = -1;
+
     public:
         using GLProgram::GLProgram;
 
@@ -25,8 +32,20 @@ namespace EARenderer {
 
         void setCamera(const Camera &camera);
 
+        /**
+         Switches the program over from transformation uniforms to the per-draw data
+
+         @param drawData per-draw transformations built by DrawCommandBuilder
+         */
+        void setDrawData(const GLFloatBufferTexture<GLTexture::Float::RGBA32F, glm::vec4> &drawData);
+
         void setModelMatrix(const glm::mat4 &matrix);
 
+        /**
+         @param matrix transformation of sub mesh positions, normalized to its bounds, back into the mesh space
+         */
+        void setPositionDequantizationMatrix(const glm::mat4 &matrix);
+
         void setMaterial(const CookTorranceMaterial &material);
 
         void setMaterial(const EmissiveMaterial &material);
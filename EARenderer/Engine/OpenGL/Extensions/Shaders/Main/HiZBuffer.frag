@@ -18,11 +18,21 @@ in vec2 vTexCoords;
 ////////////////////////////////////////////////////////////
 
 void main() {
+    ivec2 sourceSize = textureSize(uLinearDepthTexture, uLOD);
+
     // Multiplying by 2 to account for uLinearDepthTexture being twice the size of the current render target (oHiZ)
-    float depth0 = texelFetch(uLinearDepthTexture, 2 * ivec2(gl_FragCoord.xy), uLOD).r;
-    float depth1 = texelFetch(uLinearDepthTexture, 2 * (ivec2(gl_FragCoord.xy) + ivec2(1, 0)), uLOD).r;
-    float depth2 = texelFetch(uLinearDepthTexture, 2 * (ivec2(gl_FragCoord.xy) + ivec2(1, 1)), uLOD).r;
-    float depth3 = texelFetch(uLinearDepthTexture, 2 * (ivec2(gl_FragCoord.xy) + ivec2(0, 1)), uLOD).r;
+    ivec2 first = 2 * ivec2(gl_FragCoord.xy);
+
+    // Render target's size is rounded down, so the last row and column also cover the leftover texels of odd sized sources
+    ivec2 last = min(first + 1 + ivec2(equal(first + 3, sourceSize)), sourceSize - 1);
+
+    // Farthest depth keeps the pyramid conservative for occlusion culling
+    float farthestDepth = 0.0;
+    for (int y = first.y; y <= last.y; y++) {
+        for (int x = first.x; x <= last.x; x++) {
+            farthestDepth = max(farthestDepth, texelFetch(uLinearDepthTexture, ivec2(x, y), uLOD).r);
+        }
+    }
 
-    oHiZ = min(min(depth0, depth1), min(depth2, depth3));
+    oHiZ = farthestDepth;
 }
@@ -17,12 +17,23 @@ namespace EARenderer {
     GLSLShadowMap::GLSLShadowMap()
             :
             GLProgram("ShadowMap.vert", "ShadowMap.frag", "ShadowMap.geom") {
+        mModelMatrixLocation = uniformByNameCRC32(ctcrc32("uModelMat")).location();
+        mPositionDequantizationMatrixLocation = uniformByNameCRC32(ctcrc32("uPositionDequantizationMat")).location();
     }
 
 #pragma mark - Setters
 
+    void GLSLShadowMap::setDrawData(const GLFloatBufferTexture<GLTexture::Float::RGBA32F, glm::vec4> &drawData) {
+        setBufferTexture(ctcrc32("uDrawData"), drawData);
+        glUniform1i(uniformByNameCRC32(ctcrc32("uUseDrawData")).location(), GL_TRUE);
+    }
+
     void GLSLShadowMap::setModelMatrix(const glm::mat4 &modelMatrix) {
-        glUniformMatrix4fv(uniformByNameCRC32(ctcrc32("uModelMatrix")).location(), 1, GL_FALSE, glm::value_ptr(modelMatrix));
+        glUniformMatrix4fv(mModelMatrixLocation, 1, GL_FALSE, glm::value_ptr(modelMatrix));
+    }
+
+    void GLSLShadowMap::setPositionDequantizationMatrix(const glm::mat4 &matrix) {
+        glUniformMatrix4fv(mPositionDequantizationMatrixLocation, 1, GL_FALSE, glm::value_ptr(matrix));
     }
 
     void GLSLShadowMap::setViewProjectionMatrices(const std::vector<glm::mat4> &matrices) {
@@ -13,17 +13,35 @@
 #include "FrustumCascades.hpp"
 #include "Camera.hpp"
 #include "PointLight.hpp"
+#include "GLBufferTexture.hpp"
 
 #include <glm/mat4x4.hpp>
 
 namespace EARenderer {
 
     class GLSLShadowMap : public GLProgram {
+    private:
+        // Both are set for every sub mesh of every light without multi-draw-indirect, locations are resolved once
+        GLint mModelMatrixLocation = -1;
+        GLint mPositionDequantizationMatrixLocation = -1;
+
     public:
         GLSLShadowMap();
 
+        /**
+         Switches the program over from transformation uniforms to the per-draw data
+
+         @param drawData per-draw transformations built by DrawCommandBuilder
+         */
+        void setDrawData(const GLFloatBufferTexture<GLTexture::Float::RGBA32F, glm::vec4> &drawData);
+
         void setModelMatrix(const glm::mat4 &modelMatrix);
 
+        /**
+         @param matrix transformation of sub mesh positions, normalized to its bounds, back into the mesh space
+         */
+        void setPositionDequantizationMatrix(const glm::mat4 &matrix);
+
         void setViewProjectionMatrices(const std::vector<glm::mat4> &matrices);
     };
 
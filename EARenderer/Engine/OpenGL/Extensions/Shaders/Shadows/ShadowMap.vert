@@ -1,9 +1,11 @@
 #version 400 core
 
 #include "Constants.glsl"
+#include "DrawData.glsl"
 
 // Inputs
 
+// Normalized to the sub mesh bounds, w is not a part of the position
 layout (location = 0) in vec4 iPosition;
 
 // Outputs
@@ -16,5 +18,5 @@ out InterfaceBlock {
 
 void main() {
     vs_out.instanceID = gl_InstanceID;
-    gl_Position = iPosition;
+    gl_Position = DrawPositionMatrix() * vec4(iPosition.xyz, 1.0);
 }
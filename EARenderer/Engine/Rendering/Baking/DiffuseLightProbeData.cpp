@@ -8,80 +8,121 @@
 
 #include "DiffuseLightProbeData.hpp"
 #include "StringUtils.hpp"
-#include "Serializers.hpp"
-
-#include <bitsery/bitsery.h>
-#include <bitsery/traits/vector.h>
-#include <bitsery/adapter/stream.h>
-#include <fstream>
+#include "CRC32.hpp"
 
 namespace EARenderer {
 
-#pragma mark - Data
+    static constexpr uint32_t GridResolutionSectionTag = ctcrc32("probes.gridResolution");
+    static constexpr uint32_t ProjectionSHsSectionTag = ctcrc32("probes.projectionSHs");
+    static constexpr uint32_t ProjectionClusterIndicesSectionTag = ctcrc32("probes.projectionClusterIndices");
+    static constexpr uint32_t SkySHsSectionTag = ctcrc32("probes.skySHs");
+    static constexpr uint32_t MetadataSectionTag = ctcrc32("probes.metadata");
+    static constexpr uint32_t PositionsSectionTag = ctcrc32("probes.positions");
 
-    void DiffuseLightProbeData::initializeBuffers() {
-        // Transfer spherical harmonics coefficients to the GPU via buffer texture
-        std::vector<SphericalHarmonics> shs;
-        for (auto &projection : mSurfelClusterProjections) {
-            shs.push_back(projection.sphericalHarmonics);
-        }
+#pragma mark - Private helpers
+
+    DiffuseLightProbeData::GPULayout DiffuseLightProbeData::gpuLayout() const {
+        GPULayout layout;
 
-        // Transfer surfel cluster indices to the GPU via buffer texture
-        std::vector<uint32_t> indices;
+        // Spherical harmonics coefficients and surfel cluster indices of projections
         for (auto &projection : mSurfelClusterProjections) {
-            indices.push_back(static_cast<uint32_t>(projection.surfelClusterIndex));
+            layout.projectionSHs.emplace_back(projection.sphericalHarmonics);
+            layout.projectionClusterIndices.push_back(static_cast<uint32_t>(projection.surfelClusterIndex));
         }
 
-        // Transfer surfel cluster projection group offsets, sizes and probe positions to the GPU via buffer texture
-        std::vector<SphericalHarmonics> skySHs;
-        std::vector<uint32_t> metadata;
-        std::vector<glm::vec3> positions;
-
+        // Surfel cluster projection group offsets, sizes, probe positions and sky SHs
         for (auto &probe : mProbes) {
-            metadata.push_back((uint32_t) probe.surfelClusterProjectionGroupOffset);
-            metadata.push_back((uint32_t) probe.surfelClusterProjectionGroupSize);
-            positions.push_back(probe.position);
-            skySHs.push_back(probe.skySphericalHarmonics);
+            layout.probeMetadata.push_back((uint32_t) probe.surfelClusterProjectionGroupOffset);
+            layout.probeMetadata.push_back((uint32_t) probe.surfelClusterProjectionGroupSize);
+            layout.probePositions.push_back(probe.position);
+            layout.skySHs.emplace_back(probe.skySphericalHarmonics);
         }
 
-        mProjectionClusterSHsBufferTexture = std::make_shared<GLFloatBufferTexture<GLTexture::Float::RGB32F, SphericalHarmonics>>(shs.data(), shs.size());
-        mSkySHsBufferTexture = std::make_shared<GLFloatBufferTexture<GLTexture::Float::RGB32F, SphericalHarmonics>>(skySHs.data(), skySHs.size());
-        mProjectionClusterIndicesBufferTexture = std::make_shared<GLIntegerBufferTexture<GLTexture::Integer::R32UI, uint32_t>>(indices.data(), indices.size());
-        mProbeClusterProjectionsMetadataBufferTexture = std::make_shared<GLIntegerBufferTexture<GLTexture::Integer::R32UI, uint32_t>>(metadata.data(), metadata.size());
-        mProbePositionsBufferTexture = std::make_shared<GLFloatBufferTexture<GLTexture::Float::RGB32F, glm::vec3>>(positions.data(), positions.size());
+        return layout;
     }
 
-    void DiffuseLightProbeData::serialize(const std::string &filePath) {
-        std::ofstream stream(filePath, std::ios::trunc | std::ios::binary);
-        if (!stream.is_open()) {
-            throw std::runtime_error(string_format("Unable to serialize light probes: %s", filePath.c_str()));
-        }
-
-        bitsery::Serializer<bitsery::OutputBufferedStreamAdapter> serializer(stream);
-        serializer.container(mProbes, mProbes.size());
-        serializer.container(mSurfelClusterProjections, mSurfelClusterProjections.size());
-        serializer.object(mGridResolution);
-        bitsery::AdapterAccess::getWriter(serializer).flush();
+    void DiffuseLightProbeData::initializeBuffers(const CompressedSphericalHarmonics *projectionSHs, const uint32_t *projectionClusterIndices, size_t projectionCount,
+            const CompressedLumaSphericalHarmonics *skySHs, const uint32_t *probeMetadata, const glm::vec3 *probePositions, size_t probeCount) {
+        mProjectionClusterSHsBufferTexture = std::make_shared<GLIntegerBufferTexture<GLTexture::Integer::RGBA32UI, CompressedSphericalHarmonics>>(projectionSHs, projectionCount);
+        mSkySHsBufferTexture = std::make_shared<GLIntegerBufferTexture<GLTexture::Integer::RGBA32UI, CompressedLumaSphericalHarmonics>>(skySHs, probeCount);
+        mProjectionClusterIndicesBufferTexture = std::make_shared<GLIntegerBufferTexture<GLTexture::Integer::R32UI, uint32_t>>(projectionClusterIndices, projectionCount);
+        mProbeClusterProjectionsMetadataBufferTexture = std::make_shared<GLIntegerBufferTexture<GLTexture::Integer::R32UI, uint32_t>>(probeMetadata, probeCount * 2);
+        mProbePositionsBufferTexture = std::make_shared<GLFloatBufferTexture<GLTexture::Float::RGB32F, glm::vec3>>(probePositions, probeCount);
     }
 
-    bool DiffuseLightProbeData::deserialize(const std::string &filePath) {
-        std::ifstream stream(filePath);
-        if (!stream.is_open()) {
-            return false;
-        }
+#pragma mark - Data
 
-        bitsery::Deserializer<bitsery::InputStreamAdapter> deserializer(stream);
-        deserializer.container(mProbes, std::numeric_limits<uint32_t>::max());
-        deserializer.container(mSurfelClusterProjections, std::numeric_limits<uint32_t>::max());
-        deserializer.object(mGridResolution);
+    void DiffuseLightProbeData::initializeBuffers() {
+        GPULayout layout = gpuLayout();
+        initializeBuffers(layout.projectionSHs.data(), layout.projectionClusterIndices.data(), layout.projectionSHs.size(),
+                layout.skySHs.data(), layout.probeMetadata.data(), layout.probePositions.data(), layout.probePositions.size());
+    }
 
-        auto &reader = bitsery::AdapterAccess::getReader(deserializer);
+    void DiffuseLightProbeData::serialize(const std::string &filePath, uint64_t contentHash) {
+        // Probes are stored in the exact layout of GPU buffers
+        GPULayout layout = gpuLayout();
+
+        BakedDataFile::Writer writer;
+        writer.addSection(GridResolutionSectionTag, &mGridResolution, sizeof(mGridResolution));
+        writer.addSection(ProjectionSHsSectionTag, layout.projectionSHs);
+        writer.addSection(ProjectionClusterIndicesSectionTag, layout.projectionClusterIndices);
+        writer.addSection(SkySHsSectionTag, layout.skySHs);
+        writer.addSection(MetadataSectionTag, layout.probeMetadata);
+        writer.addSection(PositionsSectionTag, layout.probePositions);
+        writer.write(filePath, contentHash);
+    }
 
-        if (reader.isCompletedSuccessfully()) {
-            initializeBuffers();
+    bool DiffuseLightProbeData::deserialize(const std::string &filePath, uint64_t expectedContentHash) {
+        try {
+            BakedDataFile file(filePath);
+
+            if (file.contentHash() != expectedContentHash) {
+                return false;
+            }
+
+            auto gridResolution = file.section(GridResolutionSectionTag);
+            auto projectionSHs = file.section(ProjectionSHsSectionTag);
+            auto projectionClusterIndices = file.section(ProjectionClusterIndicesSectionTag);
+            auto skySHs = file.section(SkySHsSectionTag);
+            auto metadata = file.section(MetadataSectionTag);
+            auto positions = file.section(PositionsSectionTag);
+
+            size_t projectionCount = projectionSHs.count<CompressedSphericalHarmonics>();
+            size_t probeCount = positions.count<glm::vec3>();
+
+            if (gridResolution.size != sizeof(glm::ivec3) ||
+                    projectionClusterIndices.count<uint32_t>() != projectionCount ||
+                    skySHs.count<CompressedLumaSphericalHarmonics>() != probeCount ||
+                    metadata.count<uint32_t>() != probeCount * 2) {
+                return false;
+            }
+
+            mGridResolution = *gridResolution.objects<glm::ivec3>();
+
+            // CPU side copies are reassembled from the GPU layout
+            mProbes.resize(probeCount);
+            for (size_t i = 0; i < probeCount; i++) {
+                DiffuseLightProbe &probe = mProbes[i];
+                probe.position = positions.objects<glm::vec3>()[i];
+                probe.surfelClusterProjectionGroupOffset = metadata.objects<uint32_t>()[i * 2];
+                probe.surfelClusterProjectionGroupSize = metadata.objects<uint32_t>()[i * 2 + 1];
+                probe.skySphericalHarmonics = skySHs.objects<CompressedLumaSphericalHarmonics>()[i].decompressed();
+            }
+
+            mSurfelClusterProjections.resize(projectionCount);
+            for (size_t i = 0; i < projectionCount; i++) {
+                mSurfelClusterProjections[i].surfelClusterIndex = projectionClusterIndices.objects<uint32_t>()[i];
+                mSurfelClusterProjections[i].sphericalHarmonics = projectionSHs.objects<CompressedSphericalHarmonics>()[i].decompressed();
+            }
+
+            // GPU buffers are filled straight from the mapped file
+            initializeBuffers(projectionSHs.objects<CompressedSphericalHarmonics>(), projectionClusterIndices.objects<uint32_t>(), projectionCount,
+                    skySHs.objects<CompressedLumaSphericalHarmonics>(), metadata.objects<uint32_t>(), positions.objects<glm::vec3>(), probeCount);
+        } catch (const std::exception &) {
+            return false;
         }
 
-        return reader.isCompletedSuccessfully();
+        return true;
     }
 
 #pragma mark - Getters
@@ -98,11 +139,11 @@ namespace EARenderer {
         return mGridResolution;
     }
 
-    std::shared_ptr<GLFloatBufferTexture<GLTexture::Float::RGB32F, SphericalHarmonics>> DiffuseLightProbeData::projectionClusterSHsBufferTexture() const {
+    std::shared_ptr<GLIntegerBufferTexture<GLTexture::Integer::RGBA32UI, CompressedSphericalHarmonics>> DiffuseLightProbeData::projectionClusterSHsBufferTexture() const {
         return mProjectionClusterSHsBufferTexture;
     }
 
-    std::shared_ptr<GLFloatBufferTexture<GLTexture::Float::RGB32F, SphericalHarmonics>> DiffuseLightProbeData::skySHsBufferTexture() const {
+    std::shared_ptr<GLIntegerBufferTexture<GLTexture::Integer::RGBA32UI, CompressedLumaSphericalHarmonics>> DiffuseLightProbeData::skySHsBufferTexture() const {
         return mSkySHsBufferTexture;
     }
 
@@ -13,7 +13,9 @@
 #include "SurfelClusterProjection.hpp"
 #include "GLBufferTexture.hpp"
 #include "SphericalHarmonics.hpp"
+#include "CompressedSphericalHarmonics.hpp"
 #include "GLTexture2D.hpp"
+#include "BakedDataFile.hpp"
 
 #include <vector>
 #include <memory>
@@ -26,22 +28,51 @@ namespace EARenderer {
     private:
         friend DiffuseLightProbeGenerator;
 
+        /// Probe data flattened into arrays consumed by the GPU.
+        /// Projection SHs are YCoCg and get the full compressed layout,
+        /// while sky visibility is the same in all channels and only needs a single one.
+        struct GPULayout {
+            std::vector<CompressedSphericalHarmonics> projectionSHs;
+            std::vector<uint32_t> projectionClusterIndices;
+            std::vector<CompressedLumaSphericalHarmonics> skySHs;
+            std::vector<uint32_t> probeMetadata;
+            std::vector<glm::vec3> probePositions;
+        };
+
         std::vector<DiffuseLightProbe> mProbes;
         std::vector<SurfelClusterProjection> mSurfelClusterProjections;
         glm::ivec3 mGridResolution;
 
-        std::shared_ptr<GLFloatBufferTexture<GLTexture::Float::RGB32F, SphericalHarmonics>> mProjectionClusterSHsBufferTexture;
-        std::shared_ptr<GLFloatBufferTexture<GLTexture::Float::RGB32F, SphericalHarmonics>> mSkySHsBufferTexture;
+        std::shared_ptr<GLIntegerBufferTexture<GLTexture::Integer::RGBA32UI, CompressedSphericalHarmonics>> mProjectionClusterSHsBufferTexture;
+        std::shared_ptr<GLIntegerBufferTexture<GLTexture::Integer::RGBA32UI, CompressedLumaSphericalHarmonics>> mSkySHsBufferTexture;
         std::shared_ptr<GLIntegerBufferTexture<GLTexture::Integer::R32UI, uint32_t>> mProjectionClusterIndicesBufferTexture;
         std::shared_ptr<GLIntegerBufferTexture<GLTexture::Integer::R32UI, uint32_t>> mProbeClusterProjectionsMetadataBufferTexture;
         std::shared_ptr<GLFloatBufferTexture<GLTexture::Float::RGB32F, glm::vec3>> mProbePositionsBufferTexture;
 
+        GPULayout gpuLayout() const;
+
+        void initializeBuffers(const CompressedSphericalHarmonics *projectionSHs, const uint32_t *projectionClusterIndices, size_t projectionCount,
+                const CompressedLumaSphericalHarmonics *skySHs, const uint32_t *probeMetadata, const glm::vec3 *probePositions, size_t probeCount);
+
     public:
         void initializeBuffers();
 
-        void serialize(const std::string &filePath);
+        /**
+         Writes probes into a baked data file
+
+         @param filePath path to the file
+         @param contentHash hash of inputs probes were generated from
+         */
+        void serialize(const std::string &filePath, uint64_t contentHash);
+
+        /**
+         Maps probes from a baked data file. GPU buffers are filled right from the mapping.
 
-        bool deserialize(const std::string &filePath);
+         @param filePath path to the file
+         @param expectedContentHash hash of inputs probes are expected to be generated from
+         @return false if file is missing, corrupt or was generated from different inputs
+         */
+        bool deserialize(const std::string &filePath, uint64_t expectedContentHash);
 
         const std::vector<DiffuseLightProbe> &probes() const;
 
@@ -49,9 +80,9 @@ namespace EARenderer {
 
         const glm::ivec3 &gridResolution() const;
 
-        std::shared_ptr<GLFloatBufferTexture<GLTexture::Float::RGB32F, SphericalHarmonics>> projectionClusterSHsBufferTexture() const;
+        std::shared_ptr<GLIntegerBufferTexture<GLTexture::Integer::RGBA32UI, CompressedSphericalHarmonics>> projectionClusterSHsBufferTexture() const;
 
-        std::shared_ptr<GLFloatBufferTexture<GLTexture::Float::RGB32F, SphericalHarmonics>> skySHsBufferTexture() const;
+        std::shared_ptr<GLIntegerBufferTexture<GLTexture::Integer::RGBA32UI, CompressedLumaSphericalHarmonics>> skySHsBufferTexture() const;
 
         std::shared_ptr<GLIntegerBufferTexture<GLTexture::Integer::R32UI, uint32_t>> projectionClusterIndicesBufferTexture() const;
 
@@ -8,43 +8,47 @@
 
 #include "DiffuseLightProbeGenerator.hpp"
 #include "Measurement.hpp"
+#include "ThreadPool.hpp"
+
+#include <thread>
 
 namespace EARenderer {
 
+#pragma mark - Lifecycle
+
+    DiffuseLightProbeGenerator::DiffuseLightProbeGenerator(const SkySamplingSettings &skySamplingSettings)
+            :
+            mSkySamplingSettings(skySamplingSettings) {
+    }
+
 #pragma mark - Protected
 
-    float DiffuseLightProbeGenerator::surfelSolidAngle(const Surfel &surfel, const DiffuseLightProbe &probe, const Scene &scene) {
-        glm::vec3 Wps = surfel.position - probe.position;
+    float DiffuseLightProbeGenerator::surfelSolidAngle(const glm::vec3 &position, const glm::vec3 &normal, float area, const DiffuseLightProbe &probe) const {
+        glm::vec3 Wps = position - probe.position;
         float distance2 = glm::length2(Wps);
         Wps = glm::normalize(Wps);
 
-        float distanceTerm = std::min(surfel.area / distance2, 1.f);
-
-        float visibilityTerm = std::max(glm::dot(-surfel.normal, Wps), 0.f);
+        float distanceTerm = std::min(area / distance2, 1.f);
 
-        float visibilityTest = 0.0;
+        float visibilityTerm = std::max(glm::dot(-normal, Wps), 0.f);
 
-        // Save ray casts if surfel's facing away from the standpoint
-        if (visibilityTerm > 0.0) {
-            constexpr float p0Offset = 0.01; // Offset line segment points to avoid erroneous collision detections at surfel positions,
-            constexpr float p1Offset = 0.01; // which will happen a lot since the're located exactly on the surface of geometry
-            visibilityTest = scene.rayTracer()->lineSegmentOccluded(probe.position, surfel.position, p0Offset, p1Offset) ? 0.0f : 1.0f;
-        }
-
-        return distanceTerm * visibilityTerm * visibilityTest;
+        return distanceTerm * visibilityTerm;
     }
 
-    SurfelClusterProjection DiffuseLightProbeGenerator::projectSurfelCluster(const SurfelCluster &cluster, const DiffuseLightProbe &probe, const SurfelData& surfelData, const Scene &scene) {
+    SurfelClusterProjection DiffuseLightProbeGenerator::projectSurfelCluster(const SurfelCluster &cluster, const DiffuseLightProbe &probe, const SurfelData& surfelData, const std::vector<float> &solidAngles) const {
         SurfelClusterProjection projection;
 
+        const glm::vec3 *positions = surfelData.positions();
+        const glm::vec3 *albedos = surfelData.albedos();
+
         for (size_t i = cluster.surfelOffset; i < cluster.surfelOffset + cluster.surfelCount; i++) {
-            const Surfel &surfel = surfelData.surfels()[i];
-            glm::vec3 Wps_norm = glm::normalize(surfel.position - probe.position);
-            float solidAngle = surfelSolidAngle(surfel, probe, scene);
+            glm::vec3 Wps_norm = glm::normalize(positions[i] - probe.position);
+            float solidAngle = solidAngles[i];
 
             if (solidAngle > 0.0) {
                 // Accumulating in YCoCg space to enable compression possibilities
-                auto ycocg = surfel.albedo.convertedTo(Color::Space::YCoCg).rgb();
+                const glm::vec3 &albedo = albedos[i];
+                auto ycocg = Color(albedo.r, albedo.g, albedo.b).convertedTo(Color::Space::YCoCg).rgb();
                 projection.sphericalHarmonics.contribute(Wps_norm, ycocg, solidAngle);
             }
         }
@@ -54,56 +58,67 @@ namespace EARenderer {
         return projection;
     }
 
-    void DiffuseLightProbeGenerator::projectSurfelClustersOnProbe(DiffuseLightProbe &probe, const SurfelData& surfelData, const Scene &scene) {
-        probe.surfelClusterProjectionGroupOffset = (uint32_t) mProbeData->mSurfelClusterProjections.size();
+    void DiffuseLightProbeGenerator::projectSurfelClustersOnProbe(DiffuseLightProbe &probe, std::vector<SurfelClusterProjection> &projections, const SurfelData& surfelData, const Scene &scene, VisibilityScratch &scratch) const {
+        probe.surfelClusterProjectionGroupOffset = (uint32_t) projections.size();
+
+        size_t surfelCount = surfelData.surfelCount();
+        const glm::vec3 *positions = surfelData.positions();
+        const glm::vec3 *normals = surfelData.normals();
+        const float *areas = surfelData.areas();
+
+        scratch.solidAngles.assign(surfelCount, 0.0f);
+        scratch.segments.clear();
+        scratch.queriedSurfels.clear();
+
+        for (size_t i = 0; i < surfelCount; i++) {
+            float solidAngle = surfelSolidAngle(positions[i], normals[i], areas[i], probe);
+
+            // Save ray casts if surfel's facing away from the standpoint
+            if (solidAngle > 0.0) {
+                constexpr float p0Offset = 0.01; // Offset line segment points to avoid erroneous collision detections at surfel positions,
+                constexpr float p1Offset = 0.01; // which will happen a lot since the're located exactly on the surface of geometry
+                scratch.segments.addSegment(probe.position, positions[i], p0Offset, p1Offset);
+                scratch.queriedSurfels.push_back(i);
+                scratch.solidAngles[i] = solidAngle;
+            }
+        }
+
+        scene.rayTracer()->raysOccluded(scratch.segments, scratch.occluded);
+
+        for (size_t i = 0; i < scratch.queriedSurfels.size(); i++) {
+            if (scratch.occluded[i]) {
+                scratch.solidAngles[scratch.queriedSurfels[i]] = 0.0f;
+            }
+        }
 
         for (size_t i = 0; i < surfelData.surfelClusters().size(); i++) {
             const SurfelCluster &cluster = surfelData.surfelClusters()[i];
-            SurfelClusterProjection projection = projectSurfelCluster(cluster, probe, surfelData, scene);
+            SurfelClusterProjection projection = projectSurfelCluster(cluster, probe, surfelData, scratch.solidAngles);
 
             // Only accept projections with non-zero SH
             if (projection.sphericalHarmonics.magnitude() > 10e-7) {
                 projection.surfelClusterIndex = (uint32_t) i;
-                mProbeData->mSurfelClusterProjections.push_back(projection);
+                projections.push_back(projection);
                 probe.surfelClusterProjectionGroupSize++;
             }
         }
     }
 
-    void DiffuseLightProbeGenerator::projectSkyOnProbe(DiffuseLightProbe &probe, const Scene &scene) {
-
-        float sampleDelta = 0.025;
-        int32_t iterationCount = 0;
-
-        // Phi - azimuth (horizontal) angle
-        for (float phi = 0.0; phi < M_PI * 2.0; phi += sampleDelta) {
-
-            float sinPhi = sin(phi);
-            float cosPhi = cos(phi);
-
-            // Theta - zenith (vertical) angle
-            for (float theta = 0.0; theta < M_PI; theta += sampleDelta) {
-
-                float sinTheta = sin(theta);
-                float cosTheta = cos(theta);
-
-                glm::vec3 sampleVector(sinTheta * cosPhi, sinTheta * sinPhi, cosTheta);
-
-                float distance = 0;
-                Ray3D sampleRay(probe.position, sampleVector);
-
-                // If sky is visible (not obstructed by geometry) contribute to the spherical harmonics in that direction
-                if (!scene.rayTracer()->rayHit(sampleRay, distance)) {
-                    // Scale by sin(theta) to account for the smaller sample areas in the higher hemisphere areas
-                    probe.skySphericalHarmonics.contribute(sampleVector, glm::vec3(1.0), sinTheta);
-                }
-
-                iterationCount++;
-            }
+    DiffuseLightProbeGenerator::ProbeBatch
+    DiffuseLightProbeGenerator::bakeProbes(const std::vector<glm::vec3> &positions, size_t begin, size_t end, const Scene &scene, const SurfelData& surfelData) const {
+        ProbeBatch batch;
+        batch.probes.reserve(end - begin);
+        VisibilityScratch scratch;
+        SkyVisibilityProjector skyProjector(mSkySamplingSettings.sampleCount);
+
+        for (size_t i = begin; i < end; i++) {
+            DiffuseLightProbe probe(positions[i]);
+            projectSurfelClustersOnProbe(probe, batch.surfelClusterProjections, surfelData, scene, scratch);
+            skyProjector.project(probe.position, *scene.rayTracer(), probe.skySphericalHarmonics);
+            batch.probes.push_back(probe);
         }
 
-        probe.skySphericalHarmonics.scale(glm::vec3(1.0 / iterationCount));
-        probe.skySphericalHarmonics.convolve();
+        return batch;
     }
 
 #pragma mark - Public interface
@@ -116,17 +131,44 @@ namespace EARenderer {
         glm::vec3 resolution = glm::max(glm::vec3(1.0), glm::round(bbLengths / scene.difuseProbesSpacing()));
         glm::vec3 step = bbLengths / (resolution - 1.0f);
 
+        std::vector<glm::vec3> positions;
         for (float z = bb.min.z; z <= bb.max.z + step.z / 2.0; z += step.z) {
             for (float y = bb.min.y; y <= bb.max.y + step.y / 2.0; y += step.y) {
                 for (float x = bb.min.x; x <= bb.max.x + step.x / 2.0; x += step.x) {
-                    DiffuseLightProbe probe({x, y, z});
-                    projectSurfelClustersOnProbe(probe, surfelData, scene);
-                    projectSkyOnProbe(probe, scene);
-                    mProbeData->mProbes.push_back(probe);
+                    positions.emplace_back(x, y, z);
                 }
             }
         }
 
+        // Several batches per thread to even out the cost difference between
+        // probes buried in geometry and probes seeing lots of surfels
+        size_t batchCount = std::min(positions.size(), (size_t) std::max(std::thread::hardware_concurrency(), 1u) * 8);
+        size_t batchSize = batchCount ? (positions.size() + batchCount - 1) / batchCount : 0;
+
+        // Batches trace against the same ray tracer concurrently, which relies on queries keeping no state in it
+        std::vector<ThreadPool::TaskFuture<ProbeBatch>> futures;
+        for (size_t begin = 0; begin < positions.size(); begin += batchSize) {
+            size_t end = std::min(begin + batchSize, positions.size());
+            futures.emplace_back(ThreadPool::Default().submit([this, &positions, &scene, &surfelData, begin, end]() {
+                return bakeProbes(positions, begin, end, scene, surfelData);
+            }));
+        }
+
+        // Merge in submission order, so the output is identical to a serial bake
+        mProbeData->mProbes.reserve(positions.size());
+        for (auto &future : futures) {
+            ProbeBatch batch = future.get();
+            uint32_t projectionOffset = (uint32_t) mProbeData->mSurfelClusterProjections.size();
+
+            for (auto &probe : batch.probes) {
+                probe.surfelClusterProjectionGroupOffset += projectionOffset;
+                mProbeData->mProbes.push_back(probe);
+            }
+
+            mProbeData->mSurfelClusterProjections.insert(mProbeData->mSurfelClusterProjections.end(),
+                    batch.surfelClusterProjections.begin(), batch.surfelClusterProjections.end());
+        }
+
         mProbeData->mGridResolution = resolution;
         mProbeData->initializeBuffers();
 
@@ -12,25 +12,76 @@
 #include "Scene.hpp"
 #include "DiffuseLightProbeData.hpp"
 #include "SurfelData.hpp"
+#include "SkyVisibilityProjector.hpp"
 
 #include <memory>
+#include <vector>
 #include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
 
 namespace EARenderer {
 
     class DiffuseLightProbeGenerator {
+    public:
+        struct SkySamplingSettings {
+            /// Number of sky visibility rays traced per probe. Rounded up to a power of two
+            /// (and no less than one ray packet), which Hammersley point set needs to cover the whole sphere.
+            size_t sampleCount = 2048;
+        };
+
     private:
+        // Scratch output of a single baking task.
+        // Projection group offsets of probes are relative to the task's own projection array.
+        struct ProbeBatch {
+            std::vector<DiffuseLightProbe> probes;
+            std::vector<SurfelClusterProjection> surfelClusterProjections;
+        };
+
+        struct VisibilityScratch {
+            EmbreeRayTracer::RayBatch segments;
+            std::vector<bool> occluded;
+            std::vector<size_t> queriedSurfels;
+            std::vector<float> solidAngles;
+        };
+
+        SkySamplingSettings mSkySamplingSettings;
         std::unique_ptr<DiffuseLightProbeData> mProbeData;
 
-        float surfelSolidAngle(const Surfel &surfel, const DiffuseLightProbe &probe, const Scene &scene);
+        /**
+         Solid angle subtended by a surfel as seen from the probe, not accounting for occlusion
+
+         @return Solid angle or 0 if surfel is facing away from the probe
+         */
+        float surfelSolidAngle(const glm::vec3 &position, const glm::vec3 &normal, float area, const DiffuseLightProbe &probe) const;
 
-        SurfelClusterProjection projectSurfelCluster(const SurfelCluster &cluster, const DiffuseLightProbe &probe, const SurfelData& surfelData, const Scene &scene);
+        SurfelClusterProjection projectSurfelCluster(const SurfelCluster &cluster, const DiffuseLightProbe &probe, const SurfelData& surfelData, const std::vector<float> &solidAngles) const;
 
-        void projectSurfelClustersOnProbe(DiffuseLightProbe &probe, const SurfelData& surfelData, const Scene &scene);
+        /**
+         Projects all surfel clusters visible from the probe.
+         Visibility of every surfel facing the probe is resolved up front with a single batched ray query.
 
-        void projectSkyOnProbe(DiffuseLightProbe &probe, const Scene &scene);
+         @param probe Probe receiving the projections
+         @param projections Array receiving non-zero projections
+         @param scratch Reusable per-thread storage
+         */
+        void projectSurfelClustersOnProbe(DiffuseLightProbe &probe, std::vector<SurfelClusterProjection> &projections, const SurfelData& surfelData, const Scene &scene, VisibilityScratch &scratch) const;
+
+        /**
+         Bakes a contiguous range of probes. Safe to be called from multiple threads at once,
+         since the scene's ray tracer carries face filters in a per-query context rather than in shared state.
+
+         @param positions Positions of all probes in the grid
+         @param begin Index of the first probe in the range
+         @param end Index past the last probe in the range
+         @return Baked probes along with their surfel cluster projections
+         */
+        ProbeBatch bakeProbes(const std::vector<glm::vec3> &positions, size_t begin, size_t end, const Scene &scene, const SurfelData& surfelData) const;
 
     public:
+        DiffuseLightProbeGenerator() = default;
+
+        DiffuseLightProbeGenerator(const SkySamplingSettings &skySamplingSettings);
+
         std::unique_ptr<DiffuseLightProbeData> generateProbes(const Scene &scene, const SurfelData& surfelData);
     };
 
@@ -0,0 +1,74 @@
+//
+//  SkyVisibilityProjector.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "SkyVisibilityProjector.hpp"
+#include "LowDiscrepancySequence.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace EARenderer {
+
+#pragma mark - Lifecycle
+
+    SkyVisibilityProjector::SkyVisibilityProjector(size_t sampleCount)
+            :
+            mSampleCount(EmbreeRayTracer::PacketSize) {
+        while (mSampleCount < sampleCount) {
+            mSampleCount *= 2;
+        }
+    }
+
+#pragma mark - Getters
+
+    size_t SkyVisibilityProjector::sampleCount() const {
+        return mSampleCount;
+    }
+
+#pragma mark - Public interface
+
+    float SkyVisibilityProjector::project(const glm::vec3 &position, const EmbreeRayTracer &rayTracer, SphericalHarmonics &sphericalHarmonics) const {
+        std::array<glm::vec3, EmbreeRayTracer::PacketSize> directions;
+        size_t visibleSampleCount = 0;
+
+        for (size_t packetStart = 0; packetStart < mSampleCount; packetStart += EmbreeRayTracer::PacketSize) {
+            size_t rayCount = std::min(EmbreeRayTracer::PacketSize, mSampleCount - packetStart);
+
+            for (size_t i = 0; i < rayCount; i++) {
+                // Uniform mapping of the unit square onto the sphere
+                glm::vec2 sample = LowDiscrepancySequence::Hammersley2D(packetStart + i, mSampleCount);
+                float cosTheta = 1.0f - 2.0f * sample.x;
+                float sinTheta = std::sqrt(std::max(0.0f, 1.0f - cosTheta * cosTheta));
+                float phi = 2.0f * M_PI * sample.y;
+                directions[i] = glm::vec3(sinTheta * cos(phi), sinTheta * sin(phi), cosTheta);
+            }
+
+            EmbreeRayTracer::PacketMask occluded = rayTracer.raysOccluded(position, directions, rayCount);
+
+            for (size_t i = 0; i < rayCount; i++) {
+                // If sky is visible (not obstructed by geometry) contribute to the spherical harmonics in that direction
+                if (!occluded[i]) {
+                    sphericalHarmonics.contribute(directions[i], glm::vec3(1.0), 1.0f);
+                    visibleSampleCount++;
+                }
+            }
+        }
+
+        // Samples are distributed uniformly over the sphere (pdf = 1 / 4pi).
+        // The 1 / 2pi^2 factor keeps the scale of the former angular grid integration.
+        sphericalHarmonics.scale(glm::vec3(2.0 / (M_PI * mSampleCount)));
+        sphericalHarmonics.convolve();
+
+        return float(visibleSampleCount) / mSampleCount;
+    }
+
+    float SkyVisibilityProjector::standardError(float visibleFraction) const {
+        return std::sqrt(visibleFraction * (1.0f - visibleFraction) / mSampleCount);
+    }
+
+}
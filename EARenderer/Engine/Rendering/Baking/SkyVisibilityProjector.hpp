@@ -0,0 +1,58 @@
+//
+//  SkyVisibilityProjector.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef SkyVisibilityProjector_hpp
+#define SkyVisibilityProjector_hpp
+
+#include "EmbreeRayTracer.hpp"
+#include "SphericalHarmonics.hpp"
+
+#include <glm/vec3.hpp>
+
+namespace EARenderer {
+
+    /**
+     Projects sky visibility onto spherical harmonics using a Hammersley point set on the sphere.
+     Rays are traced in packets, since all of them share the projection point as origin.
+     */
+    class SkyVisibilityProjector {
+    private:
+        size_t mSampleCount;
+
+    public:
+        /**
+         @param sampleCount Number of sky visibility rays traced per projection. Rounded up to a power of two
+         (and no less than one ray packet), which Hammersley point set needs to cover the whole sphere.
+         */
+        SkyVisibilityProjector(size_t sampleCount);
+
+        size_t sampleCount() const;
+
+        /**
+         Projected visibility is scaled the same way as the former angular grid integration,
+         which divided the sin(theta) weighted sum by the sample count, and convolved with the cosine lobe.
+
+         @param position Point the sky is seen from
+         @param rayTracer Ray tracer of the occluding geometry
+         @param sphericalHarmonics Spherical harmonics receiving the projection
+         @return Fraction of the sky visible from the position
+         */
+        float project(const glm::vec3 &position, const EmbreeRayTracer &rayTracer, SphericalHarmonics &sphericalHarmonics) const;
+
+        /**
+         Monte Carlo estimate. Hammersley points converge faster, so it's an upper bound in practice.
+
+         @param visibleFraction Fraction of the sky returned by project()
+         @return Standard error of the visible sky fraction
+         */
+        float standardError(float visibleFraction) const;
+    };
+
+}
+
+#endif /* SkyVisibilityProjector_hpp */
@@ -0,0 +1,206 @@
+//
+//  SurfelClusterBuilder.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "SurfelClusterBuilder.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <glm/common.hpp>
+#include <glm/vector_relational.hpp>
+#include <glm/gtx/norm.hpp>
+
+namespace EARenderer {
+
+#pragma mark - Lifecycle
+
+    SurfelClusterBuilder::SurfelClusterBuilder(const EmbreeRayTracer *rayTracer, const AxisAlignedBox3D &workingVolume, float surfelSpacing, size_t maximumClusterSize)
+            :
+            mRayTracer(rayTracer),
+            mWorkingVolume(workingVolume),
+            mMaximumClusterSize(std::max(maximumClusterSize, (size_t) 1)) {
+        float extent = workingVolume.largestDimensionLength();
+        mWorkingVolumeMaximumExtent2 = extent * extent;
+
+        // Surfels lie on surfaces, so a cell crossed by a plane holds roughly (cellSize / spacing)^2 of them.
+        // Aim for a quarter of a full cluster per cell.
+        mCellSize = surfelSpacing * std::sqrt((float) mMaximumClusterSize) / 2.0f;
+        // Cell coordinates are packed in 16 bits per axis
+        mCellSize = std::max(mCellSize, extent / std::numeric_limits<uint16_t>::max());
+
+        // No surfel outside of this ring can pass the distance criterion
+        float maximumDistance = std::sqrt(Cb * mWorkingVolumeMaximumExtent2);
+        mMaximumRing = mCellSize > 0.0f ? (int32_t) std::ceil(maximumDistance / mCellSize) : 0;
+    }
+
+#pragma mark - Private helpers
+
+    glm::ivec3 SurfelClusterBuilder::cell(const glm::vec3 &position) const {
+        if (mCellSize <= 0.0f) {
+            return glm::ivec3(0);
+        }
+        return glm::ivec3(glm::floor((position - mWorkingVolume.min) / mCellSize));
+    }
+
+    uint64_t SurfelClusterBuilder::CellHash(const glm::ivec3 &cell) {
+        uint64_t hash = 0;
+        hash |= (uint64_t) (cell.x & 0xFFFF);
+        hash |= (uint64_t) (cell.y & 0xFFFF) << 16;
+        hash |= (uint64_t) (cell.z & 0xFFFF) << 32;
+        return hash;
+    }
+
+    void SurfelClusterBuilder::bucketSurfels(const std::vector<Surfel> &surfels) {
+        mCells.clear();
+        // Indices are pushed in ascending order and stay sorted within every cell
+        for (uint32_t i = 0; i < surfels.size(); i++) {
+            mCells[CellHash(cell(surfels[i].position))].push_back(i);
+        }
+    }
+
+    void SurfelClusterBuilder::gatherRing(const glm::ivec3 &center, int32_t ring, const std::vector<bool> &clustered, std::vector<uint32_t> &candidates) {
+        auto gatherCell = [&](const glm::ivec3 &offset) {
+            glm::ivec3 c = center + offset;
+            if (glm::any(glm::lessThan(c, glm::ivec3(0))) || glm::any(glm::greaterThan(c, glm::ivec3(0xFFFF)))) {
+                return;
+            }
+
+            auto it = mCells.find(CellHash(c));
+            if (it == mCells.end()) {
+                return;
+            }
+
+            auto &indices = it->second;
+            indices.erase(std::remove_if(indices.begin(), indices.end(), [&](uint32_t i) { return clustered[i]; }), indices.end());
+
+            if (indices.empty()) {
+                mCells.erase(it);
+                return;
+            }
+
+            candidates.insert(candidates.end(), indices.begin(), indices.end());
+        };
+
+        if (ring == 0) {
+            gatherCell(glm::ivec3(0));
+            return;
+        }
+
+        // Visit only the shell of the (2 * ring + 1)^3 block
+        for (int32_t x = -ring; x <= ring; x++) {
+            for (int32_t y = -ring; y <= ring; y++) {
+                if (std::abs(x) == ring || std::abs(y) == ring) {
+                    for (int32_t z = -ring; z <= ring; z++) {
+                        gatherCell({x, y, z});
+                    }
+                } else {
+                    gatherCell({x, y, -ring});
+                    gatherCell({x, y, ring});
+                }
+            }
+        }
+    }
+
+    bool SurfelClusterBuilder::surfelsAlike(const Surfel &first, const Surfel &second) const {
+        float normDistance2 = glm::length2(first.position - second.position) / mWorkingVolumeMaximumExtent2;
+        float normalDeviation = glm::dot(first.normal, second.normal);
+        return normDistance2 <= Cb && normalDeviation > Cn;
+    }
+
+    bool SurfelClusterBuilder::candidateFitsCluster(uint32_t candidate, const std::vector<uint32_t> &members, const std::vector<Surfel> &surfels) {
+        const Surfel &candidateSurfel = surfels[candidate];
+
+        for (uint32_t member : members) {
+            if (!surfelsAlike(surfels[member], candidateSurfel)) {
+                return false;
+            }
+        }
+
+        float offset = mWorkingVolumeMaximumExtent2 * 0.001f;
+        glm::vec3 offsetEnd = candidateSurfel.position + candidateSurfel.normal * offset;
+
+        mVisibilityQueries.clear();
+        for (uint32_t member : members) {
+            const Surfel &memberSurfel = surfels[member];
+            mVisibilityQueries.addSegment(memberSurfel.position + memberSurfel.normal * offset, offsetEnd);
+        }
+
+        mRayTracer->raysOccluded(mVisibilityQueries, mOcclusionResults);
+
+        return std::none_of(mOcclusionResults.begin(), mOcclusionResults.end(), [](bool occluded) { return occluded; });
+    }
+
+#pragma mark - Building
+
+    SurfelClusterBuilder::Result SurfelClusterBuilder::build(const std::vector<Surfel> &surfels) {
+        Result result;
+        result.surfels.reserve(surfels.size());
+
+        bucketSurfels(surfels);
+
+        std::vector<bool> clustered(surfels.size(), false);
+        std::vector<uint32_t> members;
+        std::vector<uint32_t> candidates;
+
+        for (uint32_t seed = 0; seed < surfels.size(); seed++) {
+            if (clustered[seed]) {
+                continue;
+            }
+
+            members.clear();
+            members.push_back(seed);
+            clustered[seed] = true;
+
+            glm::ivec3 seedCell = cell(surfels[seed].position);
+
+            int32_t fruitlessRingCount = 0;
+
+            for (int32_t ring = 0; ring <= mMaximumRing && members.size() < mMaximumClusterSize; ring++) {
+                if (fruitlessRingCount == MaximumFruitlessRingCount) {
+                    break;
+                }
+
+                size_t previousMemberCount = members.size();
+
+                candidates.clear();
+                gatherRing(seedCell, ring, clustered, candidates);
+
+                // Visit candidates in their original order to keep the result deterministic
+                std::sort(candidates.begin(), candidates.end());
+
+                for (uint32_t candidate : candidates) {
+                    if (members.size() == mMaximumClusterSize) {
+                        break;
+                    }
+
+                    if (candidateFitsCluster(candidate, members, surfels)) {
+                        members.push_back(candidate);
+                        clustered[candidate] = true;
+                    }
+                }
+
+                fruitlessRingCount = members.size() > previousMemberCount ? 0 : fruitlessRingCount + 1;
+            }
+
+            SurfelCluster cluster(result.surfels.size(), members.size());
+            cluster.center = surfels[seed].position;
+
+            for (uint32_t member : members) {
+                result.surfels.push_back(surfels[member]);
+            }
+
+            result.clusters.push_back(cluster);
+        }
+
+        mCells.clear();
+
+        return result;
+    }
+
+}
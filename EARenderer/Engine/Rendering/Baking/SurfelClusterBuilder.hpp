@@ -0,0 +1,116 @@
+//
+//  SurfelClusterBuilder.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef SurfelClusterBuilder_hpp
+#define SurfelClusterBuilder_hpp
+
+#include "Surfel.hpp"
+#include "SurfelCluster.hpp"
+#include "AxisAlignedBox3D.hpp"
+#include "EmbreeRayTracer.hpp"
+
+#include <vector>
+#include <unordered_map>
+#include <glm/vec3.hpp>
+
+namespace EARenderer {
+
+    /// Gathers similar surfels into clusters.
+    /// Surfels are bucketed into a sparse uniform grid beforehand and every cluster is grown
+    /// ring by ring from the cell of its first surfel, so that only surfels in the vicinity
+    /// of a cluster are ever tested against it.
+    /// Growth stops once the cluster is full, no farther ring can pass the distance criterion,
+    /// or a couple of rings in a row brought no new members: surfels are spread over surfaces without gaps
+    /// wider than a cell, so a cluster that stopped growing is walled off or has run out of alike surfels.
+    /// Clusters may therefore miss the odd distant surfel that testing every remaining surfel would have added.
+    class SurfelClusterBuilder {
+    public:
+
+#pragma mark - Nested types
+
+        struct Result {
+            /// Surfels reordered so that every cluster references a contiguous range
+            std::vector<Surfel> surfels;
+            std::vector<SurfelCluster> clusters;
+        };
+
+    private:
+
+#pragma mark - Member variables
+
+        // Normal deviation and normalized squared distance thresholds
+        static constexpr float Cn = -0.3f;
+        static constexpr float Cb = 0.04f;
+
+        // Rings in a row that added nothing to a cluster before its growth is stopped
+        static constexpr int32_t MaximumFruitlessRingCount = 2;
+
+        const EmbreeRayTracer *mRayTracer = nullptr;
+        AxisAlignedBox3D mWorkingVolume;
+        float mWorkingVolumeMaximumExtent2;
+        float mCellSize;
+        int32_t mMaximumRing;
+        size_t mMaximumClusterSize;
+
+        std::unordered_map<uint64_t, std::vector<uint32_t>> mCells;
+
+        EmbreeRayTracer::RayBatch mVisibilityQueries;
+        std::vector<bool> mOcclusionResults;
+
+#pragma mark - Private helpers
+
+        glm::ivec3 cell(const glm::vec3 &position) const;
+
+        static uint64_t CellHash(const glm::ivec3 &cell);
+
+        void bucketSurfels(const std::vector<Surfel> &surfels);
+
+        /**
+         Collects not yet clustered surfels located in cells at exactly 'ring' Chebyshev distance from the center cell.
+         Entries of already clustered surfels are removed from visited cells along the way.
+
+         @param center cell of the first surfel of a cluster
+         @param ring distance from the center cell, measured in cells
+         @param clustered flags of surfels that already belong to a cluster
+         @param candidates output array receiving surfel indices
+         */
+        void gatherRing(const glm::ivec3 &center, int32_t ring, const std::vector<bool> &clustered, std::vector<uint32_t> &candidates);
+
+        /**
+         Cheap part of the similarity test: distance and normal deviation
+
+         @return true if the two surfels are close enough and oriented alike
+         */
+        bool surfelsAlike(const Surfel &first, const Surfel &second) const;
+
+        /**
+         Checks the candidate against every surfel of the cluster.
+         Occlusion rays are only traced after the candidate passed the cheap tests against all members,
+         and then all at once as a single batch.
+
+         @param candidate index of surfel wishing to join the cluster
+         @param members indices of surfels already in the cluster
+         @param surfels all surfels
+         @return true if candidate is alike to and visible from all cluster members
+         */
+        bool candidateFitsCluster(uint32_t candidate, const std::vector<uint32_t> &members, const std::vector<Surfel> &surfels);
+
+    public:
+
+#pragma mark - Lifecycle
+
+        SurfelClusterBuilder(const EmbreeRayTracer *rayTracer, const AxisAlignedBox3D &workingVolume, float surfelSpacing, size_t maximumClusterSize);
+
+#pragma mark - Building
+
+        Result build(const std::vector<Surfel> &surfels);
+    };
+
+}
+
+#endif /* SurfelClusterBuilder_hpp */
@@ -8,33 +8,128 @@
 
 #include "SurfelData.hpp"
 #include "StringUtils.hpp"
+#include "Measurement.hpp"
+#include "OctahedralEncoding.hpp"
+#include "CRC32.hpp"
 
-#include <bitsery/bitsery.h>
-#include <bitsery/traits/vector.h>
-#include <bitsery/adapter/stream.h>
-#include <fstream>
+#include <limits>
+
+#include <glm/gtc/packing.hpp>
 
 namespace EARenderer {
 
-#pragma mark - Data
+    struct SurfelFileMetadata {
+        uint32_t surfelCount;
+        uint32_t quantization;
+        // Bounds of surfel positions, which compact positions are normalized to
+        glm::vec3 positionsMin;
+        glm::vec3 positionsMax;
+    };
 
-    void SurfelData::initializeBuffers() {
-        std::vector<std::vector<glm::vec3>> surfelGBufferData;
-        surfelGBufferData.emplace_back();
-        surfelGBufferData.emplace_back();
-        surfelGBufferData.emplace_back();
-
-        for (auto &surfel : mSurfels) {
-            surfelGBufferData[0].emplace_back(surfel.position);
-            surfelGBufferData[1].emplace_back(surfel.normal);
-            surfelGBufferData[2].emplace_back(surfel.albedo.rgb());
+    static constexpr uint32_t MetadataSectionTag = ctcrc32("surfels.metadata");
+    static constexpr uint32_t PositionsSectionTag = ctcrc32("surfels.positions");
+    static constexpr uint32_t NormalsSectionTag = ctcrc32("surfels.normals");
+    static constexpr uint32_t AlbedosSectionTag = ctcrc32("surfels.albedos");
+    static constexpr uint32_t AreasSectionTag = ctcrc32("surfels.areas");
+    static constexpr uint32_t ClustersSectionTag = ctcrc32("surfels.clusters");
+
+#pragma mark - Private helpers
+
+    void SurfelData::resizeColumns(size_t surfelCount) {
+        Size2D gBufferSize = GLTexture::EstimatedSize(surfelCount);
+        size_t paddedCount = gBufferSize.width * gBufferSize.height;
+
+        mSurfelCount = surfelCount;
+        mPositions.assign(paddedCount, glm::vec3(0.0f));
+        mNormals.assign(paddedCount, glm::vec3(0.0f));
+        mAlbedos.assign(paddedCount, glm::vec3(0.0f));
+        mAreas.assign(paddedCount, 0.0f);
+
+        pointColumnsToStorage();
+    }
+
+    void SurfelData::pointColumnsToStorage() {
+        mBakedDataFile = nullptr;
+        mPositionsColumn = mPositions.data();
+        mNormalsColumn = mNormals.data();
+        mAlbedosColumn = mAlbedos.data();
+        mAreasColumn = mAreas.data();
+    }
+
+    void SurfelData::setSurfels(const std::vector<Surfel> &surfels) {
+        resizeColumns(surfels.size());
+
+        for (size_t i = 0; i < surfels.size(); i++) {
+            mPositions[i] = surfels[i].position;
+            mNormals[i] = surfels[i].normal;
+            mAlbedos[i] = surfels[i].albedo.rgb();
+            mAreas[i] = surfels[i].area;
+        }
+    }
+
+    bool SurfelData::readColumns(const BakedDataFile &file, size_t surfelCount, const AxisAlignedBox3D &positionBounds) {
+        auto positions = file.section(PositionsSectionTag);
+        auto normals = file.section(NormalsSectionTag);
+        auto albedos = file.section(AlbedosSectionTag);
+        auto areas = file.section(AreasSectionTag);
+
+        if (mQuantization == Quantization::None) {
+            Size2D gBufferSize = GLTexture::EstimatedSize(surfelCount);
+            size_t paddedCount = gBufferSize.width * gBufferSize.height;
+
+            if (positions.count<glm::vec3>() != paddedCount || normals.count<glm::vec3>() != paddedCount ||
+                    albedos.count<glm::vec3>() != paddedCount || areas.count<float>() != surfelCount) {
+                return false;
+            }
+
+            // No decoding required, columns are used right from the mapping
+            mSurfelCount = surfelCount;
+            mPositions.clear();
+            mNormals.clear();
+            mAlbedos.clear();
+            mAreas.clear();
+            mPositionsColumn = positions.objects<glm::vec3>();
+            mNormalsColumn = normals.objects<glm::vec3>();
+            mAlbedosColumn = albedos.objects<glm::vec3>();
+            mAreasColumn = areas.objects<float>();
+
+            return true;
+        }
+
+        if (positions.count<uint16_t>() != surfelCount * 3 || areas.count<uint16_t>() != surfelCount ||
+                normals.count<uint32_t>() != surfelCount || albedos.count<uint32_t>() != surfelCount) {
+            return false;
+        }
+
+        resizeColumns(surfelCount);
+
+        const uint16_t *normalizedPositions = positions.objects<uint16_t>();
+        const uint16_t *halfAreas = areas.objects<uint16_t>();
+        const uint32_t *packedNormals = normals.objects<uint32_t>();
+        const uint32_t *packedAlbedos = albedos.objects<uint32_t>();
+
+        for (size_t i = 0; i < surfelCount; i++) {
+            glm::vec3 normalized(glm::unpackUnorm1x16(normalizedPositions[i * 3 + 0]),
+                    glm::unpackUnorm1x16(normalizedPositions[i * 3 + 1]),
+                    glm::unpackUnorm1x16(normalizedPositions[i * 3 + 2]));
+            mPositions[i] = positionBounds.min + normalized * (positionBounds.max - positionBounds.min);
+            mAreas[i] = glm::unpackHalf1x16(halfAreas[i]);
+            mNormals[i] = OctahedralEncoding::Decode(glm::unpackSnorm2x16(packedNormals[i]));
+            mAlbedos[i] = glm::vec3(glm::unpackUnorm4x8(packedAlbedos[i]));
         }
 
+        return true;
+    }
+
+#pragma mark - Data
+
+    void SurfelData::initializeBuffers() {
         std::vector<uint32_t> surfelClusterGBufferData;
         for (auto &cluster : mSurfelClusters) {
             uint32_t encoded = 0;
             encoded |= cluster.surfelOffset << 8;
-            encoded |= cluster.surfelCount & 0xFF;
+            // Clusters are never empty, storing count - 1 lets 8 bits cover 256 surfels
+            encoded |= (cluster.surfelCount - 1) & 0xFF;
             surfelClusterGBufferData.push_back(encoded);
         }
 
@@ -43,51 +138,163 @@ namespace EARenderer {
             clusterCenters.push_back(cluster.center);
         }
 
-        auto surfelGBufferSize = GLTexture::EstimatedSize(surfelGBufferData.back().size());
-        std::vector<const void *> surfelGbufferPointers{surfelGBufferData[0].data(), surfelGBufferData[1].data(), surfelGBufferData[2].data()};
-        mSurfelsGBuffer = std::make_shared<GLFloatTexture2DArray<GLTexture::Float::RGB32F>>(surfelGBufferSize, 3, surfelGbufferPointers, Sampling::Filter::None);
+        // Columns are already padded to the G-buffer size, no repacking required
+        Measurement::ExecutionTime(string_format("Uploading %zu surfels (%zu KB) took", mSurfelCount, memoryFootprint() / 1024), [&]() {
+            auto surfelGBufferSize = GLTexture::EstimatedSize(mSurfelCount);
+            std::vector<const void *> surfelGbufferPointers{mPositionsColumn, mNormalsColumn, mAlbedosColumn};
+            mSurfelsGBuffer = std::make_shared<GLFloatTexture2DArray<GLTexture::Float::RGB32F>>(surfelGBufferSize, 3, surfelGbufferPointers, Sampling::Filter::None);
+        });
 
         auto clusterGBufferSize = GLTexture::EstimatedSize(surfelClusterGBufferData.size());
+        surfelClusterGBufferData.resize(clusterGBufferSize.width * clusterGBufferSize.height, 0);
         mSurfelClustersGBuffer = std::make_shared<GLIntegerTexture2D<GLTexture::Integer::R32UI>>(clusterGBufferSize, surfelClusterGBufferData.data());
 
         mSurfelClusterCentersBufferTexture = std::make_shared<GLFloatBufferTexture<GLTexture::Float::RGB32F, glm::vec3>>(clusterCenters.data(), clusterCenters.size());
     }
 
-    void SurfelData::serialize(const std::string &filePath) {
-        std::ofstream stream(filePath, std::ios::trunc | std::ios::binary);
-        if (!stream.is_open()) {
-            throw std::runtime_error(string_format("Unable to serialize surfels: %s", filePath.c_str()));
+    void SurfelData::serialize(const std::string &filePath, uint64_t contentHash) {
+        BakedDataFile::Writer writer;
+
+        AxisAlignedBox3D positionBounds = mSurfelCount ? AxisAlignedBox3D::MaximumReversed() : AxisAlignedBox3D::Zero();
+        for (size_t i = 0; i < mSurfelCount; i++) {
+            positionBounds.min = glm::min(positionBounds.min, mPositionsColumn[i]);
+            positionBounds.max = glm::max(positionBounds.max, mPositionsColumn[i]);
         }
 
-        bitsery::Serializer<bitsery::OutputBufferedStreamAdapter> serializer(stream);
-        serializer.container(mSurfels, mSurfels.size());
-        serializer.container(mSurfelClusters, mSurfelClusters.size());
-        bitsery::AdapterAccess::getWriter(serializer).flush();
-    }
+        SurfelFileMetadata metadata{(uint32_t) mSurfelCount, (uint32_t) mQuantization, positionBounds.min, positionBounds.max};
+        writer.addSection(MetadataSectionTag, &metadata, sizeof(metadata));
 
-    bool SurfelData::deserialize(const std::string &filePath) {
-        std::ifstream stream(filePath);
-        if (!stream.is_open()) {
-            return false;
+        // Quantized arrays have to outlive the writer
+        std::vector<uint16_t> normalizedPositions;
+        std::vector<uint16_t> halfAreas;
+        std::vector<uint32_t> normals;
+        std::vector<uint32_t> albedos;
+
+        if (mQuantization == Quantization::Compact) {
+            normalizedPositions.resize(mSurfelCount * 3);
+
+            // Flat bounds (surfels lying in a plane parallel to an axis) would make normalization divide by zero
+            glm::vec3 extent = glm::max(positionBounds.max - positionBounds.min, glm::vec3(std::numeric_limits<float>::min()));
+            halfAreas.resize(mSurfelCount);
+            normals.resize(mSurfelCount);
+            albedos.resize(mSurfelCount);
+
+            for (size_t i = 0; i < mSurfelCount; i++) {
+                glm::vec3 normalized = (mPositionsColumn[i] - positionBounds.min) / extent;
+                normalizedPositions[i * 3 + 0] = glm::packUnorm1x16(normalized.x);
+                normalizedPositions[i * 3 + 1] = glm::packUnorm1x16(normalized.y);
+                normalizedPositions[i * 3 + 2] = glm::packUnorm1x16(normalized.z);
+                halfAreas[i] = glm::packHalf1x16(mAreasColumn[i]);
+                normals[i] = glm::packSnorm2x16(OctahedralEncoding::Encode(mNormalsColumn[i]));
+                albedos[i] = glm::packUnorm4x8(glm::vec4(glm::clamp(mAlbedosColumn[i], 0.0f, 1.0f), 1.0f));
+            }
+
+            writer.addSection(PositionsSectionTag, normalizedPositions);
+            writer.addSection(NormalsSectionTag, normals);
+            writer.addSection(AlbedosSectionTag, albedos);
+            writer.addSection(AreasSectionTag, halfAreas);
+        } else {
+            // Padding is written as well, so that columns can be uploaded to the GPU right from the mapped file
+            Size2D gBufferSize = GLTexture::EstimatedSize(mSurfelCount);
+            size_t paddedSize = gBufferSize.width * gBufferSize.height * sizeof(glm::vec3);
+
+            writer.addSection(PositionsSectionTag, mPositionsColumn, paddedSize);
+            writer.addSection(NormalsSectionTag, mNormalsColumn, paddedSize);
+            writer.addSection(AlbedosSectionTag, mAlbedosColumn, paddedSize);
+            writer.addSection(AreasSectionTag, mAreasColumn, mSurfelCount * sizeof(float));
         }
 
-        bitsery::Deserializer<bitsery::InputStreamAdapter> deserializer(stream);
-        deserializer.container(mSurfels, std::numeric_limits<uint32_t>::max());
-        deserializer.container(mSurfelClusters, std::numeric_limits<uint32_t>::max());
+        writer.addSection(ClustersSectionTag, mSurfelClusters);
+        writer.write(filePath, contentHash);
+    }
+
+    bool SurfelData::deserialize(const std::string &filePath, uint64_t expectedContentHash) {
+        std::unique_ptr<BakedDataFile> file;
+
+        try {
+            file = std::make_unique<BakedDataFile>(filePath);
+
+            if (file->contentHash() != expectedContentHash) {
+                return false;
+            }
 
-        auto &reader = bitsery::AdapterAccess::getReader(deserializer);
+            auto metadataSection = file->section(MetadataSectionTag);
+            auto clustersSection = file->section(ClustersSectionTag);
 
-        if (reader.isCompletedSuccessfully()) {
-            initializeBuffers();
+            if (metadataSection.size != sizeof(SurfelFileMetadata)) {
+                return false;
+            }
+
+            SurfelFileMetadata metadata = *metadataSection.objects<SurfelFileMetadata>();
+            if (metadata.quantization > (uint32_t) Quantization::Compact) {
+                return false;
+            }
+
+            mQuantization = (Quantization) metadata.quantization;
+
+            if (!readColumns(*file, metadata.surfelCount, AxisAlignedBox3D(metadata.positionsMin, metadata.positionsMax))) {
+                return false;
+            }
+
+            const SurfelCluster *clusters = clustersSection.objects<SurfelCluster>();
+            mSurfelClusters.assign(clusters, clusters + clustersSection.count<SurfelCluster>());
+        } catch (const std::exception &) {
+            resizeColumns(0);
+            mSurfelClusters.clear();
+            return false;
+        }
+
+        // Unquantized columns keep referencing the mapping
+        if (mQuantization == Quantization::None) {
+            mBakedDataFile = std::move(file);
         }
 
-        return reader.isCompletedSuccessfully();
+        initializeBuffers();
+
+        return true;
     }
 
 #pragma mark - Getters
 
-    const std::vector<Surfel> &SurfelData::surfels() const {
-        return mSurfels;
+    SurfelData::Quantization SurfelData::quantization() const {
+        return mQuantization;
+    }
+
+    void SurfelData::setQuantization(Quantization quantization) {
+        mQuantization = quantization;
+    }
+
+    size_t SurfelData::surfelCount() const {
+        return mSurfelCount;
+    }
+
+    const glm::vec3 *SurfelData::positions() const {
+        return mPositionsColumn;
+    }
+
+    const glm::vec3 *SurfelData::normals() const {
+        return mNormalsColumn;
+    }
+
+    const glm::vec3 *SurfelData::albedos() const {
+        return mAlbedosColumn;
+    }
+
+    const float *SurfelData::areas() const {
+        return mAreasColumn;
+    }
+
+    Surfel SurfelData::surfel(size_t index) const {
+        const glm::vec3 &albedo = mAlbedosColumn[index];
+        return Surfel(mPositionsColumn[index], mNormalsColumn[index], Color(albedo.r, albedo.g, albedo.b), mAreasColumn[index]);
+    }
+
+    size_t SurfelData::memoryFootprint() const {
+        return mPositions.capacity() * sizeof(glm::vec3) +
+                mNormals.capacity() * sizeof(glm::vec3) +
+                mAlbedos.capacity() * sizeof(glm::vec3) +
+                mAreas.capacity() * sizeof(float) +
+                mSurfelClusters.capacity() * sizeof(SurfelCluster);
     }
 
     const std::vector<SurfelCluster> &SurfelData::surfelClusters() const {
@@ -14,6 +14,8 @@
 #include "GLTexture2D.hpp"
 #include "GLTexture2DArray.hpp"
 #include "GLBufferTexture.hpp"
+#include "BakedDataFile.hpp"
+#include "AxisAlignedBox3D.hpp"
 
 #include <vector>
 #include <memory>
@@ -23,24 +25,98 @@ namespace EARenderer {
     class SurfelGenerator;
 
     class SurfelData {
+    public:
+
+#pragma mark - Nested types
+
+        /// Representation of surfels in serialized files
+        enum class Quantization {
+            /// 40 bytes per surfel, lossless
+            None,
+
+            /// 16 bytes per surfel: positions in 16-bit unorm relative to the bounds of all surfels
+            /// (a fraction of a millimeter per meter of the light baking volume), areas in half precision,
+            /// octahedral normals in 2 x 16-bit snorm and albedo in 8-bit unorm per channel
+            Compact
+        };
+
     private:
         friend SurfelGenerator;
 
-        std::vector<Surfel> mSurfels;
+        // Surfel attributes are stored column-wise. Columns are padded to the texel count of surfels' G-buffer,
+        // so each of them is uploaded to the GPU as is.
+        size_t mSurfelCount = 0;
+        std::vector<glm::vec3> mPositions;
+        std::vector<glm::vec3> mNormals;
+        std::vector<glm::vec3> mAlbedos;
+        std::vector<float> mAreas;
         std::vector<SurfelCluster> mSurfelClusters;
 
+        // Columns point either to the vectors above or directly into the mapped baked data file
+        std::unique_ptr<BakedDataFile> mBakedDataFile;
+        const glm::vec3 *mPositionsColumn = nullptr;
+        const glm::vec3 *mNormalsColumn = nullptr;
+        const glm::vec3 *mAlbedosColumn = nullptr;
+        const float *mAreasColumn = nullptr;
+
+        Quantization mQuantization = Quantization::None;
+
         std::shared_ptr<GLFloatTexture2DArray<GLTexture::Float::RGB32F>> mSurfelsGBuffer;
         std::shared_ptr<GLIntegerTexture2D<GLTexture::Integer::R32UI>> mSurfelClustersGBuffer;
         std::shared_ptr<GLFloatBufferTexture<GLTexture::Float::RGB32F, glm::vec3>> mSurfelClusterCentersBufferTexture;
 
+        void resizeColumns(size_t surfelCount);
+
+        void pointColumnsToStorage();
+
+        void setSurfels(const std::vector<Surfel> &surfels);
+
+        bool readColumns(const BakedDataFile &file, size_t surfelCount, const AxisAlignedBox3D &positionBounds);
+
     public:
         void initializeBuffers();
 
-        void serialize(const std::string &filePath);
+        /**
+         Writes surfels into a baked data file
+
+         @param filePath path to the file
+         @param contentHash hash of inputs surfels were generated from
+         */
+        void serialize(const std::string &filePath, uint64_t contentHash);
+
+        /**
+         Maps surfels from a baked data file. Unquantized columns are used right from the mapping.
+
+         @param filePath path to the file
+         @param expectedContentHash hash of inputs surfels are expected to be generated from
+         @return false if file is missing, corrupt or was generated from different inputs
+         */
+        bool deserialize(const std::string &filePath, uint64_t expectedContentHash);
+
+        Quantization quantization() const;
+
+        /// Representation used by subsequent serialize() calls
+        void setQuantization(Quantization quantization);
+
+        size_t surfelCount() const;
+
+        /// World space positions of all surfels, surfelCount() elements
+        const glm::vec3 *positions() const;
+
+        const glm::vec3 *normals() const;
+
+        /// Linear space albedo values
+        const glm::vec3 *albedos() const;
+
+        const float *areas() const;
 
-        bool deserialize(const std::string &filePath);
+        /// Gathers attributes of a single surfel from the columns
+        Surfel surfel(size_t index) const;
 
-        const std::vector<Surfel> &surfels() const;
+        /**
+         @return number of bytes occupied by surfel and cluster data in system memory
+         */
+        size_t memoryFootprint() const;
 
         const std::vector<SurfelCluster> &surfelClusters() const;
 
@@ -15,6 +15,7 @@
 #include "ThreadPool.hpp"
 #include "SparseOctree.hpp"
 #include "GaussianFunction.hpp"
+#include "TupleHash.hpp"
 
 #include <random>
 #include <limits>
@@ -40,14 +41,18 @@ namespace EARenderer {
             logarithmicBinIterator(iterator) {
     }
 
+    SurfelGenerator::TaskContext::TaskContext(uint64_t seed, const AxisAlignedBox3D &volume, uint32_t spaceDivisionResolution)
+            :
+            distribution(0.0f, 1.0f),
+            surfelSpatialHash(volume, spaceDivisionResolution) {
+        std::seed_seq sequence{(uint32_t) seed, (uint32_t) (seed >> 32)};
+        engine.seed(sequence);
+    }
+
     SurfelGenerator::SurfelGenerator(const SharedResourceStorage *resourcePool, const Scene *scene)
             :
-            mEngine(std::random_device()()),
-            mDistribution(0.0f, 1.0f),
             mResourcePool(resourcePool),
             mScene(scene),
-            mSurfelSpatialHash(AxisAlignedBox3D::Zero(), 1),
-            mSurfelFlatStorage(10000),
             mSurfelSpacing(scene->surfelSpacing()) {
     }
 
@@ -70,9 +75,9 @@ namespace EARenderer {
         return M_PI * mSurfelSpacing * mSurfelSpacing / 4.0;
     }
 
-    glm::vec3 SurfelGenerator::randomBarycentricCoordinates() {
-        float r = mDistribution(mEngine);
-        float s = mDistribution(mEngine);
+    glm::vec3 SurfelGenerator::randomBarycentricCoordinates(TaskContext &context) const {
+        float r = context.distribution(context.engine);
+        float s = context.distribution(context.engine);
 
         if (r + s >= 1.0f) {
             r = 1.0f - r;
@@ -91,7 +96,32 @@ namespace EARenderer {
         return std::max(spaceDivisionResolution, (uint32_t) 1);
     }
 
-    LogarithmicBin<SurfelGenerator::TransformedTriangleData> SurfelGenerator::constructSubMeshVertexDataBin(const SubMesh &subMesh, const MeshInstance &containingInstance) {
+    uint64_t SurfelGenerator::contentSeed(const SubMesh &subMesh, const MeshInstance &containingInstance) const {
+        size_t seed = 0;
+
+        glm::mat4 modelMatrix = containingInstance.transformation().modelMatrix();
+        for (int32_t column = 0; column < 4; column++) {
+            for (int32_t row = 0; row < 4; row++) {
+                std::hash_combine(seed, modelMatrix[column][row]);
+            }
+        }
+
+        std::hash_combine(seed, subMesh.vertices().size());
+        for (auto &vertex : subMesh.vertices()) {
+            std::hash_combine(seed, vertex.position.x);
+            std::hash_combine(seed, vertex.position.y);
+            std::hash_combine(seed, vertex.position.z);
+        }
+
+        std::hash_combine(seed, subMesh.indices().size());
+        for (uint32_t index : subMesh.indices()) {
+            std::hash_combine(seed, index);
+        }
+
+        return seed;
+    }
+
+    LogarithmicBin<SurfelGenerator::TransformedTriangleData> SurfelGenerator::constructSubMeshVertexDataBin(const SubMesh &subMesh, const MeshInstance &containingInstance, uint32_t seed) const {
         glm::mat4 modelMatrix = containingInstance.transformation().modelMatrix();
         glm::mat4 normalMatrix = containingInstance.transformation().normalMatrix();
 
@@ -102,10 +132,13 @@ namespace EARenderer {
 
         // Calculate triangle areas, transform positions and normals using
         // mesh instance's model transformation
-        for (size_t i = 0; i < subMesh.vertices().size(); i += 3) {
-            auto &vertex0 = subMesh.vertices()[i];
-            auto &vertex1 = subMesh.vertices()[i + 1];
-            auto &vertex2 = subMesh.vertices()[i + 2];
+        const auto &vertices = subMesh.vertices();
+        const auto &indices = subMesh.indices();
+
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            auto &vertex0 = vertices[indices[i]];
+            auto &vertex1 = vertices[indices[i + 1]];
+            auto &vertex2 = vertices[indices[i + 2]];
 
             // Transform positions
             Triangle3D triangle(modelMatrix * vertex0.position,
@@ -143,7 +176,8 @@ namespace EARenderer {
         // Also truncate maximum area if it's smaller than optimal one.
         maximumArea = std::max(maximumArea, optimalArea);
 
-        LogarithmicBin<TransformedTriangleData> bin(minimumArea, maximumArea);
+        LogarithmicBin<TransformedTriangleData> bin(minimumArea, maximumArea, seed);
+        bin.setSamplingMode(LogarithmicBin<TransformedTriangleData>::SamplingMode::AliasTable);
 
         for (auto &transformedTriangle : transformedTriangleProperties) {
             bin.insert(transformedTriangle, minimumAreaTruncated ? minimumArea : transformedTriangle.positions.area());
@@ -152,9 +186,9 @@ namespace EARenderer {
         return bin;
     }
 
-    bool SurfelGenerator::triangleCompletelyCovered(Triangle3D &triangle) {
+    bool SurfelGenerator::triangleCompletelyCovered(Triangle3D &triangle, TaskContext &context) const {
         bool triangleCoveredCompletely = false;
-        for (auto &surfel : mSurfelSpatialHash.neighbours(triangle.p2)) {
+        for (auto &surfel : context.surfelSpatialHash.neighbours(triangle.p2)) {
             Sphere enclosingSphere(surfel.position, mSurfelSpacing);
             if (enclosingSphere.contains(triangle)) {
                 triangleCoveredCompletely = true;
@@ -164,9 +198,9 @@ namespace EARenderer {
         return triangleCoveredCompletely;
     }
 
-    bool SurfelGenerator::surfelCandidateMeetsMinimumDistanceRequirement(SurfelCandidate &candidate) {
+    bool SurfelGenerator::surfelCandidateMeetsMinimumDistanceRequirement(SurfelCandidate &candidate, TaskContext &context) const {
         bool minimumDistanceRequirementMet = true;
-        for (auto &surfel : mSurfelSpatialHash.neighbours(candidate.position)) {
+        for (auto &surfel : context.surfelSpatialHash.neighbours(candidate.position)) {
             // Ignore surfel/candidate looking in the opposite directions to avoid tests
             // with surfels located on another side of a thin mesh (a wall for example)
             if (glm::dot(surfel.normal, candidate.normal) < 0.0) {
@@ -184,7 +218,7 @@ namespace EARenderer {
         return minimumDistanceRequirementMet;
     }
 
-    SurfelGenerator::SurfelCandidate SurfelGenerator::generateSurfelCandidate(const SubMesh &subMesh, LogarithmicBin<TransformedTriangleData> &transformedVerticesBin) {
+    SurfelGenerator::SurfelCandidate SurfelGenerator::generateSurfelCandidate(LogarithmicBin<TransformedTriangleData> &transformedVerticesBin, TaskContext &context) const {
         auto &&it = transformedVerticesBin.random();
         auto &randomTriangleData = *it;
 
@@ -194,7 +228,7 @@ namespace EARenderer {
         auto Nab = randomTriangleData.normals.b - randomTriangleData.normals.a;
         auto Nac = randomTriangleData.normals.c - randomTriangleData.normals.a;
 
-        glm::vec3 barycentric = randomBarycentricCoordinates();
+        glm::vec3 barycentric = randomBarycentricCoordinates(context);
         glm::vec3 position = randomTriangleData.positions.a + ((ab * barycentric.x) + (ac * barycentric.y));
         glm::vec3 normal = glm::normalize(randomTriangleData.normals.a + ((Nab * barycentric.x) + (Nac * barycentric.y)));
 
@@ -204,7 +238,7 @@ namespace EARenderer {
     template<class TextureFormat, TextureFormat Format>
     Surfel SurfelGenerator::generateSurfel(SurfelCandidate &surfelCandidate,
             LogarithmicBin<TransformedTriangleData> &transformedVerticesBin,
-            const GLTexture2DSampler<TextureFormat, Format> &albedoMapSampler) {
+            const GLTexture2DSampler<TextureFormat, Format> &albedoMapSampler) const {
         TransformedTriangleData &triangleData = *surfelCandidate.logarithmicBinIterator;
 
         glm::vec2 p1p2 = triangleData.UVs.p2 - triangleData.UVs.p1;
@@ -224,174 +258,197 @@ namespace EARenderer {
         return Surfel(surfelCandidate.position, surfelCandidate.normal, albedoLinear, singleSurfelArea);
     }
 
-    void SurfelGenerator::generateSurflesOnMeshInstance(const MeshInstance &instance) {
-        const auto &mesh = mResourcePool->mesh(instance.meshID());
+    std::vector<SurfelGenerator::SubMeshTask> SurfelGenerator::collectSubMeshTasks(std::unordered_map<ID, std::unique_ptr<AlbedoMapSampler>> &samplers) const {
+        std::vector<SubMeshTask> tasks;
 
-        for (ID subMeshID : mesh.subMeshes()) {
-            auto &subMesh = mesh.subMeshes()[subMeshID];
+        for (ID meshInstanceID : mScene->staticMeshInstanceIDs()) {
+            const auto &instance = mScene->meshInstances()[meshInstanceID];
+            const auto &mesh = mResourcePool->mesh(instance.meshID());
+
+            for (ID subMeshID : mesh.subMeshes()) {
+                // Right now surfels could only be generated on CookTorrance surfaces
+                auto materialRef = instance.materialReference;
+                if (!materialRef) {
+                    materialRef = instance.materialReferenceForSubMeshID(subMeshID);
+                }
 
-            // Right now surfels could only be generated on CookTorrance surfaces
-            auto materialRef = instance.materialReference;
-            if (!materialRef) {
-                materialRef = instance.materialReferenceForSubMeshID(subMeshID);
-            }
+                if (!materialRef.has_value() || materialRef->first != MaterialType::CookTorrance) {
+                    continue;
+                }
 
-            if (!materialRef.has_value() || materialRef->first != MaterialType::CookTorrance) {
-                continue;
+                auto samplerIt = samplers.find(materialRef->second);
+                if (samplerIt == samplers.end()) {
+                    auto &material = mResourcePool->cookTorranceMaterial(materialRef->second);
+
+                    // Sample higher mip level to get rid of high frequency color information
+                    // It will be better to use low-frequency, blurred albedo texture since this algorithm is all about diffuse GI
+                    int32_t mipLevel = material.albedoMap()->mipMapCount() * 0.6;
+                    auto sampler = std::make_unique<AlbedoMapSampler>(material.albedoMap()->sampleTexels(mipLevel));
+                    samplerIt = samplers.emplace(materialRef->second, std::move(sampler)).first;
+                }
+
+                tasks.push_back({meshInstanceID, subMeshID, samplerIt->second.get()});
             }
+        }
 
-            auto &material = mResourcePool->cookTorranceMaterial(materialRef->second);
+        return tasks;
+    }
 
-            auto bin = constructSubMeshVertexDataBin(subMesh, instance);
+    std::vector<Surfel> SurfelGenerator::generateSurfelsOnSubMesh(const SubMeshTask &task) const {
+        const auto &instance = mScene->meshInstances()[task.meshInstanceID];
+        const auto &mesh = mResourcePool->mesh(instance.meshID());
+        const auto &subMesh = mesh.subMeshes()[task.subMeshID];
+        const auto &sampler = *task.albedoMapSampler;
 
-            // Sample higher mip level to get rid of high frequency color information
-            // It will be better to use low-frequency, blurred albedo texture since this algorithm is all about diffuse GI
-            int32_t mipLevel = material.albedoMap()->mipMapCount() * 0.6;
-            GLTexture2DSampler sampler = material.albedoMap()->sampleTexels(mipLevel);
+        TaskContext context(contentSeed(subMesh, instance), mScene->lightBakingVolume(), spaceDivisionResolution(1.5, mScene->lightBakingVolume()));
 
-            // Actual algorithm that uniformly distributes surfels on geometry
-            while (!bin.empty()) {
-                // Algorithm selects an active triangle F with probability proportional to its area.
-                // It then chooses a random point p on the triangle and makes it a surfel candidate.
-                SurfelCandidate surfelCandidate = generateSurfelCandidate(subMesh, bin);
+        auto bin = constructSubMeshVertexDataBin(subMesh, instance, context.engine());
 
-                // Get rid of triangles that lie outside of scene's baking volume
-                if (!mScene->lightBakingVolume().contains(surfelCandidate.position)) {
-                    bin.erase(surfelCandidate.logarithmicBinIterator);
-                    continue;
-                }
+        // Actual algorithm that uniformly distributes surfels on geometry
+        while (!bin.empty()) {
+            // Algorithm selects an active triangle F with probability proportional to its area.
+            // It then chooses a random point p on the triangle and makes it a surfel candidate.
+            SurfelCandidate surfelCandidate = generateSurfelCandidate(bin, context);
 
-                // Checks to see if surfel candidate meets the minimum distance requirement with respect to the current surfel set
+            // Get rid of triangles that lie outside of scene's baking volume
+            if (!mScene->lightBakingVolume().contains(surfelCandidate.position)) {
+                bin.erase(surfelCandidate.logarithmicBinIterator);
+                continue;
+            }
 
-                // If the minimum distance requirement is met, the algorithm computes all missing information
-                // for the surfel candidate and then adds the resultant surfel to the surfel set
-                if (surfelCandidateMeetsMinimumDistanceRequirement(surfelCandidate)) {
-                    auto surfel = generateSurfel(surfelCandidate, bin, sampler);
-                    mSurfelSpatialHash.insert(surfel, surfelCandidate.position);
-                    mSurfelFlatStorage.insert(surfel);
-                }
+            // Checks to see if surfel candidate meets the minimum distance requirement with respect to the current surfel set
 
-                // In any case, the algorithm then checks to see whether triangle is completely covered by any surfel from the surfel set
-                auto &surfelPositionTriangle = surfelCandidate.logarithmicBinIterator->positions;
-                float triangleArea = surfelPositionTriangle.area();
-                float subTriangleArea = triangleArea / 4.0f;
+            // If the minimum distance requirement is met, the algorithm computes all missing information
+            // for the surfel candidate and then adds the resultant surfel to the surfel set
+            if (surfelCandidateMeetsMinimumDistanceRequirement(surfelCandidate, context)) {
+                auto surfel = generateSurfel(surfelCandidate, bin, sampler);
+                context.surfelSpatialHash.insert(surfel, surfelCandidate.position);
+                context.surfels.push_back(surfel);
+            }
 
-                if (triangleCompletelyCovered(surfelPositionTriangle)) {
-                    // If triangle is covered, it is discarded
-                    bin.erase(surfelCandidate.logarithmicBinIterator);
-                } else {
-                    // Otherwise, we split it into a number of child triangles and
-                    // add the uncovered triangles back to the list of active triangles
-
-                    // Discard triangles that are too small
-                    if (subTriangleArea < bin.minWeight()) {
-                        bin.erase(surfelCandidate.logarithmicBinIterator);
-                        continue;
-                    }
+            // In any case, the algorithm then checks to see whether triangle is completely covered by any surfel from the surfel set
+            auto &surfelPositionTriangle = surfelCandidate.logarithmicBinIterator->positions;
+            float triangleArea = surfelPositionTriangle.area();
+            float subTriangleArea = triangleArea / 4.0f;
+
+            if (triangleCompletelyCovered(surfelPositionTriangle, context)) {
+                // If triangle is covered, it is discarded
+                bin.erase(surfelCandidate.logarithmicBinIterator);
+            } else {
+                // Otherwise, we split it into a number of child triangles and
+                // add the uncovered triangles back to the list of active triangles
 
-                    // Access first, only then erase!!
-                    auto subTriangles = surfelCandidate.logarithmicBinIterator->split();
+                // Discard triangles that are too small
+                if (subTriangleArea < bin.minWeight()) {
                     bin.erase(surfelCandidate.logarithmicBinIterator);
+                    continue;
+                }
 
-                    for (auto &subTriangle : subTriangles) {
-                        // Uncovered triangle goes back to the bin
-                        if (!triangleCompletelyCovered(subTriangle.positions)) {
-                            bin.insert(subTriangle, subTriangleArea);
-                        }
+                // Access first, only then erase!!
+                auto subTriangles = surfelCandidate.logarithmicBinIterator->split();
+                bin.erase(surfelCandidate.logarithmicBinIterator);
+
+                for (auto &subTriangle : subTriangles) {
+                    // Uncovered triangle goes back to the bin
+                    if (!triangleCompletelyCovered(subTriangle.positions, context)) {
+                        bin.insert(subTriangle, subTriangleArea);
                     }
                 }
             }
         }
-    }
-
-    bool SurfelGenerator::surfelsAlike(const Surfel &first, const Surfel &second, float workingVolumeMaximumExtent2) {
-        float normDistance2 = glm::length2(first.position - second.position) / workingVolumeMaximumExtent2;
-        float normalDeviation = glm::dot(first.normal, second.normal);
-
-        const float Cn = -0.3;
-        const float Cb = 0.04;
 
-        auto offsetStart = first.position + first.normal * workingVolumeMaximumExtent2 * 0.001f;
-        auto offsetEnd = second.position + second.normal * workingVolumeMaximumExtent2 * 0.001f;
-
-        if (mScene->rayTracer()->lineSegmentOccluded(offsetStart, offsetEnd)) {
-            return false;
-        }
-
-        return normDistance2 <= Cb && normalDeviation > Cn;
+        return std::move(context.surfels);
     }
 
-    void SurfelGenerator::formClusters() {
-        std::vector<ID> idsToDelete;
-        float extent2 = mScene->lightBakingVolume().largestDimensionLength() * mScene->lightBakingVolume().largestDimensionLength();
-
-        while (mSurfelFlatStorage.size()) {
-            // Allocate cluster with count of 1 since we're immediately inserting 1 surfel
-            SurfelCluster cluster(mSurfelDataContainer->mSurfels.size(), 1);
-
-            // Push random surfel to a cluster
-            ID firstSurfelID = *mSurfelFlatStorage.begin();
-            Surfel &firstSurfel = mSurfelFlatStorage[firstSurfelID];
-            mSurfelDataContainer->mSurfels.push_back(firstSurfel);
-            cluster.center = firstSurfel.position;
-            mSurfelFlatStorage.erase(firstSurfelID);
-
-            // Iterate over all left surfels
-            for (auto it = mSurfelFlatStorage.begin(); it != mSurfelFlatStorage.end(); ++it) {
-                auto &nextSurfel = mSurfelFlatStorage[*it];
-
-                bool alikeToAllSurfelsInCluster = true;
-
-                // Determine if the surfel is similar to all the surfels in the current cluster
-                for (size_t i = cluster.surfelOffset; i < cluster.surfelOffset + cluster.surfelCount; i++) {
-                    auto &surfel = mSurfelDataContainer->mSurfels[i];
-                    if (!surfelsAlike(surfel, nextSurfel, extent2)) {
-                        alikeToAllSurfelsInCluster = false;
-                        break;
+    std::vector<Surfel> SurfelGenerator::rejectOverlappingSurfels(const std::vector<std::vector<Surfel>> &taskSurfels) const {
+        const AxisAlignedBox3D &volume = mScene->lightBakingVolume();
+        // Holds accepted surfels only, so that a rejected surfel never causes rejection of others
+        ConcurrentSpatialHash<TaskSurfel> spatialHash(volume, spaceDivisionResolution(1.5, volume));
+        float minimumDistance2 = mSurfelSpacing * mSurfelSpacing;
+
+        // Surfels of a task already meet the distance requirement among themselves,
+        // so a task can be resolved in parallel chunks, as long as tasks are resolved one after another
+        constexpr size_t ChunkSize = 1024;
+
+        std::vector<Surfel> surfels;
+        for (size_t i = 0; i < taskSurfels.size(); i++) {
+            const std::vector<Surfel> &candidates = taskSurfels[i];
+
+            std::vector<ThreadPool::TaskFuture<std::vector<Surfel>>> rejections;
+            for (size_t begin = 0; begin < candidates.size(); begin += ChunkSize) {
+                size_t end = std::min(begin + ChunkSize, candidates.size());
+
+                rejections.emplace_back(ThreadPool::Default().submit([&candidates, &spatialHash, minimumDistance2, i, begin, end]() {
+                    std::vector<Surfel> accepted;
+
+                    for (size_t s = begin; s < end; s++) {
+                        const Surfel &surfel = candidates[s];
+
+                        bool overlaps = spatialHash.anyNeighbour(surfel.position, [&](const TaskSurfel &other) {
+                            // Accepted surfels of the same task are being inserted concurrently
+                            if (other.taskIndex >= i) {
+                                return false;
+                            }
+                            // Same rules as in surfelCandidateMeetsMinimumDistanceRequirement
+                            if (glm::dot(other.surfel.normal, surfel.normal) < 0.0) {
+                                return false;
+                            }
+                            return glm::length2(other.surfel.position - surfel.position) < minimumDistance2;
+                        });
+
+                        if (!overlaps) {
+                            spatialHash.insert({surfel, i}, surfel.position);
+                            accepted.push_back(surfel);
+                        }
                     }
-                }
-
-                // If surfel meets similarity criteria
-                // we push it to the cluster and remove from surfel list
-                if (alikeToAllSurfelsInCluster) {
-                    mSurfelDataContainer->mSurfels.push_back(nextSurfel);
-                    idsToDelete.push_back(*it);
-                    cluster.surfelCount++;
 
-                    // Limit the amount of surfels int cluster
-                    if (cluster.surfelCount == mMaximumSurfelClusterSize) {
-                        continue;
-                    }
-                }
+                    return accepted;
+                }));
             }
 
-            // Remove all clustered surfels from surfel list
-            for (ID id : idsToDelete) {
-                mSurfelFlatStorage.erase(id);
+            // Next task may only be resolved against the final set of accepted surfels of this one
+            for (auto &rejection : rejections) {
+                auto accepted = rejection.get();
+                surfels.insert(surfels.end(), accepted.begin(), accepted.end());
             }
+        }
 
-            idsToDelete.clear();
+        return surfels;
+    }
 
-            // Push cluster to cluster list
-            mSurfelDataContainer->mSurfelClusters.push_back(cluster);
+    void SurfelGenerator::formClusters(const std::vector<Surfel> &surfels) {
+        SurfelClusterBuilder builder(mScene->rayTracer().get(), mScene->lightBakingVolume(), mSurfelSpacing, mMaximumSurfelClusterSize);
+        SurfelClusterBuilder::Result result = builder.build(surfels);
 
-            // Then repear until all surfels are asigned to clusters
-        }
+        mSurfelDataContainer->setSurfels(result.surfels);
+        mSurfelDataContainer->mSurfelClusters = std::move(result.clusters);
     }
 
 #pragma mark - Public interface
 
     std::unique_ptr<SurfelData> SurfelGenerator::generateStaticGeometrySurfels() {
         mSurfelDataContainer = std::make_unique<SurfelData>();
-        mSurfelSpatialHash = SpatialHash<Surfel>(mScene->lightBakingVolume(), spaceDivisionResolution(1.5, mScene->lightBakingVolume()));
-        mSurfelFlatStorage = PackedLookupTable<Surfel>(10000);
 
-        for (ID meshInstanceID : mScene->staticMeshInstanceIDs()) {
-            const auto &meshInstance = mScene->meshInstances()[meshInstanceID];
-            generateSurflesOnMeshInstance(meshInstance);
+        std::unordered_map<ID, std::unique_ptr<AlbedoMapSampler>> samplers;
+        std::vector<SubMeshTask> tasks = collectSubMeshTasks(samplers);
+
+        // Every sub mesh is processed independently and with its own content-derived seed,
+        // so the output doesn't depend on the number of threads or on the order of execution
+        std::vector<ThreadPool::TaskFuture<std::vector<Surfel>>> futures;
+        futures.reserve(tasks.size());
+        for (const auto &task : tasks) {
+            futures.emplace_back(ThreadPool::Default().submit([this, &task]() {
+                return generateSurfelsOnSubMesh(task);
+            }));
+        }
+
+        std::vector<std::vector<Surfel>> taskSurfels;
+        taskSurfels.reserve(futures.size());
+        for (auto &future : futures) {
+            taskSurfels.emplace_back(future.get());
         }
 
-        formClusters();
+        formClusters(rejectOverlappingSurfels(taskSurfels));
 
         mSurfelDataContainer->initializeBuffers();
 
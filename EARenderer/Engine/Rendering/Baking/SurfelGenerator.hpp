@@ -15,9 +15,12 @@
 #include "LogarithmicBin.hpp"
 #include "Triangle2D.hpp"
 #include "Triangle3D.hpp"
-#include "SpatialHash.hpp"
+#include "FlatSpatialHash.hpp"
 #include "SparseOctree.hpp"
 #include "SurfelData.hpp"
+#include "ConcurrentSpatialHash.hpp"
+#include "GLTexture2DSampler.hpp"
+#include "SurfelClusterBuilder.hpp"
 
 #include <vector>
 #include <unordered_map>
@@ -35,6 +38,8 @@ namespace EARenderer {
 
 #pragma mark - Nested types
 
+        using AlbedoMapSampler = GLTexture2DSampler<GLTexture::Normalized, GLTexture::Normalized::RGBACompressedRGBAInput>;
+
         struct TransformedTriangleData {
             Triangle3D positions;
             Triangle3D normals;
@@ -56,15 +61,34 @@ namespace EARenderer {
             SurfelCandidate(const glm::vec3 &position, const glm::vec3 &normal, const glm::vec3 &barycentric, BinIterator iterator);
         };
 
+        // Unit of parallel work: surfels of one sub mesh belonging to one mesh instance
+        struct SubMeshTask {
+            ID meshInstanceID;
+            ID subMeshID;
+            const AlbedoMapSampler *albedoMapSampler;
+        };
+
+        // State owned exclusively by a single task
+        struct TaskContext {
+            std::mt19937 engine;
+            std::uniform_real_distribution<float> distribution;
+            FlatSpatialHash<Surfel> surfelSpatialHash;
+            std::vector<Surfel> surfels;
+
+            TaskContext(uint64_t seed, const AxisAlignedBox3D &volume, uint32_t spaceDivisionResolution);
+        };
+
+        struct TaskSurfel {
+            Surfel surfel;
+            size_t taskIndex;
+        };
+
 #pragma mark - Member variables
 
         float mSurfelSpacing;
+        // Cluster's surfel count minus one is packed into 8 bits in the clusters' G-buffer (see SurfelData)
         size_t mMaximumSurfelClusterSize = 256;
 
-        std::mt19937 mEngine;
-        std::uniform_real_distribution<float> mDistribution;
-        PackedLookupTable<Surfel> mSurfelFlatStorage;
-        SpatialHash<Surfel> mSurfelSpatialHash;
         std::unique_ptr<SurfelData> mSurfelDataContainer;
         const SharedResourceStorage *mResourcePool = nullptr;
         const Scene *mScene = nullptr;
@@ -90,44 +114,58 @@ namespace EARenderer {
         /**
          Generates 3 random numbers between 0 and 1
 
+         @param context Task context providing the random engine
          @return Normalized triple of random numbers
          */
-        glm::vec3 randomBarycentricCoordinates();
+        glm::vec3 randomBarycentricCoordinates(TaskContext &context) const;
+
+        /**
+         Derives a random seed from sub mesh geometry and instance transformation, so that
+         the same scene always produces the same surfels no matter how the work is scheduled
+
+         @param subMesh Sub mesh object holding geometry data
+         @param containingInstance Mesh instance that applies transformation to underlying sub mesh
+         @return Seed for the task's random engines
+         */
+        uint64_t contentSeed(const SubMesh &subMesh, const MeshInstance &containingInstance) const;
 
         /**
          Creates LogarithmicBin data structure and fills it with sub mesh's transformed triangle data
 
          @param subMesh Sub mesh object holding geometry data
          @param containingInstance Mesh instance that applies transformation and materials to underlying sub mesh
+         @param seed Seed for the bin's random selection
          @return A logarithmic bin containing sub mesh's triangle data (positions, normals, albedo values and texture coordinates)
          */
-        LogarithmicBin<TransformedTriangleData> constructSubMeshVertexDataBin(const SubMesh &subMesh, const MeshInstance &containingInstance);
+        LogarithmicBin<TransformedTriangleData> constructSubMeshVertexDataBin(const SubMesh &subMesh, const MeshInstance &containingInstance, uint32_t seed) const;
 
         /**
-         Checks to see whether triangle is completely covered by any surfel from existing surfel set
+         Checks to see whether triangle is completely covered by any surfel from the task's surfel set
 
          @param triangle Test subject
+         @param context Task context holding already generated surfels
          @return Bool value indicating whether triangle is covered
          */
-        bool triangleCompletelyCovered(Triangle3D &triangle);
+        bool triangleCompletelyCovered(Triangle3D &triangle, TaskContext &context) const;
 
         /**
-         Checks to see whether surfel candidate is far enough from all the already generated surfels
+         Checks to see whether surfel candidate is far enough from all the surfels already generated by the task
 
          @param candidate Test subject
+         @param context Task context holding already generated surfels
          @return Bool value indicating whether surfel candidate is far enough to be accepted as a full-fledged surfel
          */
-        bool surfelCandidateMeetsMinimumDistanceRequirement(SurfelCandidate &candidate);
+        bool surfelCandidateMeetsMinimumDistanceRequirement(SurfelCandidate &candidate, TaskContext &context) const;
 
         /**
          Generates a surfel candidate with minimum amount of data required to perform routines deciding
          whether this candidate is worthy to be added to a full-fledged surfel set
 
-         @param subMesh A sub mesh on which candidate is generated
          @param transformedVerticesBin Bin that holds all transformed triangle data of the sub mesh
+         @param context Task context providing the random engine
          @return A surfel candidate ready to participate in validity tests
          */
-        SurfelCandidate generateSurfelCandidate(const SubMesh &subMesh, LogarithmicBin<TransformedTriangleData> &transformedVerticesBin);
+        SurfelCandidate generateSurfelCandidate(LogarithmicBin<TransformedTriangleData> &transformedVerticesBin, TaskContext &context) const;
 
         /**
          Computes all necessary data for a surfel candidate (normal, albedo, uv and an area) to transform it into a full-fledged surfel
@@ -139,29 +177,41 @@ namespace EARenderer {
         template<class TextureFormat, TextureFormat Format>
         Surfel generateSurfel(SurfelCandidate &surfelCandidate,
                 LogarithmicBin<TransformedTriangleData> &transformedVerticesBin,
-                const GLTexture2DSampler<TextureFormat, Format> &albedoMapSampler);
+                const GLTexture2DSampler<TextureFormat, Format> &albedoMapSampler) const;
 
         /**
-         Generates surfels for a single mesh instance
+         Collects sub meshes of all static mesh instances that surfels can be generated on.
+         Albedo maps are read back here, because it requires an active GL context.
 
-         @param instance An instance on which surfels will be generated on
+         @param samplers Storage that keeps albedo map samplers alive while tasks are running
+         @return Independent work items, ordered as they appear in the scene
          */
-        void generateSurflesOnMeshInstance(const MeshInstance &instance);
+        std::vector<SubMeshTask> collectSubMeshTasks(std::unordered_map<ID, std::unique_ptr<AlbedoMapSampler>> &samplers) const;
 
         /**
-         Determines resemblance of two surfels to decide whether thay belong to the same cluster
+         Generates surfels for a single sub mesh. Safe to be called from multiple threads at once.
 
-         @param first surfel one
-         @param second surfel two
-         @param workingVolumeMaximumExtent2 squared largest length of scene's light baking volume
-         @return returns a true if surfels are alike and belong to the same surfel cluster
+         @param task Sub mesh on which surfels will be generated on
+         @return Surfels that are evenly distributed over the sub mesh
          */
-        bool surfelsAlike(const Surfel &first, const Surfel &second, float workingVolumeMaximumExtent2);
+        std::vector<Surfel> generateSurfelsOnSubMesh(const SubMeshTask &task) const;
 
         /**
-         Gathers similar surfels into clusters
+         Removes surfels that violate the minimum distance requirement with surfels of other sub meshes.
+         Tasks are resolved in order of their indices: a surfel is dropped when it's too close to an accepted surfel
+         of a task with a smaller index, which makes the result independent of the order in which tasks were executed.
+
+         @param taskSurfels Surfels generated by each task
+         @return Surfels of all tasks that passed the test, ordered by task
+         */
+        std::vector<Surfel> rejectOverlappingSurfels(const std::vector<std::vector<Surfel>> &taskSurfels) const;
+
+        /**
+         Gathers similar surfels into clusters and stores both in the surfel data container
+
+         @param surfels Surfels to be clustered
          */
-        void formClusters();
+        void formClusters(const std::vector<Surfel> &surfels);
 
     public:
         SurfelGenerator(const SharedResourceStorage *resourcePool, const Scene *scene);
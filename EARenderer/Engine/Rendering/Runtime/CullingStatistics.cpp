@@ -0,0 +1,26 @@
+//
+//  CullingStatistics.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "CullingStatistics.hpp"
+
+#include <cstdio>
+
+namespace EARenderer {
+
+    std::string CullingStatistics::description() const {
+        size_t culledDrawCount = frustumCulledDrawCount + occlusionCulledDrawCount;
+        size_t totalDrawCount = submittedDrawCount + culledDrawCount;
+        float culledPercentage = totalDrawCount > 0 ? 100.0f * culledDrawCount / totalDrawCount : 0.0f;
+
+        char description[256];
+        snprintf(description, sizeof(description), "%zu draws submitted, %zu culled (%.1f%%): %zu outside of the frustum, %zu occluded",
+                submittedDrawCount, culledDrawCount, culledPercentage, frustumCulledDrawCount, occlusionCulledDrawCount);
+        return description;
+    }
+
+}
@@ -0,0 +1,30 @@
+//
+//  CullingStatistics.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef CullingStatistics_hpp
+#define CullingStatistics_hpp
+
+#include <string>
+
+namespace EARenderer {
+
+    /// Per-frame draw counts of a render pass which skips invisible sub meshes
+    struct CullingStatistics {
+        size_t submittedDrawCount = 0;
+        size_t frustumCulledDrawCount = 0;
+        size_t occlusionCulledDrawCount = 0;
+
+        /**
+         @return one line summary of the draw counts, e.g. for the statistics UI
+         */
+        std::string description() const;
+    };
+
+}
+
+#endif /* CullingStatistics_hpp */
@@ -80,6 +80,10 @@ namespace EARenderer {
         return mIndirectLightAccumulator.gridProbesSphericalHarmonics();
     }
 
+    const ShadowMapper &DeferredSceneRenderer::shadowMapper() const {
+        return mShadowMapper;
+    }
+
     const GLFloatTexture2D<GLTexture::Float::R16F> &DeferredSceneRenderer::surfelsLuminanceMap() const {
         return mIndirectLightAccumulator.surfelsLuminanceMap();
     }
@@ -110,6 +110,8 @@ namespace EARenderer {
 
         const GLFloatTexture2D<GLTexture::Float::R16F> &surfelClustersLuminanceMap() const;
 
+        const ShadowMapper &shadowMapper() const;
+
         /**
          Renders the scene
 
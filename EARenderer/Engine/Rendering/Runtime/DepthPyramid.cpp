@@ -0,0 +1,151 @@
+//
+//  DepthPyramid.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "DepthPyramid.hpp"
+
+#include <glm/common.hpp>
+#include <algorithm>
+#include <limits>
+
+namespace EARenderer {
+
+#pragma mark - Level
+
+    float DepthPyramid::Level::depth(uint32_t x, uint32_t y) const {
+        return depths[y * width + x];
+    }
+
+#pragma mark - Lifecycle
+
+    DepthPyramid::DepthPyramid(const Size2D &viewportSize, uint16_t baseMipLevel, Level &&base)
+            :
+            mViewportSize(viewportSize),
+            mBaseMipLevel(baseMipLevel) {
+
+        mLevels.emplace_back(std::move(base));
+
+        while (mLevels.back().width > 1 || mLevels.back().height > 1) {
+            mLevels.emplace_back(Reduced(mLevels.back()));
+        }
+    }
+
+    DepthPyramid::Level DepthPyramid::Reduced(const Level &level) {
+        Level reduced;
+        reduced.width = std::max(level.width / 2, 1u);
+        reduced.height = std::max(level.height / 2, 1u);
+        reduced.depths.resize(reduced.width * reduced.height);
+
+        for (uint32_t y = 0; y < reduced.height; y++) {
+            // Last row of an odd sized level has no row of its own one level up
+            uint32_t firstY = y * 2;
+            uint32_t lastY = std::min(firstY + 1 + (firstY + 3 == level.height ? 1 : 0), level.height - 1);
+
+            for (uint32_t x = 0; x < reduced.width; x++) {
+                uint32_t firstX = x * 2;
+                uint32_t lastX = std::min(firstX + 1 + (firstX + 3 == level.width ? 1 : 0), level.width - 1);
+
+                float farthest = 0.0f;
+                for (uint32_t sy = firstY; sy <= lastY; sy++) {
+                    for (uint32_t sx = firstX; sx <= lastX; sx++) {
+                        farthest = std::max(farthest, level.depth(sx, sy));
+                    }
+                }
+
+                reduced.depths[y * reduced.width + x] = farthest;
+            }
+        }
+
+        return reduced;
+    }
+
+#pragma mark - Getters
+
+    bool DepthPyramid::isEmpty() const {
+        return mLevels.empty();
+    }
+
+    const std::vector<DepthPyramid::Level> &DepthPyramid::levels() const {
+        return mLevels;
+    }
+
+#pragma mark - Private Helpers
+
+    float DepthPyramid::farthestDepth(uint32_t minX, uint32_t minY, uint32_t maxX, uint32_t maxY) const {
+        for (size_t i = 0; i < mLevels.size(); i++) {
+            const Level &level = mLevels[i];
+            uint32_t shift = mBaseMipLevel + uint32_t(i);
+
+            // Pixels beyond the last texel of a level are covered by that texel, see Reduced()
+            uint32_t firstX = std::min(minX >> shift, level.width - 1);
+            uint32_t lastX = std::min(maxX >> shift, level.width - 1);
+            uint32_t firstY = std::min(minY >> shift, level.height - 1);
+            uint32_t lastY = std::min(maxY >> shift, level.height - 1);
+
+            // The finest level where the rectangle fits into 2x2 texels
+            bool isFootprintSmallEnough = lastX - firstX <= 1 && lastY - firstY <= 1;
+            if (!isFootprintSmallEnough && i + 1 < mLevels.size()) {
+                continue;
+            }
+
+            float farthest = 0.0f;
+            for (uint32_t y = firstY; y <= lastY; y++) {
+                for (uint32_t x = firstX; x <= lastX; x++) {
+                    farthest = std::max(farthest, level.depth(x, y));
+                }
+            }
+            return farthest;
+        }
+
+        return 1.0f;
+    }
+
+#pragma mark - Occlusion
+
+    bool DepthPyramid::isVisible(const AxisAlignedBox3D &box, const glm::mat4 &viewProjection) const {
+        if (isEmpty()) {
+            return true;
+        }
+
+        glm::vec3 ndcMin(std::numeric_limits<float>::max());
+        glm::vec3 ndcMax(std::numeric_limits<float>::lowest());
+
+        for (auto &corner : box.cornerPoints()) {
+            glm::vec4 clipSpaceCorner = viewProjection * corner;
+
+            // Projection of boxes crossing the camera's plane is unbounded
+            if (clipSpaceCorner.w <= 0.0f) {
+                return true;
+            }
+
+            glm::vec3 ndcCorner = glm::vec3(clipSpaceCorner) / clipSpaceCorner.w;
+            ndcMin = glm::min(ndcMin, ndcCorner);
+            ndcMax = glm::max(ndcMax, ndcCorner);
+        }
+
+        if (ndcMax.x < -1.0f || ndcMin.x > 1.0f || ndcMax.y < -1.0f || ndcMin.y > 1.0f) {
+            return false;
+        }
+
+        float nearestDepth = ndcMin.z * 0.5f + 0.5f;
+        if (nearestDepth <= 0.0f) {
+            return true;
+        }
+
+        auto pixel = [](float ndc, float viewportDimension) {
+            return uint32_t(glm::clamp((ndc * 0.5f + 0.5f) * viewportDimension, 0.0f, viewportDimension - 1.0f));
+        };
+
+        uint32_t minX = pixel(ndcMin.x, mViewportSize.width);
+        uint32_t maxX = pixel(ndcMax.x, mViewportSize.width);
+        uint32_t minY = pixel(ndcMin.y, mViewportSize.height);
+        uint32_t maxY = pixel(ndcMax.y, mViewportSize.height);
+
+        return nearestDepth <= farthestDepth(minX, minY, maxX, maxY);
+    }
+
+}
@@ -0,0 +1,77 @@
+//
+//  DepthPyramid.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef DepthPyramid_hpp
+#define DepthPyramid_hpp
+
+#include "AxisAlignedBox3D.hpp"
+#include "Size2D.hpp"
+
+#include <glm/mat4x4.hpp>
+
+#include <vector>
+#include <cstdint>
+
+namespace EARenderer {
+
+    /// CPU copy of a hierarchical depth buffer for occlusion tests.
+    /// Every texel holds the farthest window space depth of the pixels it covers, so a box whose nearest point
+    /// lies behind all texels under its screen rectangle is guaranteed to be hidden.
+    /// Levels are reduced the same way HiZBuffer.frag does it: level sizes are halved and rounded down,
+    /// and the last texel in a row or column also covers the leftover texel of an odd sized parent.
+    class DepthPyramid {
+    public:
+        struct Level {
+            uint32_t width = 0;
+            uint32_t height = 0;
+            std::vector<float> depths;
+
+            float depth(uint32_t x, uint32_t y) const;
+        };
+
+    private:
+        Size2D mViewportSize;
+        uint16_t mBaseMipLevel = 0;
+        std::vector<Level> mLevels;
+
+        /**
+         @return farthest depth within the rectangle of viewport pixels, inclusive
+         */
+        float farthestDepth(uint32_t minX, uint32_t minY, uint32_t maxX, uint32_t maxY) const;
+
+    public:
+        DepthPyramid() = default;
+
+        /**
+         Builds coarser levels on top of the given one
+
+         @param viewportSize resolution of the depth buffer the pyramid was built from
+         @param baseMipLevel mip level of that depth buffer which the base level is a copy of
+         @param base farthest depths in [0; 1] range, rows go from the bottom of the viewport to its top
+         */
+        DepthPyramid(const Size2D &viewportSize, uint16_t baseMipLevel, Level &&base);
+
+        static Level Reduced(const Level &level);
+
+        bool isEmpty() const;
+
+        const std::vector<Level> &levels() const;
+
+        /**
+         Conservative occlusion test. Boxes crossing the camera's plane are always reported as visible.
+
+         @param box world space bounding box
+         @param viewProjection matrix the depth buffer was rendered with
+         @return false if the box is guaranteed to be hidden behind the depth buffer's contents
+         */
+        bool isVisible(const AxisAlignedBox3D &box, const glm::mat4 &viewProjection) const;
+    };
+
+}
+
+#endif /* DepthPyramid_hpp */
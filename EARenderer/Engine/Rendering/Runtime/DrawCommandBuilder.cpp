@@ -0,0 +1,135 @@
+//
+//  DrawCommandBuilder.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "DrawCommandBuilder.hpp"
+
+#include <limits>
+#include <numeric>
+#include <glm/matrix.hpp>
+
+namespace EARenderer {
+
+#pragma mark - Lifecycle
+
+    DrawCommandBuilder::DrawCommandBuilder()
+            :
+            mLastModelMatrix(0.0f),
+            mLastNormalMatrix(1.0f) {
+    }
+
+    bool DrawCommandBuilder::IsMultiDrawIndirectSupported() {
+#ifdef GL_VERSION_4_3
+        static bool isSupported = [] {
+            GLint major = 0;
+            GLint minor = 0;
+            glGetIntegerv(GL_MAJOR_VERSION, &major);
+            glGetIntegerv(GL_MINOR_VERSION, &minor);
+            return major > 4 || (major == 4 && minor >= 3);
+        }();
+        return isSupported;
+#else
+        // Headers of 4.1 platforms (macOS) don't even declare the entry point
+        return false;
+#endif
+    }
+
+#pragma mark - Private helpers
+
+    void DrawCommandBuilder::reserveGPUStorage(size_t commandCount) {
+        if (mDrawDataTexture && mDrawDataTexture->buffer().count() >= commandCount * DrawDataTexelCount) {
+            return;
+        }
+
+        size_t capacity = 64;
+        while (capacity < commandCount) {
+            capacity *= 2;
+        }
+
+        // Rewritten by every upload
+        mDrawDataTexture = std::make_unique<DrawDataTexture>(nullptr, capacity * DrawDataTexelCount, GL_STREAM_DRAW);
+        mCommandBuffer = std::make_unique<GLDrawIndirectBuffer>(nullptr, capacity);
+
+        // Base instance of every command points at its own index in here
+        std::vector<GLfloat> drawIndices(capacity);
+        std::iota(drawIndices.begin(), drawIndices.end(), 0.0f);
+        mDrawIndices = std::make_unique<GLVertexArrayBuffer<GLfloat>>(drawIndices.data(), drawIndices.size());
+    }
+
+    void DrawCommandBuilder::submitIndirect(size_t firstCommand, size_t commandCount) {
+#ifdef GL_VERSION_4_3
+        // Divisor exceeds any instance count, so every instance of a command reads the element at its base instance
+        mDrawIndices->bind();
+        glVertexAttribPointer(DrawIndexAttributeLocation, 1, GL_FLOAT, GL_FALSE, sizeof(GLfloat), nullptr);
+        glVertexAttribDivisor(DrawIndexAttributeLocation, std::numeric_limits<GLuint>::max());
+        glEnableVertexAttribArray(DrawIndexAttributeLocation);
+
+        mCommandBuffer->bind();
+        glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+                reinterpret_cast<void *>(firstCommand * sizeof(GLDrawElementsIndirectCommand)), static_cast<GLsizei>(commandCount), 0);
+#endif
+    }
+
+    void DrawCommandBuilder::submitDirect(size_t commandIndex) {
+        const GLDrawElementsIndirectCommand &command = mCommands[commandIndex];
+        glDrawElementsInstancedBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(command.indexCount), GL_UNSIGNED_INT,
+                reinterpret_cast<void *>(command.firstIndex * sizeof(GLuint)), static_cast<GLsizei>(command.instanceCount), command.baseVertex);
+    }
+
+#pragma mark - Building
+
+    void DrawCommandBuilder::clear() {
+        mCommands.clear();
+        mDrawTransformations.clear();
+        mDrawData.clear();
+    }
+
+    size_t DrawCommandBuilder::add(const GLIBODataLocation &location, size_t instanceCount, const glm::mat4 &modelMatrix, const glm::mat4 &positionDequantizationMatrix) {
+        size_t index = mCommands.size();
+
+        mCommands.push_back({
+                static_cast<GLuint>(location.indexCount),
+                static_cast<GLuint>(instanceCount),
+                static_cast<GLuint>(location.offset),
+                static_cast<GLint>(location.baseVertex),
+                static_cast<GLuint>(index)
+        });
+
+        if (!IsMultiDrawIndirectSupported()) {
+            mDrawTransformations.push_back({modelMatrix, positionDequantizationMatrix});
+            return index;
+        }
+
+        // Sub meshes of the same instance come in a row, normal matrix is inverted once for all of them
+        if (modelMatrix != mLastModelMatrix) {
+            mLastModelMatrix = modelMatrix;
+            mLastNormalMatrix = glm::transpose(glm::inverse(modelMatrix));
+        }
+
+        glm::mat4 positionMatrix = modelMatrix * positionDequantizationMatrix;
+        mDrawData.insert(mDrawData.end(), &positionMatrix[0], &positionMatrix[0] + 4);
+        mDrawData.insert(mDrawData.end(), &mLastNormalMatrix[0], &mLastNormalMatrix[0] + 4);
+
+        return index;
+    }
+
+    size_t DrawCommandBuilder::commandCount() const {
+        return mCommands.size();
+    }
+
+    void DrawCommandBuilder::upload() {
+        // Without multi-draw-indirect commands are read on the CPU and transformations are set as uniforms
+        if (mCommands.empty() || !IsMultiDrawIndirectSupported()) {
+            return;
+        }
+
+        reserveGPUStorage(mCommands.size());
+        mDrawDataTexture->buffer().write(mDrawData.data(), mDrawData.size());
+        mCommandBuffer->write(mCommands.data(), mCommands.size());
+    }
+
+}
@@ -0,0 +1,146 @@
+//
+//  DrawCommandBuilder.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef DrawCommandBuilder_hpp
+#define DrawCommandBuilder_hpp
+
+#include "GLDrawIndirectBuffer.hpp"
+#include "GLVertexArrayBuffer.hpp"
+#include "GLElementArrayBuffer.hpp"
+#include "GLBufferTexture.hpp"
+
+#include <vector>
+#include <memory>
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+
+namespace EARenderer {
+
+    /// Collects indexed draws of sub meshes stored in the shared mesh VAO as indirect commands,
+    /// along with per-draw transformations, so that a pass can submit runs of draws at once.
+    ///
+    /// On GL 4.3+ contexts runs are submitted with glMultiDrawElementsIndirect. Shaders fetch per-draw data
+    /// from a buffer texture (see DrawData.glsl), indexed by an instanced draw index vertex attribute
+    /// at DrawIndexAttributeLocation, which is sourced through the base instance of each command.
+    /// 4.1 contexts (macOS) keep drawing one command at a time with transformations set as program uniforms,
+    /// since a loop of draws gains nothing from fetching them out of a buffer texture.
+    class DrawCommandBuilder {
+    public:
+        static constexpr GLuint DrawIndexAttributeLocation = 5;
+
+        /// Number of RGBA32F texels a single draw occupies in the data buffer
+        static constexpr size_t DrawDataTexelCount = 8;
+
+        using DrawDataTexture = GLFloatBufferTexture<GLTexture::Float::RGBA32F, glm::vec4>;
+
+    private:
+        struct DrawTransformation {
+            glm::mat4 modelMatrix;
+            glm::mat4 positionDequantizationMatrix;
+        };
+
+        std::vector<GLDrawElementsIndirectCommand> mCommands;
+        // Only filled on contexts without multi-draw-indirect
+        std::vector<DrawTransformation> mDrawTransformations;
+        // Mesh space to world space matrix (including position dequantization) followed by the normal matrix
+        std::vector<glm::vec4> mDrawData;
+
+        std::unique_ptr<GLDrawIndirectBuffer> mCommandBuffer;
+        std::unique_ptr<DrawDataTexture> mDrawDataTexture;
+        std::unique_ptr<GLVertexArrayBuffer<GLfloat>> mDrawIndices;
+
+        glm::mat4 mLastModelMatrix;
+        glm::mat4 mLastNormalMatrix;
+
+        void reserveGPUStorage(size_t commandCount);
+
+        void submitIndirect(size_t firstCommand, size_t commandCount);
+
+        void submitDirect(size_t commandIndex);
+
+    public:
+        /**
+         @return true if the current context supports multi-draw-indirect (GL 4.3+), checked once
+         */
+        static bool IsMultiDrawIndirectSupported();
+
+        DrawCommandBuilder();
+
+        void clear();
+
+        /**
+         @param location sub mesh location in the shared mesh buffers
+         @param instanceCount number of instances of the draw, visible to shaders as gl_InstanceID
+         @param modelMatrix transformation of the mesh instance
+         @param positionDequantizationMatrix transformation of sub mesh positions, normalized to its bounds, back into the mesh space
+         @return index of the added command
+         */
+        size_t add(const GLIBODataLocation &location, size_t instanceCount, const glm::mat4 &modelMatrix, const glm::mat4 &positionDequantizationMatrix);
+
+        size_t commandCount() const;
+
+        /**
+         Hands commands and per-draw data over to GL. Has to be called before submitting and after the last add().
+         */
+        void upload();
+
+        /**
+         Hands per-draw data over to the program, has to be called after every upload since storage may be reallocated.
+         Does nothing on contexts without multi-draw-indirect, where submit() sets transformations instead.
+
+         @param program bound program with setDrawData(), GLSLGBuffer or GLSLShadowMap
+         */
+        template<typename Program>
+        void bindDrawData(Program &program) {
+            if (!IsMultiDrawIndirectSupported() || mCommands.empty()) {
+                return;
+            }
+            program.ensureSamplerValidity([&] {
+                program.setDrawData(*mDrawDataTexture);
+            });
+        }
+
+        /**
+         Draws a range of uploaded commands. Expects the mesh VAO and the program to be bound.
+
+         @param firstCommand index of the first command in the range
+         @param commandCount number of commands in the range
+         @param program bound program with setModelMatrix() and setPositionDequantizationMatrix(),
+         used on contexts without multi-draw-indirect
+         */
+        template<typename Program>
+        void submit(size_t firstCommand, size_t commandCount, Program &program) {
+            if (commandCount == 0) {
+                return;
+            }
+
+            if (IsMultiDrawIndirectSupported()) {
+                submitIndirect(firstCommand, commandCount);
+                return;
+            }
+
+            for (size_t i = firstCommand; i < firstCommand + commandCount; i++) {
+                const DrawTransformation &transformation = mDrawTransformations[i];
+                // Sub meshes of the same instance come in a row, model matrix (and the normal matrix derived from it) is set once for all of them
+                if (i == firstCommand || transformation.modelMatrix != mDrawTransformations[i - 1].modelMatrix) {
+                    program.setModelMatrix(transformation.modelMatrix);
+                }
+                program.setPositionDequantizationMatrix(transformation.positionDequantizationMatrix);
+                submitDirect(i);
+            }
+        }
+
+        template<typename Program>
+        void submit(Program &program) {
+            submit(0, mCommands.size(), program);
+        }
+    };
+
+}
+
+#endif /* DrawCommandBuilder_hpp */
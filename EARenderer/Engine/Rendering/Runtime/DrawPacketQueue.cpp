@@ -0,0 +1,115 @@
+//
+//  DrawPacketQueue.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "DrawPacketQueue.hpp"
+
+#include <glm/common.hpp>
+#include <array>
+
+namespace EARenderer {
+
+    static constexpr uint64_t PassShift = 60;
+    static constexpr uint64_t ProgramShift = 52;
+    static constexpr uint64_t MaterialShift = 28;
+    static constexpr uint64_t DepthShift = 12;
+
+    static constexpr uint64_t PassMask = 0xF;
+    static constexpr uint64_t ProgramMask = 0xFF;
+    static constexpr uint64_t MaterialMask = 0xFFFFFF;
+    static constexpr uint64_t DepthMask = 0xFFFF;
+
+#pragma mark - Keys
+
+    uint64_t DrawPacketQueue::SortKey(uint8_t pass, uint8_t program, uint32_t material, uint16_t depthBucket) {
+        return ((uint64_t(pass) & PassMask) << PassShift) |
+                ((uint64_t(program) & ProgramMask) << ProgramShift) |
+                ((uint64_t(material) & MaterialMask) << MaterialShift) |
+                ((uint64_t(depthBucket) & DepthMask) << DepthShift);
+    }
+
+    uint16_t DrawPacketQueue::DepthBucket(float distance, float farClipPlane) {
+        float normalizedDistance = glm::clamp(distance / farClipPlane, 0.0f, 1.0f);
+        return uint16_t(normalizedDistance * DepthMask);
+    }
+
+    uint8_t DrawPacketQueue::Pass(uint64_t key) {
+        return uint8_t((key >> PassShift) & PassMask);
+    }
+
+    uint8_t DrawPacketQueue::Program(uint64_t key) {
+        return uint8_t((key >> ProgramShift) & ProgramMask);
+    }
+
+    uint32_t DrawPacketQueue::Material(uint64_t key) {
+        return uint32_t((key >> MaterialShift) & MaterialMask);
+    }
+
+#pragma mark - Packets
+
+    void DrawPacketQueue::clear() {
+        mPackets.clear();
+    }
+
+    void DrawPacketQueue::add(uint64_t key, ID meshInstanceID, ID subMeshID) {
+        mPackets.push_back({key, meshInstanceID, subMeshID});
+    }
+
+    size_t DrawPacketQueue::sort() {
+        if (mPackets.size() < 2) {
+            return 0;
+        }
+
+        mScratchPackets.resize(mPackets.size());
+        size_t passCount = 0;
+
+        for (uint64_t shift = 0; shift < 64; shift += 8) {
+            std::array<size_t, 256> offsets{};
+            for (auto &packet : mPackets) {
+                offsets[(packet.key >> shift) & 0xFF]++;
+            }
+
+            // All keys share the digit, the pass wouldn't change the order
+            if (offsets[(mPackets.front().key >> shift) & 0xFF] == mPackets.size()) {
+                continue;
+            }
+
+            size_t offset = 0;
+            for (auto &count : offsets) {
+                size_t digitCount = count;
+                count = offset;
+                offset += digitCount;
+            }
+
+            for (auto &packet : mPackets) {
+                mScratchPackets[offsets[(packet.key >> shift) & 0xFF]++] = packet;
+            }
+
+            mPackets.swap(mScratchPackets);
+            passCount++;
+        }
+
+        return passCount;
+    }
+
+    const std::vector<DrawPacketQueue::Packet> &DrawPacketQueue::packets() const {
+        return mPackets;
+    }
+
+    void DrawPacketQueue::materialRuns(std::vector<MaterialRun> &runs) const {
+        runs.clear();
+
+        for (size_t i = 0; i < mPackets.size(); i++) {
+            uint32_t material = Material(mPackets[i].key);
+            if (runs.empty() || (material != 0 && material != runs.back().material)) {
+                runs.push_back({material, i, 0});
+            }
+            runs.back().packetCount++;
+        }
+    }
+
+}
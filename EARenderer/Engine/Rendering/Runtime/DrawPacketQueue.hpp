@@ -0,0 +1,85 @@
+//
+//  DrawPacketQueue.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef DrawPacketQueue_hpp
+#define DrawPacketQueue_hpp
+
+#include "PackedLookupTable.hpp"
+
+#include <vector>
+#include <cstdint>
+
+namespace EARenderer {
+
+    /// Sub mesh draws of a render pass, ordered by 64-bit keys so that draws sharing GL state end up next to each other
+    /// and the pass only has to apply state that differs from the previous draw.
+    ///
+    /// Key layout, from the most significant bits:
+    ///  pass (4 bits), program (8 bits), material (24 bits), depth bucket (16 bits), 12 unused bits.
+    class DrawPacketQueue {
+    public:
+        struct Packet {
+            uint64_t key;
+            ID meshInstanceID;
+            ID subMeshID;
+        };
+
+        /// Consecutive packets that are submitted with the same material bound
+        struct MaterialRun {
+            uint32_t material;
+            size_t firstPacket;
+            size_t packetCount;
+        };
+
+    private:
+        std::vector<Packet> mPackets;
+        std::vector<Packet> mScratchPackets;
+
+    public:
+        static uint64_t SortKey(uint8_t pass, uint8_t program, uint32_t material, uint16_t depthBucket);
+
+        /**
+         @param distance distance from the camera
+         @param farClipPlane distance beyond which all draws fall into the last bucket
+         @return bucket of draws sorted front to back
+         */
+        static uint16_t DepthBucket(float distance, float farClipPlane);
+
+        static uint8_t Pass(uint64_t key);
+
+        static uint8_t Program(uint64_t key);
+
+        static uint32_t Material(uint64_t key);
+
+        void clear();
+
+        void add(uint64_t key, ID meshInstanceID, ID subMeshID);
+
+        /**
+         Stable least significant digit radix sort, one byte per pass.
+         Passes over bytes that are the same in all keys are skipped, so unused key bits cost nothing.
+
+         @return number of passes that weren't skipped
+         */
+        size_t sort();
+
+        const std::vector<Packet> &packets() const;
+
+        /**
+         Splits packets, in their current order, into runs that need a material switch only at their start.
+         Packets without a material (0) don't start a run and are drawn with whatever material is bound,
+         so only the first run can have material 0.
+
+         @param runs output array receiving the runs
+         */
+        void materialRuns(std::vector<MaterialRun> &runs) const;
+    };
+
+}
+
+#endif /* DrawPacketQueue_hpp */
@@ -42,12 +42,14 @@ namespace EARenderer {
                 glDrawArraysInstanced(GL_TRIANGLES, VBOOffset, static_cast<GLsizei>(vertexCount), static_cast<GLsizei>(instanceCount));
             }
 
-            void TriangleMesh::Draw(const GLVBODataLocation &location) {
-                glDrawArrays(GL_TRIANGLES, location.offset, static_cast<GLsizei>(location.vertexCount));
+            void Draw(const GLIBODataLocation &location) {
+                glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(location.indexCount), GL_UNSIGNED_INT,
+                        reinterpret_cast<void *>(location.offset * sizeof(GLuint)), static_cast<GLint>(location.baseVertex));
             }
 
-            void TriangleMesh::DrawInstanced(size_t instanceCount, const GLVBODataLocation &location) {
-                glDrawArraysInstanced(GL_TRIANGLES, location.offset, static_cast<GLsizei>(location.vertexCount), static_cast<GLsizei>(instanceCount));
+            void DrawInstanced(size_t instanceCount, const GLIBODataLocation &location) {
+                glDrawElementsInstancedBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(location.indexCount), GL_UNSIGNED_INT,
+                        reinterpret_cast<void *>(location.offset * sizeof(GLuint)), static_cast<GLsizei>(instanceCount), static_cast<GLint>(location.baseVertex));
             }
 
         }
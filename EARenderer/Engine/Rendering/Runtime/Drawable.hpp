@@ -32,9 +32,10 @@ namespace EARenderer {
 
             void DrawInstanced(size_t instanceCount, size_t vertexCount = 1, size_t VBOOffset = 0);
 
-            void Draw(const GLVBODataLocation& location);
+            /// Indexed draws, index buffer is expected to be bound to the current VAO
+            void Draw(const GLIBODataLocation &location);
 
-            void DrawInstanced(size_t instanceCount, const GLVBODataLocation& location);
+            void DrawInstanced(size_t instanceCount, const GLIBODataLocation &location);
         }
 
     }
@@ -0,0 +1,74 @@
+//
+//  FrustumCuller.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "FrustumCuller.hpp"
+
+#include <glm/common.hpp>
+#include <glm/mat3x3.hpp>
+
+namespace EARenderer {
+
+#pragma mark - Lifecycle
+
+    FrustumCuller::FrustumCuller(const Scene *scene, const SharedResourceStorage *resourceStorage)
+            :
+            mScene(scene),
+            mResourceStorage(resourceStorage) {
+    }
+
+#pragma mark - Private Helpers
+
+    void FrustumCuller::gatherWorldBoundingBoxes() {
+        mCandidates.clear();
+        mBoxes.clear();
+
+        for (ID instanceID : mScene->meshInstances()) {
+            auto &instance = mScene->meshInstances()[instanceID];
+            auto &subMeshes = mResourceStorage->mesh(instance.meshID()).subMeshes();
+            glm::mat4 modelMatrix = instance.transformation().modelMatrix();
+
+            // Transformed box is bounded by the transformed center plus the extents projected onto each axis (Arvo's method)
+            glm::mat3 absoluteLinearPart(glm::abs(glm::vec3(modelMatrix[0])), glm::abs(glm::vec3(modelMatrix[1])), glm::abs(glm::vec3(modelMatrix[2])));
+
+            for (ID subMeshID : subMeshes) {
+                const AxisAlignedBox3D &box = subMeshes[subMeshID].boundingBox();
+
+                glm::vec3 center = glm::vec3(modelMatrix * glm::vec4(box.center(), 1.0f));
+                glm::vec3 extents = absoluteLinearPart * ((box.max - box.min) * 0.5f);
+
+                mCandidates.push_back({instanceID, subMeshID, AxisAlignedBox3D()});
+                mBoxes.push_back(center - extents, center + extents);
+            }
+        }
+    }
+
+#pragma mark - Culling
+
+    const std::vector<FrustumCuller::VisibleSubMesh> &FrustumCuller::cull(const Frustum &frustum) {
+        gatherWorldBoundingBoxes();
+        mVisibleSubMeshes.clear();
+
+        frustum.intersectingBoxes(mBoxes, mIntersectingIndices);
+
+        for (size_t index : mIntersectingIndices) {
+            VisibleSubMesh visibleSubMesh = mCandidates[index];
+            visibleSubMesh.boundingBox = mBoxes.box(index);
+            mVisibleSubMeshes.push_back(visibleSubMesh);
+        }
+
+        mStatistics.submittedDrawCount = mVisibleSubMeshes.size();
+        mStatistics.frustumCulledDrawCount = mCandidates.size() - mVisibleSubMeshes.size();
+
+        return mVisibleSubMeshes;
+    }
+
+    const CullingStatistics &FrustumCuller::statistics() const {
+        return mStatistics;
+    }
+
+}
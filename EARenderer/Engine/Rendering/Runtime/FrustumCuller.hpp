@@ -0,0 +1,62 @@
+//
+//  FrustumCuller.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef FrustumCuller_hpp
+#define FrustumCuller_hpp
+
+#include "Scene.hpp"
+#include "SharedResourceStorage.hpp"
+#include "Frustum.hpp"
+#include "CullingStatistics.hpp"
+
+#include <vector>
+
+namespace EARenderer {
+
+    /// Tests world space bounding boxes of all sub meshes in the scene against a frustum.
+    /// Boxes are laid out as separate arrays of components, so that each plane is tested
+    /// against a whole batch of boxes in a loop the compiler turns into SIMD code, see Frustum::intersectingBoxes().
+    class FrustumCuller {
+    public:
+        struct VisibleSubMesh {
+            ID meshInstanceID;
+            ID subMeshID;
+            AxisAlignedBox3D boundingBox;
+        };
+
+    private:
+        const Scene *mScene;
+        const SharedResourceStorage *mResourceStorage;
+
+        std::vector<VisibleSubMesh> mCandidates;
+        AxisAlignedBox3DArray mBoxes;
+        std::vector<size_t> mIntersectingIndices;
+
+        std::vector<VisibleSubMesh> mVisibleSubMeshes;
+        CullingStatistics mStatistics;
+
+        void gatherWorldBoundingBoxes();
+
+    public:
+        FrustumCuller(const Scene *scene, const SharedResourceStorage *resourceStorage);
+
+        /**
+         @return sub meshes intersecting the frustum along with their world space bounding boxes,
+         grouped by mesh instance in the scene's order
+         */
+        const std::vector<VisibleSubMesh> &cull(const Frustum &frustum);
+
+        /**
+         @return draw counts of the last cull() call
+         */
+        const CullingStatistics &statistics() const;
+    };
+
+}
+
+#endif /* FrustumCuller_hpp */
@@ -0,0 +1,41 @@
+//
+//  GeometryTraffic.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "GeometryTraffic.hpp"
+#include "PackedVertex1P1N2UV1T1BT.hpp"
+
+#include <cstdio>
+
+namespace EARenderer {
+
+    void GeometryTraffic::reset() {
+        *this = GeometryTraffic();
+    }
+
+    void GeometryTraffic::account(const GLIBODataLocation &location, size_t instanceCount) {
+        drawCount++;
+        indexBytes += location.indexCount * sizeof(GLuint) * instanceCount;
+        packedVertexBytes += location.vertexCount * sizeof(PackedVertex1P1N2UV1T1BT) * instanceCount;
+        fullPrecisionVertexBytes += location.vertexCount * sizeof(Vertex1P1N2UV1T1BT) * instanceCount;
+    }
+
+    void GeometryTraffic::account(const GeometryTraffic &traffic) {
+        drawCount += traffic.drawCount;
+        indexBytes += traffic.indexBytes;
+        packedVertexBytes += traffic.packedVertexBytes;
+        fullPrecisionVertexBytes += traffic.fullPrecisionVertexBytes;
+    }
+
+    std::string GeometryTraffic::description() const {
+        char description[256];
+        snprintf(description, sizeof(description), "%zu draws, %zu KB of indices, %zu KB of packed vertices (%zu KB with full precision vertices)",
+                drawCount, indexBytes / 1024, packedVertexBytes / 1024, fullPrecisionVertexBytes / 1024);
+        return description;
+    }
+
+}
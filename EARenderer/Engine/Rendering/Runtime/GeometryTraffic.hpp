@@ -0,0 +1,39 @@
+//
+//  GeometryTraffic.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef GeometryTraffic_hpp
+#define GeometryTraffic_hpp
+
+#include "GLElementArrayBuffer.hpp"
+
+#include <string>
+
+namespace EARenderer {
+
+    /// CPU side accounting of index and vertex bytes a render pass makes the GPU fetch.
+    /// Every referenced vertex is assumed to be fetched once per instance.
+    /// Vertex bytes are tracked for both packed and full precision layouts to compare the two formats.
+    struct GeometryTraffic {
+        size_t drawCount = 0;
+        size_t indexBytes = 0;
+        size_t packedVertexBytes = 0;
+        size_t fullPrecisionVertexBytes = 0;
+
+        void reset();
+
+        void account(const GLIBODataLocation &location, size_t instanceCount = 1);
+
+        /// Adds up traffic accounted elsewhere, such as draws of a command list submitted several times
+        void account(const GeometryTraffic &traffic);
+
+        std::string description() const;
+    };
+
+}
+
+#endif /* GeometryTraffic_hpp */
@@ -8,6 +8,9 @@
 
 #include "SceneGBufferConstructor.hpp"
 #include "Drawable.hpp"
+#include "GLTextureUnitManager.hpp"
+
+#include <glm/geometric.hpp>
 
 namespace EARenderer {
 
@@ -24,14 +27,21 @@ namespace EARenderer {
             mGPUResourceController(gpuResourceController),
             mFramebuffer(settings.displayedFrameResolution),
             mDepthRenderbuffer(settings.displayedFrameResolution),
-            mGBuffer(std::make_unique<SceneGBuffer>(settings.displayedFrameResolution)) {
+            mGBuffer(std::make_unique<SceneGBuffer>(settings.displayedFrameResolution)),
+            mFrustumCuller(scene, resourceStorage) {
 
         mFramebuffer.attachTexture(mGBuffer->materialData);
         mFramebuffer.attachTexture(mGBuffer->HiZBuffer);
         mFramebuffer.attachDepthTexture(mGBuffer->depthBuffer);
 
-        // Preallocate HiZ buffer mipmaps
-//        mGBuffer->HiZBuffer.generateMipMaps();
+        // Preallocate HiZ buffer mipmaps down to the one used for occlusion tests
+        uint8_t occlusionTestMipLevel = 0;
+        while (GLTexture::EstimatedMipSize(settings.displayedFrameResolution, occlusionTestMipLevel).width > OcclusionTestResolution) {
+            occlusionTestMipLevel++;
+        }
+        mGBuffer->HiZBuffer.generateMipMaps(occlusionTestMipLevel);
+
+        rebuildMaterialSortIndices();
     }
 
 #pragma mark -
@@ -40,20 +50,46 @@ namespace EARenderer {
         return mGBuffer.get();
     }
 
+    const GeometryTraffic &SceneGBufferConstructor::geometryTraffic() const {
+        return mGeometryTraffic;
+    }
+
+    const CullingStatistics &SceneGBufferConstructor::cullingStatistics() const {
+        return mCullingStatistics;
+    }
+
     void SceneGBufferConstructor::setRenderingSettings(const RenderingSettings &settings) {
         mSettings = settings;
     }
 
+    void SceneGBufferConstructor::rebuildMaterialSortIndices() {
+        mMaterialSortIndices.clear();
+        mMaterialsBySortIndex.clear();
+
+        // Ordered set keeps indices independent of the order instances were added in
+        std::set<MaterialReference> materials;
+        for (ID instanceID : mScene->meshInstances()) {
+            auto &instance = mScene->meshInstances()[instanceID];
+            for (ID subMeshID : mResourceStorage->mesh(instance.meshID()).subMeshes()) {
+                if (auto materialRef = materialReference(instance, subMeshID)) {
+                    materials.insert(*materialRef);
+                }
+            }
+        }
+
+        for (auto &materialRef : materials) {
+            materialSortIndex(materialRef);
+        }
+    }
+
 #pragma mark - Rendering
 #pragma mark - Private Helpers
 
-    void SceneGBufferConstructor::generateGBuffer() {
+    void SceneGBufferConstructor::bindGBufferTargets() {
         mFramebuffer.bind();
         mFramebuffer.viewport().apply();
 
         mGBufferShader.bind();
-        mGBufferShader.setCamera(*mScene->camera());
-        mGBufferShader.setSettings(mSettings);
 
         // Attach 0 mip again after HiZ buffer construction
         mFramebuffer.redirectRenderingToTexturesMip(
@@ -62,66 +98,198 @@ namespace EARenderer {
         );
 
         mGPUResourceController->meshVAO()->bind();
+    }
 
-        for (ID instanceID : mScene->meshInstances()) {
-            auto &instance = mScene->meshInstances()[instanceID];
-            renderMeshInstance(instance);
+    void SceneGBufferConstructor::generateGBuffer() {
+        bindGBufferTargets();
+        mGBufferShader.setCamera(*mScene->camera());
+        mGBufferShader.setSettings(mSettings);
+
+        // Pixels not covered by geometry have to be the farthest ones for occlusion tests
+        const GLfloat farthestDepth[] = {1.0, 1.0, 1.0, 1.0};
+        glClearBufferfv(GL_COLOR, 1, farthestDepth);
+
+        const auto &subMeshesInFrustum = mFrustumCuller.cull(mScene->camera()->frustum());
+        mCullingStatistics = mFrustumCuller.statistics();
+
+        std::vector<FrustumCuller::VisibleSubMesh> firstPhaseSubMeshes;
+        for (auto &subMesh : subMeshesInFrustum) {
+            if (mPreviouslyVisibleSubMeshes.count({subMesh.meshInstanceID, subMesh.subMeshID})) {
+                firstPhaseSubMeshes.push_back(subMesh);
+            }
         }
 
-        for (ID lightID : mScene->pointLights()) {
-            const PointLight &light = mScene->pointLights()[lightID];
+        renderSubMeshes(firstPhaseSubMeshes);
 
-            if (!light.isEnabled()) {
+        // Rest of the sub meshes are tested against the depth drawn so far, seen through the same camera
+        generateHiZBuffer();
+        readDepthPyramid();
+        bindGBufferTargets();
+
+        // Sub meshes drawn in the first phase are tested as well, the ones hidden by other first phase sub meshes
+        // won't be drawn first in the next frame
+        std::set<std::pair<ID, ID>> visibleSubMeshes;
+        std::vector<FrustumCuller::VisibleSubMesh> secondPhaseSubMeshes;
+        glm::mat4 viewProjection = mScene->camera()->viewProjectionMatrix();
+
+        for (auto &subMesh : subMeshesInFrustum) {
+            if (!mDepthPyramid.isVisible(subMesh.boundingBox, viewProjection)) {
                 continue;
             }
 
-            if (light.meshInstance) {
-                Transformation lightBaseTransform(glm::vec3(1.0), light.position(), glm::quat());
-                renderMeshInstance(*light.meshInstance, &lightBaseTransform);
+            auto key = std::make_pair(subMesh.meshInstanceID, subMesh.subMeshID);
+            visibleSubMeshes.insert(key);
+
+            if (!mPreviouslyVisibleSubMeshes.count(key)) {
+                secondPhaseSubMeshes.push_back(subMesh);
             }
         }
+
+        renderSubMeshes(secondPhaseSubMeshes);
+
+        mPreviouslyVisibleSubMeshes = std::move(visibleSubMeshes);
+
+        size_t submittedDrawCount = firstPhaseSubMeshes.size() + secondPhaseSubMeshes.size();
+        mCullingStatistics.submittedDrawCount = submittedDrawCount;
+        mCullingStatistics.occlusionCulledDrawCount = subMeshesInFrustum.size() - submittedDrawCount;
+
+        renderLightMeshInstances();
+
+        // Lighting and post processing passes need the HiZ buffer of the complete depth
+        generateHiZBuffer();
+    }
+
+    std::optional<MaterialReference> SceneGBufferConstructor::materialReference(const MeshInstance &instance, ID subMeshID) const {
+        if (instance.materialReference) {
+            return instance.materialReference;
+        }
+        return instance.materialReferenceForSubMeshID(subMeshID);
     }
 
-    void SceneGBufferConstructor::renderMeshInstance(const MeshInstance &instance, const Transformation *baseTransform) {
-        auto &subMeshes = mResourceStorage->mesh(instance.meshID()).subMeshes();
+    uint32_t SceneGBufferConstructor::materialSortIndex(const std::optional<MaterialReference> &materialRef) {
+        if (!materialRef) {
+            return 0;
+        }
 
-        if (baseTransform) {
-            mGBufferShader.setModelMatrix(instance.transformation().combinedWith(*baseTransform).modelMatrix());
-        } else {
-            mGBufferShader.setModelMatrix(instance.transformation().modelMatrix());
+        auto it = mMaterialSortIndices.find(*materialRef);
+        if (it != mMaterialSortIndices.end()) {
+            return it->second;
         }
 
-        for (ID subMeshID : subMeshes) {
-            auto &subMesh = subMeshes[subMeshID];
+        mMaterialsBySortIndex.push_back(*materialRef);
+        uint32_t index = uint32_t(mMaterialsBySortIndex.size());
+        mMaterialSortIndices[*materialRef] = index;
+        return index;
+    }
 
-            mGBufferShader.ensureSamplerValidity([&] {
-                auto materialRef = instance.materialReference;
+    void SceneGBufferConstructor::setMaterial(const MaterialReference &materialRef) {
+        mGBufferShader.ensureSamplerValidity([&] {
+            switch (materialRef.first) {
+                case MaterialType::CookTorrance:
+                    mGBufferShader.setMaterial(mResourceStorage->cookTorranceMaterial(materialRef.second));
+                    break;
+                case MaterialType::Emissive:
+                    mGBufferShader.setMaterial(mResourceStorage->emissiveMaterial(materialRef.second));
+                    break;
+            }
+        });
+    }
 
-                if (!materialRef) {
-                    materialRef = instance.materialReferenceForSubMeshID(subMeshID);
-                }
+    void SceneGBufferConstructor::renderSubMeshes(const std::vector<FrustumCuller::VisibleSubMesh> &subMeshes) {
+        const Camera &camera = *mScene->camera();
+        mDrawPackets.clear();
+
+        // Single pass and program, draws are ordered by material and then front to back
+        for (auto &visibleSubMesh : subMeshes) {
+            auto &instance = mScene->meshInstances()[visibleSubMesh.meshInstanceID];
+            uint32_t material = materialSortIndex(materialReference(instance, visibleSubMesh.subMeshID));
+            float distance = glm::length(visibleSubMesh.boundingBox.center() - camera.position());
+            uint64_t key = DrawPacketQueue::SortKey(0, 0, material, DrawPacketQueue::DepthBucket(distance, camera.farClipPlane()));
+            mDrawPackets.add(key, visibleSubMesh.meshInstanceID, visibleSubMesh.subMeshID);
+        }
 
-                if (!materialRef) {
-                    return;
-                }
+        mDrawPackets.sort();
 
-                switch (materialRef->first) {
-                    case MaterialType::CookTorrance:
-                        mGBufferShader.setMaterial(mResourceStorage->cookTorranceMaterial(materialRef->second));
-                        break;
-                    case MaterialType::Emissive:
-                        mGBufferShader.setMaterial(mResourceStorage->emissiveMaterial(materialRef->second));
-                        break;
-                }
-            });
+        const auto &packets = mDrawPackets.packets();
+        const MeshInstance *currentInstance = nullptr;
+        glm::mat4 modelMatrix;
+
+        mDrawCommands.clear();
+        for (auto &packet : packets) {
+            auto &instance = mScene->meshInstances()[packet.meshInstanceID];
+            if (&instance != currentInstance) {
+                modelMatrix = instance.transformation().modelMatrix();
+                currentInstance = &instance;
+            }
+            addSubMesh(instance, packet.subMeshID, modelMatrix);
+        }
+
+        if (mDrawCommands.commandCount() == 0) {
+            return;
+        }
+
+        mDrawCommands.upload();
+        mDrawCommands.bindDrawData(mGBufferShader);
+
+        // Commands follow the packet order, every run of draws sharing a material is submitted at once
+        mDrawPackets.materialRuns(mMaterialRuns);
+        for (auto &run : mMaterialRuns) {
+            if (run.material != 0) {
+                setMaterial(mMaterialsBySortIndex[run.material - 1]);
+            }
+            mDrawCommands.submit(run.firstPacket, run.packetCount, mGBufferShader);
+        }
+    }
+
+    void SceneGBufferConstructor::renderLightMeshInstances() {
+        mDrawCommands.clear();
+        mLightMeshMaterials.clear();
 
-            Drawable::TriangleMesh::Draw(mGPUResourceController->subMeshVBODataLocation(instance.meshID(), subMeshID));
+        for (ID lightID : mScene->pointLights()) {
+            const PointLight &light = mScene->pointLights()[lightID];
+
+            if (!light.isEnabled() || !light.meshInstance) {
+                continue;
+            }
+
+            const MeshInstance &instance = *light.meshInstance;
+            Transformation lightBaseTransform(glm::vec3(1.0), light.position(), glm::quat());
+            glm::mat4 modelMatrix = instance.transformation().combinedWith(lightBaseTransform).modelMatrix();
+
+            for (ID subMeshID : mResourceStorage->mesh(instance.meshID()).subMeshes()) {
+                addSubMesh(instance, subMeshID, modelMatrix);
+                mLightMeshMaterials.push_back(materialReference(instance, subMeshID));
+            }
         }
+
+        if (mDrawCommands.commandCount() == 0) {
+            return;
+        }
+
+        // Meshes of all lights go through a single upload
+        mDrawCommands.upload();
+        mDrawCommands.bindDrawData(mGBufferShader);
+
+        for (size_t i = 0; i < mLightMeshMaterials.size(); i++) {
+            if (mLightMeshMaterials[i]) {
+                setMaterial(*mLightMeshMaterials[i]);
+            }
+            mDrawCommands.submit(i, 1, mGBufferShader);
+        }
+    }
+
+    void SceneGBufferConstructor::addSubMesh(const MeshInstance &instance, ID subMeshID, const glm::mat4 &modelMatrix) {
+        auto &subMesh = mResourceStorage->mesh(instance.meshID()).subMeshes()[subMeshID];
+        const auto &location = mGPUResourceController->subMeshIBODataLocation(instance.meshID(), subMeshID);
+        mDrawCommands.add(location, 1, modelMatrix, subMesh.positionDequantizationMatrix());
+        mGeometryTraffic.account(location);
     }
 
     void SceneGBufferConstructor::generateHiZBuffer() {
         // Disable depth writes to not pollute depth buffer with HIZ buffer quads
+        // and depth testing to not lose HiZ texels behind the nearest geometry
         glDepthMask(GL_FALSE);
+        glDisable(GL_DEPTH_TEST);
 
         mFramebuffer.bind();
 
@@ -144,14 +312,30 @@ namespace EARenderer {
             Drawable::TriangleStripQuad::Draw();
         }
 
+        glEnable(GL_DEPTH_TEST);
         glDepthMask(GL_TRUE);
     }
 
+    void SceneGBufferConstructor::readDepthPyramid() {
+        uint16_t mipLevel = mGBuffer->HiZBufferMipCount;
+        Size2D mipSize = GLTexture::EstimatedMipSize(mGBuffer->HiZBuffer.size(), mipLevel);
+
+        DepthPyramid::Level level;
+        level.width = uint32_t(mipSize.width);
+        level.height = uint32_t(mipSize.height);
+        level.depths.resize(size_t(level.width) * size_t(level.height));
+
+        GLTextureUnitManager::Shared().bindTextureToActiveUnit(mGBuffer->HiZBuffer);
+        glGetTexImage(GL_TEXTURE_2D, mipLevel, GL_RED, GL_FLOAT, level.depths.data());
+
+        mDepthPyramid = DepthPyramid(mGBuffer->HiZBuffer.size(), mipLevel, std::move(level));
+    }
+
 #pragma mark - Public Interface
 
     void SceneGBufferConstructor::render() {
+        mGeometryTraffic.reset();
         generateGBuffer();
-//        generateHiZBuffer();
     }
 
 }
@@ -17,14 +17,34 @@
 #include "GLSLHiZBuffer.hpp"
 #include "RenderingSettings.hpp"
 #include "SceneGBuffer.hpp"
+#include "GeometryTraffic.hpp"
+#include "FrustumCuller.hpp"
+#include "DepthPyramid.hpp"
+#include "CullingStatistics.hpp"
+#include "DrawPacketQueue.hpp"
+#include "DrawCommandBuilder.hpp"
 
 #include <memory>
+#include <set>
+#include <map>
+#include <utility>
+#include <optional>
 #include "GPUResourceController.hpp"
 
 namespace EARenderer {
 
+    /// Renders the scene into the G-buffer in two phases to skip occluded sub meshes.
+    /// The first phase draws sub meshes that were visible in the previous frame.
+    /// The HiZ buffer is then built from the depth of the first phase and its coarsest level is read back,
+    /// the rest of the sub meshes inside the frustum are tested against it with the current camera,
+    /// and the second phase draws the ones that turned out to be visible.
+    /// The read back level is tiny, so waiting for it costs less than drawing everything,
+    /// and sub meshes disoccluded by camera movement show up in the same frame.
     class SceneGBufferConstructor {
     private:
+        /// Occlusion tests read back the first HiZ level that is at most this wide
+        static constexpr float OcclusionTestResolution = 256.0;
+
         const Scene *mScene;
         const SharedResourceStorage *mResourceStorage;
         const GPUResourceController *mGPUResourceController;
@@ -37,13 +57,53 @@ namespace EARenderer {
         GLSLHiZBuffer mHiZBufferShader;
 
         std::unique_ptr<SceneGBuffer> mGBuffer;
+        GeometryTraffic mGeometryTraffic;
+        FrustumCuller mFrustumCuller;
+        std::set<std::pair<ID, ID>> mPreviouslyVisibleSubMeshes;
+        CullingStatistics mCullingStatistics;
+        DrawPacketQueue mDrawPackets;
+        std::vector<DrawPacketQueue::MaterialRun> mMaterialRuns;
+        DrawCommandBuilder mDrawCommands;
+
+        DepthPyramid mDepthPyramid;
+
+        // Sort keys refer to materials by dense indices starting from 1, 0 stands for sub meshes without a material.
+        // Materials assigned after the last rebuild are appended.
+        std::map<MaterialReference, uint32_t> mMaterialSortIndices;
+        std::vector<MaterialReference> mMaterialsBySortIndex;
+
+        // Materials of light mesh draws, in the order of their commands
+        std::vector<std::optional<MaterialReference>> mLightMeshMaterials;
+
+        std::optional<MaterialReference> materialReference(const MeshInstance &instance, ID subMeshID) const;
+
+        uint32_t materialSortIndex(const std::optional<MaterialReference> &materialRef);
+
+        void setMaterial(const MaterialReference &materialRef);
 
         void generateGBuffer();
 
-        void renderMeshInstance(const MeshInstance &instance, const Transformation *baseTransform = nullptr);
+        /**
+         Binds the G-buffer shader and redirects rendering to the base level of the G-buffer textures
+         */
+        void bindGBufferTargets();
+
+        void renderSubMeshes(const std::vector<FrustumCuller::VisibleSubMesh> &subMeshes);
+
+        /**
+         Draws meshes representing point lights
+         */
+        void renderLightMeshInstances();
+
+        void addSubMesh(const MeshInstance &instance, ID subMeshID, const glm::mat4 &modelMatrix);
 
         void generateHiZBuffer();
 
+        /**
+         Rebuilds the depth pyramid from the coarsest HiZ level. Waits for the GPU to finish the HiZ buffer.
+         */
+        void readDepthPyramid();
+
     public:
         SceneGBufferConstructor(
                 const Scene *scene,
@@ -54,6 +114,22 @@ namespace EARenderer {
 
         const SceneGBuffer *GBuffer() const;
 
+        /**
+         Reassigns sort indices to the materials used by the scene's mesh instances, dropping materials no longer in use.
+         Called on construction, call again after loading a different scene into the same Scene object.
+         */
+        void rebuildMaterialSortIndices();
+
+        /**
+         @return geometry fetched during the last render() call
+         */
+        const GeometryTraffic &geometryTraffic() const;
+
+        /**
+         @return draws of scene's mesh instances submitted and skipped by frustum and occlusion culling during the last render() call
+         */
+        const CullingStatistics &cullingStatistics() const;
+
         void setRenderingSettings(const RenderingSettings &settings);
 
         void render();
@@ -62,6 +62,14 @@ namespace EARenderer {
         return mShadowCascades;
     }
 
+    const GeometryTraffic &ShadowMapper::directionalGeometryTraffic() const {
+        return mDirectionalGeometryTraffic;
+    }
+
+    const GeometryTraffic &ShadowMapper::omnidirectionalGeometryTraffic() const {
+        return mOmnidirectionalGeometryTraffic;
+    }
+
     const GLDepthTextureCubemap &ShadowMapper::shadowMapForPointLight(ID pointLightID) const {
         auto it = mOmnidirectionalShadowMaps.find(pointLightID);
         if (it == mOmnidirectionalShadowMaps.end()) {
@@ -88,6 +96,26 @@ namespace EARenderer {
 
 #pragma mark - Private Helpers
 
+    void ShadowMapper::buildDrawCommands(DrawCommandBuilder &builder, size_t instanceCount) {
+        builder.clear();
+        mDrawTraffic.reset();
+
+        for (ID meshInstanceID : mScene->meshInstances()) {
+            const auto &instance = mScene->meshInstances()[meshInstanceID];
+            const auto &subMeshes = mResourceStorage->mesh(instance.meshID()).subMeshes();
+            glm::mat4 modelMatrix = instance.transformation().modelMatrix();
+
+            for (ID subMeshID : subMeshes) {
+                const auto &subMesh = subMeshes[subMeshID];
+                const auto &location = mGPUResourceController->subMeshIBODataLocation(instance.meshID(), subMeshID);
+                builder.add(location, instanceCount, modelMatrix, subMesh.positionDequantizationMatrix());
+                mDrawTraffic.account(location, instanceCount);
+            }
+        }
+
+        builder.upload();
+    }
+
     void ShadowMapper::renderDirectionalShadowMaps() {
         if (!mScene->sun().isEnabled()) {
             return;
@@ -101,23 +129,23 @@ namespace EARenderer {
         GLViewport(mSettings.directionalShadowMapResolution).apply();
         mShadowFramebuffer.clear(GLFramebuffer::UnderlyingBuffer::Depth);
 
-        for (ID meshInstanceID : mScene->meshInstances()) {
-            const auto &instance = mScene->meshInstances()[meshInstanceID];
-            const auto &subMeshes = mResourceStorage->mesh(instance.meshID()).subMeshes();
-
-            mShadowMapShader.setModelMatrix(instance.transformation().modelMatrix());
-
-            for (ID subMeshID : subMeshes) {
-                const auto &subMesh = subMeshes[subMeshID];
-                const auto &location = mGPUResourceController->subMeshVBODataLocation(instance.meshID(), subMeshID);
-                Drawable::TriangleMesh::DrawInstanced(mShadowCascades.amount, location);
-            }
+        buildDrawCommands(mDrawCommands, mShadowCascades.amount);
+        if (mDrawCommands.commandCount() == 0) {
+            return;
         }
+
+        mDrawCommands.bindDrawData(mShadowMapShader);
+        mDrawCommands.submit(mShadowMapShader);
+        mDirectionalGeometryTraffic.account(mDrawTraffic);
     }
 
     void ShadowMapper::renderOmnidirectionalShadowMaps() {
         mShadowMapShader.bind();
 
+        // 6 instances for 6 cubemap faces, commands are the same for every light
+        buildDrawCommands(mDrawCommands, 6);
+        mDrawCommands.bindDrawData(mShadowMapShader);
+
         mShadowFramebuffer.bind();
         GLViewport(mSettings.omnidirectionalShadowMapResolution).apply();
 
@@ -135,18 +163,8 @@ namespace EARenderer {
             auto matrices = light.viewProjectionMatrices();
             mShadowMapShader.setViewProjectionMatrices({matrices.begin(), matrices.end()});
 
-            for (ID meshInstanceID : mScene->meshInstances()) {
-                auto &instance = mScene->meshInstances()[meshInstanceID];
-                auto &subMeshes = mResourceStorage->mesh(instance.meshID()).subMeshes();
-
-                mShadowMapShader.setModelMatrix(instance.transformation().modelMatrix());
-
-                for (ID subMeshID : subMeshes) {
-                    const auto &subMesh = subMeshes[subMeshID];
-                    const auto &location = mGPUResourceController->subMeshVBODataLocation(instance.meshID(), subMeshID);
-                    Drawable::TriangleMesh::DrawInstanced(6, location); // 6 for 6 cubemap faces
-                }
-            }
+            mDrawCommands.submit(mShadowMapShader);
+            mOmnidirectionalGeometryTraffic.account(mDrawTraffic);
         }
     }
 
@@ -208,6 +226,9 @@ namespace EARenderer {
 #pragma mark - Rendering
 
     void ShadowMapper::render() {
+        mDirectionalGeometryTraffic.reset();
+        mOmnidirectionalGeometryTraffic.reset();
+
         mGPUResourceController->meshVAO()->bind();
         mShadowCascades = mScene->sun().cascadesForBoundingBox(mScene->boundingBox(), mCascadeCount);
 //        mShadowCascades = mScene->sun().cascadesForCamera(*mScene->camera(), 1);
@@ -16,6 +16,7 @@
 #include "GLTextureCubemapArray.hpp"
 #include "GLTexture2DArray.hpp"
 #include "GaussianBlurEffect.hpp"
+#include "GeometryTraffic.hpp"
 #include "RenderingSettings.hpp"
 #include "SceneGBuffer.hpp"
 #include "GLSLShadowMap.hpp"
@@ -26,6 +27,7 @@
 #include <memory>
 #include <unordered_map>
 #include "GPUResourceController.hpp"
+#include "DrawCommandBuilder.hpp"
 
 namespace EARenderer {
 
@@ -57,9 +59,21 @@ namespace EARenderer {
         std::unordered_map<ID, GLDepthTextureCubemap> mOmnidirectionalShadowMaps;
         std::unordered_map<ID, GLFloatTexture2D<GLTexture::Float::R16F>> mOmnidirectionalPenumbras;
 
+        GeometryTraffic mDirectionalGeometryTraffic;
+        GeometryTraffic mOmnidirectionalGeometryTraffic;
+
+        DrawCommandBuilder mDrawCommands;
+        // Traffic of a single submission of the draw commands
+        GeometryTraffic mDrawTraffic;
+
         GaussianBlurEffect mBlurEffect;
         GLSampler mBilinearSampler;
 
+        /**
+         Fills the builder with draws of all sub meshes of the scene and uploads them, accounting a single submission in mDrawTraffic
+         */
+        void buildDrawCommands(DrawCommandBuilder &builder, size_t instanceCount);
+
         void renderDirectionalPenumbra();
 
         void renderOmnidirectionalPenumbras();
@@ -89,6 +103,16 @@ namespace EARenderer {
 
         const FrustumCascades &cascades() const;
 
+        /**
+         @return geometry fetched while rendering cascaded shadow maps during the last render() call
+         */
+        const GeometryTraffic &directionalGeometryTraffic() const;
+
+        /**
+         @return geometry fetched while rendering cube shadow maps during the last render() call
+         */
+        const GeometryTraffic &omnidirectionalGeometryTraffic() const;
+
         void render();
     };
 
@@ -43,7 +43,15 @@ namespace EARenderer {
                     GLVertexAttribute::UniqueAttribute(sizeof(Color), 4),
                     GLVertexAttribute::UniqueAttribute(sizeof(float), 1)
             };
-            mSurfelClusterVAOs.emplace_back(surfelData->surfels().data() + cluster.surfelOffset, cluster.surfelCount, attributes.data(), attributes.size());
+
+            // Debug rendering consumes interleaved vertices, so gather cluster's surfels from the columns
+            std::vector<Surfel> clusterSurfels;
+            clusterSurfels.reserve(cluster.surfelCount);
+            for (size_t i = cluster.surfelOffset; i < cluster.surfelOffset + cluster.surfelCount; i++) {
+                clusterSurfels.push_back(surfelData->surfel(i));
+            }
+
+            mSurfelClusterVAOs.emplace_back(clusterSurfels.data(), clusterSurfels.size(), attributes.data(), attributes.size());
             mSurfelClusterColors.emplace_back(Color(distribution(engine), distribution(engine), distribution(engine)));
         }
     }
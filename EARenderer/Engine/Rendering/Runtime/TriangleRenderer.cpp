@@ -31,11 +31,11 @@ namespace EARenderer {
             auto &subMeshes = mResourceStorage->mesh(instance.meshID()).subMeshes();
 
             glm::mat4 mvp = viewProjection * instance.modelMatrix();
-            mTriangleRenderingShader.setModelViewProjectionMatrix(mvp);
 
             for (ID subMeshID : subMeshes) {
                 auto &subMesh = subMeshes[subMeshID];
-                Drawable::TriangleMesh::Draw(mGPUResourceController->subMeshVBODataLocation(instance.meshID(), subMeshID));
+                mTriangleRenderingShader.setModelViewProjectionMatrix(mvp * subMesh.positionDequantizationMatrix());
+                Drawable::TriangleMesh::Draw(mGPUResourceController->subMeshIBODataLocation(instance.meshID(), subMeshID));
             }
         }
 
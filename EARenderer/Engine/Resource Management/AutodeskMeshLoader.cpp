@@ -7,6 +7,8 @@
 //
 
 #include "AutodeskMeshLoader.hpp"
+#include "MeshOptimizer.hpp"
+#include "Measurement.hpp"
 #include "StringUtils.hpp"
 
 #include <stdexcept>
@@ -275,6 +277,13 @@ namespace EARenderer {
         for (size_t i = 0; i < rootNode->GetChildCount(); i++) {
             processChildNode(rootNode->GetChild(i));
         }
+
+        MeshOptimizer::Statistics statistics;
+        for (auto &subMesh : subMeshes) {
+            statistics += subMesh.optimize();
+            subMesh.pack();
+        }
+        Measurement::Value(string_format("Optimized mesh %s:", mMeshPath.c_str()), statistics.description());
     }
 
 }
@@ -0,0 +1,167 @@
+//
+//  CookedMesh.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "CookedMesh.hpp"
+#include "BakedDataFile.hpp"
+#include "CRC32.hpp"
+
+#include <algorithm>
+
+namespace EARenderer {
+
+    struct CookedMeshHeader {
+        AxisAlignedBox3D boundingBox;
+        uint32_t nameLength;
+        uint32_t subMeshCount;
+    };
+
+    struct CookedSubMeshEntry {
+        AxisAlignedBox3D boundingBox;
+        float area;
+        uint32_t nameOffset;
+        uint32_t nameLength;
+        uint32_t materialNameOffset;
+        uint32_t materialNameLength;
+        uint32_t reserved;
+        uint64_t vertexOffset;
+        uint64_t vertexCount;
+        uint64_t indexOffset;
+        uint64_t indexCount;
+    };
+
+    static constexpr uint32_t HeaderSectionTag = ctcrc32("mesh.header");
+    static constexpr uint32_t SubMeshesSectionTag = ctcrc32("mesh.subMeshes");
+    static constexpr uint32_t StringsSectionTag = ctcrc32("mesh.strings");
+    static constexpr uint32_t VerticesSectionTag = ctcrc32("mesh.vertices");
+    static constexpr uint32_t IndicesSectionTag = ctcrc32("mesh.indices");
+    // Packed vertices share offsets and counts with full precision ones
+    static constexpr uint32_t PackedVerticesSectionTag = ctcrc32("mesh.packedVertices");
+
+#pragma mark - Reading
+
+    bool CookedMesh::Read(const std::string &filePath, uint64_t sourceHash, std::vector<SubMesh> &subMeshes, std::string &meshName, AxisAlignedBox3D &boundingBox) {
+        try {
+            BakedDataFile file(filePath);
+
+            if (file.contentHash() != sourceHash) {
+                return false;
+            }
+
+            auto header = file.section(HeaderSectionTag);
+            auto entries = file.section(SubMeshesSectionTag);
+            auto strings = file.section(StringsSectionTag);
+            auto vertices = file.section(VerticesSectionTag);
+            auto indices = file.section(IndicesSectionTag);
+            auto packedVertices = file.section(PackedVerticesSectionTag);
+
+            if (header.size != sizeof(CookedMeshHeader) ||
+                    packedVertices.count<PackedVertex1P1N2UV1T1BT>() != vertices.count<Vertex1P1N2UV1T1BT>()) {
+                return false;
+            }
+
+            const CookedMeshHeader &meshHeader = *header.objects<CookedMeshHeader>();
+            if (entries.count<CookedSubMeshEntry>() != meshHeader.subMeshCount || meshHeader.nameLength > strings.size) {
+                return false;
+            }
+
+            auto string = [&](uint32_t offset, uint32_t length) {
+                if ((uint64_t) offset + length > strings.size) {
+                    throw std::out_of_range("String is out of cooked mesh bounds");
+                }
+                return std::string(strings.objects<char>() + offset, length);
+            };
+
+            std::vector<SubMesh> result(meshHeader.subMeshCount);
+
+            for (size_t i = 0; i < result.size(); i++) {
+                const CookedSubMeshEntry &entry = entries.objects<CookedSubMeshEntry>()[i];
+                if (entry.vertexOffset + entry.vertexCount > vertices.count<Vertex1P1N2UV1T1BT>() ||
+                        entry.indexOffset + entry.indexCount > indices.count<uint32_t>()) {
+                    return false;
+                }
+
+                const Vertex1P1N2UV1T1BT *firstVertex = vertices.objects<Vertex1P1N2UV1T1BT>() + entry.vertexOffset;
+                const PackedVertex1P1N2UV1T1BT *firstPackedVertex = packedVertices.objects<PackedVertex1P1N2UV1T1BT>() + entry.vertexOffset;
+                const uint32_t *firstIndex = indices.objects<uint32_t>() + entry.indexOffset;
+
+                // Indices are validated once here, so that the rest of the engine can trust them
+                if (std::any_of(firstIndex, firstIndex + entry.indexCount, [&](uint32_t index) { return index >= entry.vertexCount; })) {
+                    return false;
+                }
+
+                result[i].setName(string(entry.nameOffset, entry.nameLength));
+                result[i].setMaterialName(string(entry.materialNameOffset, entry.materialNameLength));
+                result[i].setVertices(std::vector<Vertex1P1N2UV1T1BT>(firstVertex, firstVertex + entry.vertexCount),
+                        std::vector<uint32_t>(firstIndex, firstIndex + entry.indexCount),
+                        entry.boundingBox, entry.area);
+                result[i].setPackedVertices(std::vector<PackedVertex1P1N2UV1T1BT>(firstPackedVertex, firstPackedVertex + entry.vertexCount));
+            }
+
+            subMeshes = std::move(result);
+            meshName = string(0, meshHeader.nameLength);
+            boundingBox = meshHeader.boundingBox;
+        } catch (const std::exception &) {
+            return false;
+        }
+
+        return true;
+    }
+
+#pragma mark - Writing
+
+    void CookedMesh::Write(const std::string &filePath, uint64_t sourceHash, const std::vector<SubMesh> &subMeshes, const std::string &meshName, const AxisAlignedBox3D &boundingBox) {
+        CookedMeshHeader header{boundingBox, (uint32_t) meshName.size(), (uint32_t) subMeshes.size()};
+
+        // Mesh name goes first into the string blob
+        std::string strings = meshName;
+        std::vector<CookedSubMeshEntry> entries;
+        std::vector<Vertex1P1N2UV1T1BT> vertices;
+        std::vector<uint32_t> indices;
+        std::vector<PackedVertex1P1N2UV1T1BT> packedVertices;
+
+        size_t vertexCount = 0;
+        size_t indexCount = 0;
+        for (auto &subMesh : subMeshes) {
+            vertexCount += subMesh.vertices().size();
+            indexCount += subMesh.indices().size();
+        }
+        vertices.reserve(vertexCount);
+        packedVertices.reserve(vertexCount);
+        indices.reserve(indexCount);
+
+        for (auto &subMesh : subMeshes) {
+            CookedSubMeshEntry entry{};
+            entry.boundingBox = subMesh.boundingBox();
+            entry.area = subMesh.surfaceArea();
+            entry.nameOffset = (uint32_t) strings.size();
+            entry.nameLength = (uint32_t) subMesh.name().size();
+            strings += subMesh.name();
+            entry.materialNameOffset = (uint32_t) strings.size();
+            entry.materialNameLength = (uint32_t) subMesh.materialName().size();
+            strings += subMesh.materialName();
+            entry.vertexOffset = vertices.size();
+            entry.vertexCount = subMesh.vertices().size();
+            vertices.insert(vertices.end(), subMesh.vertices().begin(), subMesh.vertices().end());
+            packedVertices.insert(packedVertices.end(), subMesh.packedVertices().begin(), subMesh.packedVertices().end());
+            entry.indexOffset = indices.size();
+            entry.indexCount = subMesh.indices().size();
+            indices.insert(indices.end(), subMesh.indices().begin(), subMesh.indices().end());
+            entries.push_back(entry);
+        }
+
+        BakedDataFile::Writer writer;
+        writer.addSection(HeaderSectionTag, &header, sizeof(header));
+        writer.addSection(SubMeshesSectionTag, entries);
+        writer.addSection(StringsSectionTag, strings.data(), strings.size());
+        writer.addSection(VerticesSectionTag, vertices);
+        writer.addSection(IndicesSectionTag, indices);
+        writer.addSection(PackedVerticesSectionTag, packedVertices);
+        writer.write(filePath, sourceHash);
+    }
+
+}
@@ -0,0 +1,44 @@
+//
+//  CookedMesh.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef CookedMesh_hpp
+#define CookedMesh_hpp
+
+#include "SubMesh.hpp"
+#include "AxisAlignedBox3D.hpp"
+
+#include <string>
+#include <vector>
+
+namespace EARenderer {
+
+    /// Binary representation of a loaded mesh: sub mesh table with bounding boxes and areas,
+    /// names, raw and packed vertex arrays and index arrays, stored in a BakedDataFile.
+    /// Reading one takes a single mapping and a copy per sub mesh, without any parsing or tangent space reconstruction.
+    class CookedMesh {
+    public:
+        /**
+         Reads sub meshes from a cooked mesh file
+
+         @param filePath path to the cooked mesh
+         @param sourceHash hash of the source file and of the loader that produced the cooked mesh
+         @return false if file is missing, corrupt or was cooked from a different source
+         */
+        static bool Read(const std::string &filePath, uint64_t sourceHash, std::vector<SubMesh> &subMeshes, std::string &meshName, AxisAlignedBox3D &boundingBox);
+
+        /**
+         Writes sub meshes into a cooked mesh file
+
+         @throws std::runtime_error if file could not be written
+         */
+        static void Write(const std::string &filePath, uint64_t sourceHash, const std::vector<SubMesh> &subMeshes, const std::string &meshName, const AxisAlignedBox3D &boundingBox);
+    };
+
+}
+
+#endif /* CookedMesh_hpp */
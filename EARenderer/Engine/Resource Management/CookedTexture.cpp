@@ -0,0 +1,99 @@
+//
+//  CookedTexture.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "CookedTexture.hpp"
+#include "BakedDataFile.hpp"
+#include "CRC32.hpp"
+
+namespace EARenderer {
+
+    struct CookedTextureHeader {
+        MipChain::Content content;
+        uint32_t levelCount;
+    };
+
+    struct CookedLevelEntry {
+        uint32_t width;
+        uint32_t height;
+        uint64_t texelOffset;
+        uint64_t texelCount;
+    };
+
+    static constexpr uint32_t HeaderSectionTag = ctcrc32("texture.header");
+    static constexpr uint32_t LevelsSectionTag = ctcrc32("texture.levels");
+    static constexpr uint32_t TexelsSectionTag = ctcrc32("texture.texels");
+
+#pragma mark - Reading
+
+    bool CookedTexture::Read(const std::string &filePath, uint64_t sourceHash, MipChain &mipChain) {
+        try {
+            BakedDataFile file(filePath);
+
+            if (file.contentHash() != sourceHash) {
+                return false;
+            }
+
+            auto header = file.section(HeaderSectionTag);
+            auto entries = file.section(LevelsSectionTag);
+            auto texels = file.section(TexelsSectionTag);
+
+            if (header.size != sizeof(CookedTextureHeader)) {
+                return false;
+            }
+
+            const CookedTextureHeader &textureHeader = *header.objects<CookedTextureHeader>();
+            if (entries.count<CookedLevelEntry>() != textureHeader.levelCount || textureHeader.levelCount == 0) {
+                return false;
+            }
+
+            uint32_t channels = MipChain::ChannelCount(textureHeader.content);
+            std::vector<MipChain::Level> levels(textureHeader.levelCount);
+
+            for (size_t i = 0; i < levels.size(); i++) {
+                const CookedLevelEntry &entry = entries.objects<CookedLevelEntry>()[i];
+                if (entry.texelOffset + entry.texelCount > texels.size ||
+                        entry.texelCount != uint64_t(entry.width) * entry.height * channels) {
+                    return false;
+                }
+
+                const uint8_t *firstTexel = texels.objects<uint8_t>() + entry.texelOffset;
+                levels[i].width = entry.width;
+                levels[i].height = entry.height;
+                levels[i].texels.assign(firstTexel, firstTexel + entry.texelCount);
+            }
+
+            mipChain = MipChain(textureHeader.content, std::move(levels));
+        } catch (const std::exception &) {
+            return false;
+        }
+
+        return true;
+    }
+
+#pragma mark - Writing
+
+    void CookedTexture::Write(const std::string &filePath, uint64_t sourceHash, const MipChain &mipChain) {
+        CookedTextureHeader header{mipChain.content(), (uint32_t) mipChain.levels().size()};
+
+        std::vector<CookedLevelEntry> entries;
+        std::vector<uint8_t> texels;
+        texels.reserve(mipChain.byteCount());
+
+        for (auto &level : mipChain.levels()) {
+            entries.push_back({level.width, level.height, texels.size(), level.texels.size()});
+            texels.insert(texels.end(), level.texels.begin(), level.texels.end());
+        }
+
+        BakedDataFile::Writer writer;
+        writer.addSection(HeaderSectionTag, &header, sizeof(header));
+        writer.addSection(LevelsSectionTag, entries);
+        writer.addSection(TexelsSectionTag, texels);
+        writer.write(filePath, sourceHash);
+    }
+
+}
@@ -0,0 +1,41 @@
+//
+//  CookedTexture.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef CookedTexture_hpp
+#define CookedTexture_hpp
+
+#include "MipChain.hpp"
+
+#include <string>
+
+namespace EARenderer {
+
+    /// Binary representation of a decoded image with its whole mip chain, stored in a BakedDataFile.
+    /// Reading one takes a single mapping and a copy per level, without any decoding or filtering.
+    class CookedTexture {
+    public:
+        /**
+         Reads a mip chain from a cooked texture file
+
+         @param filePath path to the cooked texture
+         @param sourceHash hash of the source image and of the cooker that produced the cooked texture
+         @return false if file is missing, corrupt or was cooked from a different source
+         */
+        static bool Read(const std::string &filePath, uint64_t sourceHash, MipChain &mipChain);
+
+        /**
+         Writes a mip chain into a cooked texture file
+
+         @throws std::runtime_error if file could not be written
+         */
+        static void Write(const std::string &filePath, uint64_t sourceHash, const MipChain &mipChain);
+    };
+
+}
+
+#endif /* CookedTexture_hpp */
@@ -11,69 +11,64 @@
 namespace EARenderer {
 
     GPUResourceController::GPUResourceController()
-            : mMeshVAO(std::make_unique<GLVertexArray<Vertex1P1N2UV1T1BT>>(nullptr, 1, nullptr, 0)),
-              mUniformBuffer(std::make_unique<GLUniformBuffer>()) {
+            : mMeshVAO(std::make_unique<GLVertexArray<PackedVertex1P1N2UV1T1BT>>(nullptr, 1, nullptr, 0)),
+              mUniformBuffer(std::make_unique<GLUniformRingBuffer>()) {
     }
 
-    const GLVertexArray<Vertex1P1N2UV1T1BT> *GPUResourceController::meshVAO() const {
+    const GLVertexArray<PackedVertex1P1N2UV1T1BT> *GPUResourceController::meshVAO() const {
         return mMeshVAO.get();
     }
 
-    const GLUniformBuffer *GPUResourceController::uniformBuffer() const {
+    const GLUniformRingBuffer *GPUResourceController::uniformBuffer() const {
         return mUniformBuffer.get();
     }
 
     void GPUResourceController::updateMeshVAO(const SharedResourceStorage &resourceStorage) {
-        std::vector<Vertex1P1N2UV1T1BT> vertices;
+        std::vector<PackedVertex1P1N2UV1T1BT> vertices;
+        std::vector<GLuint> indices;
 
+        // Indices stay local to their sub mesh and are offset by the base vertex at draw time
         resourceStorage.iterateMeshes([&](ID meshID) {
             const Mesh &mesh = resourceStorage.mesh(meshID);
             for (ID subMeshID : mesh.subMeshes()) {
                 const SubMesh &subMesh = mesh.subMeshes()[subMeshID];
-                mSubMeshVBODataLocations[meshID][subMeshID] = {vertices.size(), subMesh.vertices().size()};
-                vertices.insert(vertices.end(), subMesh.vertices().begin(), subMesh.vertices().end());
+                mSubMeshIBODataLocations[meshID][subMeshID] = {indices.size(), subMesh.indices().size(), vertices.size(), subMesh.packedVertices().size()};
+                vertices.insert(vertices.end(), subMesh.packedVertices().begin(), subMesh.packedVertices().end());
+                indices.insert(indices.end(), subMesh.indices().begin(), subMesh.indices().end());
             }
         });
 
-        std::array<GLVertexAttribute, 6> attributes{
-                GLVertexAttribute::UniqueAttribute(sizeof(glm::vec4), glm::vec4::length()),
-                GLVertexAttribute::UniqueAttribute(sizeof(glm::vec3), glm::vec3::length()),
-                GLVertexAttribute::UniqueAttribute(sizeof(glm::vec2), glm::vec2::length()),
-                GLVertexAttribute::UniqueAttribute(sizeof(glm::vec3), glm::vec3::length()),
-                GLVertexAttribute::UniqueAttribute(sizeof(glm::vec3), glm::vec3::length()),
-                GLVertexAttribute::UniqueAttribute(sizeof(glm::vec3), glm::vec3::length())
-        };
+        if (vertices.empty() || indices.empty()) {
+            return;
+        }
+
+        auto attributes = PackedVertex1P1N2UV1T1BT::Attributes();
 
-        mMeshVAO = std::make_unique<GLVertexArray<Vertex1P1N2UV1T1BT>>(vertices.data(), vertices.size(), attributes.data(), attributes.size());
+        mMeshVAO = std::make_unique<GLVertexArray<PackedVertex1P1N2UV1T1BT>>(vertices.data(), vertices.size(), indices.data(), indices.size(), attributes.data(), attributes.size());
     }
 
     void GPUResourceController::updateUniformBuffer(const SharedResourceStorage &resourceStorage, const Scene &scene) {
-        auto session = mUniformBuffer->createWritingSession();
-
-        CameraUBOContent cameraContent(*scene.camera());
-//        offset = session.write(reinterpret_cast<std::byte *>(&cameraContent), sizeof(cameraContent), offset);
-
-        std::vector<PointLightUBOContent> pointLightContent;
+        // Previous frame's data stays intact in its own segment until the GPU is done with it
+        mUniformBuffer->beginFrame();
 
         for (ID id : scene.pointLights()) {
             const PointLight &light = scene.pointLights()[id];
-            auto &content = pointLightContent.emplace_back(light);
-            size_t offset = session.enqueueData(reinterpret_cast<std::byte *>(&content), sizeof(content));
-            mPointLightUBODataLocations[id] = {offset, sizeof(content)};
+            PointLightUBOContent content(light);
+            mPointLightUBODataLocations[id] = mUniformBuffer->write(&content, sizeof(content));
         }
 
-        session.flush();
+        mUniformBuffer->finishWriting();
     }
 
-    const GLVBODataLocation &GPUResourceController::subMeshVBODataLocation(ID meshID, ID subMeshID) const {
-        auto subMeshIt = mSubMeshVBODataLocations.find(meshID);
-        if (subMeshIt == mSubMeshVBODataLocations.end()) {
-            throw std::invalid_argument(string_format("VBO location not found for mesh with ID: %d", meshID));
+    const GLIBODataLocation &GPUResourceController::subMeshIBODataLocation(ID meshID, ID subMeshID) const {
+        auto subMeshIt = mSubMeshIBODataLocations.find(meshID);
+        if (subMeshIt == mSubMeshIBODataLocations.end()) {
+            throw std::invalid_argument(string_format("IBO location not found for mesh with ID: %d", meshID));
         }
 
         auto locationIt = subMeshIt->second.find(subMeshID);
         if (locationIt == subMeshIt->second.end()) {
-            throw std::invalid_argument(string_format("VBO location not found for sub mesh with ID: %d", subMeshID));
+            throw std::invalid_argument(string_format("IBO location not found for sub mesh with ID: %d", subMeshID));
         }
 
         return locationIt->second;
@@ -7,9 +7,10 @@
 #define EARENDERER_GPURESOURCECONTROLLER_HPP
 
 #include "GLVertexArray.hpp"
+#include "PackedVertex1P1N2UV1T1BT.hpp"
 #include "Scene.hpp"
 #include "SharedResourceStorage.hpp"
-#include "GLUniformBuffer.hpp"
+#include "GLUniformRingBuffer.hpp"
 
 #include <unordered_map>
 
@@ -17,10 +18,10 @@ namespace EARenderer {
 
     class GPUResourceController {
     private:
-        std::unique_ptr<GLVertexArray<Vertex1P1N2UV1T1BT>> mMeshVAO;
-        std::unique_ptr<GLUniformBuffer> mUniformBuffer;
+        std::unique_ptr<GLVertexArray<PackedVertex1P1N2UV1T1BT>> mMeshVAO;
+        std::unique_ptr<GLUniformRingBuffer> mUniformBuffer;
 
-        std::unordered_map<ID, std::unordered_map<ID, GLVBODataLocation>> mSubMeshVBODataLocations;
+        std::unordered_map<ID, std::unordered_map<ID, GLIBODataLocation>> mSubMeshIBODataLocations;
         std::unordered_map<ID, GLUBODataLocation> mMaterialUBODataLocations;
         std::unordered_map<ID, GLUBODataLocation> mMaterialInstanceUBODataLocations;
         std::unordered_map<ID, GLUBODataLocation> mMeshInstanceUBODataLocations;
@@ -31,15 +32,15 @@ namespace EARenderer {
     public:
         GPUResourceController();
 
-        const GLVertexArray<Vertex1P1N2UV1T1BT> *meshVAO() const;
+        const GLVertexArray<PackedVertex1P1N2UV1T1BT> *meshVAO() const;
 
-        const GLUniformBuffer *uniformBuffer() const;
+        const GLUniformRingBuffer *uniformBuffer() const;
 
         void updateMeshVAO(const SharedResourceStorage &resourceStorage);
 
         void updateUniformBuffer(const SharedResourceStorage &resourceStorage, const Scene &scene);
 
-        const GLVBODataLocation &subMeshVBODataLocation(ID meshID, ID subMeshID) const;
+        const GLIBODataLocation &subMeshIBODataLocation(ID meshID, ID subMeshID) const;
 
         const GLUBODataLocation &cameraUBODataLocation() const;
 
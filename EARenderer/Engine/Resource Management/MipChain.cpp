@@ -0,0 +1,273 @@
+//
+//  MipChain.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "MipChain.hpp"
+#include "StbImage.hpp"
+
+#include <array>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+#include <glm/common.hpp>
+#include <glm/gtc/constants.hpp>
+
+namespace EARenderer {
+
+    // Shaders decode colors with pow(2.2) rather than the exact sRGB curve, filtering has to match that
+    static constexpr float Gamma = 2.2f;
+    static constexpr float LanczosRadius = 2.0f;
+
+#pragma mark - Helpers
+
+    struct FilterTaps {
+        // Taps of destination texel i are [offsets[i], offsets[i + 1])
+        std::vector<uint32_t> offsets;
+        std::vector<uint32_t> sourceIndices;
+        std::vector<float> weights;
+    };
+
+    static float Sinc(float x) {
+        float px = glm::pi<float>() * x;
+        return std::sin(px) / px;
+    }
+
+    static float Lanczos(float x) {
+        x = std::fabs(x);
+        if (x < 1e-5f) return 1.0f;
+        if (x >= LanczosRadius) return 0.0f;
+        return Sinc(x) * Sinc(x / LanczosRadius);
+    }
+
+    /// Weights of a Lanczos kernel stretched by the downsampling ratio, source indices wrap around
+    static FilterTaps Taps(uint32_t sourceSize, uint32_t destinationSize) {
+        FilterTaps taps;
+        taps.offsets.push_back(0);
+
+        float scale = float(sourceSize) / float(destinationSize);
+        float radius = LanczosRadius * scale;
+
+        for (uint32_t i = 0; i < destinationSize; i++) {
+            float center = (i + 0.5f) * scale;
+            int32_t first = (int32_t) std::floor(center - radius);
+            int32_t last = (int32_t) std::ceil(center + radius);
+
+            size_t firstTap = taps.weights.size();
+            float weightSum = 0.0f;
+
+            for (int32_t j = first; j <= last; j++) {
+                float weight = Lanczos((j + 0.5f - center) / scale);
+                if (weight == 0.0f) {
+                    continue;
+                }
+                int32_t wrapped = ((j % (int32_t) sourceSize) + (int32_t) sourceSize) % (int32_t) sourceSize;
+                taps.sourceIndices.push_back((uint32_t) wrapped);
+                taps.weights.push_back(weight);
+                weightSum += weight;
+            }
+
+            for (size_t t = firstTap; t < taps.weights.size(); t++) {
+                taps.weights[t] /= weightSum;
+            }
+
+            taps.offsets.push_back((uint32_t) taps.weights.size());
+        }
+
+        return taps;
+    }
+
+    /// Separable resampling of a float image with interleaved channels
+    static std::vector<float> Downsample(const std::vector<float> &source, uint32_t width, uint32_t height,
+            uint32_t newWidth, uint32_t newHeight, uint32_t channels) {
+        FilterTaps horizontal = Taps(width, newWidth);
+        FilterTaps vertical = Taps(height, newHeight);
+
+        std::vector<float> rows(newWidth * height * channels, 0.0f);
+        for (uint32_t y = 0; y < height; y++) {
+            const float *sourceRow = source.data() + y * width * channels;
+            float *row = rows.data() + y * newWidth * channels;
+
+            for (uint32_t x = 0; x < newWidth; x++) {
+                for (uint32_t t = horizontal.offsets[x]; t < horizontal.offsets[x + 1]; t++) {
+                    const float *texel = sourceRow + horizontal.sourceIndices[t] * channels;
+                    for (uint32_t c = 0; c < channels; c++) {
+                        row[x * channels + c] += texel[c] * horizontal.weights[t];
+                    }
+                }
+            }
+        }
+
+        std::vector<float> result(newWidth * newHeight * channels, 0.0f);
+        size_t rowLength = newWidth * channels;
+        for (uint32_t y = 0; y < newHeight; y++) {
+            float *row = result.data() + y * rowLength;
+
+            // Whole rows are accumulated at once, which keeps memory access sequential
+            for (uint32_t t = vertical.offsets[y]; t < vertical.offsets[y + 1]; t++) {
+                const float *sourceRow = rows.data() + vertical.sourceIndices[t] * rowLength;
+                float weight = vertical.weights[t];
+                for (size_t i = 0; i < rowLength; i++) {
+                    row[i] += sourceRow[i] * weight;
+                }
+            }
+        }
+
+        return result;
+    }
+
+    static uint8_t Quantize(float value) {
+        return (uint8_t) std::lround(glm::clamp(value, 0.0f, 1.0f) * 255.0f);
+    }
+
+    static std::vector<float> LinearTexels(const std::vector<uint8_t> &texels, MipChain::Content content) {
+        std::array<float, 256> decoded;
+        for (size_t i = 0; i < decoded.size(); i++) {
+            decoded[i] = float(i) / 255.0f;
+        }
+
+        std::array<float, 256> linear = decoded;
+        if (content == MipChain::Content::Color) {
+            for (auto &value : linear) { value = std::pow(value, Gamma); }
+        }
+
+        std::vector<float> result(texels.size());
+        uint32_t channels = MipChain::ChannelCount(content);
+        for (size_t i = 0; i < texels.size(); i++) {
+            // Alpha is never gamma encoded
+            bool isAlpha = channels == 4 && i % 4 == 3;
+            result[i] = isAlpha ? decoded[texels[i]] : linear[texels[i]];
+        }
+        return result;
+    }
+
+    static std::vector<uint8_t> EncodedTexels(const std::vector<float> &texels, MipChain::Content content) {
+        std::vector<uint8_t> result(texels.size());
+
+        switch (content) {
+            case MipChain::Content::Color:
+                for (size_t i = 0; i < texels.size(); i++) {
+                    bool isAlpha = i % 4 == 3;
+                    float value = glm::clamp(texels[i], 0.0f, 1.0f);
+                    result[i] = Quantize(isAlpha ? value : std::pow(value, 1.0f / Gamma));
+                }
+                break;
+
+            case MipChain::Content::NormalMap:
+                for (size_t i = 0; i < texels.size(); i += 4) {
+                    // Averaged normals get shorter, shading expects unit vectors
+                    float x = texels[i] * 2.0f - 1.0f;
+                    float y = texels[i + 1] * 2.0f - 1.0f;
+                    float z = texels[i + 2] * 2.0f - 1.0f;
+                    float length = std::sqrt(x * x + y * y + z * z);
+                    if (length > 1e-5f) {
+                        x /= length;
+                        y /= length;
+                        z /= length;
+                    }
+                    result[i] = Quantize(x * 0.5f + 0.5f);
+                    result[i + 1] = Quantize(y * 0.5f + 0.5f);
+                    result[i + 2] = Quantize(z * 0.5f + 0.5f);
+                    result[i + 3] = Quantize(texels[i + 3]);
+                }
+                break;
+
+            case MipChain::Content::Scalar:
+                for (size_t i = 0; i < texels.size(); i++) {
+                    result[i] = Quantize(texels[i]);
+                }
+                break;
+        }
+
+        return result;
+    }
+
+#pragma mark - Lifecycle
+
+    MipChain::MipChain(Content content, std::vector<Level> &&levels)
+            :
+            mContent(content),
+            mLevels(std::move(levels)) {
+    }
+
+    MipChain MipChain::Build(const std::vector<uint8_t> &encodedImage, Content content) {
+        int32_t width = 0;
+        int32_t height = 0;
+        int32_t components = 0;
+
+        StbImage::EnableVerticalFlip();
+        stbi_uc *pixelData = stbi_load_from_memory(encodedImage.data(), (int) encodedImage.size(), &width, &height, &components, STBI_rgb_alpha);
+
+        if (!pixelData) {
+            throw std::invalid_argument(stbi_failure_reason());
+        }
+
+        uint32_t channels = ChannelCount(content);
+        size_t texelCount = size_t(width) * size_t(height);
+
+        Level base;
+        base.width = (uint32_t) width;
+        base.height = (uint32_t) height;
+        base.texels.resize(texelCount * channels);
+
+        if (channels == 4) {
+            std::copy(pixelData, pixelData + texelCount * 4, base.texels.begin());
+        } else {
+            for (size_t i = 0; i < texelCount; i++) {
+                base.texels[i] = pixelData[i * 4];
+            }
+        }
+
+        stbi_image_free(pixelData);
+
+        std::vector<Level> levels;
+        std::vector<float> texels = LinearTexels(base.texels, content);
+        levels.emplace_back(std::move(base));
+
+        // Every level is filtered from the previous one in full precision, only the result is quantized
+        while (levels.back().width > 1 || levels.back().height > 1) {
+            const Level &previous = levels.back();
+
+            Level level;
+            level.width = std::max(previous.width / 2, 1u);
+            level.height = std::max(previous.height / 2, 1u);
+
+            texels = Downsample(texels, previous.width, previous.height, level.width, level.height, channels);
+            level.texels = EncodedTexels(texels, content);
+            levels.emplace_back(std::move(level));
+        }
+
+        return MipChain(content, std::move(levels));
+    }
+
+#pragma mark - Getters
+
+    uint32_t MipChain::ChannelCount(Content content) {
+        return content == Content::Scalar ? 1 : 4;
+    }
+
+    MipChain::Content MipChain::content() const {
+        return mContent;
+    }
+
+    uint32_t MipChain::channelCount() const {
+        return ChannelCount(mContent);
+    }
+
+    const std::vector<MipChain::Level> &MipChain::levels() const {
+        return mLevels;
+    }
+
+    size_t MipChain::byteCount() const {
+        size_t count = 0;
+        for (auto &level : mLevels) {
+            count += level.texels.size();
+        }
+        return count;
+    }
+
+}
@@ -0,0 +1,75 @@
+//
+//  MipChain.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef MipChain_hpp
+#define MipChain_hpp
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+namespace EARenderer {
+
+    /// 8-bit image with all of its mip levels, built on the CPU so that GL only has to upload them.
+    /// Levels follow GL's size convention: every level is half of the previous one rounded down, down to 1x1.
+    class MipChain {
+    public:
+
+#pragma mark - Nested types
+
+        enum class Content : uint32_t {
+            /// Gamma encoded color (decoded with pow(2.2) by shaders), filtered in linear space. RGBA.
+            Color,
+            /// Tangent space normals remapped into [0; 1], renormalized after filtering. RGBA.
+            NormalMap,
+            /// Single channel data such as roughness or height, only red channel is kept. R.
+            Scalar
+        };
+
+        struct Level {
+            uint32_t width = 0;
+            uint32_t height = 0;
+            std::vector<uint8_t> texels;
+        };
+
+    private:
+        Content mContent = Content::Color;
+        std::vector<Level> mLevels;
+
+    public:
+
+#pragma mark - Lifecycle
+
+        MipChain() = default;
+
+        MipChain(Content content, std::vector<Level> &&levels);
+
+        /**
+         Decodes an image and filters its mip levels with a Lanczos-2 kernel, wrapping around the edges like repeating textures do
+
+         @param encodedImage contents of an image file in any format stb_image supports
+         @throws std::invalid_argument if the image could not be decoded
+         */
+        static MipChain Build(const std::vector<uint8_t> &encodedImage, Content content);
+
+#pragma mark - Getters
+
+        static uint32_t ChannelCount(Content content);
+
+        Content content() const;
+
+        uint32_t channelCount() const;
+
+        const std::vector<Level> &levels() const;
+
+        size_t byteCount() const;
+    };
+
+}
+
+#endif /* MipChain_hpp */
@@ -13,7 +13,7 @@ namespace EARenderer {
 
 #pragma mark - Lifecycle
 
-    SharedResourceStorage::SharedResourceStorage() : mMeshes(100), mCookTorranceMaterials(100), mEmissiveMaterials(100) {}
+    SharedResourceStorage::SharedResourceStorage() = default;
 
 #pragma mark - Getters
 
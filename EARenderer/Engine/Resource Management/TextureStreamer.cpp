@@ -0,0 +1,207 @@
+//
+//  TextureStreamer.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "TextureStreamer.hpp"
+#include "CookedTexture.hpp"
+#include "ContentHash.hpp"
+#include "StringUtils.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+
+namespace EARenderer {
+
+#pragma mark - Request
+
+    TextureStreamer::Request::Request(const std::string &imagePath, UploadFunction &&upload, ThreadPool::TaskFuture<MipChain> &&future)
+            :
+            imagePath(imagePath),
+            upload(std::move(upload)),
+            future(std::move(future)) {
+    }
+
+    size_t TextureStreamer::Request::nextLevelByteCount() const {
+        return mipChain->levels()[nextLevel].texels.size();
+    }
+
+#pragma mark - Lifecycle
+
+    TextureStreamer::TextureStreamer() {
+        // Futures of pending requests block on destruction, so the pool has to outlive the streamer.
+        // Statics are destroyed in reverse order of their construction.
+        ThreadPool::Default();
+    }
+
+    TextureStreamer &TextureStreamer::Shared() {
+        static TextureStreamer streamer;
+        return streamer;
+    }
+
+#pragma mark - Private helpers
+
+    std::vector<uint8_t> TextureStreamer::ReadImageFile(const std::string &imagePath) {
+        std::ifstream stream(imagePath, std::ios::binary | std::ios::ate);
+        if (!stream.is_open()) {
+            throw std::invalid_argument(string_format("Failed to load texture file (%s)", imagePath.c_str()));
+        }
+
+        std::vector<uint8_t> encodedImage((size_t) stream.tellg());
+        stream.seekg(0);
+        stream.read(reinterpret_cast<char *>(encodedImage.data()), encodedImage.size());
+        return encodedImage;
+    }
+
+    uint64_t TextureStreamer::SourceHash(const std::vector<uint8_t> &encodedImage, MipChain::Content content) {
+        ContentHash hash;
+        hash.append(CookerVersion);
+        hash.append(content);
+        hash.append(encodedImage.data(), encodedImage.size());
+        return hash.value();
+    }
+
+    MipChain TextureStreamer::LoadMipChain(const std::string &imagePath, MipChain::Content content) {
+        std::vector<uint8_t> encodedImage = ReadImageFile(imagePath);
+        uint64_t sourceHash = SourceHash(encodedImage, content);
+
+        std::string cookedTexturePath = imagePath + ".cooked";
+        MipChain mipChain;
+
+        if (CookedTexture::Read(cookedTexturePath, sourceHash, mipChain)) {
+            return mipChain;
+        }
+
+        try {
+            mipChain = MipChain::Build(encodedImage, content);
+        } catch (const std::invalid_argument &error) {
+            throw std::invalid_argument(string_format("Failed to load texture file (%s): %s", imagePath.c_str(), error.what()));
+        }
+
+        try {
+            CookedTexture::Write(cookedTexturePath, sourceHash, mipChain);
+        } catch (const std::runtime_error &error) {
+            std::cerr << "Failed to cook texture: " << error.what() << std::endl;
+        }
+
+        return mipChain;
+    }
+
+    bool TextureStreamer::resolve(Request &request, bool shouldWait) {
+        // Upload function is reset once the request is either complete or failed
+        if (!request.upload) {
+            return false;
+        }
+
+        if (request.mipChain) {
+            return true;
+        }
+
+        if (!shouldWait && !request.future.isReady()) {
+            return false;
+        }
+
+        try {
+            request.mipChain = std::make_unique<MipChain>(request.future.get());
+            request.nextLevel = (int32_t) request.mipChain->levels().size() - 1;
+            return true;
+        } catch (const std::exception &error) {
+            // The texture keeps its placeholder contents
+            std::cerr << error.what() << std::endl;
+            request.upload = nullptr;
+            return false;
+        }
+    }
+
+    void TextureStreamer::upload(Request &request) {
+        if (request.upload(*request.mipChain, (uint16_t) request.nextLevel)) {
+            request.nextLevel--;
+        } else {
+            // Texture is gone, the rest of the chain is of no use
+            request.nextLevel = -1;
+        }
+
+        if (request.nextLevel < 0) {
+            request.upload = nullptr;
+            request.mipChain.reset();
+        }
+    }
+
+    void TextureStreamer::removeCompletedRequests() {
+        if (mRequests.empty()) {
+            return;
+        }
+
+        mRequests.erase(std::remove_if(mRequests.begin(), mRequests.end(), [](const std::unique_ptr<Request> &request) {
+            return !request->upload;
+        }), mRequests.end());
+    }
+
+#pragma mark - Hashing
+
+    uint64_t TextureStreamer::SourceHash(const std::string &imagePath, MipChain::Content content) {
+        return SourceHash(ReadImageFile(imagePath), content);
+    }
+
+#pragma mark - Requests
+
+    void TextureStreamer::enqueue(const std::string &imagePath, MipChain::Content content, UploadFunction &&upload) {
+        auto future = ThreadPool::Default().submit([imagePath, content]() {
+            return LoadMipChain(imagePath, content);
+        });
+
+        mRequests.emplace_back(std::make_unique<Request>(imagePath, std::move(upload), std::move(future)));
+    }
+
+#pragma mark - Uploading
+
+    size_t TextureStreamer::update(size_t byteBudget) {
+        size_t uploadedByteCount = 0;
+
+        while (true) {
+            // The smallest pending level goes first, so that coarse versions of all textures arrive before fine ones
+            Request *next = nullptr;
+            for (auto &request : mRequests) {
+                if (resolve(*request, false) && (!next || request->nextLevelByteCount() < next->nextLevelByteCount())) {
+                    next = request.get();
+                }
+            }
+
+            if (!next) {
+                break;
+            }
+
+            size_t byteCount = next->nextLevelByteCount();
+            if (uploadedByteCount > 0 && uploadedByteCount + byteCount > byteBudget) {
+                break;
+            }
+
+            upload(*next);
+            uploadedByteCount += byteCount;
+        }
+
+        removeCompletedRequests();
+        return uploadedByteCount;
+    }
+
+    void TextureStreamer::finish() {
+        for (auto &request : mRequests) {
+            if (resolve(*request, true)) {
+                while (request->upload) {
+                    upload(*request);
+                }
+            }
+        }
+
+        removeCompletedRequests();
+    }
+
+    bool TextureStreamer::isIdle() const {
+        return mRequests.empty();
+    }
+
+}
@@ -0,0 +1,142 @@
+//
+//  TextureStreamer.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef TextureStreamer_hpp
+#define TextureStreamer_hpp
+
+#include "MipChain.hpp"
+#include "GLTexture2D.hpp"
+#include "ThreadPool.hpp"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+
+namespace EARenderer {
+
+    /// Loads image files into textures without stalling the GL thread.
+    ///
+    /// Images are decoded and their mip chains are filtered on the default thread pool.
+    /// Results are cooked next to the source images (<path>.cooked), so subsequent launches skip both steps.
+    /// Ready mip levels are handed to GL by update() within a per-frame byte budget, smallest levels first,
+    /// so every texture gets a blurry version quickly and sharpens over the following frames.
+    ///
+    /// The budget is measured in uncompressed texel data handed to GL, not in video memory.
+    /// Textures with generic compressed formats are compressed by the driver on upload, on the GL thread,
+    /// so for them the budget bounds the compression work of a frame, while the memory written is several times smaller.
+    class TextureStreamer {
+    public:
+        /// Has to be incremented whenever changes to decoding or filtering affect mip chains,
+        /// which invalidates previously cooked textures
+        static constexpr uint32_t CookerVersion = 1;
+
+        static constexpr size_t DefaultUploadBudget = 16 << 20;
+
+        /// Uploads a level of the chain, returns false if the texture is gone
+        using UploadFunction = std::function<bool(const MipChain &chain, uint16_t level)>;
+
+    private:
+        struct Request {
+            std::string imagePath;
+            UploadFunction upload;
+            ThreadPool::TaskFuture<MipChain> future;
+            std::unique_ptr<MipChain> mipChain;
+            // Next level to upload, levels go from the smallest one to the base one
+            int32_t nextLevel = -1;
+
+            Request(const std::string &imagePath, UploadFunction &&upload, ThreadPool::TaskFuture<MipChain> &&future);
+
+            size_t nextLevelByteCount() const;
+        };
+
+        std::vector<std::unique_ptr<Request>> mRequests;
+
+        TextureStreamer();
+
+        static std::vector<uint8_t> ReadImageFile(const std::string &imagePath);
+
+        static uint64_t SourceHash(const std::vector<uint8_t> &encodedImage, MipChain::Content content);
+
+        static MipChain LoadMipChain(const std::string &imagePath, MipChain::Content content);
+
+        /**
+         @return true if the mip chain is available, failed requests are reported and get their upload function reset
+         */
+        bool resolve(Request &request, bool shouldWait);
+
+        void upload(Request &request);
+
+        void removeCompletedRequests();
+
+    public:
+
+#pragma mark - Lifecycle
+
+        static TextureStreamer &Shared();
+
+        TextureStreamer(const TextureStreamer &that) = delete;
+
+        TextureStreamer &operator=(const TextureStreamer &rhs) = delete;
+
+#pragma mark - Hashing
+
+        /**
+         Hash the cooked texture of the image is keyed by, which changes along with the image file and the cooker
+
+         @throws std::invalid_argument if the image file could not be read
+         */
+        static uint64_t SourceHash(const std::string &imagePath, MipChain::Content content);
+
+#pragma mark - Requests
+
+        void enqueue(const std::string &imagePath, MipChain::Content content, UploadFunction &&upload);
+
+        /**
+         Schedules loading of the image into the texture, which keeps its current contents until the first level arrives.
+         The streamer doesn't own the texture, requests of destroyed textures are dropped.
+         */
+        template<GLTexture::Normalized Format>
+        void stream(const std::string &imagePath, MipChain::Content content, const std::shared_ptr<GLNormalizedTexture2D<Format>> &texture) {
+            std::weak_ptr<GLNormalizedTexture2D<Format>> weakTexture = texture;
+
+            enqueue(imagePath, content, [weakTexture](const MipChain &chain, uint16_t level) {
+                auto texture = weakTexture.lock();
+                if (!texture) {
+                    return false;
+                }
+
+                const MipChain::Level &base = chain.levels().front();
+                texture->uploadMipLevel(Size2D(base.width, base.height), level, (uint16_t) chain.levels().size(),
+                        chain.levels()[level].texels.data(), chain.channelCount() == 1 ? GL_RED : GL_RGBA);
+                return true;
+            });
+        }
+
+#pragma mark - Uploading
+
+        /**
+         Uploads mip levels which are ready, until the budget is exhausted. Has to be called on the GL thread.
+         At least one level is uploaded if there is one, regardless of its size.
+
+         @param byteBudget amount of uncompressed texel data to hand over to GL
+         @return amount of uncompressed texel data uploaded
+         */
+        size_t update(size_t byteBudget = DefaultUploadBudget);
+
+        /**
+         Waits for all pending images and uploads all of their levels, for clients that need final texture contents right away
+         */
+        void finish();
+
+        bool isIdle() const;
+    };
+
+}
+
+#endif /* TextureStreamer_hpp */
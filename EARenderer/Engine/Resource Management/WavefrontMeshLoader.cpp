@@ -7,99 +7,52 @@
 //
 
 #include "WavefrontMeshLoader.hpp"
+#include "CookedMesh.hpp"
+#include "MeshOptimizer.hpp"
+#include "ContentHash.hpp"
+#include "Measurement.hpp"
+#include "StringUtils.hpp"
 
-#include <fstream>
+#include <iostream>
+#include <memory>
 
 namespace EARenderer {
 
-#pragma mark - Callbacks (static)
-
-    void WavefrontMeshLoader::vertexCallback(void *userData, float x, float y, float z, float w) {
-        WavefrontMeshLoader *thisPtr = reinterpret_cast<WavefrontMeshLoader *>(userData);
-
-        thisPtr->mBoundingBox->min.x = std::min(thisPtr->mBoundingBox->min.x, x);
-        thisPtr->mBoundingBox->min.y = std::min(thisPtr->mBoundingBox->min.y, y);
-        thisPtr->mBoundingBox->min.z = std::min(thisPtr->mBoundingBox->min.z, z);
-
-        thisPtr->mBoundingBox->max.x = std::max(thisPtr->mBoundingBox->max.x, x);
-        thisPtr->mBoundingBox->max.y = std::max(thisPtr->mBoundingBox->max.y, y);
-        thisPtr->mBoundingBox->max.z = std::max(thisPtr->mBoundingBox->max.z, z);
-
-        thisPtr->mVertices.emplace_back(x, y, z, w);
-    }
-
-    void WavefrontMeshLoader::normalCallback(void *userData, float x, float y, float z) {
-        WavefrontMeshLoader *thisPtr = reinterpret_cast<WavefrontMeshLoader *>(userData);
-        thisPtr->mNormals.emplace_back(x, y, z);
-    }
-
-    void WavefrontMeshLoader::texcoordCallback(void *userData, float x, float y, float z) {
-        WavefrontMeshLoader *thisPtr = reinterpret_cast<WavefrontMeshLoader *>(userData);
-        thisPtr->mTexCoords.emplace_back(x, y, z);
-    }
-
-    void WavefrontMeshLoader::indexCallback(void *userData, tinyobj::index_t *indices, int numIndices) {
-        tinyobj::index_t *idxs = reinterpret_cast<tinyobj::index_t *>(indices);
-        WavefrontMeshLoader *thisPtr = reinterpret_cast<WavefrontMeshLoader *>(userData);
-
-        // Triangulate
-        tinyobj::index_t i0 = idxs[0];// f[0];
-        tinyobj::index_t i1 = {-1, -1, -1};
-        tinyobj::index_t i2 = idxs[1]; //f[1];
-
-        for (size_t k = 2; k < numIndices; k++) {
-            i1 = i2;
-            i2 = idxs[k];
-
-            std::array<tinyobj::index_t, 3> indices = {i0, i1, i2};
-            thisPtr->processTriangle(indices);
-        }
-    }
-
-    void WavefrontMeshLoader::groupCallback(void *userData, const char **names, int numNames) {
-        WavefrontMeshLoader *thisPtr = reinterpret_cast<WavefrontMeshLoader *>(userData);
+#pragma mark - Private instance functions
 
-        if (thisPtr->wasEmptyGroupOrObjectDetected()) {return;};
+    void WavefrontMeshLoader::beginSubMesh(const std::string *name) {
+        if (wasEmptyGroupOrObjectDetected()) {return;};
 
-        if (!thisPtr->mSubMeshes->empty()) {
-            thisPtr->finalizeSubMesh(thisPtr->mSubMeshes->back());
+        if (!mSubMeshes->empty()) {
+            finalizeSubMesh(mSubMeshes->back());
         }
 
-        thisPtr->mSubMeshes->emplace_back();
-        SubMesh *lastSubMesh = &thisPtr->mSubMeshes->back();
-        if (numNames) {
-            lastSubMesh->setName(std::string(names[numNames - 1]));
+        mSubMeshes->emplace_back();
+        if (name) {
+            mSubMeshes->back().setName(*name);
         }
     }
 
-    void WavefrontMeshLoader::objectCallback(void *userData, const char *name) {
-        WavefrontMeshLoader *thisPtr = reinterpret_cast<WavefrontMeshLoader *>(userData);
-
-        if (thisPtr->wasEmptyGroupOrObjectDetected()) {return;};
-
-        if (!thisPtr->mSubMeshes->empty()) {
-            thisPtr->finalizeSubMesh(thisPtr->mSubMeshes->back());
-        }
-
-        thisPtr->mSubMeshes->emplace_back();
-        SubMesh *lastSubMesh = &thisPtr->mSubMeshes->back();
-        if (name) {
-            lastSubMesh->setName(std::string(name));
+    void WavefrontMeshLoader::setMaterialName(const std::string &name) {
+        // Statements preceding any group or object still need a sub mesh to go to
+        if (mSubMeshes->empty()) {
+            mSubMeshes->emplace_back();
         }
+        mSubMeshes->back().setMaterialName(name);
     }
 
-    void WavefrontMeshLoader::materialCallback(void *userData, const char *name, int material_id) {
-        WavefrontMeshLoader *thisPtr = reinterpret_cast<WavefrontMeshLoader *>(userData);
+    void WavefrontMeshLoader::processFace(const WavefrontParser::FaceVertex *vertices, uint32_t vertexCount) {
+        if (mSubMeshes->empty()) {
+            mSubMeshes->emplace_back();
+        }
 
-        auto &lastSubMesh = thisPtr->mSubMeshes->back();
-        if (name) {
-            lastSubMesh.setMaterialName(name);
+        // Triangulate
+        for (uint32_t k = 2; k < vertexCount; k++) {
+            processTriangle({vertices[0], vertices[k - 1], vertices[k]});
         }
     }
 
-#pragma mark - Private instance functions
-
-    void WavefrontMeshLoader::processTriangle(const std::array<tinyobj::index_t, 3> &indices) {
+    void WavefrontMeshLoader::processTriangle(const std::array<WavefrontParser::FaceVertex, 3> &vertices) {
         std::array<int32_t, 3> positionIndices;
         std::array<int32_t, 3> texCoordIndices;
         bool shouldBuildTangent = false;
@@ -110,23 +63,23 @@ namespace EARenderer {
         SubMesh &lastSubMesh = mSubMeshes->back();
 
         for (int32_t i = 0; i < faceVertexCount; i++) {
-            int32_t fixedVIdx = fixIndex(indices[i].vertex_index, static_cast<int32_t>(mVertices.size()));
-            int32_t fixedNIdx = fixIndex(indices[i].normal_index, static_cast<int32_t>(mNormals.size()));
-            int32_t fixedTIdx = fixIndex(indices[i].texcoord_index, static_cast<int32_t>(mTexCoords.size()));
+            bool isTexCoordPresent = vertices[i].texCoord != WavefrontParser::FaceVertex::Absent;
+            bool isNormalPresent = vertices[i].normal != WavefrontParser::FaceVertex::Absent;
 
-            bool isTexCoordPresent = indices[i].texcoord_index != 0;
-            bool isNormalPresent = indices[i].normal_index != 0;
+            // Absent texture coordinates are addressed as the first ones, the way OBJ index 0 always was
+            int32_t vIdx = vertices[i].position;
+            int32_t tIdx = isTexCoordPresent ? vertices[i].texCoord : 0;
 
-            lastSubMesh.addVertex(Vertex1P1N2UV1T1BT(mVertices[fixedVIdx],
-                    isTexCoordPresent ? mTexCoords[fixedTIdx] : glm::vec3(),
-                    isTexCoordPresent ? mTexCoords[fixedTIdx] : glm::vec2(),
-                    isNormalPresent ? mNormals[fixedNIdx] : glm::vec3()));
+            lastSubMesh.addVertex(Vertex1P1N2UV1T1BT(mVertices[vIdx],
+                    isTexCoordPresent ? mTexCoords[tIdx] : glm::vec3(),
+                    isTexCoordPresent ? mTexCoords[tIdx] : glm::vec2(),
+                    isNormalPresent ? mNormals[vertices[i].normal] : glm::vec3()));
 
             shouldCalculateNormal = !isNormalPresent;
             shouldBuildTangent = isTexCoordPresent;
 
-            positionIndices[i] = fixedVIdx;
-            texCoordIndices[i] = fixedTIdx;
+            positionIndices[i] = vIdx;
+            texCoordIndices[i] = tIdx;
         }
 
         if (shouldCalculateNormal) {
@@ -183,12 +136,6 @@ namespace EARenderer {
         }
     }
 
-    int32_t WavefrontMeshLoader::fixIndex(int32_t idx, int32_t n) {
-        if (idx > 0) return idx - 1;
-        if (idx == 0) return 0;
-        return n + idx;  // negative value = relative
-    }
-
     bool WavefrontMeshLoader::wasEmptyGroupOrObjectDetected() {
         if (mSubMeshes->size() < 1) {return false;};
         auto lastSubmeshIdx = mSubMeshes->size() - 1;
@@ -209,6 +156,13 @@ namespace EARenderer {
         }
     }
 
+    uint64_t WavefrontMeshLoader::sourceHash(const WavefrontParser &parser) const {
+        ContentHash hash;
+        hash.append(LoaderVersion);
+        hash.append(parser.data(), parser.size());
+        return hash.value();
+    }
+
 #pragma mark - Lifecycle
 
     WavefrontMeshLoader::WavefrontMeshLoader(const std::string &meshPath)
@@ -219,40 +173,100 @@ namespace EARenderer {
 #pragma mark - Public
 
     void WavefrontMeshLoader::load(std::vector<SubMesh> &subMeshes, std::string &meshName, AxisAlignedBox3D &boundingBox) {
-        mSubMeshes = &subMeshes;
-        mBoundingBox = &boundingBox;
-        mBoundingBox->min = glm::vec3(std::numeric_limits<float>::max());
-        mBoundingBox->max = glm::vec3(-std::numeric_limits<float>::max());
-
-        tinyobj::callback_t cb;
-        cb.vertex_cb = vertexCallback;
-        cb.normal_cb = normalCallback;
-        cb.texcoord_cb = texcoordCallback;
-        cb.index_cb = indexCallback;
-        cb.group_cb = groupCallback;
-        cb.object_cb = objectCallback;
-        cb.usemtl_cb = materialCallback;
-
-        std::string err;
-        std::ifstream ifs(mMeshPath.c_str());
-
-        if (ifs.fail()) {
-            std::cerr << "file not found." << std::endl;
+        std::unique_ptr<WavefrontParser> parser;
+        try {
+            parser = std::make_unique<WavefrontParser>(mMeshPath);
+        } catch (const std::runtime_error &error) {
+            std::cerr << error.what() << std::endl;
             return;
         }
 
-        bool ret = tinyobj::LoadObjWithCallback(ifs, cb, this, nullptr, &err);
-        meshName = mMeshName;
+        std::string cookedMeshPath = mMeshPath + ".cooked";
+        uint64_t hash = sourceHash(*parser);
 
-        finalizeSubMesh(mSubMeshes->back());
+        bool isCooked = false;
+        Measurement::ExecutionTime(string_format("Loading cooked mesh %s took", mMeshPath.c_str()), [&]() {
+            isCooked = CookedMesh::Read(cookedMeshPath, hash, subMeshes, meshName, boundingBox);
+        });
 
-        if (!err.empty()) {
-            std::cerr << err << std::endl;
+        if (isCooked) {
+            return;
         }
 
-        if (!ret) {
-            std::cerr << "Failed to parse .obj" << std::endl;
+        try {
+            Measurement::ExecutionTime(string_format("Parsing mesh %s (%zu MB) took", mMeshPath.c_str(), parser->size() >> 20), [&]() {
+                parse(*parser, subMeshes, meshName, boundingBox);
+            });
+        } catch (const std::runtime_error &error) {
+            std::cerr << "Failed to parse mesh " << mMeshPath << ": " << error.what() << std::endl;
             return;
         }
+
+        // Attribute arrays are not needed past parsing, the mapping goes away with the parser
+        mVertices = {};
+        mNormals = {};
+        mTexCoords = {};
+        parser.reset();
+
+        // Optimized geometry is what gets cooked, so this cost is paid only once per source file
+        MeshOptimizer::Statistics statistics;
+        Measurement::ExecutionTime(string_format("Optimizing mesh %s took", mMeshPath.c_str()), [&]() {
+            for (auto &subMesh : subMeshes) {
+                statistics += subMesh.optimize();
+                subMesh.pack();
+            }
+        });
+        Measurement::Value(string_format("Optimized mesh %s:", mMeshPath.c_str()), statistics.description());
+
+        if (subMeshes.empty()) {
+            return;
+        }
+
+        try {
+            CookedMesh::Write(cookedMeshPath, hash, subMeshes, meshName, boundingBox);
+        } catch (const std::runtime_error &error) {
+            std::cerr << "Failed to cook mesh: " << error.what() << std::endl;
+        }
+    }
+
+    void WavefrontMeshLoader::parse(WavefrontParser &parser, std::vector<SubMesh> &subMeshes, std::string &meshName, AxisAlignedBox3D &boundingBox) {
+        mSubMeshes = &subMeshes;
+        mBoundingBox = &boundingBox;
+
+        parser.parse();
+
+        mVertices = std::move(parser.positions());
+        mNormals = std::move(parser.normals());
+        mTexCoords = std::move(parser.texCoords());
+        *mBoundingBox = parser.boundingBox();
+
+        // Chunks are replayed in file order, so sub meshes come out exactly as if the file was read serially
+        for (auto &chunk : parser.chunks()) {
+            const WavefrontParser::FaceVertex *faceVertices = chunk.faceVertices.data();
+
+            for (auto &statement : chunk.statements) {
+                switch (statement.type) {
+                    case WavefrontParser::Statement::Type::Face:
+                        processFace(faceVertices, statement.argument);
+                        faceVertices += statement.argument;
+                        break;
+
+                    case WavefrontParser::Statement::Type::Group:
+                    case WavefrontParser::Statement::Type::Object:
+                        beginSubMesh(statement.argument != WavefrontParser::Statement::NoName ? &chunk.names[statement.argument] : nullptr);
+                        break;
+
+                    case WavefrontParser::Statement::Type::Material:
+                        setMaterialName(chunk.names[statement.argument]);
+                        break;
+                }
+            }
+        }
+
+        meshName = mMeshName;
+
+        if (!mSubMeshes->empty()) {
+            finalizeSubMesh(mSubMeshes->back());
+        }
     }
 }
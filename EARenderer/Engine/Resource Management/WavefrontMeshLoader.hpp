@@ -21,12 +21,16 @@
 
 #include "Mesh.hpp"
 #include "SubMesh.hpp"
-#include "tiny_obj_loader.h"
+#include "WavefrontParser.hpp"
 
 namespace EARenderer {
 
     class WavefrontMeshLoader : public MeshLoader {
     private:
+        /// Has to be incremented whenever changes to the loader affect the resulting sub meshes,
+        /// which invalidates previously cooked meshes
+        static constexpr uint32_t LoaderVersion = 3;
+
         /// Objects of such type contain averaged normal for a vertex and indices of vertices
         /// in current submesh which are sharing this normal
         using SmoothNormalData = std::pair<glm::vec3, std::vector<int32_t>>;
@@ -40,35 +44,39 @@ namespace EARenderer {
         AxisAlignedBox3D *mBoundingBox;
         std::string mMeshName;
 
-        static void vertexCallback(void *userData, float x, float y, float z, float w);
-
-        static void normalCallback(void *userData, float x, float y, float z);
-
-        static void texcoordCallback(void *userData, float x, float y, float z);
-
-        static void indexCallback(void *userData, tinyobj::index_t *indices, int numIndices);
+        void beginSubMesh(const std::string *name);
 
-        static void groupCallback(void *userData, const char **names, int numNames);
+        void setMaterialName(const std::string &name);
 
-        static void objectCallback(void *userData, const char *name);
+        void processFace(const WavefrontParser::FaceVertex *vertices, uint32_t vertexCount);
 
-        static void materialCallback(void *user_data, const char *name, int material_id);
-
-        void processTriangle(const std::array<tinyobj::index_t, 3> &indices);
+        void processTriangle(const std::array<WavefrontParser::FaceVertex, 3> &vertices);
 
         void buildTangentSpace(const std::array<int32_t, 3> &positionIndices, const std::array<int32_t, 3> &texCoordIndices);
 
         void calculateNormal(const std::array<int32_t, 3> &positionIndices);
 
-        int32_t fixIndex(int32_t idx, int32_t n);
-
         bool wasEmptyGroupOrObjectDetected();
 
         void finalizeSubMesh(SubMesh &subMesh);
 
+        /**
+         @return hash of the source file contents and the loader version
+         */
+        uint64_t sourceHash(const WavefrontParser &parser) const;
+
+        /**
+         Parses the source .obj file in parallel and builds sub meshes in file order
+         */
+        void parse(WavefrontParser &parser, std::vector<SubMesh> &subMeshes, std::string &meshName, AxisAlignedBox3D &boundingBox);
+
     public:
         WavefrontMeshLoader(const std::string &meshPath);
 
+        /**
+         Loads the mesh from its cooked counterpart stored next to the source (<path>.cooked).
+         If there is none or it is outdated, the source is parsed and cooked for subsequent launches.
+         */
         void load(std::vector<SubMesh> &subMeshes, std::string &meshName, AxisAlignedBox3D &boundingBox) override;
     };
 
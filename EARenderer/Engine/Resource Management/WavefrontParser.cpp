@@ -0,0 +1,596 @@
+//
+//  WavefrontParser.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "WavefrontParser.hpp"
+#include "ThreadPool.hpp"
+#include "StringUtils.hpp"
+
+#include <array>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace EARenderer {
+
+#pragma mark - Tokenizing
+
+    // A line is the [cursor, end) range without the line break, so every helper is bounded by the line end.
+    // Delimiters are the same as in tinyobjloader: spaces and tabs separate tokens, carriage returns end them.
+
+    static bool IsSpace(char c) {
+        return c == ' ' || c == '\t';
+    }
+
+    static bool IsDelimiter(char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    static bool IsDigit(char c) {
+        return static_cast<unsigned int>(c - '0') < 10u;
+    }
+
+    static char CharAt(const char *cursor, const char *end, size_t offset) {
+        return cursor + offset < end ? cursor[offset] : '\0';
+    }
+
+    static const char *SkipSpaces(const char *cursor, const char *end) {
+        while (cursor < end && IsSpace(*cursor)) { cursor++; }
+        return cursor;
+    }
+
+    static const char *SkipDelimiters(const char *cursor, const char *end) {
+        while (cursor < end && IsDelimiter(*cursor)) { cursor++; }
+        return cursor;
+    }
+
+    static const char *TokenEnd(const char *cursor, const char *end) {
+        while (cursor < end && !IsDelimiter(*cursor)) { cursor++; }
+        return cursor;
+    }
+
+    static const char *IndexEnd(const char *cursor, const char *end) {
+        while (cursor < end && !IsDelimiter(*cursor) && *cursor != '/') { cursor++; }
+        return cursor;
+    }
+
+    static bool StartsWithKeyword(const char *cursor, const char *end, const char *keyword, size_t length) {
+        return (size_t) (end - cursor) > length && std::memcmp(cursor, keyword, length) == 0 && IsSpace(cursor[length]);
+    }
+
+    /// First whitespace separated word, the way sscanf("%s") reads statement arguments
+    static std::string Word(const char *cursor, const char *end) {
+        while (cursor < end && std::isspace((unsigned char) *cursor)) { cursor++; }
+        const char *wordEnd = cursor;
+        while (wordEnd < end && !std::isspace((unsigned char) *wordEnd)) { wordEnd++; }
+        return std::string(cursor, wordEnd);
+    }
+
+#pragma mark - Numbers
+
+    /// Same result as atoi() for well-formed input
+    static int32_t ParseInteger(const char *cursor, const char *end) {
+        cursor = SkipSpaces(cursor, end);
+
+        bool negative = false;
+        if (cursor < end && (*cursor == '+' || *cursor == '-')) {
+            negative = *cursor == '-';
+            cursor++;
+        }
+
+        int64_t value = 0;
+        while (cursor < end && IsDigit(*cursor)) {
+            value = value * 10 + (*cursor - '0');
+            cursor++;
+        }
+
+        return static_cast<int32_t>(negative ? -value : value);
+    }
+
+    /// pow(10.0, -i) as computed by tinyobjloader for every fractional digit
+    static const std::array<double, 32> &NegativePowersOfTen() {
+        static const std::array<double, 32> powers = []() {
+            std::array<double, 32> result;
+            for (size_t i = 0; i < result.size(); i++) {
+                result[i] = pow(10.0, -static_cast<int>(i));
+            }
+            return result;
+        }();
+        return powers;
+    }
+
+    // Follows tinyobjloader's tryParseDouble operation by operation, because a correctly rounded
+    // conversion (std::from_chars, strtod) produces different bits and would change the loaded meshes.
+    // The only shortcuts are the table lookup of powers of ten and skipping the exponent scaling when it is a no-op.
+    static bool ParseDouble(const char *s, const char *end, double &result) {
+        if (s >= end) {
+            return false;
+        }
+
+        const std::array<double, 32> &powers = NegativePowersOfTen();
+
+        double mantissa = 0.0;
+        int exponent = 0;
+        char sign = '+';
+        char exponentSign = '+';
+        const char *current = s;
+        int read = 0;
+
+        if (*current == '+' || *current == '-') {
+            sign = *current;
+            current++;
+        } else if (!IsDigit(*current)) {
+            return false;
+        }
+
+        while (current < end && IsDigit(*current)) {
+            mantissa *= 10;
+            mantissa += static_cast<int>(*current - '0');
+            current++;
+            read++;
+        }
+
+        if (read == 0) {
+            return false;
+        }
+
+        if (current < end) {
+            bool hasExponent = false;
+
+            if (*current == '.') {
+                current++;
+                read = 1;
+                while (current < end && IsDigit(*current)) {
+                    double power = read < (int) powers.size() ? powers[read] : pow(10.0, -read);
+                    mantissa += static_cast<int>(*current - '0') * power;
+                    read++;
+                    current++;
+                }
+                hasExponent = current < end && (*current == 'e' || *current == 'E');
+            } else {
+                hasExponent = *current == 'e' || *current == 'E';
+            }
+
+            if (hasExponent) {
+                current++;
+                if (current < end && (*current == '+' || *current == '-')) {
+                    exponentSign = *current;
+                    current++;
+                } else if (!(current < end && IsDigit(*current))) {
+                    return false;
+                }
+
+                read = 0;
+                while (current < end && IsDigit(*current)) {
+                    exponent *= 10;
+                    exponent += static_cast<int>(*current - '0');
+                    current++;
+                    read++;
+                }
+                exponent *= (exponentSign == '+' ? 1 : -1);
+                if (read == 0) {
+                    return false;
+                }
+            }
+        }
+
+        double magnitude = exponent == 0 ? mantissa : ldexp(mantissa * pow(5.0, exponent), exponent);
+        result = (sign == '+' ? 1 : -1) * magnitude;
+        return true;
+    }
+
+    static float ParseFloat(const char *&cursor, const char *end, double defaultValue = 0.0) {
+        cursor = SkipSpaces(cursor, end);
+        const char *tokenEnd = TokenEnd(cursor, end);
+        double value = defaultValue;
+        ParseDouble(cursor, tokenEnd, value);
+        cursor = tokenEnd;
+        return static_cast<float>(value);
+    }
+
+#pragma mark - Lines
+
+    enum class LineType {
+        Position, Normal, TexCoord, Face, Material, Group, Object, Other
+    };
+
+    /**
+     @param cursor beginning of the line, moved past the statement keyword
+     */
+    static LineType ClassifyLine(const char *&cursor, const char *end) {
+        cursor = SkipSpaces(cursor, end);
+
+        char first = CharAt(cursor, end, 0);
+        char second = CharAt(cursor, end, 1);
+
+        if (first == 'v') {
+            if (IsSpace(second)) {
+                cursor += 2;
+                return LineType::Position;
+            }
+            if (second == 'n' && IsSpace(CharAt(cursor, end, 2))) {
+                cursor += 3;
+                return LineType::Normal;
+            }
+            if (second == 't' && IsSpace(CharAt(cursor, end, 2))) {
+                cursor += 3;
+                return LineType::TexCoord;
+            }
+            return LineType::Other;
+        }
+
+        if (first == 'f' && IsSpace(second)) {
+            cursor += 2;
+            return LineType::Face;
+        }
+
+        if (StartsWithKeyword(cursor, end, "usemtl", 6)) {
+            cursor += 7;
+            return LineType::Material;
+        }
+
+        if (first == 'g' && IsSpace(second)) {
+            return LineType::Group;
+        }
+
+        if (first == 'o' && IsSpace(second)) {
+            cursor += 2;
+            return LineType::Object;
+        }
+
+        // Comments, material libraries (never read by this loader) and unsupported statements
+        return LineType::Other;
+    }
+
+    /// Calls the functor with every line of the range, excluding line breaks and a trailing carriage return
+    template<class LineFunctor>
+    static void ForEachLine(const char *begin, const char *end, LineFunctor &&functor) {
+        const char *lineBegin = begin;
+        while (lineBegin < end) {
+            const char *lineEnd = reinterpret_cast<const char *>(std::memchr(lineBegin, '\n', end - lineBegin));
+            if (!lineEnd) {
+                lineEnd = end;
+            }
+
+            const char *contentEnd = lineEnd;
+            if (contentEnd > lineBegin && contentEnd[-1] == '\r') {
+                contentEnd--;
+            }
+
+            functor(lineBegin, contentEnd);
+            lineBegin = lineEnd + 1;
+        }
+    }
+
+    static int32_t ResolveIndex(int32_t index, size_t count) {
+        if (index > 0) return index - 1;
+        if (index == 0) return 0;
+        return static_cast<int32_t>(count) + index; // Negative indices are relative
+    }
+
+    static bool IsIndexInRange(int32_t index, size_t count) {
+        return index >= 0 && static_cast<size_t>(index) < count;
+    }
+
+#pragma mark - Lifecycle
+
+    WavefrontParser::WavefrontParser(const std::string &filePath) {
+        int descriptor = open(filePath.c_str(), O_RDONLY);
+        if (descriptor == -1) {
+            throw std::runtime_error(string_format("Unable to open mesh: %s", filePath.c_str()));
+        }
+
+        struct stat fileInfo;
+        if (fstat(descriptor, &fileInfo) == -1) {
+            close(descriptor);
+            throw std::runtime_error(string_format("Unable to read mesh: %s", filePath.c_str()));
+        }
+
+        mMappingSize = (size_t) fileInfo.st_size;
+
+        // Empty files can't be mapped, there is nothing to parse anyway
+        if (mMappingSize == 0) {
+            close(descriptor);
+            return;
+        }
+
+        void *mapping = mmap(nullptr, mMappingSize, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        close(descriptor);
+
+        if (mapping == MAP_FAILED) {
+            throw std::runtime_error(string_format("Unable to map mesh: %s", filePath.c_str()));
+        }
+
+        mMapping = reinterpret_cast<const char *>(mapping);
+
+        // The file is read front to back by every chunk
+        madvise(mapping, mMappingSize, MADV_SEQUENTIAL);
+    }
+
+    WavefrontParser::~WavefrontParser() {
+        if (mMapping) {
+            munmap(const_cast<char *>(mMapping), mMappingSize);
+        }
+    }
+
+#pragma mark - Private helpers
+
+    void WavefrontParser::splitIntoChunks(size_t chunkCount) {
+        mChunks.clear();
+        mChunks.resize(chunkCount);
+
+        const char *end = mMapping + mMappingSize;
+        const char *chunkBegin = mMapping;
+
+        for (size_t i = 0; i < chunkCount; i++) {
+            const char *chunkEnd = end;
+
+            if (i + 1 < chunkCount) {
+                // Move the split point past the next line break, so lines are never torn apart
+                chunkEnd = std::max(chunkBegin, mMapping + mMappingSize * (i + 1) / chunkCount);
+                const char *lineBreak = reinterpret_cast<const char *>(std::memchr(chunkEnd, '\n', end - chunkEnd));
+                chunkEnd = lineBreak ? lineBreak + 1 : end;
+            }
+
+            mChunks[i].begin = chunkBegin;
+            mChunks[i].end = chunkEnd;
+            chunkBegin = chunkEnd;
+        }
+    }
+
+    void WavefrontParser::countAttributes(Chunk &chunk) const {
+        ForEachLine(chunk.begin, chunk.end, [&](const char *cursor, const char *end) {
+            switch (ClassifyLine(cursor, end)) {
+                case LineType::Position: chunk.positionCount++; break;
+                case LineType::Normal: chunk.normalCount++; break;
+                case LineType::TexCoord: chunk.texCoordCount++; break;
+                default: break;
+            }
+        });
+    }
+
+    void WavefrontParser::parseChunk(Chunk &chunk) {
+        glm::vec4 *positions = mPositions.data() + chunk.positionsOffset;
+        glm::vec3 *normals = mNormals.data() + chunk.normalsOffset;
+        glm::vec3 *texCoords = mTexCoords.data() + chunk.texCoordsOffset;
+
+        // Attributes preceding the current line, needed to resolve relative indices
+        size_t positionCount = chunk.positionsOffset;
+        size_t normalCount = chunk.normalsOffset;
+        size_t texCoordCount = chunk.texCoordsOffset;
+
+        ForEachLine(chunk.begin, chunk.end, [&](const char *lineBegin, const char *end) {
+            const char *cursor = lineBegin;
+            switch (ClassifyLine(cursor, end)) {
+                case LineType::Position: {
+                    float x = ParseFloat(cursor, end);
+                    float y = ParseFloat(cursor, end);
+                    float z = ParseFloat(cursor, end);
+                    float w = ParseFloat(cursor, end, 1.0);
+
+                    glm::vec3 position(x, y, z);
+                    chunk.boundingBox.min = glm::min(chunk.boundingBox.min, position);
+                    chunk.boundingBox.max = glm::max(chunk.boundingBox.max, position);
+
+                    *positions++ = glm::vec4(x, y, z, w);
+                    positionCount++;
+                    break;
+                }
+
+                case LineType::Normal: {
+                    float x = ParseFloat(cursor, end);
+                    float y = ParseFloat(cursor, end);
+                    float z = ParseFloat(cursor, end);
+                    *normals++ = glm::vec3(x, y, z);
+                    normalCount++;
+                    break;
+                }
+
+                case LineType::TexCoord: {
+                    float x = ParseFloat(cursor, end);
+                    float y = ParseFloat(cursor, end);
+                    float z = ParseFloat(cursor, end);
+                    *texCoords++ = glm::vec3(x, y, z);
+                    texCoordCount++;
+                    break;
+                }
+
+                case LineType::Face: {
+                    // Index triples: v, v/vt, v//vn, v/vt/vn. Zero is an invalid index in OBJ and marks an absent attribute.
+                    uint32_t vertexCount = 0;
+                    cursor = SkipSpaces(cursor, end);
+
+                    while (cursor < end && *cursor != '\r') {
+                        int32_t position = ParseInteger(cursor, end);
+                        int32_t texCoord = 0;
+                        int32_t normal = 0;
+
+                        cursor = IndexEnd(cursor, end);
+                        if (cursor < end && *cursor == '/') {
+                            cursor++;
+                            if (cursor < end && *cursor == '/') {
+                                cursor++;
+                                normal = ParseInteger(cursor, end);
+                                cursor = IndexEnd(cursor, end);
+                            } else {
+                                texCoord = ParseInteger(cursor, end);
+                                cursor = IndexEnd(cursor, end);
+                                if (cursor < end && *cursor == '/') {
+                                    cursor++;
+                                    normal = ParseInteger(cursor, end);
+                                    cursor = IndexEnd(cursor, end);
+                                }
+                            }
+                        }
+
+                        FaceVertex vertex;
+                        vertex.position = ResolveIndex(position, positionCount);
+                        vertex.texCoord = texCoord != 0 ? ResolveIndex(texCoord, texCoordCount) : FaceVertex::Absent;
+                        vertex.normal = normal != 0 ? ResolveIndex(normal, normalCount) : FaceVertex::Absent;
+
+                        // Attribute arrays are complete at this point, so forward references are checked as well.
+                        // Presence is decided by the written index, as relative ones may resolve to the value of Absent.
+                        bool isValid = IsIndexInRange(vertex.position, mPositions.size()) &&
+                                (texCoord == 0 || IsIndexInRange(vertex.texCoord, mTexCoords.size())) &&
+                                (normal == 0 || IsIndexInRange(vertex.normal, mNormals.size()));
+
+                        if (!isValid && !chunk.invalidFaceLine) {
+                            chunk.invalidFaceLine = lineBegin;
+                        }
+
+                        chunk.faceVertices.push_back(vertex);
+                        vertexCount++;
+
+                        cursor = SkipDelimiters(cursor, end);
+                    }
+
+                    if (vertexCount > 0) {
+                        chunk.statements.push_back({Statement::Type::Face, vertexCount});
+                    }
+                    break;
+                }
+
+                case LineType::Material: {
+                    chunk.statements.push_back({Statement::Type::Material, (uint32_t) chunk.names.size()});
+                    chunk.names.emplace_back(Word(cursor, end));
+                    break;
+                }
+
+                case LineType::Group: {
+                    // The first token is 'g' itself, the last of the following names identifies the group
+                    std::string lastName;
+                    size_t nameCount = 0;
+
+                    while (cursor < end && *cursor != '\r') {
+                        cursor = SkipSpaces(cursor, end);
+                        const char *nameEnd = TokenEnd(cursor, end);
+                        lastName.assign(cursor, nameEnd);
+                        nameCount++;
+                        cursor = SkipDelimiters(nameEnd, end);
+                    }
+
+                    if (nameCount > 1) {
+                        chunk.statements.push_back({Statement::Type::Group, (uint32_t) chunk.names.size()});
+                        chunk.names.emplace_back(std::move(lastName));
+                    } else {
+                        chunk.statements.push_back({Statement::Type::Group, Statement::NoName});
+                    }
+                    break;
+                }
+
+                case LineType::Object: {
+                    chunk.statements.push_back({Statement::Type::Object, (uint32_t) chunk.names.size()});
+                    chunk.names.emplace_back(Word(cursor, end));
+                    break;
+                }
+
+                case LineType::Other:
+                    break;
+            }
+        });
+    }
+
+#pragma mark - Parsing
+
+    void WavefrontParser::parse(size_t minimumChunkSize) {
+        size_t threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+        // A few chunks per thread even out the differences in their contents
+        size_t chunkCount = std::max<size_t>(1, std::min(mMappingSize / std::max<size_t>(minimumChunkSize, 1), threadCount * 4));
+        splitIntoChunks(mMapping ? chunkCount : 0);
+
+        {
+            std::vector<ThreadPool::TaskFuture<void>> counts;
+            for (auto &chunk : mChunks) {
+                counts.emplace_back(ThreadPool::Default().submit([this, &chunk]() {
+                    countAttributes(chunk);
+                }));
+            }
+            // Futures block on destruction, so all chunks are counted past this scope
+        }
+
+        size_t positionCount = 0;
+        size_t normalCount = 0;
+        size_t texCoordCount = 0;
+
+        for (auto &chunk : mChunks) {
+            chunk.positionsOffset = positionCount;
+            chunk.normalsOffset = normalCount;
+            chunk.texCoordsOffset = texCoordCount;
+            positionCount += chunk.positionCount;
+            normalCount += chunk.normalCount;
+            texCoordCount += chunk.texCoordCount;
+        }
+
+        mPositions.resize(positionCount);
+        mNormals.resize(normalCount);
+        mTexCoords.resize(texCoordCount);
+
+        {
+            std::vector<ThreadPool::TaskFuture<void>> parses;
+            for (auto &chunk : mChunks) {
+                parses.emplace_back(ThreadPool::Default().submit([this, &chunk]() {
+                    parseChunk(chunk);
+                }));
+            }
+        }
+
+        // Reported here rather than thrown by the tasks, as futures rethrow in destructors
+        for (auto &chunk : mChunks) {
+            if (chunk.invalidFaceLine) {
+                const char *end = mMapping + mMappingSize;
+                const char *lineEnd = reinterpret_cast<const char *>(std::memchr(chunk.invalidFaceLine, '\n', end - chunk.invalidFaceLine));
+                std::string line(chunk.invalidFaceLine, lineEnd ? lineEnd : end);
+                throw std::runtime_error(string_format("Face index is out of range at byte %zu: %s",
+                        (size_t) (chunk.invalidFaceLine - mMapping), line.c_str()));
+            }
+        }
+
+        mBoundingBox = AxisAlignedBox3D::MaximumReversed();
+        for (auto &chunk : mChunks) {
+            mBoundingBox.min = glm::min(mBoundingBox.min, chunk.boundingBox.min);
+            mBoundingBox.max = glm::max(mBoundingBox.max, chunk.boundingBox.max);
+        }
+    }
+
+#pragma mark - Getters
+
+    const char *WavefrontParser::data() const {
+        return mMapping;
+    }
+
+    size_t WavefrontParser::size() const {
+        return mMappingSize;
+    }
+
+    std::vector<glm::vec4> &WavefrontParser::positions() {
+        return mPositions;
+    }
+
+    std::vector<glm::vec3> &WavefrontParser::normals() {
+        return mNormals;
+    }
+
+    std::vector<glm::vec3> &WavefrontParser::texCoords() {
+        return mTexCoords;
+    }
+
+    const std::vector<WavefrontParser::Chunk> &WavefrontParser::chunks() const {
+        return mChunks;
+    }
+
+    const AxisAlignedBox3D &WavefrontParser::boundingBox() const {
+        return mBoundingBox;
+    }
+
+}
@@ -0,0 +1,142 @@
+//
+//  WavefrontParser.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef WavefrontParser_hpp
+#define WavefrontParser_hpp
+
+#include "AxisAlignedBox3D.hpp"
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+namespace EARenderer {
+
+    /// Parallel reader of .obj files.
+    ///
+    /// The file is memory mapped and split into line-aligned chunks. The first pass counts
+    /// vertex attribute statements of every chunk, so that the second pass can parse chunks
+    /// in parallel straight into the shared attribute arrays and resolve relative face indices.
+    /// Faces, groups, objects and material switches of every chunk are recorded as statements,
+    /// which clients replay chunk by chunk to get exactly the sequence a serial reader would produce.
+    ///
+    /// Numbers are parsed with the same arithmetic as tinyobjloader, so results are bit-identical.
+    class WavefrontParser {
+    public:
+
+#pragma mark - Nested types
+
+        /// Zero-based indices into positions, texture coordinates and normals
+        struct FaceVertex {
+            static constexpr int32_t Absent = -1;
+
+            int32_t position = 0;
+            int32_t texCoord = Absent;
+            int32_t normal = Absent;
+        };
+
+        struct Statement {
+            enum class Type : uint8_t {
+                Face, Group, Object, Material
+            };
+
+            static constexpr uint32_t NoName = UINT32_MAX;
+
+            Type type;
+            /// Vertex count for faces, index into chunk's names (or NoName) for everything else
+            uint32_t argument;
+        };
+
+        struct Chunk {
+            const char *begin = nullptr;
+            const char *end = nullptr;
+            size_t positionsOffset = 0;
+            size_t normalsOffset = 0;
+            size_t texCoordsOffset = 0;
+            size_t positionCount = 0;
+            size_t normalCount = 0;
+            size_t texCoordCount = 0;
+            std::vector<Statement> statements;
+            std::vector<FaceVertex> faceVertices;
+            std::vector<std::string> names;
+            AxisAlignedBox3D boundingBox = AxisAlignedBox3D::MaximumReversed();
+            /// First line of the chunk with a face referencing a missing attribute, nullptr if there is none
+            const char *invalidFaceLine = nullptr;
+        };
+
+        static constexpr size_t MinimumChunkSize = 1 << 20;
+
+    private:
+        const char *mMapping = nullptr;
+        size_t mMappingSize = 0;
+
+        std::vector<glm::vec4> mPositions;
+        std::vector<glm::vec3> mNormals;
+        std::vector<glm::vec3> mTexCoords;
+        std::vector<Chunk> mChunks;
+        AxisAlignedBox3D mBoundingBox = AxisAlignedBox3D::MaximumReversed();
+
+        void splitIntoChunks(size_t chunkCount);
+
+        void countAttributes(Chunk &chunk) const;
+
+        void parseChunk(Chunk &chunk);
+
+    public:
+
+#pragma mark - Lifecycle
+
+        /**
+         Maps the file into memory
+
+         @param filePath path to the .obj file
+         @throws std::runtime_error if file could not be opened or mapped
+         */
+        WavefrontParser(const std::string &filePath);
+
+        ~WavefrontParser();
+
+        WavefrontParser(const WavefrontParser &that) = delete;
+
+        WavefrontParser &operator=(const WavefrontParser &rhs) = delete;
+
+#pragma mark - Parsing
+
+        /**
+         Parses the whole file on the default thread pool
+
+         @param minimumChunkSize files smaller than that are parsed in one chunk
+         @throws std::runtime_error if a face index is out of range of the file's attributes
+         */
+        void parse(size_t minimumChunkSize = MinimumChunkSize);
+
+#pragma mark - Getters
+
+        /// Raw file contents, valid while this object is alive
+        const char *data() const;
+
+        size_t size() const;
+
+        std::vector<glm::vec4> &positions();
+
+        std::vector<glm::vec3> &normals();
+
+        std::vector<glm::vec3> &texCoords();
+
+        /// Chunks in file order
+        const std::vector<Chunk> &chunks() const;
+
+        const AxisAlignedBox3D &boundingBox() const;
+    };
+
+}
+
+#endif /* WavefrontParser_hpp */
@@ -176,6 +176,10 @@ namespace EARenderer {
         return glm::inverse(projectionMatrix());
     }
 
+    Frustum Camera::frustum() const {
+        return Frustum(viewProjectionMatrix());
+    }
+
 #pragma mark - Setters
 
     void Camera::setViewportAspectRatio(float aspectRatio) {
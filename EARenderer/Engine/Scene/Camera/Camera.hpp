@@ -10,6 +10,7 @@
 #define Camera_hpp
 
 #include "Ray3D.hpp"
+#include "Frustum.hpp"
 #include "GLViewport.hpp"
 
 #include <glm/vec3.hpp>
@@ -88,6 +89,11 @@ namespace EARenderer {
 
         glm::mat4 inverseProjectionMatrix() const;
 
+        /**
+         @return world space volume visible to the camera
+         */
+        Frustum frustum() const;
+
         void setViewportAspectRatio(float aspectRatio);
     };
 
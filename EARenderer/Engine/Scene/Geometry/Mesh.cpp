@@ -13,13 +13,12 @@ namespace EARenderer {
 
 #pragma mark - Lifecycle
 
-    Mesh::Mesh(const std::string &filePath)
-            :
-            mSubMeshes(500) {
+    Mesh::Mesh(const std::string &filePath) {
         auto meshLoader = MeshLoader::Create(filePath);
         std::vector<SubMesh> subMeshes;
 
         meshLoader->load(subMeshes, mName, mBoundingBox);
+        mSubMeshes.reserve(subMeshes.size());
         for (auto &subMesh : subMeshes) {
             mSubMeshes.emplace(std::move(subMesh));
         }
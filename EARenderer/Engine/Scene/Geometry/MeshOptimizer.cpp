@@ -0,0 +1,436 @@
+//
+//  MeshOptimizer.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "MeshOptimizer.hpp"
+#include "ContentHash.hpp"
+#include "Triangle3D.hpp"
+#include "StringUtils.hpp"
+
+#include <array>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include <glm/geometric.hpp>
+
+namespace EARenderer {
+
+    // Welding compares vertices bitwise, which requires them to be free of padding
+    static_assert(sizeof(Vertex1P1N2UV1T1BT) == 18 * sizeof(float), "Vertex layout has padding");
+
+    // Forsyth's tuning constants
+    static constexpr size_t ForsythCacheSize = 32;
+    static constexpr size_t MaximumScoredValence = 32;
+    static constexpr float CacheDecayPower = 1.5f;
+    static constexpr float LastTriangleScore = 0.75f;
+    static constexpr float ValenceBoostScale = 2.0f;
+    static constexpr float ValenceBoostPower = 0.5f;
+
+    static constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+#pragma mark - Statistics
+
+    float MeshOptimizer::Statistics::sourceACMR() const {
+        return indexCount ? (float) sourceCacheMisses / (indexCount / 3) : 0.0f;
+    }
+
+    float MeshOptimizer::Statistics::ACMR() const {
+        return indexCount ? (float) cacheMisses / (indexCount / 3) : 0.0f;
+    }
+
+    MeshOptimizer::Statistics &MeshOptimizer::Statistics::operator+=(const Statistics &rhs) {
+        sourceVertexCount += rhs.sourceVertexCount;
+        vertexCount += rhs.vertexCount;
+        indexCount += rhs.indexCount;
+        sourceCacheMisses += rhs.sourceCacheMisses;
+        cacheMisses += rhs.cacheMisses;
+        return *this;
+    }
+
+    std::string MeshOptimizer::Statistics::description() const {
+        size_t vertexSize = sizeof(Vertex1P1N2UV1T1BT);
+        float weldedFraction = sourceVertexCount ? (float) vertexCount / sourceVertexCount * 100.0f : 0.0f;
+
+        return string_format("%zu vertices welded into %zu (%.1f%%), %zu KB of vertex data (%zu KB before) + %zu KB of indices, ACMR %.2f (%.2f before reordering)",
+                sourceVertexCount, vertexCount, weldedFraction,
+                vertexCount * vertexSize / 1024, sourceVertexCount * vertexSize / 1024, indexCount * sizeof(uint32_t) / 1024,
+                ACMR(), sourceACMR());
+    }
+
+#pragma mark - Helpers
+
+    class ForsythScoreTable {
+    private:
+        std::array<float, ForsythCacheSize> mCachePositionScores;
+        std::array<float, MaximumScoredValence + 1> mValenceScores;
+
+    public:
+        ForsythScoreTable() {
+            for (size_t i = 0; i < ForsythCacheSize; i++) {
+                if (i < 3) {
+                    // Vertices of the last triangle get a fixed score, so that the algorithm
+                    // doesn't prefer triangles sharing an edge with it too much
+                    mCachePositionScores[i] = LastTriangleScore;
+                } else {
+                    float scaler = 1.0f / (ForsythCacheSize - 3);
+                    mCachePositionScores[i] = std::pow(1.0f - (i - 3) * scaler, CacheDecayPower);
+                }
+            }
+
+            mValenceScores[0] = 0.0f;
+            for (size_t i = 1; i <= MaximumScoredValence; i++) {
+                // Boost vertices with few triangles left, so that lone triangles don't stay behind
+                mValenceScores[i] = ValenceBoostScale * std::pow((float) i, -ValenceBoostPower);
+            }
+        }
+
+        float score(int32_t cachePosition, uint32_t remainingValence) const {
+            if (remainingValence == 0) {
+                return -1.0f;
+            }
+
+            float score = cachePosition >= 0 ? mCachePositionScores[cachePosition] : 0.0f;
+            return score + mValenceScores[std::min(remainingValence, (uint32_t) MaximumScoredValence)];
+        }
+    };
+
+#pragma mark - Processing
+
+    std::vector<uint32_t> MeshOptimizer::WeldVertices(std::vector<Vertex1P1N2UV1T1BT> &vertices) {
+        std::vector<uint32_t> indices(vertices.size());
+        std::vector<Vertex1P1N2UV1T1BT> uniqueVertices;
+        uniqueVertices.reserve(vertices.size());
+
+        // Open addressed table of unique vertex indices, kept at most half full
+        size_t tableSize = 1;
+        while (tableSize < vertices.size() * 2) {
+            tableSize <<= 1;
+        }
+        std::vector<uint32_t> table(tableSize, InvalidIndex);
+
+        for (size_t i = 0; i < vertices.size(); i++) {
+            const Vertex1P1N2UV1T1BT &vertex = vertices[i];
+
+            ContentHash hash;
+            hash.append(&vertex, sizeof(vertex));
+            size_t slot = hash.value() & (tableSize - 1);
+
+            while (true) {
+                uint32_t candidate = table[slot];
+
+                if (candidate == InvalidIndex) {
+                    table[slot] = (uint32_t) uniqueVertices.size();
+                    indices[i] = (uint32_t) uniqueVertices.size();
+                    uniqueVertices.push_back(vertex);
+                    break;
+                }
+
+                if (memcmp(&uniqueVertices[candidate], &vertex, sizeof(vertex)) == 0) {
+                    indices[i] = candidate;
+                    break;
+                }
+
+                slot = (slot + 1) & (tableSize - 1);
+            }
+        }
+
+        uniqueVertices.shrink_to_fit();
+        vertices = std::move(uniqueVertices);
+
+        return indices;
+    }
+
+    void MeshOptimizer::OptimizeVertexCache(std::vector<uint32_t> &indices, size_t vertexCount) {
+        static const ForsythScoreTable scoreTable;
+
+        size_t triangleCount = indices.size() / 3;
+        if (triangleCount < 2) {
+            return;
+        }
+
+        // Triangles adjacent to every vertex, stored in compressed rows.
+        // Emitted triangles are swapped out of the rows, so the valence is also the number of remaining triangles.
+        std::vector<uint32_t> valences(vertexCount, 0);
+        for (uint32_t index : indices) {
+            valences[index]++;
+        }
+
+        std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+        for (size_t v = 0; v < vertexCount; v++) {
+            adjacencyOffsets[v + 1] = adjacencyOffsets[v] + valences[v];
+        }
+
+        std::vector<uint32_t> adjacency(indices.size());
+        std::vector<uint32_t> fillPositions(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (size_t i = 0; i < indices.size(); i++) {
+            adjacency[fillPositions[indices[i]]++] = (uint32_t) (i / 3);
+        }
+
+        std::vector<float> vertexScores(vertexCount);
+        for (size_t v = 0; v < vertexCount; v++) {
+            vertexScores[v] = scoreTable.score(-1, valences[v]);
+        }
+
+        std::vector<float> triangleScores(triangleCount);
+        std::vector<bool> emitted(triangleCount, false);
+
+        uint32_t bestTriangle = 0;
+        for (size_t t = 0; t < triangleCount; t++) {
+            triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+            if (triangleScores[t] > triangleScores[bestTriangle]) {
+                bestTriangle = (uint32_t) t;
+            }
+        }
+
+        std::vector<uint32_t> result;
+        result.reserve(indices.size());
+
+        // Cache may temporarily overflow by the 3 vertices of the emitted triangle
+        std::array<uint32_t, ForsythCacheSize + 3> cache;
+        std::array<uint32_t, ForsythCacheSize + 3> newCache;
+        size_t cacheCount = 0;
+
+        // Fallback for the case when no triangle in the cache is left: scanning continues
+        // from where it stopped the last time, keeping the whole algorithm linear
+        size_t scanPosition = 0;
+
+        while (bestTriangle != InvalidIndex) {
+            emitted[bestTriangle] = true;
+            const uint32_t *triangle = &indices[bestTriangle * 3];
+            result.insert(result.end(), triangle, triangle + 3);
+
+            size_t newCacheCount = 0;
+
+            for (size_t k = 0; k < 3; k++) {
+                uint32_t v = triangle[k];
+
+                auto rowBegin = adjacency.begin() + adjacencyOffsets[v];
+                auto rowEnd = rowBegin + valences[v];
+                auto it = std::find(rowBegin, rowEnd, bestTriangle);
+                std::iter_swap(it, rowEnd - 1);
+                valences[v]--;
+
+                if (std::find(newCache.begin(), newCache.begin() + newCacheCount, v) == newCache.begin() + newCacheCount) {
+                    newCache[newCacheCount++] = v;
+                }
+            }
+
+            for (size_t i = 0; i < cacheCount; i++) {
+                uint32_t v = cache[i];
+                if (v != triangle[0] && v != triangle[1] && v != triangle[2]) {
+                    newCache[newCacheCount++] = v;
+                }
+            }
+
+            // Propagate score changes of every vertex that moved within, entered or left the cache
+            for (size_t i = 0; i < newCacheCount; i++) {
+                uint32_t v = newCache[i];
+                int32_t position = i < ForsythCacheSize ? (int32_t) i : -1;
+
+                float score = scoreTable.score(position, valences[v]);
+                float delta = score - vertexScores[v];
+                vertexScores[v] = score;
+
+                for (uint32_t a = adjacencyOffsets[v]; a < adjacencyOffsets[v] + valences[v]; a++) {
+                    triangleScores[adjacency[a]] += delta;
+                }
+            }
+
+            cacheCount = std::min(newCacheCount, ForsythCacheSize);
+            std::copy(newCache.begin(), newCache.begin() + cacheCount, cache.begin());
+
+            // Best candidate is always adjacent to some cached vertex
+            bestTriangle = InvalidIndex;
+            float bestScore = std::numeric_limits<float>::lowest();
+            for (size_t i = 0; i < cacheCount; i++) {
+                uint32_t v = cache[i];
+                for (uint32_t a = adjacencyOffsets[v]; a < adjacencyOffsets[v] + valences[v]; a++) {
+                    uint32_t t = adjacency[a];
+                    if (triangleScores[t] > bestScore) {
+                        bestScore = triangleScores[t];
+                        bestTriangle = t;
+                    }
+                }
+            }
+
+            if (bestTriangle == InvalidIndex) {
+                while (scanPosition < triangleCount && emitted[scanPosition]) {
+                    scanPosition++;
+                }
+                if (scanPosition < triangleCount) {
+                    bestTriangle = (uint32_t) scanPosition;
+                }
+            }
+        }
+
+        indices = std::move(result);
+    }
+
+    void MeshOptimizer::OptimizeOverdraw(std::vector<uint32_t> &indices, const std::vector<Vertex1P1N2UV1T1BT> &vertices, float maximumACMRIncrease) {
+        struct Cluster {
+            size_t firstTriangle;
+            size_t triangleCount;
+            float sortKey;
+        };
+
+        size_t triangleCount = indices.size() / 3;
+        if (triangleCount < 2) {
+            return;
+        }
+
+        // Cut the index buffer where the simulated cache misses all 3 vertices of a triangle,
+        // reordering clusters at these points costs almost nothing in terms of cache efficiency
+        std::vector<Cluster> clusters;
+        std::vector<uint32_t> timestamps(vertices.size(), 0);
+        uint32_t time = SimulatedCacheSize + 1;
+
+        for (size_t t = 0; t < triangleCount; t++) {
+            size_t misses = 0;
+            for (size_t k = 0; k < 3; k++) {
+                uint32_t v = indices[t * 3 + k];
+                if (time - timestamps[v] > SimulatedCacheSize) {
+                    timestamps[v] = time++;
+                    misses++;
+                }
+            }
+
+            if (misses == 3 || clusters.empty()) {
+                clusters.push_back({t, 0, 0.0f});
+            }
+            clusters.back().triangleCount++;
+        }
+
+        if (clusters.size() < 2) {
+            return;
+        }
+
+        auto triangle = [&](size_t t) {
+            return Triangle3D(glm::vec3(vertices[indices[t * 3]].position),
+                    glm::vec3(vertices[indices[t * 3 + 1]].position),
+                    glm::vec3(vertices[indices[t * 3 + 2]].position));
+        };
+
+        glm::vec3 meshCentroid(0.0);
+        float meshArea = 0.0;
+        for (size_t t = 0; t < triangleCount; t++) {
+            Triangle3D tri = triangle(t);
+            float area = tri.area();
+            meshCentroid += (tri.p1 + tri.p2 + tri.p3) / 3.0f * area;
+            meshArea += area;
+        }
+        if (meshArea > 0.0) {
+            meshCentroid /= meshArea;
+        }
+
+        // Clusters facing away from the mesh center are likely to occlude the rest, draw them first
+        for (Cluster &cluster : clusters) {
+            glm::vec3 centroid(0.0);
+            glm::vec3 normal(0.0);
+            float area = 0.0;
+
+            for (size_t t = cluster.firstTriangle; t < cluster.firstTriangle + cluster.triangleCount; t++) {
+                Triangle3D tri = triangle(t);
+                glm::vec3 areaWeightedNormal = glm::cross(tri.p2 - tri.p1, tri.p3 - tri.p1) * 0.5f;
+                float triangleArea = glm::length(areaWeightedNormal);
+                centroid += (tri.p1 + tri.p2 + tri.p3) / 3.0f * triangleArea;
+                normal += areaWeightedNormal;
+                area += triangleArea;
+            }
+
+            float normalLength = glm::length(normal);
+            if (area > 0.0 && normalLength > 0.0) {
+                cluster.sortKey = glm::dot(centroid / area - meshCentroid, normal / normalLength);
+            }
+        }
+
+        std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster &lhs, const Cluster &rhs) {
+            return lhs.sortKey > rhs.sortKey;
+        });
+
+        std::vector<uint32_t> result;
+        result.reserve(indices.size());
+        for (const Cluster &cluster : clusters) {
+            auto first = indices.begin() + cluster.firstTriangle * 3;
+            result.insert(result.end(), first, first + cluster.triangleCount * 3);
+        }
+
+        size_t sourceMisses = CacheMisses(indices, vertices.size());
+        size_t misses = CacheMisses(result, vertices.size());
+
+        if (misses <= sourceMisses * maximumACMRIncrease) {
+            indices = std::move(result);
+        }
+    }
+
+    void MeshOptimizer::OptimizeVertexFetch(std::vector<Vertex1P1N2UV1T1BT> &vertices, std::vector<uint32_t> &indices) {
+        std::vector<uint32_t> remap(vertices.size(), InvalidIndex);
+        std::vector<Vertex1P1N2UV1T1BT> reorderedVertices;
+        reorderedVertices.reserve(vertices.size());
+
+        for (uint32_t &index : indices) {
+            if (remap[index] == InvalidIndex) {
+                remap[index] = (uint32_t) reorderedVertices.size();
+                reorderedVertices.push_back(vertices[index]);
+            }
+            index = remap[index];
+        }
+
+        vertices = std::move(reorderedVertices);
+    }
+
+    MeshOptimizer::Statistics MeshOptimizer::Optimize(std::vector<Vertex1P1N2UV1T1BT> &vertices, std::vector<uint32_t> &indices) {
+        Statistics statistics;
+        statistics.sourceVertexCount = vertices.size();
+
+        indices = WeldVertices(vertices);
+
+        // Triangles that collapsed into a line or a point after welding produce no fragments
+        size_t writePosition = 0;
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            uint32_t a = indices[i], b = indices[i + 1], c = indices[i + 2];
+            if (a != b && b != c && a != c) {
+                indices[writePosition++] = a;
+                indices[writePosition++] = b;
+                indices[writePosition++] = c;
+            }
+        }
+        indices.resize(writePosition);
+
+        statistics.sourceCacheMisses = CacheMisses(indices, vertices.size());
+
+        OptimizeVertexCache(indices, vertices.size());
+        OptimizeOverdraw(indices, vertices);
+        OptimizeVertexFetch(vertices, indices);
+
+        statistics.vertexCount = vertices.size();
+        statistics.indexCount = indices.size();
+        statistics.cacheMisses = CacheMisses(indices, vertices.size());
+
+        return statistics;
+    }
+
+#pragma mark - Metrics
+
+    size_t MeshOptimizer::CacheMisses(const std::vector<uint32_t> &indices, size_t vertexCount, size_t cacheSize) {
+        // Vertex is in the FIFO cache if less than 'cacheSize' other vertices were inserted after it
+        std::vector<size_t> timestamps(vertexCount, 0);
+        size_t time = cacheSize + 1;
+        size_t misses = 0;
+
+        for (uint32_t index : indices) {
+            if (time - timestamps[index] > cacheSize) {
+                timestamps[index] = time++;
+                misses++;
+            }
+        }
+
+        return misses;
+    }
+
+}
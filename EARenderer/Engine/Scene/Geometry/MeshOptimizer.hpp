@@ -0,0 +1,108 @@
+//
+//  MeshOptimizer.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef MeshOptimizer_hpp
+#define MeshOptimizer_hpp
+
+#include "Vertex1P1N2UV1T1BT.hpp"
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+namespace EARenderer {
+
+    /// Turns triangle soups into indexed triangle lists suitable for the post-transform vertex cache.
+    /// All functions operate on triangle lists, i.e. every 3 consecutive indices form a triangle.
+    class MeshOptimizer {
+    public:
+
+#pragma mark - Nested types
+
+        struct Statistics {
+            size_t sourceVertexCount = 0;
+            size_t vertexCount = 0;
+            size_t indexCount = 0;
+            /// Simulated post-transform cache misses of the welded index buffer before and after reordering
+            size_t sourceCacheMisses = 0;
+            size_t cacheMisses = 0;
+
+            /**
+             @return average cache miss ratio, i.e. vertex shader invocations per triangle, before reordering
+             */
+            float sourceACMR() const;
+
+            float ACMR() const;
+
+            Statistics &operator+=(const Statistics &rhs);
+
+            /**
+             @return vertex counts, data sizes and ACMR before and after optimization in a single line
+             */
+            std::string description() const;
+        };
+
+        /// FIFO cache size used to estimate ACMR and to cut the index buffer into clusters for overdraw optimization
+        static constexpr size_t SimulatedCacheSize = 16;
+
+#pragma mark - Processing
+
+        /**
+         Merges bitwise identical vertices
+
+         @param vertices triangle soup, replaced by unique vertices in order of their first appearance
+         @return index buffer referencing the unique vertices
+         */
+        static std::vector<uint32_t> WeldVertices(std::vector<Vertex1P1N2UV1T1BT> &vertices);
+
+        /**
+         Reorders triangles for post-transform vertex cache efficiency.
+         Linear-speed greedy algorithm by Tom Forsyth: the next triangle is always the one with the
+         highest score, which grows for vertices recently used and for vertices with few remaining triangles.
+
+         @param indices triangle list to be reordered in place
+         @param vertexCount number of vertices referenced by the indices
+         */
+        static void OptimizeVertexCache(std::vector<uint32_t> &indices, size_t vertexCount);
+
+        /**
+         Reorders clusters of cache-optimized triangles so that outward facing parts of the mesh go first.
+         Index buffer is only cut where the simulated cache is flushed anyway, and the result is discarded
+         if cache efficiency drops by more than the given ratio (Tipsify's linear-speed overdraw pass).
+
+         @param indices cache-optimized triangle list to be reordered in place
+         @param vertices vertices referenced by the indices
+         @param maximumACMRIncrease ratio of ACMR after and before the reordering which is still acceptable
+         */
+        static void OptimizeOverdraw(std::vector<uint32_t> &indices, const std::vector<Vertex1P1N2UV1T1BT> &vertices, float maximumACMRIncrease = 1.05f);
+
+        /**
+         Reorders vertices in order of their first use by the index buffer, improving pre-transform fetch locality.
+         Unreferenced vertices are dropped.
+         */
+        static void OptimizeVertexFetch(std::vector<Vertex1P1N2UV1T1BT> &vertices, std::vector<uint32_t> &indices);
+
+        /**
+         Runs the whole pipeline: welding, vertex cache, overdraw and vertex fetch optimizations
+
+         @param vertices triangle soup, replaced by unique vertices
+         @param indices receives the index buffer, without degenerate triangles
+         */
+        static Statistics Optimize(std::vector<Vertex1P1N2UV1T1BT> &vertices, std::vector<uint32_t> &indices);
+
+#pragma mark - Metrics
+
+        /**
+         @return number of vertex shader invocations for the index buffer with a FIFO post-transform cache
+         */
+        static size_t CacheMisses(const std::vector<uint32_t> &indices, size_t vertexCount, size_t cacheSize = SimulatedCacheSize);
+    };
+
+}
+
+#endif /* MeshOptimizer_hpp */
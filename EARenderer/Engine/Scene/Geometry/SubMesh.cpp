@@ -33,6 +33,22 @@ namespace EARenderer {
         return mVertices;
     }
 
+    const std::vector<uint32_t> &SubMesh::indices() const {
+        return mIndices;
+    }
+
+    size_t SubMesh::triangleCount() const {
+        return mIndices.size() / 3;
+    }
+
+    const std::vector<PackedVertex1P1N2UV1T1BT> &SubMesh::packedVertices() const {
+        return mPackedVertices;
+    }
+
+    glm::mat4 SubMesh::positionDequantizationMatrix() const {
+        return PackedVertex1P1N2UV1T1BT::DequantizationMatrix(mBoundingBox);
+    }
+
     float SubMesh::surfaceArea() const {
         return mArea;
     }
@@ -52,6 +68,7 @@ namespace EARenderer {
     void SubMesh::addVertex(const Vertex1P1N2UV1T1BT &vertex) {
         mBoundingBox.min = glm::min(glm::vec3(vertex.position), mBoundingBox.min);
         mBoundingBox.max = glm::max(glm::vec3(vertex.position), mBoundingBox.max);
+        mIndices.push_back((uint32_t) mVertices.size());
         mVertices.push_back(vertex);
 
         if ((mVertices.size() % 3) == 0) {
@@ -65,4 +82,27 @@ namespace EARenderer {
         }
     }
 
+    void SubMesh::setVertices(std::vector<Vertex1P1N2UV1T1BT> &&vertices, std::vector<uint32_t> &&indices, const AxisAlignedBox3D &boundingBox, float area) {
+        mVertices = std::move(vertices);
+        mIndices = std::move(indices);
+        mBoundingBox = boundingBox;
+        mArea = area;
+    }
+
+    MeshOptimizer::Statistics SubMesh::optimize() {
+        return MeshOptimizer::Optimize(mVertices, mIndices);
+    }
+
+    void SubMesh::pack() {
+        mPackedVertices.clear();
+        mPackedVertices.reserve(mVertices.size());
+        for (auto &vertex : mVertices) {
+            mPackedVertices.emplace_back(vertex, mBoundingBox);
+        }
+    }
+
+    void SubMesh::setPackedVertices(std::vector<PackedVertex1P1N2UV1T1BT> &&packedVertices) {
+        mPackedVertices = std::move(packedVertices);
+    }
+
 }
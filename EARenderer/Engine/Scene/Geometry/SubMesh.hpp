@@ -10,11 +10,13 @@
 #define SubMesh_hpp
 
 #include "Vertex1P1N2UV1T1BT.hpp"
+#include "PackedVertex1P1N2UV1T1BT.hpp"
 #include "GLVertexArrayBuffer.hpp"
 #include "GLElementArrayBuffer.hpp"
 #include "GLVertexArray.hpp"
 #include "PackedLookupTable.hpp"
 #include "AxisAlignedBox3D.hpp"
+#include "MeshOptimizer.hpp"
 
 #include <vector>
 
@@ -25,6 +27,8 @@ namespace EARenderer {
         std::string mName;
         std::string mMaterialName;
         std::vector<Vertex1P1N2UV1T1BT> mVertices;
+        std::vector<uint32_t> mIndices;
+        std::vector<PackedVertex1P1N2UV1T1BT> mPackedVertices;
         AxisAlignedBox3D mBoundingBox = AxisAlignedBox3D::MaximumReversed();
         float mArea = 0.0;
 
@@ -41,13 +45,57 @@ namespace EARenderer {
 
         std::vector<Vertex1P1N2UV1T1BT> &vertices();
 
+        /**
+         @return triangle list indexing vertices()
+         */
+        const std::vector<uint32_t> &indices() const;
+
+        size_t triangleCount() const;
+
+        /**
+         @return GPU representation of vertices(), empty until pack() is called
+         */
+        const std::vector<PackedVertex1P1N2UV1T1BT> &packedVertices() const;
+
+        /**
+         @return matrix turning packed positions, normalized to the bounding box, back into the mesh space
+         */
+        glm::mat4 positionDequantizationMatrix() const;
+
         float surfaceArea() const;
 
         void setName(const std::string &name);
 
         void setMaterialName(const std::string &name);
 
+        /**
+         Appends a vertex along with its own index, so that sub mesh is a triangle soup until optimize() is called
+         */
         void addVertex(const Vertex1P1N2UV1T1BT &vertex);
+
+        /**
+         Replaces all vertices at once, skipping per-vertex bookkeeping.
+         Meant for vertices that were already processed before, e.g. the ones loaded from a cooked mesh.
+
+         @param vertices vertices referenced by the indices
+         @param indices triangle list
+         @param boundingBox bounding box of the vertices
+         @param area total area of the triangles
+         */
+        void setVertices(std::vector<Vertex1P1N2UV1T1BT> &&vertices, std::vector<uint32_t> &&indices, const AxisAlignedBox3D &boundingBox, float area);
+
+        /**
+         Welds identical vertices and reorders triangles and vertices for the GPU caches.
+         Should be called once, after all vertices were added.
+         */
+        MeshOptimizer::Statistics optimize();
+
+        /**
+         Builds packed counterparts of the vertices. Should be called after optimize().
+         */
+        void pack();
+
+        void setPackedVertices(std::vector<PackedVertex1P1N2UV1T1BT> &&packedVertices);
     };
 
 }
@@ -7,11 +7,25 @@
 //
 
 #include "CookTorranceMaterial.hpp"
-#include "GLTextureFactory.hpp"
+#include "TextureStreamer.hpp"
 #include "Visitor.hpp"
 
+#include <array>
+#include <stdexcept>
+
 namespace EARenderer {
 
+#pragma mark - Helpers
+
+    template<GLTexture::Normalized Format>
+    static std::shared_ptr<GLNormalizedTexture2D<Format>> StreamedTexture(const std::string &imagePath, MipChain::Content content,
+            const std::array<uint8_t, 4> &placeholder) {
+        auto texture = std::make_shared<GLNormalizedTexture2D<Format>>(Size2D(1), placeholder.data(),
+                Sampling::Filter::Anisotropic, Sampling::WrapMode::Repeat);
+        TextureStreamer::Shared().stream(imagePath, content, texture);
+        return texture;
+    }
+
 #pragma mark - Lifecycle
 
     CookTorranceMaterial::CookTorranceMaterial(
@@ -22,60 +36,73 @@ namespace EARenderer {
             std::variant<std::string, float> ambientOcclusion,
             std::variant<std::string, float> displacement) {
 
+        // Tells constant maps from image ones, so that equal parameter bytes of differently configured materials hash differently
+        for (bool isImage : {std::holds_alternative<std::string>(albedo), std::holds_alternative<std::string>(normal),
+                             std::holds_alternative<std::string>(metalness), std::holds_alternative<std::string>(roughness),
+                             std::holds_alternative<std::string>(ambientOcclusion), std::holds_alternative<std::string>(displacement)}) {
+            mParametersHash.append(isImage);
+        }
+
         // All std::variant functionality that might throw std::bad_variant_access is marked as available starting with macOS 10.14
         // and that means we can't use std::visit **angry face**
         // https://stackoverflow.com/questions/52310835/xcode-10-call-to-unavailable-function-stdvisit
         //
         if (std::holds_alternative<std::string>(albedo)) {
-            mAlbedoMap = GLTextureFactory::LoadLDRImage<GLTexture::Normalized::RGBACompressedRGBAInput>(*std::get_if<std::string>(&albedo));
-            mAlbedoMap->generateMipMaps();
+            mAlbedoMap = StreamedTexture<GLTexture::Normalized::RGBACompressedRGBAInput>(*std::get_if<std::string>(&albedo), MipChain::Content::Color, {128, 128, 128, 255});
+            mImageSources.push_back({*std::get_if<std::string>(&albedo), MipChain::Content::Color});
         } else {
             auto colorData = std::get_if<Color>(&albedo)->rgba();
-            mAlbedoMap = std::make_unique<AlbedoMap>(Size2D(1), &colorData);
+            mAlbedoMap = std::make_shared<AlbedoMap>(Size2D(1), &colorData);
+            mParametersHash.append(colorData);
         }
 
         if (std::holds_alternative<std::string>(normal)) {
-            mNormalMap = GLTextureFactory::LoadLDRImage<GLTexture::Normalized::RGBCompressedRGBAInput>(*std::get_if<std::string>(&normal));
-            mNormalMap->generateMipMaps();
+            mNormalMap = StreamedTexture<GLTexture::Normalized::RGBCompressedRGBAInput>(*std::get_if<std::string>(&normal), MipChain::Content::NormalMap, {128, 128, 255, 255});
+            mImageSources.push_back({*std::get_if<std::string>(&normal), MipChain::Content::NormalMap});
         } else {
             auto normalData = *std::get_if<glm::vec3>(&normal);
-            mNormalMap = std::make_unique<NormalMap>(Size2D(1), &normalData);
+            mNormalMap = std::make_shared<NormalMap>(Size2D(1), &normalData);
+            mParametersHash.append(normalData);
         }
 
         if (std::holds_alternative<std::string>(metalness)) {
-            mMetallicMap = GLTextureFactory::LoadLDRImage<GLTexture::Normalized::RCompressedRGBAInput>(*std::get_if<std::string>(&metalness));
-            mMetallicMap->generateMipMaps();
+            mMetallicMap = StreamedTexture<GLTexture::Normalized::RCompressedRGBAInput>(*std::get_if<std::string>(&metalness), MipChain::Content::Scalar, {0, 0, 0, 255});
+            mImageSources.push_back({*std::get_if<std::string>(&metalness), MipChain::Content::Scalar});
         } else {
             float value = *std::get_if<float>(&metalness);
+            mParametersHash.append(value);
             uint8_t unnormalizedValue = uint8_t(value * 255.0);
-            mMetallicMap = std::make_unique<MetallnessMap>(Size2D(1), &unnormalizedValue);
+            mMetallicMap = std::make_shared<MetallnessMap>(Size2D(1), &unnormalizedValue);
         }
 
         if (std::holds_alternative<std::string>(roughness)) {
-            mRoughnessMap = GLTextureFactory::LoadLDRImage<GLTexture::Normalized::RCompressedRGBAInput>(*std::get_if<std::string>(&roughness));
-            mRoughnessMap->generateMipMaps();
+            mRoughnessMap = StreamedTexture<GLTexture::Normalized::RCompressedRGBAInput>(*std::get_if<std::string>(&roughness), MipChain::Content::Scalar, {128, 128, 128, 255});
+            mImageSources.push_back({*std::get_if<std::string>(&roughness), MipChain::Content::Scalar});
         } else {
             float value = *std::get_if<float>(&roughness);
+            mParametersHash.append(value);
             uint8_t unnormalizedValue = uint8_t(value * 255.0);
-            mRoughnessMap = std::make_unique<RoughnessMap>(Size2D(1), (&unnormalizedValue));
+            mRoughnessMap = std::make_shared<RoughnessMap>(Size2D(1), (&unnormalizedValue));
         }
 
         if (std::holds_alternative<std::string>(ambientOcclusion)) {
-            mAmbientOcclusionMap = GLTextureFactory::LoadLDRImage<GLTexture::Normalized::RCompressedRGBAInput>(*std::get_if<std::string>(&ambientOcclusion));
-            mAmbientOcclusionMap->generateMipMaps();
+            mAmbientOcclusionMap = StreamedTexture<GLTexture::Normalized::RCompressedRGBAInput>(*std::get_if<std::string>(&ambientOcclusion), MipChain::Content::Scalar, {255, 255, 255, 255});
+            mImageSources.push_back({*std::get_if<std::string>(&ambientOcclusion), MipChain::Content::Scalar});
         } else {
             float value = *std::get_if<float>(&ambientOcclusion);
+            mParametersHash.append(value);
             uint8_t unnormalizedValue = uint8_t(value * 255.0);
-            mAmbientOcclusionMap = std::make_unique<AmbientOcclusionMap>(Size2D(1), (&unnormalizedValue));
+            mAmbientOcclusionMap = std::make_shared<AmbientOcclusionMap>(Size2D(1), (&unnormalizedValue));
         }
 
         if (std::holds_alternative<std::string>(displacement)) {
-            mDisplacementMap = GLTextureFactory::LoadLDRImage<GLTexture::Normalized::RCompressedRGBAInput>(*std::get_if<std::string>(&displacement));
-            mDisplacementMap->generateMipMaps();
+            mDisplacementMap = StreamedTexture<GLTexture::Normalized::RCompressedRGBAInput>(*std::get_if<std::string>(&displacement), MipChain::Content::Scalar, {0, 0, 0, 255});
+            mImageSources.push_back({*std::get_if<std::string>(&displacement), MipChain::Content::Scalar});
         } else {
             float value = *std::get_if<float>(&displacement);
+            mParametersHash.append(value);
             uint8_t unnormalizedValue = uint8_t(value * 255.0);
-            mDisplacementMap = std::make_unique<DisplacementMap>(Size2D(1), (&unnormalizedValue));
+            mDisplacementMap = std::make_shared<DisplacementMap>(Size2D(1), (&unnormalizedValue));
         }
 
     }
@@ -106,4 +133,18 @@ namespace EARenderer {
         return mDisplacementMap.get();
     }
 
+#pragma mark - Hashing
+
+    uint64_t CookTorranceMaterial::contentHash() const {
+        ContentHash hash = mParametersHash;
+        for (auto &source : mImageSources) {
+            try {
+                hash.append(TextureStreamer::SourceHash(source.imagePath, source.content));
+            } catch (const std::invalid_argument &) {
+                hash.append(source.imagePath);
+            }
+        }
+        return hash.value();
+    }
+
 }
@@ -17,6 +17,8 @@
 
 #include "GLTexture2D.hpp"
 #include "Color.hpp"
+#include "MipChain.hpp"
+#include "ContentHash.hpp"
 
 namespace EARenderer {
 
@@ -30,14 +32,27 @@ namespace EARenderer {
         using DisplacementMap       = GLNormalizedTexture2D<GLTexture::Normalized::RCompressedRGBAInput>;
 
     private:
-        std::unique_ptr<AlbedoMap> mAlbedoMap;
-        std::unique_ptr<NormalMap> mNormalMap;
-        std::unique_ptr<MetallnessMap> mMetallicMap;
-        std::unique_ptr<RoughnessMap> mRoughnessMap;
-        std::unique_ptr<AmbientOcclusionMap> mAmbientOcclusionMap;
-        std::unique_ptr<DisplacementMap> mDisplacementMap;
+        struct ImageSource {
+            std::string imagePath;
+            MipChain::Content content;
+        };
+
+        // Shared with the texture streamer, which fills image based maps after construction
+        std::shared_ptr<AlbedoMap> mAlbedoMap;
+        std::shared_ptr<NormalMap> mNormalMap;
+        std::shared_ptr<MetallnessMap> mMetallicMap;
+        std::shared_ptr<RoughnessMap> mRoughnessMap;
+        std::shared_ptr<AmbientOcclusionMap> mAmbientOcclusionMap;
+        std::shared_ptr<DisplacementMap> mDisplacementMap;
+
+        // Constant parameters are hashed right away, images only when the content hash is requested
+        ContentHash mParametersHash;
+        std::vector<ImageSource> mImageSources;
 
     public:
+        /**
+         Maps given as image paths are streamed in asynchronously and hold neutral placeholder values until the first mip level arrives
+         */
         CookTorranceMaterial(
                 std::variant<std::string, Color> albedo,
                 std::variant<std::string, glm::vec3> normal,
@@ -58,6 +73,12 @@ namespace EARenderer {
         const AmbientOcclusionMap *ambientOcclusionMap() const;
 
         const DisplacementMap *displacementMap() const;
+
+        /**
+         Fingerprint of constant parameters and of the contents of image files the maps are streamed from.
+         Image files are read on every call; a missing file is represented by its path, since the map keeps its placeholder.
+         */
+        uint64_t contentHash() const;
     };
 
 }
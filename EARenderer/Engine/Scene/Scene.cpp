@@ -10,19 +10,45 @@
 
 #include <glm/vec3.hpp>
 #include <glm/gtc/constants.hpp>
+#include <stdio.h>
+#include <stdexcept>
+#include <set>
 
 #include "Collision.hpp"
 #include "Measurement.hpp"
 #include "SharedResourceStorage.hpp"
+#include "ContentHash.hpp"
 
 namespace EARenderer {
 
 #pragma mark - Lifecycle
 
     Scene::Scene()
-            : mDirectionalLight(Color(1.0, 1.0), glm::vec3(0.0, -1.0, 0.0), 1.0, 0.0),
-              mPointLights(5),
-              mMeshInstances(10) {}
+            : mDirectionalLight(Color(1.0, 1.0), glm::vec3(0.0, -1.0, 0.0), 1.0, 0.0) {}
+
+#pragma mark - Private helpers
+
+    EmbreeRayTracer::MeshTriangles Scene::raytracerMeshTriangles(const Mesh &mesh) const {
+        EmbreeRayTracer::MeshTriangles meshTriangles;
+
+        for (ID subMeshID : mesh.subMeshes()) {
+            const auto &subMesh = mesh.subMeshes()[subMeshID];
+            std::vector<Triangle3D> triangles;
+            const auto &vertices = subMesh.vertices();
+            const auto &indices = subMesh.indices();
+            triangles.reserve(subMesh.triangleCount());
+
+            for (size_t i = 0; i < indices.size(); i += 3) {
+                triangles.emplace_back(vertices[indices[i]].position,
+                        vertices[indices[i + 1]].position,
+                        vertices[indices[i + 2]].position);
+            }
+
+            meshTriangles.emplace_back(std::move(triangles));
+        }
+
+        return meshTriangles;
+    }
 
 #pragma mark - Getters
 
@@ -50,7 +76,7 @@ namespace EARenderer {
         return mMeshInstances;
     }
 
-    std::shared_ptr<SparseOctree<MeshTriangleRef>> Scene::octree() const {
+    std::shared_ptr<LinearOctree<MeshTriangleRef>> Scene::octree() const {
         return mOctree;
     }
 
@@ -98,6 +124,61 @@ namespace EARenderer {
         return mStaticGeometryArea;
     }
 
+    uint64_t Scene::lightBakingInputsHash(const SharedResourceStorage &resourceStorage) const {
+        ContentHash hash;
+        hash.append(mSurfelSpacing);
+        hash.append(mDiffuseProbesSpacing);
+        hash.append(mLightBakingVolume.min);
+        hash.append(mLightBakingVolume.max);
+
+        // Materials are usually shared by many instances, so contents of every one are hashed once
+        std::set<MaterialReference> materialReferences;
+
+        for (ID meshInstanceID : mStaticMeshInstanceIDs) {
+            auto &instance = mMeshInstances[meshInstanceID];
+            auto &mesh = resourceStorage.mesh(instance.meshID());
+
+            hash.append(instance.modelMatrix());
+            hash.append(instance.materialReference.has_value());
+            if (instance.materialReference) {
+                hash.append(instance.materialReference->first);
+                hash.append(instance.materialReference->second);
+                materialReferences.insert(*instance.materialReference);
+            }
+
+            for (ID subMeshID : mesh.subMeshes()) {
+                auto &subMesh = mesh.subMeshes()[subMeshID];
+                hash.append(subMesh.materialName());
+                hash.append(subMesh.vertices());
+                hash.append(subMesh.indices());
+
+                auto materialReference = instance.materialReferenceForSubMeshID(subMeshID);
+                hash.append(materialReference.has_value());
+                if (materialReference) {
+                    hash.append(materialReference->first);
+                    hash.append(materialReference->second);
+                    materialReferences.insert(*materialReference);
+                }
+            }
+        }
+
+        for (auto &reference : materialReferences) {
+            hash.append(reference.first);
+            hash.append(reference.second);
+
+            switch (reference.first) {
+                case MaterialType::CookTorrance:
+                    hash.append(resourceStorage.cookTorranceMaterial(reference.second).contentHash());
+                    break;
+                case MaterialType::Emissive:
+                    hash.append(resourceStorage.emissiveMaterial(reference.second).emissionColor.rgba());
+                    break;
+            }
+        }
+
+        return hash.value();
+    }
+
 #pragma mark - Setters
 
     void Scene::setCamera(std::unique_ptr<Camera> camera) {
@@ -152,12 +233,7 @@ namespace EARenderer {
             return nodeBoundingBox.contains(ref.triangle);
         };
 
-        auto collision = [&](const MeshTriangleRef &ref, const Ray3D &ray) {
-            float distance = 0;
-            return Collision::RayTriangle(ray, ref.triangle, distance);
-        };
-
-        mOctree = std::shared_ptr<SparseOctree<MeshTriangleRef>>(new SparseOctree<MeshTriangleRef>(mBoundingBox, mOctreeDepth, containment, collision));
+        std::vector<MeshTriangleRef> triangleRefs;
 
         for (ID meshInstanceID : mStaticMeshInstanceIDs) {
             auto &meshInstance = mMeshInstances[meshInstanceID];
@@ -168,43 +244,91 @@ namespace EARenderer {
             for (ID subMeshID : mesh.subMeshes()) {
                 auto &subMesh = mesh.subMeshes()[subMeshID];
 
-                for (size_t i = 0; i < subMesh.vertices().size(); i += 3) {
-                    Triangle3D triangle(modelMatrix * subMesh.vertices()[i].position,
-                            modelMatrix * subMesh.vertices()[i + 1].position,
-                            modelMatrix * subMesh.vertices()[i + 2].position);
+                const auto &vertices = subMesh.vertices();
+                const auto &indices = subMesh.indices();
+
+                for (size_t i = 0; i < indices.size(); i += 3) {
+                    Triangle3D triangle(modelMatrix * vertices[indices[i]].position,
+                            modelMatrix * vertices[indices[i + 1]].position,
+                            modelMatrix * vertices[indices[i + 2]].position);
 
-                    MeshTriangleRef ref({meshInstanceID, subMeshID, triangle});
-                    mOctree->insert(ref);
+                    triangleRefs.push_back({meshInstanceID, subMeshID, triangle});
                 }
             }
         }
+
+        mOctree = std::make_shared<LinearOctree<MeshTriangleRef>>(mBoundingBox, mOctreeDepth);
+        mOctree->build(triangleRefs, containment);
     }
 
     void Scene::buildStaticGeometryRaytracer(const SharedResourceStorage &resourceStorage) {
-        std::vector<Triangle3D> triangles;
+        std::vector<EmbreeRayTracer::MeshTriangles> meshes;
+        std::vector<EmbreeRayTracer::Instance> instances;
+        mRaytracerMeshIndices.clear();
+        mRaytracerDynamicInstanceIndices.clear();
 
         for (ID meshInstanceID : mStaticMeshInstanceIDs) {
             const auto &meshInstance = mMeshInstances[meshInstanceID];
-            const auto &mesh = resourceStorage.mesh(meshInstance.meshID());
 
-            auto modelMatrix = meshInstance.modelMatrix();
+            auto meshIndexIt = mRaytracerMeshIndices.find(meshInstance.meshID());
 
-            for (ID subMeshID : mesh.subMeshes()) {
-                const auto &subMesh = mesh.subMeshes()[subMeshID];
+            // Mesh geometry is uploaded once in its local space and shared between all of its instances
+            if (meshIndexIt == mRaytracerMeshIndices.end()) {
+                meshes.emplace_back(raytracerMeshTriangles(resourceStorage.mesh(meshInstance.meshID())));
+                meshIndexIt = mRaytracerMeshIndices.emplace(meshInstance.meshID(), meshes.size() - 1).first;
+            }
 
-                for (size_t i = 0; i < subMesh.vertices().size(); i += 3) {
-                    triangles.emplace_back(modelMatrix * subMesh.vertices()[i].position,
-                            modelMatrix * subMesh.vertices()[i + 1].position,
-                            modelMatrix * subMesh.vertices()[i + 2].position);
-                }
+            instances.push_back({meshIndexIt->second, meshInstance.modelMatrix()});
+        }
+
+        mRaytracer = std::make_shared<EmbreeRayTracer>(meshes, instances);
+    }
+
+    void Scene::buildDynamicGeometryRaytracer(const SharedResourceStorage &resourceStorage) {
+        if (!mRaytracer) {
+            throw std::runtime_error("Static geometry ray tracer must be built before dynamic geometry is added to it");
+        }
+
+        for (ID meshInstanceID : mDynamicMeshInstanceIDs) {
+            if (mRaytracerDynamicInstanceIndices.find(meshInstanceID) != mRaytracerDynamicInstanceIndices.end()) {
+                continue;
             }
+
+            const auto &meshInstance = mMeshInstances[meshInstanceID];
+
+            auto meshIndexIt = mRaytracerMeshIndices.find(meshInstance.meshID());
+            if (meshIndexIt == mRaytracerMeshIndices.end()) {
+                size_t meshIndex = mRaytracer->addMesh(raytracerMeshTriangles(resourceStorage.mesh(meshInstance.meshID())));
+                meshIndexIt = mRaytracerMeshIndices.emplace(meshInstance.meshID(), meshIndex).first;
+            }
+
+            size_t instanceIndex = mRaytracer->addDynamicInstance({meshIndexIt->second, meshInstance.transformation().modelMatrix()});
+            mRaytracerDynamicInstanceIndices[meshInstanceID] = instanceIndex;
         }
 
-        mRaytracer = std::make_shared<EmbreeRayTracer>(triangles);
+        mRaytracer->commitDynamicInstances();
+    }
+
+    void Scene::refitDynamicGeometryRaytracer() {
+        if (!mRaytracer) {
+            return;
+        }
+
+        for (auto &idIndexPair : mRaytracerDynamicInstanceIndices) {
+            const auto &meshInstance = mMeshInstances[idIndexPair.first];
+            // Transformation may be altered in place, which bypasses the cached model matrix
+            mRaytracer->setDynamicInstanceModelMatrix(idIndexPair.second, meshInstance.transformation().modelMatrix());
+        }
+
+        mRaytracer->commitDynamicInstances();
     }
 
     void Scene::destroyAuxiliaryData() {
-        mRaytracer = nullptr;
+        // Dynamic instances are refitted as they move, the ray tracer has to outlive baking in that case
+        if (mRaytracerDynamicInstanceIndices.empty()) {
+            mRaytracer = nullptr;
+            mRaytracerMeshIndices.clear();
+        }
         mOctree = nullptr;
     }
 
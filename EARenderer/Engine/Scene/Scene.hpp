@@ -22,7 +22,7 @@
 #include "GLBufferTexture.hpp"
 #include "Surfel.hpp"
 #include "SurfelCluster.hpp"
-#include "SparseOctree.hpp"
+#include "LinearOctree.hpp"
 #include "MeshTriangleRef.hpp"
 #include "SurfelClusterProjection.hpp"
 #include "EmbreeRayTracer.hpp"
@@ -31,6 +31,7 @@
 #include <vector>
 #include <list>
 #include <memory>
+#include <unordered_map>
 
 namespace EARenderer {
 
@@ -59,8 +60,10 @@ namespace EARenderer {
         std::vector<SurfelClusterProjection> mSurfelClusterProjections;
         std::vector<DiffuseLightProbe> mDiffuseLightProbes;
 
-        std::shared_ptr<SparseOctree<MeshTriangleRef>> mOctree;
+        std::shared_ptr<LinearOctree<MeshTriangleRef>> mOctree;
         std::shared_ptr<EmbreeRayTracer> mRaytracer;
+        std::unordered_map<ID, size_t> mRaytracerMeshIndices;
+        std::unordered_map<ID, size_t> mRaytracerDynamicInstanceIndices;
 
         std::list<ID> mStaticMeshInstanceIDs;
         std::list<ID> mDynamicMeshInstanceIDs;
@@ -71,6 +74,10 @@ namespace EARenderer {
         AxisAlignedBox3D mBoundingBox;
         AxisAlignedBox3D mLightBakingVolume;
 
+#pragma mark - Private helpers
+
+        EmbreeRayTracer::MeshTriangles raytracerMeshTriangles(const Mesh &mesh) const;
+
     public:
 
 #pragma mark - Lifecycle
@@ -91,7 +98,7 @@ namespace EARenderer {
 
         const PackedLookupTable<MeshInstance> &meshInstances() const;
 
-        std::shared_ptr<SparseOctree<MeshTriangleRef>> octree() const;
+        std::shared_ptr<LinearOctree<MeshTriangleRef>> octree() const;
 
         std::shared_ptr<EmbreeRayTracer> rayTracer() const;
 
@@ -111,6 +118,16 @@ namespace EARenderer {
 
         float staticGeometryArea() const;
 
+        /**
+         Fingerprint of everything baked global illumination data depends on:
+         static geometry, its transformations, material parameters and image files, light baking volume, surfel and probe spacing.
+         Image files of referenced materials are read to be hashed.
+
+         @param resourceStorage storage containing meshes and materials referenced by static mesh instances
+         @return hash used to detect stale baked data
+         */
+        uint64_t lightBakingInputsHash(const SharedResourceStorage &resourceStorage) const;
+
         Camera *camera() const;
 
         Skybox *skybox() const;
@@ -141,8 +158,21 @@ namespace EARenderer {
 
         void buildStaticGeometryRaytracer(const SharedResourceStorage& resourceStorage);
 
+        /**
+         Adds dynamic mesh instances to the ray tracer built by buildStaticGeometryRaytracer().
+         They are kept in a separate BVH, which is refitted by refitDynamicGeometryRaytracer().
+         */
+        void buildDynamicGeometryRaytracer(const SharedResourceStorage& resourceStorage);
+
+        /**
+         Pushes current transformations of dynamic mesh instances to the ray tracer.
+         Only the dynamic BVH is refitted, and only if any of the instances has moved.
+         */
+        void refitDynamicGeometryRaytracer();
+
         /**
          Destroy helper objects that take up a lot of memory, but can be recreated at any time (ray tracers, etc.)
+         The ray tracer is kept if it contains dynamic instances, since they are refitted after every move.
          */
         void destroyAuxiliaryData();
     };
@@ -93,6 +93,9 @@ namespace EARenderer {
             // Set instanse's transform back
             instance.setTransformation(transform);
 
+            // Keep ray traced visibility in sync with moved dynamic instances
+            mScene->refitDynamicGeometryRaytracer();
+
             mMeshUpdateEvent(mAxesSelection.meshID);
         }
 
@@ -0,0 +1,166 @@
+//
+//  BakedDataFile.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "BakedDataFile.hpp"
+#include "MemoryUtils.hpp"
+#include "StringUtils.hpp"
+
+#include <fstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace EARenderer {
+
+#pragma mark - Writer
+
+    void BakedDataFile::Writer::addSection(uint32_t tag, const void *data, size_t size) {
+        for (auto &section : mSections) {
+            if (section.tag == tag) {
+                throw std::invalid_argument(string_format("Section with tag %u has already been added", tag));
+            }
+        }
+        mSections.push_back({tag, data, size});
+    }
+
+    void BakedDataFile::Writer::write(const std::string &filePath, uint64_t contentHash) const {
+        Header header{Magic, FormatVersion, contentHash, (uint32_t) mSections.size(), 0};
+
+        std::vector<SectionEntry> table;
+        uint64_t offset = sizeof(Header) + sizeof(SectionEntry) * mSections.size();
+
+        for (auto &section : mSections) {
+            offset += Utils::Memory::Padding(offset, SectionAlignment);
+            table.push_back({section.tag, 0, offset, section.size});
+            offset += section.size;
+        }
+
+        std::ofstream stream(filePath, std::ios::trunc | std::ios::binary);
+        if (!stream.is_open()) {
+            throw std::runtime_error(string_format("Unable to write baked data: %s", filePath.c_str()));
+        }
+
+        stream.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+        stream.write(reinterpret_cast<const char *>(table.data()), table.size() * sizeof(SectionEntry));
+
+        const char zeros[SectionAlignment] = {};
+        uint64_t position = sizeof(Header) + sizeof(SectionEntry) * table.size();
+
+        for (size_t i = 0; i < mSections.size(); i++) {
+            stream.write(zeros, table[i].offset - position);
+            stream.write(reinterpret_cast<const char *>(mSections[i].data), mSections[i].size);
+            position = table[i].offset + table[i].size;
+        }
+
+        if (!stream.good()) {
+            throw std::runtime_error(string_format("Unable to write baked data: %s", filePath.c_str()));
+        }
+    }
+
+#pragma mark - Lifecycle
+
+    BakedDataFile::BakedDataFile(const std::string &filePath) {
+        int descriptor = open(filePath.c_str(), O_RDONLY);
+        if (descriptor == -1) {
+            throw std::runtime_error(string_format("Unable to open baked data: %s", filePath.c_str()));
+        }
+
+        struct stat fileInfo;
+        if (fstat(descriptor, &fileInfo) == -1 || fileInfo.st_size < (off_t) sizeof(Header)) {
+            close(descriptor);
+            throw std::runtime_error(string_format("Baked data file is truncated: %s", filePath.c_str()));
+        }
+
+        mMappingSize = (size_t) fileInfo.st_size;
+        void *mapping = mmap(nullptr, mMappingSize, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+        // Mapping stays valid after the descriptor is closed
+        close(descriptor);
+
+        if (mapping == MAP_FAILED) {
+            throw std::runtime_error(string_format("Unable to map baked data: %s", filePath.c_str()));
+        }
+
+        mMapping = reinterpret_cast<const uint8_t *>(mapping);
+
+        try {
+            validate();
+        } catch (...) {
+            munmap(const_cast<uint8_t *>(mMapping), mMappingSize);
+            throw;
+        }
+    }
+
+    BakedDataFile::~BakedDataFile() {
+        munmap(const_cast<uint8_t *>(mMapping), mMappingSize);
+    }
+
+#pragma mark - Private helpers
+
+    const BakedDataFile::Header *BakedDataFile::header() const {
+        return reinterpret_cast<const Header *>(mMapping);
+    }
+
+    const BakedDataFile::SectionEntry *BakedDataFile::sectionTable() const {
+        return reinterpret_cast<const SectionEntry *>(mMapping + sizeof(Header));
+    }
+
+    void BakedDataFile::validate() const {
+        const Header *fileHeader = header();
+
+        if (fileHeader->magic != Magic) {
+            throw std::runtime_error("Not a baked data file");
+        }
+
+        if (fileHeader->version != FormatVersion) {
+            throw std::runtime_error(string_format("Baked data format version %u is not supported (expected %u)", fileHeader->version, FormatVersion));
+        }
+
+        uint64_t tableEnd = sizeof(Header) + (uint64_t) fileHeader->sectionCount * sizeof(SectionEntry);
+        if (tableEnd > mMappingSize) {
+            throw std::runtime_error("Baked data section table is truncated");
+        }
+
+        for (uint32_t i = 0; i < fileHeader->sectionCount; i++) {
+            const SectionEntry &entry = sectionTable()[i];
+            if (entry.offset % SectionAlignment != 0 || entry.offset < tableEnd ||
+                    entry.offset > mMappingSize || entry.size > mMappingSize - entry.offset) {
+                throw std::runtime_error("Baked data section is out of file bounds");
+            }
+        }
+    }
+
+#pragma mark - Getters
+
+    uint64_t BakedDataFile::contentHash() const {
+        return header()->contentHash;
+    }
+
+    bool BakedDataFile::hasSection(uint32_t tag) const {
+        for (uint32_t i = 0; i < header()->sectionCount; i++) {
+            if (sectionTable()[i].tag == tag) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    BakedDataFile::Section BakedDataFile::section(uint32_t tag) const {
+        for (uint32_t i = 0; i < header()->sectionCount; i++) {
+            const SectionEntry &entry = sectionTable()[i];
+            if (entry.tag == tag) {
+                return {mMapping + entry.offset, (size_t) entry.size};
+            }
+        }
+        throw std::out_of_range(string_format("Baked data has no section with tag %u", tag));
+    }
+
+}
@@ -0,0 +1,138 @@
+//
+//  BakedDataFile.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef BakedDataFile_hpp
+#define BakedDataFile_hpp
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace EARenderer {
+
+    /// Read-only memory mapped container of precomputed (baked) data.
+    ///
+    /// Layout: header, section table, then raw sections each starting at a 64-byte boundary.
+    /// Sections are memory images of trivially copyable arrays, so they can be handed
+    /// to GL buffer uploads right from the mapping without any parsing.
+    /// The header carries a hash of everything the data was computed from,
+    /// which lets clients detect stale files.
+    class BakedDataFile {
+    public:
+
+#pragma mark - Nested types
+
+        static constexpr uint32_t Magic = 0x4B424145; // 'EABK'
+        static constexpr uint32_t FormatVersion = 2;
+        static constexpr size_t SectionAlignment = 64;
+
+        struct Section {
+            const void *data = nullptr;
+            size_t size = 0;
+
+            template<class T>
+            const T *objects() const {
+                return reinterpret_cast<const T *>(data);
+            }
+
+            template<class T>
+            size_t count() const {
+                return size / sizeof(T);
+            }
+        };
+
+        /// Collects sections in memory and writes them to disk in one go.
+        /// Section data is not copied and must outlive the writer.
+        class Writer {
+        private:
+            struct PendingSection {
+                uint32_t tag;
+                const void *data;
+                size_t size;
+            };
+
+            std::vector<PendingSection> mSections;
+
+        public:
+            void addSection(uint32_t tag, const void *data, size_t size);
+
+            template<class T>
+            void addSection(uint32_t tag, const std::vector<T> &objects) {
+                addSection(tag, objects.data(), objects.size() * sizeof(T));
+            }
+
+            /**
+             Writes header and all sections to the file, replacing its contents
+
+             @param filePath path to the file
+             @param contentHash hash of inputs the data was produced from
+             @throws std::runtime_error if file could not be written
+             */
+            void write(const std::string &filePath, uint64_t contentHash) const;
+        };
+
+    private:
+        struct Header {
+            uint32_t magic;
+            uint32_t version;
+            uint64_t contentHash;
+            uint32_t sectionCount;
+            uint32_t reserved;
+        };
+
+        struct SectionEntry {
+            uint32_t tag;
+            uint32_t reserved;
+            uint64_t offset;
+            uint64_t size;
+        };
+
+        const uint8_t *mMapping = nullptr;
+        size_t mMappingSize = 0;
+
+        const Header *header() const;
+
+        const SectionEntry *sectionTable() const;
+
+        void validate() const;
+
+    public:
+
+#pragma mark - Lifecycle
+
+        /**
+         Maps the file into memory
+
+         @param filePath path to the file
+         @throws std::runtime_error if file could not be mapped, is corrupt, or was written in a different format version
+         */
+        BakedDataFile(const std::string &filePath);
+
+        ~BakedDataFile();
+
+        BakedDataFile(const BakedDataFile &that) = delete;
+
+        BakedDataFile &operator=(const BakedDataFile &rhs) = delete;
+
+#pragma mark - Getters
+
+        uint64_t contentHash() const;
+
+        bool hasSection(uint32_t tag) const;
+
+        /**
+         @param tag tag the section was written with
+         @return memory range of the section, valid while this object is alive
+         @throws std::out_of_range if there is no section with such tag
+         */
+        Section section(uint32_t tag) const;
+    };
+
+}
+
+#endif /* BakedDataFile_hpp */
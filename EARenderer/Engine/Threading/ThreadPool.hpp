@@ -13,6 +13,7 @@
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <future>
@@ -108,6 +109,13 @@ namespace EARenderer {
             auto get() {
                 return mFuture.get();
             }
+
+            /**
+             * Checks whether the result is available without blocking.
+             */
+            bool isReady() const {
+                return mFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+            }
         };
 
 #pragma mark - Thread Pool Member Variables
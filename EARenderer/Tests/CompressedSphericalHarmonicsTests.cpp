@@ -0,0 +1,92 @@
+//
+//  CompressedSphericalHarmonicsTests.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+//  Engine sources: Math/CompressedSphericalHarmonics.cpp, Math/SphericalHarmonics.cpp, Foundation/Color.cpp
+//
+
+#include "TestUtils.hpp"
+#include "CompressedSphericalHarmonics.hpp"
+
+#include <glm/geometric.hpp>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace EARenderer;
+
+using Coefficients = std::array<glm::vec3, SphericalHarmonics::CoefficientCount>;
+
+// Luma dominated, the way YCoCg projections of baked lighting look
+static std::vector<SphericalHarmonics> RandomYCoCgSHs(size_t count, float scale) {
+    std::mt19937 engine(5);
+    std::uniform_real_distribution<float> luma(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> chroma(-0.2f, 0.2f);
+
+    std::vector<SphericalHarmonics> shs;
+    for (size_t i = 0; i < count; i++) {
+        Coefficients coefficients;
+        for (auto &coefficient : coefficients) {
+            coefficient = glm::vec3(luma(engine), chroma(engine), chroma(engine)) * scale;
+        }
+        shs.emplace_back(coefficients);
+    }
+    return shs;
+}
+
+/// Relative RMS error over all coefficients of all the SHs, in the channels selected by the mask
+template<class Compressed>
+static double RelativeError(const std::vector<SphericalHarmonics> &shs, const glm::vec3 &channelMask) {
+    double error2 = 0.0;
+    double norm2 = 0.0;
+    for (auto &sh : shs) {
+        Coefficients original = sh.coefficients();
+        Coefficients decompressed = Compressed(sh).decompressed().coefficients();
+        for (size_t c = 0; c < SphericalHarmonics::CoefficientCount; c++) {
+            glm::vec3 delta = (original[c] - decompressed[c]) * channelMask;
+            error2 += glm::dot(delta, delta);
+            norm2 += glm::dot(original[c] * channelMask, original[c] * channelMask);
+        }
+    }
+    return std::sqrt(error2 / norm2);
+}
+
+TEST(CompressedSizesMatchGPULayout) {
+    EXPECT(sizeof(CompressedSphericalHarmonics) == 32);
+    EXPECT(sizeof(CompressedLumaSphericalHarmonics) == 16);
+}
+
+TEST(ProjectionErrorIsSmall) {
+    // Shared exponents make the error independent of magnitude
+    for (float scale : {0.01f, 1.0f, 300.0f}) {
+        EXPECT(RelativeError<CompressedSphericalHarmonics>(RandomYCoCgSHs(1000, scale), glm::vec3(1.0f)) < 0.01);
+    }
+}
+
+TEST(LumaErrorIsSmall) {
+    for (float scale : {0.01f, 1.0f, 300.0f}) {
+        EXPECT(RelativeError<CompressedLumaSphericalHarmonics>(RandomYCoCgSHs(1000, scale), glm::vec3(1.0f, 0.0f, 0.0f)) < 0.01);
+    }
+}
+
+TEST(LumaIsReplicatedToAllChannels) {
+    Coefficients decompressed = CompressedLumaSphericalHarmonics(RandomYCoCgSHs(1, 1.0f)[0]).decompressed().coefficients();
+    for (auto &coefficient : decompressed) {
+        EXPECT(coefficient.r == coefficient.g && coefficient.r == coefficient.b);
+    }
+}
+
+TEST(ZeroStaysZero) {
+    for (auto &coefficient : CompressedSphericalHarmonics(SphericalHarmonics()).decompressed().coefficients()) {
+        EXPECT(coefficient == glm::vec3(0.0f));
+    }
+    for (auto &coefficient : CompressedLumaSphericalHarmonics(SphericalHarmonics()).decompressed().coefficients()) {
+        EXPECT(coefficient == glm::vec3(0.0f));
+    }
+}
+
+TEST_MAIN()
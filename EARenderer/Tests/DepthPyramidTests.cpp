@@ -0,0 +1,122 @@
+//
+//  DepthPyramidTests.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+//  Engine sources: Rendering/Runtime/DepthPyramid.cpp, Math/AxisAlignedBox3D.cpp, Math/Size2D.cpp, Scene/Geometry/Transformation.cpp
+//
+
+#include "TestUtils.hpp"
+#include "DepthPyramid.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace EARenderer;
+
+static DepthPyramid::Level UniformLevel(uint32_t width, uint32_t height, float depth) {
+    DepthPyramid::Level level;
+    level.width = width;
+    level.height = height;
+    level.depths.assign(width * height, depth);
+    return level;
+}
+
+// Window space depth of a point at the given distance in front of the camera
+static float WindowDepth(const glm::mat4 &projection, float distance) {
+    glm::vec4 clip = projection * glm::vec4(0.0f, 0.0f, -distance, 1.0f);
+    return clip.z / clip.w * 0.5f + 0.5f;
+}
+
+static const glm::mat4 &Projection() {
+    static glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f);
+    return projection;
+}
+
+// Camera at the origin looking down -Z, with a wall at distance 10 covering the whole 64x64 viewport
+static DepthPyramid WallPyramid() {
+    return DepthPyramid(Size2D(64, 64), 2, UniformLevel(16, 16, WindowDepth(Projection(), 10.0f)));
+}
+
+TEST(ReducedKeepsFarthestDepth) {
+    DepthPyramid::Level level = UniformLevel(4, 4, 0.1f);
+    level.depths[1 * 4 + 2] = 0.9f;
+
+    DepthPyramid::Level reduced = DepthPyramid::Reduced(level);
+    EXPECT(reduced.width == 2 && reduced.height == 2);
+    EXPECT(reduced.depth(1, 0) == 0.9f);
+    EXPECT(reduced.depth(0, 0) == 0.1f);
+    EXPECT(reduced.depth(0, 1) == 0.1f);
+    EXPECT(reduced.depth(1, 1) == 0.1f);
+}
+
+TEST(ReducedCoversLeftoverTexelsOfOddSizes) {
+    DepthPyramid::Level level = UniformLevel(5, 3, 0.1f);
+    // Last column and last row have no texel of their own one level up
+    level.depths[0 * 5 + 4] = 0.7f;
+    level.depths[2 * 5 + 0] = 0.8f;
+
+    DepthPyramid::Level reduced = DepthPyramid::Reduced(level);
+    EXPECT(reduced.width == 2 && reduced.height == 1);
+    EXPECT(reduced.depth(0, 0) == 0.8f);
+    EXPECT(reduced.depth(1, 0) == 0.7f);
+}
+
+TEST(PyramidIsReducedDownToSingleTexel) {
+    DepthPyramid::Level base = UniformLevel(7, 3, 0.2f);
+    base.depths[2 * 7 + 6] = 0.6f;
+
+    DepthPyramid pyramid(Size2D(28, 12), 2, std::move(base));
+    auto &levels = pyramid.levels();
+    EXPECT(levels.size() == 3);
+    EXPECT(levels.back().width == 1 && levels.back().height == 1);
+    EXPECT(levels.back().depths[0] == 0.6f);
+}
+
+TEST(EmptyPyramidReportsEverythingVisible) {
+    DepthPyramid pyramid;
+    EXPECT(pyramid.isEmpty());
+    EXPECT(pyramid.isVisible(AxisAlignedBox3D(glm::vec3(-1.0f, -1.0f, -50.0f), glm::vec3(1.0f, 1.0f, -49.0f)), Projection()));
+}
+
+TEST(BoxBehindWallIsHidden) {
+    DepthPyramid pyramid = WallPyramid();
+    EXPECT(!pyramid.isVisible(AxisAlignedBox3D(glm::vec3(-1.0f, -1.0f, -21.0f), glm::vec3(1.0f, 1.0f, -20.0f)), Projection()));
+}
+
+TEST(BoxInFrontOfWallIsVisible) {
+    DepthPyramid pyramid = WallPyramid();
+    EXPECT(pyramid.isVisible(AxisAlignedBox3D(glm::vec3(-1.0f, -1.0f, -6.0f), glm::vec3(1.0f, 1.0f, -5.0f)), Projection()));
+    // Intersecting the wall
+    EXPECT(pyramid.isVisible(AxisAlignedBox3D(glm::vec3(-1.0f, -1.0f, -12.0f), glm::vec3(1.0f, 1.0f, -8.0f)), Projection()));
+}
+
+TEST(BoxSeenThroughHoleIsVisible) {
+    DepthPyramid::Level base = UniformLevel(16, 16, WindowDepth(Projection(), 10.0f));
+    // Far plane shows through the center of the viewport
+    for (uint32_t y = 6; y < 10; y++) {
+        for (uint32_t x = 6; x < 10; x++) {
+            base.depths[y * 16 + x] = 1.0f;
+        }
+    }
+    DepthPyramid pyramid(Size2D(64, 64), 2, std::move(base));
+
+    EXPECT(pyramid.isVisible(AxisAlignedBox3D(glm::vec3(-0.5f, -0.5f, -21.0f), glm::vec3(0.5f, 0.5f, -20.0f)), Projection()));
+    // Off to the side the wall still hides it
+    EXPECT(!pyramid.isVisible(AxisAlignedBox3D(glm::vec3(10.0f, 10.0f, -21.0f), glm::vec3(11.0f, 11.0f, -20.0f)), Projection()));
+}
+
+TEST(BoxOutsideViewportIsHidden) {
+    DepthPyramid pyramid = WallPyramid();
+    EXPECT(!pyramid.isVisible(AxisAlignedBox3D(glm::vec3(50.0f, -1.0f, -6.0f), glm::vec3(51.0f, 1.0f, -5.0f)), Projection()));
+}
+
+TEST(BoxCrossingCameraPlaneIsVisible) {
+    DepthPyramid pyramid = WallPyramid();
+    EXPECT(pyramid.isVisible(AxisAlignedBox3D(glm::vec3(-1.0f, -1.0f, -30.0f), glm::vec3(1.0f, 1.0f, 1.0f)), Projection()));
+    // Entirely behind the camera, which is left to frustum culling
+    EXPECT(pyramid.isVisible(AxisAlignedBox3D(glm::vec3(-1.0f, -1.0f, 5.0f), glm::vec3(1.0f, 1.0f, 6.0f)), Projection()));
+}
+
+TEST_MAIN()
@@ -0,0 +1,275 @@
+//
+//  DrawPacketQueueTests.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+//  Engine sources: Rendering/Runtime/DrawPacketQueue.cpp, OpenGL/Core/GLTextureUnitManager.cpp,
+//  OpenGL/Core/Textures/GLTexture.cpp, OpenGL/Core/GLNamedObject.cpp, Math/Size2D.cpp
+//  GL entry points used by those sources are defined here and record the calls, so don't link against OpenGL.
+//
+
+#include "TestUtils.hpp"
+#include "DrawPacketQueue.hpp"
+#include "GLTextureUnitManager.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace EARenderer;
+
+#pragma mark - GL call recorder
+
+struct GLCallCounts {
+    size_t textureBinds = 0;
+    size_t unitSwitches = 0;
+    size_t uniformUploads = 0;
+};
+
+static GLCallCounts RecordedCalls;
+static GLuint LastTextureName = 0;
+
+extern "C" {
+    void glGenTextures(GLsizei n, GLuint *textures) { for (GLsizei i = 0; i < n; i++) textures[i] = ++LastTextureName; }
+    void glDeleteTextures(GLsizei, const GLuint *) {}
+    void glBindTexture(GLenum, GLuint) { RecordedCalls.textureBinds++; }
+    void glActiveTexture(GLenum) { RecordedCalls.unitSwitches++; }
+    void glBindSampler(GLuint, GLuint) {}
+    void glUniform1i(GLint, GLint) { RecordedCalls.uniformUploads++; }
+    void glGetIntegerv(GLenum, GLint *data) { *data = 16; }
+    void glGetFloatv(GLenum, GLfloat *data) { *data = 16.0f; }
+    void glTexParameteri(GLenum, GLenum, GLint) {}
+    void glTexParameterf(GLenum, GLenum, GLfloat) {}
+    void glGenerateMipmap(GLenum) {}
+    void glGetTexLevelParameteriv(GLenum, GLint, GLenum, GLint *data) { *data = 1; }
+}
+
+struct RecordedTexture : public GLTexture {
+    RecordedTexture() : GLTexture(GL_TEXTURE_2D) {}
+};
+
+// Packets remember their insertion order in meshInstanceID, so that stability can be checked
+static std::vector<ID> SortedInsertionOrder(DrawPacketQueue &queue) {
+    queue.sort();
+    std::vector<ID> order;
+    for (auto &packet : queue.packets()) {
+        order.push_back(packet.meshInstanceID);
+    }
+    return order;
+}
+
+static std::vector<ID> ExpectedInsertionOrder(const std::vector<uint64_t> &keys) {
+    std::vector<ID> order(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](ID lhs, ID rhs) {
+        return keys[lhs] < keys[rhs];
+    });
+    return order;
+}
+
+TEST(KeyFieldsRoundTrip) {
+    uint64_t key = DrawPacketQueue::SortKey(0xA, 0xBC, 0x123456, 0xFFFF);
+    EXPECT(DrawPacketQueue::Pass(key) == 0xA);
+    EXPECT(DrawPacketQueue::Program(key) == 0xBC);
+    EXPECT(DrawPacketQueue::Material(key) == 0x123456);
+    // Unused low bits stay clear
+    EXPECT((key & 0xFFF) == 0);
+}
+
+TEST(KeyFieldsAreMasked) {
+    uint64_t key = DrawPacketQueue::SortKey(0xFF, 0, 0xFFFFFFFF, 0);
+    EXPECT(DrawPacketQueue::Pass(key) == 0xF);
+    EXPECT(DrawPacketQueue::Program(key) == 0);
+    EXPECT(DrawPacketQueue::Material(key) == 0xFFFFFF);
+}
+
+TEST(KeyFieldsArePrioritized) {
+    EXPECT(DrawPacketQueue::SortKey(1, 0, 0, 0) > DrawPacketQueue::SortKey(0, 0xFF, 0xFFFFFF, 0xFFFF));
+    EXPECT(DrawPacketQueue::SortKey(0, 1, 0, 0) > DrawPacketQueue::SortKey(0, 0, 0xFFFFFF, 0xFFFF));
+    EXPECT(DrawPacketQueue::SortKey(0, 0, 1, 0) > DrawPacketQueue::SortKey(0, 0, 0, 0xFFFF));
+    EXPECT(DrawPacketQueue::SortKey(0, 0, 0, 1) > DrawPacketQueue::SortKey(0, 0, 0, 0));
+}
+
+TEST(DepthBucketsAreClamped) {
+    EXPECT(DrawPacketQueue::DepthBucket(0.0f, 100.0f) == 0);
+    EXPECT(DrawPacketQueue::DepthBucket(-5.0f, 100.0f) == 0);
+    EXPECT(DrawPacketQueue::DepthBucket(100.0f, 100.0f) == 0xFFFF);
+    EXPECT(DrawPacketQueue::DepthBucket(1000.0f, 100.0f) == 0xFFFF);
+    EXPECT(DrawPacketQueue::DepthBucket(10.0f, 100.0f) < DrawPacketQueue::DepthBucket(20.0f, 100.0f));
+}
+
+TEST(SortIsStable) {
+    std::mt19937 engine(11);
+    // Few distinct values per field, so that many keys are equal
+    std::uniform_int_distribution<uint32_t> field(0, 3);
+
+    DrawPacketQueue queue;
+    std::vector<uint64_t> keys;
+    for (size_t i = 0; i < 1000; i++) {
+        keys.push_back(DrawPacketQueue::SortKey(field(engine), field(engine), field(engine) * 0x10101, field(engine) * 0x1001));
+        queue.add(keys.back(), i, 0);
+    }
+
+    EXPECT(SortedInsertionOrder(queue) == ExpectedInsertionOrder(keys));
+}
+
+TEST(SortHandlesFullKeys) {
+    std::mt19937_64 engine(13);
+
+    DrawPacketQueue queue;
+    std::vector<uint64_t> keys;
+    for (size_t i = 0; i < 500; i++) {
+        keys.push_back(engine());
+        queue.add(keys.back(), i, 0);
+    }
+
+    EXPECT(SortedInsertionOrder(queue) == ExpectedInsertionOrder(keys));
+}
+
+TEST(SharedDigitsAreSkipped) {
+    DrawPacketQueue queue;
+    std::vector<uint64_t> keys;
+
+    // Equal keys need no passes at all
+    for (size_t i = 0; i < 10; i++) {
+        keys.push_back(DrawPacketQueue::SortKey(2, 7, 42, 300));
+        queue.add(keys.back(), i, 0);
+    }
+    EXPECT(queue.sort() == 0);
+    EXPECT(SortedInsertionOrder(queue) == ExpectedInsertionOrder(keys));
+
+    // Depth buckets below 16 only differ in the second byte of the key
+    queue.clear();
+    keys.clear();
+    for (size_t i = 0; i < 10; i++) {
+        keys.push_back(DrawPacketQueue::SortKey(2, 7, 42, uint16_t(15 - i)));
+        queue.add(keys.back(), i, 0);
+    }
+    EXPECT(queue.sort() == 1);
+
+    queue.clear();
+    for (size_t i = 0; i < keys.size(); i++) {
+        queue.add(keys[i], i, 0);
+    }
+    EXPECT(SortedInsertionOrder(queue) == ExpectedInsertionOrder(keys));
+}
+
+TEST(ClearEmptiesQueue) {
+    DrawPacketQueue queue;
+    queue.add(1, 0, 0);
+    queue.clear();
+    EXPECT(queue.packets().empty());
+    EXPECT(queue.sort() == 0);
+}
+
+TEST(MaterialRunsSplitOnMaterialChanges) {
+    DrawPacketQueue queue;
+    // Sub meshes without a material join whatever run they follow, unless they come first
+    for (uint32_t material : {0, 0, 3, 3, 0, 5, 5, 3}) {
+        queue.add(DrawPacketQueue::SortKey(0, 0, material, 0), 0, 0);
+    }
+
+    std::vector<DrawPacketQueue::MaterialRun> runs;
+    queue.materialRuns(runs);
+
+    EXPECT(runs.size() == 4);
+    EXPECT(runs[0].material == 0 && runs[0].firstPacket == 0 && runs[0].packetCount == 2);
+    EXPECT(runs[1].material == 3 && runs[1].firstPacket == 2 && runs[1].packetCount == 3);
+    EXPECT(runs[2].material == 5 && runs[2].firstPacket == 5 && runs[2].packetCount == 2);
+    EXPECT(runs[3].material == 3 && runs[3].firstPacket == 7 && runs[3].packetCount == 1);
+
+    queue.clear();
+    queue.materialRuns(runs);
+    EXPECT(runs.empty());
+}
+
+#pragma mark - Submission
+
+// Cook-Torrance materials of DemoScene1's Sponza: own albedo and normal maps, while metallic, roughness,
+// ambient occlusion and displacement maps are shared by all of them
+struct DemoSceneMaterials {
+    static constexpr size_t MaterialCount = 25;
+    static constexpr size_t MapCount = 6;
+
+    std::vector<std::unique_ptr<RecordedTexture>> albedoMaps;
+    std::vector<std::unique_ptr<RecordedTexture>> normalMaps;
+    RecordedTexture metallicMap;
+    RecordedTexture blankMap;
+
+    DemoSceneMaterials() {
+        for (size_t i = 0; i < MaterialCount; i++) {
+            albedoMaps.push_back(std::make_unique<RecordedTexture>());
+            normalMaps.push_back(std::make_unique<RecordedTexture>());
+        }
+    }
+
+    // Same calls GLSLGBuffer::setMaterial() issues inside GLProgram::ensureSamplerValidity(), texture unit per map
+    void bind(uint32_t material) const {
+        auto &units = GLTextureUnitManager::Shared();
+        units.bindTextureToUnit(*albedoMaps[material - 1], 0);
+        units.bindTextureToUnit(*normalMaps[material - 1], 1);
+        units.bindTextureToUnit(metallicMap, 2);
+        units.bindTextureToUnit(blankMap, 3);
+        units.bindTextureToUnit(blankMap, 4);
+        units.bindTextureToUnit(blankMap, 5);
+        glUniform1i(0, 0);
+        units.activateUnit(units.maximumTextureUnits() - 1);
+    }
+};
+
+// A few hundred sub meshes spread over the materials in the order a mesh file lists them, at random distances
+static void AddDemoScenePackets(DrawPacketQueue &queue) {
+    std::mt19937 engine(23);
+    std::uniform_int_distribution<uint32_t> material(1, DemoSceneMaterials::MaterialCount);
+    std::uniform_real_distribution<float> distance(1.0f, 100.0f);
+
+    for (ID subMeshID = 0; subMeshID < 380; subMeshID++) {
+        queue.add(DrawPacketQueue::SortKey(0, 0, material(engine), DrawPacketQueue::DepthBucket(distance(engine), 100.0f)), 0, subMeshID);
+    }
+}
+
+// Mirrors SceneGBufferConstructor::renderSubMeshes()
+static GLCallCounts Submit(const DrawPacketQueue &queue, size_t &materialSwitchCount) {
+    DemoSceneMaterials materials;
+    RecordedCalls = GLCallCounts();
+
+    std::vector<DrawPacketQueue::MaterialRun> runs;
+    queue.materialRuns(runs);
+    for (auto &run : runs) {
+        if (run.material != 0) {
+            materials.bind(run.material);
+        }
+    }
+
+    materialSwitchCount = runs.size();
+    return RecordedCalls;
+}
+
+TEST(SortedDemoSceneBindsEveryMaterialOnce) {
+    DrawPacketQueue queue;
+    AddDemoScenePackets(queue);
+
+    size_t unsortedSwitchCount = 0;
+    GLCallCounts unsorted = Submit(queue, unsortedSwitchCount);
+
+    queue.sort();
+    size_t sortedSwitchCount = 0;
+    GLCallCounts sorted = Submit(queue, sortedSwitchCount);
+
+    EXPECT(sortedSwitchCount == DemoSceneMaterials::MaterialCount);
+    EXPECT(unsortedSwitchCount > 300);
+
+    // All maps go in with the first material, only the two maps of its own with every following one
+    EXPECT(sorted.textureBinds == DemoSceneMaterials::MapCount + 2 * (sortedSwitchCount - 1));
+    EXPECT(unsorted.textureBinds == DemoSceneMaterials::MapCount + 2 * (unsortedSwitchCount - 1));
+    EXPECT(sorted.uniformUploads == sortedSwitchCount);
+    EXPECT(unsorted.uniformUploads == unsortedSwitchCount);
+    EXPECT(sorted.unitSwitches < unsorted.unitSwitches);
+}
+
+TEST_MAIN()
@@ -0,0 +1,148 @@
+//
+//  EmbreeRayTracerBenchmark.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+//  Engine sources: Algorithm/EmbreeRayTracer/EmbreeRayTracer.cpp, Math/Ray3D.cpp, Math/Triangle3D.cpp,
+//  Math/AxisAlignedBox3D.cpp, Scene/Geometry/Transformation.cpp
+//  Links against Embree 3 (-lembree3)
+//
+
+#include "EmbreeRayTracer.hpp"
+
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace EARenderer;
+
+// Beyond the scene bounds, so that segments of this length behave like rays of unlimited length
+static constexpr float FarDistance = 1000.0f;
+
+template<class Function>
+static double Milliseconds(Function &&function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Randomly oriented triangles filling a 20 units cube, so that rays travel a bit before hitting anything
+static std::vector<Triangle3D> ClutterTriangles(size_t count) {
+    std::mt19937 engine(3);
+    std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> offset(-0.5f, 0.5f);
+
+    std::vector<Triangle3D> triangles;
+    for (size_t i = 0; i < count; i++) {
+        glm::vec3 center(position(engine), position(engine), position(engine));
+        triangles.emplace_back(center + glm::vec3(offset(engine), offset(engine), offset(engine)),
+                center + glm::vec3(offset(engine), offset(engine), offset(engine)),
+                center + glm::vec3(offset(engine), offset(engine), offset(engine)));
+    }
+    return triangles;
+}
+
+static std::vector<glm::vec3> RandomDirections(size_t count) {
+    std::mt19937 engine(7);
+    std::normal_distribution<float> distribution;
+
+    std::vector<glm::vec3> directions;
+    for (size_t i = 0; i < count; i++) {
+        directions.push_back(glm::normalize(glm::vec3(distribution(engine), distribution(engine), distribution(engine))));
+    }
+    return directions;
+}
+
+static void PrintRate(const char *method, size_t rayCount, double milliseconds) {
+    printf("  %-16s %9.2f ms %9.3f Mrays/s\n", method, milliseconds, rayCount / milliseconds / 1000.0);
+}
+
+// Probe-like workload: a bunch of origins, each shooting a few packets of incoherent rays
+static size_t Run(size_t triangleCount, size_t originCount, size_t packetsPerOrigin) {
+    EmbreeRayTracer rayTracer(ClutterTriangles(triangleCount));
+
+    std::mt19937 engine(11);
+    std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+    std::vector<glm::vec3> origins;
+    for (size_t i = 0; i < originCount; i++) {
+        origins.emplace_back(position(engine), position(engine), position(engine));
+    }
+
+    size_t raysPerOrigin = packetsPerOrigin * EmbreeRayTracer::PacketSize;
+    size_t rayCount = originCount * raysPerOrigin;
+    std::vector<glm::vec3> directions = RandomDirections(rayCount);
+
+    printf("%zu triangles, %zu rays\n", triangleCount, rayCount);
+
+    std::vector<bool> singleOccluded(rayCount);
+    double singleTime = Milliseconds([&] {
+        for (size_t i = 0; i < rayCount; i++) {
+            const glm::vec3 &origin = origins[i / raysPerOrigin];
+            singleOccluded[i] = rayTracer.lineSegmentOccluded(origin, origin + directions[i] * FarDistance);
+        }
+    });
+    PrintRate("Single rays", rayCount, singleTime);
+
+    std::vector<bool> packetOccluded(rayCount);
+    double packetTime = Milliseconds([&] {
+        std::array<glm::vec3, EmbreeRayTracer::PacketSize> packet;
+        for (size_t packetStart = 0; packetStart < rayCount; packetStart += EmbreeRayTracer::PacketSize) {
+            std::copy(directions.begin() + packetStart, directions.begin() + packetStart + EmbreeRayTracer::PacketSize, packet.begin());
+            auto mask = rayTracer.raysOccluded(origins[packetStart / raysPerOrigin], packet);
+            for (size_t lane = 0; lane < EmbreeRayTracer::PacketSize; lane++) {
+                packetOccluded[packetStart + lane] = mask[lane];
+            }
+        }
+    });
+    PrintRate("Packets of 16", rayCount, packetTime);
+
+    // Batch filling is part of the cost of using streams, so it's measured too
+    std::vector<bool> streamOccluded;
+    double streamTime = Milliseconds([&] {
+        EmbreeRayTracer::RayBatch batch;
+        batch.reserve(rayCount);
+        for (size_t i = 0; i < rayCount; i++) {
+            const glm::vec3 &origin = origins[i / raysPerOrigin];
+            batch.addSegment(origin, origin + directions[i] * FarDistance);
+        }
+        rayTracer.raysOccluded(batch, streamOccluded);
+    });
+    PrintRate("Stream", rayCount, streamTime);
+
+    size_t mismatchCount = 0;
+    for (size_t i = 0; i < rayCount; i++) {
+        mismatchCount += packetOccluded[i] != singleOccluded[i] || streamOccluded[i] != singleOccluded[i];
+    }
+
+    // Segments shorter and longer than a unit, which are parametrized by their own length rather than by distance
+    EmbreeRayTracer::RayBatch segments;
+    std::vector<bool> segmentOccluded;
+    std::uniform_real_distribution<float> length(0.05f, 5.0f);
+    for (size_t i = 0; i < rayCount; i++) {
+        const glm::vec3 &origin = origins[i / raysPerOrigin];
+        segments.addSegment(origin, origin + directions[i] * length(engine), 0.01f, 0.01f);
+    }
+    rayTracer.raysOccluded(segments, segmentOccluded);
+    for (size_t i = 0; i < rayCount; i++) {
+        glm::vec3 p0(segments.originsX[i], segments.originsY[i], segments.originsZ[i]);
+        glm::vec3 p1 = p0 + glm::vec3(segments.directionsX[i], segments.directionsY[i], segments.directionsZ[i]);
+        mismatchCount += segmentOccluded[i] != rayTracer.lineSegmentOccluded(p0, p1, 0.01f, 0.01f);
+    }
+
+    printf("  %zu results differ from single ray queries\n", mismatchCount);
+    return mismatchCount;
+}
+
+int main() {
+    size_t mismatchCount = 0;
+    mismatchCount += Run(2000, 64, 16);
+    mismatchCount += Run(20000, 64, 16);
+    return mismatchCount == 0 ? 0 : 1;
+}
@@ -0,0 +1,154 @@
+//
+//  EmbreeRayTracerTests.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+//  Engine sources: Algorithm/EmbreeRayTracer/EmbreeRayTracer.cpp, Math/Ray3D.cpp, Math/Triangle3D.cpp,
+//  Math/AxisAlignedBox3D.cpp, Scene/Geometry/Transformation.cpp
+//
+
+#include "TestUtils.hpp"
+#include "EmbreeRayTracer.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace EARenderer;
+
+// Square in the z = 0 plane facing +z, spanning [-10; 10] along x and y
+static EmbreeRayTracer PlaneRayTracer() {
+    return EmbreeRayTracer(std::vector<Triangle3D>{
+            Triangle3D(glm::vec3(-10.0f, -10.0f, 0.0f), glm::vec3(10.0f, -10.0f, 0.0f), glm::vec3(10.0f, 10.0f, 0.0f)),
+            Triangle3D(glm::vec3(-10.0f, -10.0f, 0.0f), glm::vec3(10.0f, 10.0f, 0.0f), glm::vec3(-10.0f, 10.0f, 0.0f))
+    });
+}
+
+struct Segment {
+    glm::vec3 p0;
+    glm::vec3 p1;
+    float p0OffsetFactor;
+    float p1OffsetFactor;
+};
+
+// Segments shorter and longer than a unit, both crossing the plane and stopping short of it
+static std::vector<Segment> Segments() {
+    std::vector<Segment> segments;
+    for (float length : {0.05f, 0.5f, 2.0f, 20.0f}) {
+        // Crosses the plane in the middle
+        segments.push_back({glm::vec3(1.0f, 2.0f, length * 0.5f), glm::vec3(1.0f, 2.0f, -length * 0.5f), 0.0f, 0.0f});
+        // Ends right above the plane
+        segments.push_back({glm::vec3(-3.0f, 0.5f, length * 1.01f), glm::vec3(-3.0f, 0.5f, length * 0.01f), 0.0f, 0.0f});
+        // Crosses the plane, but the crossing is cut off by the end offset
+        segments.push_back({glm::vec3(2.0f, 2.0f, length * 0.75f), glm::vec3(2.0f, 2.0f, -length * 0.25f), 0.0f, 0.3f});
+        // Crosses the plane, but the crossing is cut off by the start offset
+        segments.push_back({glm::vec3(2.0f, -2.0f, length * 0.25f), glm::vec3(2.0f, -2.0f, -length * 0.75f), 0.3f, 0.0f});
+        // Diagonal crossing, offsets keep the crossing inside the segment
+        segments.push_back({glm::vec3(-length, -length, length) * 0.2f, glm::vec3(length, length, -length) * 0.2f, 0.1f, 0.1f});
+    }
+    return segments;
+}
+
+TEST(BatchedSegmentsMatchSingleSegments) {
+    auto rayTracer = PlaneRayTracer();
+    auto segments = Segments();
+
+    EmbreeRayTracer::RayBatch batch;
+    for (auto &segment : segments) {
+        batch.addSegment(segment.p0, segment.p1, segment.p0OffsetFactor, segment.p1OffsetFactor);
+    }
+
+    for (auto faceFilter : {EmbreeRayTracer::FaceFilter::None, EmbreeRayTracer::FaceFilter::CullBack, EmbreeRayTracer::FaceFilter::CullFront}) {
+        std::vector<bool> occluded;
+        rayTracer.raysOccluded(batch, occluded, faceFilter);
+
+        EXPECT(occluded.size() == segments.size());
+        for (size_t i = 0; i < segments.size(); i++) {
+            auto &segment = segments[i];
+            EXPECT(occluded[i] == rayTracer.lineSegmentOccluded(segment.p0, segment.p1, segment.p0OffsetFactor, segment.p1OffsetFactor, faceFilter));
+        }
+    }
+}
+
+TEST(SegmentsAreOccludedOnlyWhenCrossingThePlane) {
+    auto rayTracer = PlaneRayTracer();
+    auto segments = Segments();
+
+    for (size_t i = 0; i < segments.size(); i++) {
+        auto &segment = segments[i];
+        bool expected = i % 5 == 0 || i % 5 == 4;
+        EXPECT(rayTracer.lineSegmentOccluded(segment.p0, segment.p1, segment.p0OffsetFactor, segment.p1OffsetFactor) == expected);
+    }
+}
+
+TEST(BatchedSegmentDistancesAreSegmentFractions) {
+    auto rayTracer = PlaneRayTracer();
+
+    EmbreeRayTracer::RayBatch batch;
+    batch.addSegment(glm::vec3(0.0f, 0.0f, 5.0f), glm::vec3(0.0f, 0.0f, -15.0f));
+    batch.addSegment(glm::vec3(0.0f, 0.0f, 0.1f), glm::vec3(0.0f, 0.0f, -0.3f));
+
+    std::vector<bool> hits;
+    std::vector<float> distances;
+    rayTracer.raysHit(batch, hits, distances);
+
+    EXPECT(hits[0] && hits[1]);
+    EXPECT(std::abs(distances[0] - 0.25f) < 1e-5f);
+    EXPECT(std::abs(distances[1] - 0.25f) < 1e-5f);
+}
+
+// Face filters travel with each query, so threads tracing with different filters must not see each other's
+TEST(ConcurrentQueriesKeepTheirFaceFilters) {
+    auto rayTracer = PlaneRayTracer();
+    std::vector<EmbreeRayTracer::FaceFilter> faceFilters = {
+            EmbreeRayTracer::FaceFilter::None, EmbreeRayTracer::FaceFilter::CullBack, EmbreeRayTracer::FaceFilter::CullFront
+    };
+
+    // Segments crossing the plane downwards and upwards, so that each filter culls a different half of them
+    EmbreeRayTracer::RayBatch batch;
+    std::array<glm::vec3, EmbreeRayTracer::PacketSize> directions;
+    for (size_t i = 0; i < EmbreeRayTracer::PacketSize; i++) {
+        float x = -8.0f + i;
+        float z = i % 2 ? 1.0f : -1.0f;
+        batch.addSegment(glm::vec3(x, 1.0f, z), glm::vec3(x, 1.0f, -z));
+        directions[i] = glm::vec3(0.1f * x, 0.0f, i % 2 ? -1.0f : 1.0f);
+    }
+    glm::vec3 packetOrigin(0.0f, 0.0f, 1.0f);
+
+    // Serial results of every filter, that concurrent queries are checked against
+    std::vector<std::vector<bool>> expectedSegments(faceFilters.size());
+    std::vector<EmbreeRayTracer::PacketMask> expectedPackets(faceFilters.size());
+    for (size_t f = 0; f < faceFilters.size(); f++) {
+        rayTracer.raysOccluded(batch, expectedSegments[f], faceFilters[f]);
+        expectedPackets[f] = rayTracer.raysOccluded(packetOrigin, directions, EmbreeRayTracer::PacketSize, faceFilters[f]);
+    }
+    EXPECT(expectedSegments[0] != expectedSegments[1] && expectedSegments[1] != expectedSegments[2]);
+
+    std::atomic<size_t> mismatchCount(0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < faceFilters.size() * 2; t++) {
+        threads.emplace_back([&, t]() {
+            size_t f = t % faceFilters.size();
+            std::vector<bool> occluded;
+            for (size_t iteration = 0; iteration < 200; iteration++) {
+                rayTracer.raysOccluded(batch, occluded, faceFilters[f]);
+                mismatchCount += occluded != expectedSegments[f];
+                mismatchCount += rayTracer.raysOccluded(packetOrigin, directions, EmbreeRayTracer::PacketSize, faceFilters[f]) != expectedPackets[f];
+
+                size_t i = iteration % EmbreeRayTracer::PacketSize;
+                glm::vec3 p0(batch.originsX[i], batch.originsY[i], batch.originsZ[i]);
+                glm::vec3 p1 = p0 + glm::vec3(batch.directionsX[i], batch.directionsY[i], batch.directionsZ[i]);
+                mismatchCount += rayTracer.lineSegmentOccluded(p0, p1, 0.0f, 0.0f, faceFilters[f]) != expectedSegments[f][i];
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT(mismatchCount == 0);
+}
+
+TEST_MAIN()
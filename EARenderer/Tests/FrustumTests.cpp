@@ -0,0 +1,111 @@
+//
+//  FrustumTests.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+//  Engine sources: Math/Frustum.cpp, Math/Plane.cpp, Math/AxisAlignedBox3D.cpp, Math/AxisAlignedBox3DArray.cpp,
+//  Math/Triangle3D.cpp, Scene/Geometry/Transformation.cpp
+//
+
+#include "TestUtils.hpp"
+#include "Frustum.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace EARenderer;
+
+// Camera at the origin looking down -Z, the frustum spans [-1; 1] in X and Y and [-10; -1] in Z
+static Frustum BoxFrustum() {
+    return Frustum(glm::ortho(-1.0f, 1.0f, -1.0f, 1.0f, 1.0f, 10.0f));
+}
+
+static AxisAlignedBox3D BoxAround(const glm::vec3 &center, float halfSize) {
+    return AxisAlignedBox3D(center - glm::vec3(halfSize), center + glm::vec3(halfSize));
+}
+
+// Boxes just inside, straddling and just outside of every plane, in the order of Frustum::planes
+static std::vector<std::pair<AxisAlignedBox3D, bool>> PlaneCases() {
+    std::vector<std::pair<AxisAlignedBox3D, bool>> cases;
+    glm::vec3 center(0.0f, 0.0f, -5.5f);
+    glm::vec3 axes[3] = {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}};
+    float halfExtents[3] = {1.0f, 1.0f, 4.5f};
+
+    for (size_t axis = 0; axis < 3; axis++) {
+        for (float side : {-1.0f, 1.0f}) {
+            glm::vec3 boundary = center + axes[axis] * side * halfExtents[axis];
+            cases.emplace_back(BoxAround(boundary - axes[axis] * side * 0.2f, 0.1f), true);
+            cases.emplace_back(BoxAround(boundary, 0.1f), true);
+            cases.emplace_back(BoxAround(boundary + axes[axis] * side * 0.2f, 0.1f), false);
+        }
+    }
+    return cases;
+}
+
+TEST(BoxesAgainstEveryPlane) {
+    Frustum frustum = BoxFrustum();
+    for (auto &testCase : PlaneCases()) {
+        EXPECT(frustum.intersects(testCase.first) == testCase.second);
+    }
+    EXPECT(frustum.intersects(BoxAround({0.0f, 0.0f, -5.0f}, 0.5f)));
+    // Encloses the whole frustum
+    EXPECT(frustum.intersects(BoxAround({0.0f, 0.0f, -5.0f}, 100.0f)));
+}
+
+TEST(BatchesMatchSingleBoxTest) {
+    Frustum frustum(glm::perspective(glm::radians(60.0f), 1.5f, 0.5f, 50.0f) *
+            glm::lookAt(glm::vec3(3.0f, 2.0f, 10.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+
+    std::mt19937 engine(7);
+    std::uniform_real_distribution<float> position(-60.0f, 60.0f);
+    std::uniform_real_distribution<float> size(0.1f, 10.0f);
+
+    // Partial batches on either side of the batch size
+    for (size_t boxCount : {0, 1, 5, 63, 64, 65, 127, 200}) {
+        AxisAlignedBox3DArray boxes;
+        std::vector<size_t> expectedIndices;
+
+        for (size_t i = 0; i < boxCount; i++) {
+            glm::vec3 min(position(engine), position(engine), position(engine));
+            glm::vec3 max = min + glm::vec3(size(engine), size(engine), size(engine));
+            boxes.push_back(min, max);
+
+            if (frustum.intersects(AxisAlignedBox3D(min, max))) {
+                expectedIndices.push_back(i);
+            }
+        }
+
+        std::vector<size_t> intersectingIndices{42};
+        frustum.intersectingBoxes(boxes, intersectingIndices);
+        EXPECT(intersectingIndices == expectedIndices);
+    }
+}
+
+TEST(BatchedPlaneCases) {
+    Frustum frustum = BoxFrustum();
+    auto cases = PlaneCases();
+
+    // 18 cases repeated into a count that isn't a multiple of the batch size
+    AxisAlignedBox3DArray boxes;
+    std::vector<size_t> expectedIndices;
+    for (size_t i = 0; i < 100; i++) {
+        auto &testCase = cases[i % cases.size()];
+        boxes.push_back(testCase.first.min, testCase.first.max);
+        if (testCase.second) {
+            expectedIndices.push_back(i);
+        }
+    }
+
+    std::vector<size_t> intersectingIndices;
+    frustum.intersectingBoxes(boxes, intersectingIndices);
+    EXPECT(intersectingIndices == expectedIndices);
+
+    EXPECT(boxes.box(1).min == cases[1].first.min);
+    EXPECT(boxes.box(1).max == cases[1].first.max);
+}
+
+TEST_MAIN()
@@ -0,0 +1,216 @@
+//
+//  InstancedRayTracerBenchmark.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+//  Engine sources: Algorithm/EmbreeRayTracer/EmbreeRayTracer.cpp, Math/Ray3D.cpp, Math/Triangle3D.cpp,
+//  Math/AxisAlignedBox3D.cpp, Scene/Geometry/Transformation.cpp
+//  Links against Embree 3 (-lembree3)
+//
+
+#include "EmbreeRayTracer.hpp"
+
+#include <glm/gtc/constants.hpp>
+#include <glm/gtx/transform.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace EARenderer;
+
+// A forest of GridSize x GridSize instances of a few unique meshes
+static constexpr size_t GridSize = 32;
+static constexpr float GridSpacing = 4.0f;
+static constexpr size_t SegmentCount = 1 << 16;
+
+template<class Function>
+static double Milliseconds(Function &&function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Embree allocates BVH nodes outside of malloc, so the footprint is taken from the resident size of the process
+static size_t ResidentBytes() {
+#if defined(__APPLE__)
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t) &info, &count);
+    return info.resident_size;
+#else
+    size_t pageCount = 0;
+    size_t residentPageCount = 0;
+    FILE *file = fopen("/proc/self/statm", "r");
+    if (fscanf(file, "%zu %zu", &pageCount, &residentPageCount) != 2) {
+        residentPageCount = 0;
+    }
+    fclose(file);
+    return residentPageCount * sysconf(_SC_PAGESIZE);
+#endif
+}
+
+/// Tessellates a parametric surface into two sub meshes, the upper and the lower halves of the v range
+static EmbreeRayTracer::MeshTriangles ParametricMesh(size_t uSegments, size_t vSegments, const std::function<glm::vec3(float u, float v)> &surface) {
+    EmbreeRayTracer::MeshTriangles mesh(2);
+    for (size_t i = 0; i < uSegments; i++) {
+        for (size_t j = 0; j < vSegments; j++) {
+            float u0 = float(i) / uSegments;
+            float u1 = float(i + 1) / uSegments;
+            float v0 = float(j) / vSegments;
+            float v1 = float(j + 1) / vSegments;
+
+            auto &subMesh = mesh[j < vSegments / 2 ? 0 : 1];
+            subMesh.emplace_back(surface(u0, v0), surface(u1, v0), surface(u1, v1));
+            subMesh.emplace_back(surface(u0, v0), surface(u1, v1), surface(u0, v1));
+        }
+    }
+    return mesh;
+}
+
+static std::vector<EmbreeRayTracer::MeshTriangles> UniqueMeshes() {
+    const float TwoPi = glm::two_pi<float>();
+    const float Pi = glm::pi<float>();
+
+    auto sphere = ParametricMesh(64, 32, [&](float u, float v) {
+        return glm::vec3(std::sin(v * Pi) * std::cos(u * TwoPi), std::cos(v * Pi), std::sin(v * Pi) * std::sin(u * TwoPi));
+    });
+    auto torus = ParametricMesh(96, 24, [&](float u, float v) {
+        float radius = 1.0f + 0.35f * std::cos(v * TwoPi);
+        return glm::vec3(radius * std::cos(u * TwoPi), 0.35f * std::sin(v * TwoPi), radius * std::sin(u * TwoPi));
+    });
+    auto cone = ParametricMesh(48, 16, [&](float u, float v) {
+        return glm::vec3((1.0f - v) * std::cos(u * TwoPi), 3.0f * v, (1.0f - v) * std::sin(u * TwoPi));
+    });
+    return {sphere, torus, cone};
+}
+
+/// Randomly rotated and scaled placements on a grid, a few of them mirrored
+static std::vector<EmbreeRayTracer::Instance> Instances(size_t meshCount) {
+    std::mt19937 engine(17);
+    std::uniform_real_distribution<float> angle(0.0f, glm::two_pi<float>());
+    std::uniform_real_distribution<float> scale(0.6f, 1.4f);
+
+    std::vector<EmbreeRayTracer::Instance> instances;
+    for (size_t x = 0; x < GridSize; x++) {
+        for (size_t z = 0; z < GridSize; z++) {
+            glm::mat4 modelMatrix = glm::translate(glm::vec3(x * GridSpacing, 0.0f, z * GridSpacing)) *
+                    glm::rotate(angle(engine), glm::vec3(0.0f, 1.0f, 0.0f)) *
+                    glm::scale(glm::vec3((x + z) % 7 == 0 ? -1.0f : 1.0f, 1.0f, 1.0f) * scale(engine));
+            instances.push_back({(x * GridSize + z) % meshCount, modelMatrix});
+        }
+    }
+    return instances;
+}
+
+/// World space triangles of every instance, what Scene used to hand over to the ray tracer
+static std::vector<Triangle3D> FlattenedTriangles(const std::vector<EmbreeRayTracer::MeshTriangles> &meshes, const std::vector<EmbreeRayTracer::Instance> &instances) {
+    std::vector<Triangle3D> triangles;
+    for (auto &instance : instances) {
+        for (auto &subMesh : meshes[instance.meshIndex]) {
+            for (auto &triangle : subMesh) {
+                triangles.emplace_back(instance.modelMatrix * glm::vec4(triangle.p1, 1.0f),
+                        instance.modelMatrix * glm::vec4(triangle.p2, 1.0f),
+                        instance.modelMatrix * glm::vec4(triangle.p3, 1.0f));
+            }
+        }
+    }
+    return triangles;
+}
+
+/// Segments between random points of the forest's bounds, long enough to pass by a number of instances
+static EmbreeRayTracer::RayBatch RandomSegments() {
+    std::mt19937 engine(19);
+    std::uniform_real_distribution<float> horizontal(-2.0f, GridSize * GridSpacing + 2.0f);
+    std::uniform_real_distribution<float> vertical(-1.0f, 3.0f);
+
+    EmbreeRayTracer::RayBatch segments;
+    for (size_t i = 0; i < SegmentCount; i++) {
+        glm::vec3 p0(horizontal(engine), vertical(engine), horizontal(engine));
+        glm::vec3 p1(horizontal(engine), vertical(engine), horizontal(engine));
+        segments.addSegment(p0, p1);
+    }
+    return segments;
+}
+
+struct Measurements {
+    double buildTime = 0.0;
+    double queryTime = 0.0;
+    size_t residentBytes = 0;
+    std::vector<bool> occluded;
+};
+
+template<class Factory>
+static Measurements Measure(const EmbreeRayTracer::RayBatch &segments, Factory &&factory) {
+    Measurements measurements;
+    size_t residentBytesBefore = ResidentBytes();
+
+    EmbreeRayTracer *rayTracer = nullptr;
+    measurements.buildTime = Milliseconds([&] {
+        rayTracer = factory();
+    });
+    size_t residentBytesAfter = ResidentBytes();
+    measurements.residentBytes = residentBytesAfter > residentBytesBefore ? residentBytesAfter - residentBytesBefore : 0;
+
+    measurements.queryTime = Milliseconds([&] {
+        rayTracer->raysOccluded(segments, measurements.occluded);
+    });
+
+    delete rayTracer;
+    return measurements;
+}
+
+static void Print(const char *layout, size_t triangleCount, const Measurements &measurements) {
+    // 3 vertices and 3 indices of 4 byte components, as createTriangleGeometry lays them out
+    double geometryMegabytes = triangleCount * (3 * sizeof(glm::vec3) + sizeof(glm::uvec3)) / 1048576.0;
+    printf("  %-10s %10zu %14.1f %14.1f %12.2f %12.2f\n", layout, triangleCount, geometryMegabytes,
+            measurements.residentBytes / 1048576.0, measurements.buildTime, measurements.queryTime);
+}
+
+int main() {
+    auto meshes = UniqueMeshes();
+    auto instances = Instances(meshes.size());
+    auto segments = RandomSegments();
+
+    size_t uniqueTriangleCount = 0;
+    for (auto &mesh : meshes) {
+        for (auto &subMesh : mesh) {
+            uniqueTriangleCount += subMesh.size();
+        }
+    }
+
+    // Built before the measurements, so that the input isn't accounted to the flat tracer
+    auto flattenedTriangles = FlattenedTriangles(meshes, instances);
+
+    // Instanced layout goes first, so that pages freed by it can't hide any of the flat layout's footprint
+    Measurements instanced = Measure(segments, [&] {
+        return new EmbreeRayTracer(meshes, instances);
+    });
+    Measurements flat = Measure(segments, [&] {
+        return new EmbreeRayTracer(flattenedTriangles);
+    });
+
+    printf("%zu unique meshes, %zu instances, %zu occlusion queries\n", meshes.size(), instances.size(), SegmentCount);
+    printf("  %-10s %10s %14s %14s %12s %12s\n", "Layout", "Triangles", "Geometry MB", "Resident MB", "Build ms", "Query ms");
+    Print("Flat", flattenedTriangles.size(), flat);
+    Print("Instanced", uniqueTriangleCount, instanced);
+
+    size_t mismatchCount = 0;
+    for (size_t i = 0; i < SegmentCount; i++) {
+        mismatchCount += flat.occluded[i] != instanced.occluded[i];
+    }
+    printf("  %zu results differ between the layouts\n", mismatchCount);
+
+    return mismatchCount == 0 ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+//
+//  LinearOctreeTests.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+//  Engine sources: Math/AxisAlignedBox3D.cpp, Math/Ray3D.cpp, Math/Triangle3D.cpp, Scene/Geometry/Transformation.cpp
+//
+
+#include "TestUtils.hpp"
+#include "LinearOctree.hpp"
+
+#include <algorithm>
+#include <vector>
+
+using namespace EARenderer;
+
+// Tree over [-8; 8]^3 with a small box in the middle of every octant of the first level
+static LinearOctree<AxisAlignedBox3D> OctantsTree() {
+    std::vector<AxisAlignedBox3D> boxes;
+    for (float x : {-4.0f, 4.0f}) {
+        for (float y : {-4.0f, 4.0f}) {
+            for (float z : {-4.0f, 4.0f}) {
+                boxes.emplace_back(glm::vec3(x, y, z) - 0.5f, glm::vec3(x, y, z) + 0.5f);
+            }
+        }
+    }
+
+    LinearOctree<AxisAlignedBox3D> tree(AxisAlignedBox3D(glm::vec3(-8.0f), glm::vec3(8.0f)), 3);
+    tree.build(boxes, [](const AxisAlignedBox3D &box, const AxisAlignedBox3D &nodeBoundingBox) {
+        return nodeBoundingBox.contains(box);
+    });
+    return tree;
+}
+
+// Centers of boxes whose nodes were visited by the segment, every object is reported to the detector
+static std::vector<glm::vec3> VisitedCenters(const LinearOctree<AxisAlignedBox3D> &tree, const glm::vec3 &p0, const glm::vec3 &p1) {
+    std::vector<glm::vec3> centers;
+    tree.raymarch(p0, p1, [&](const AxisAlignedBox3D &box, const Ray3D &) {
+        centers.push_back((box.min + box.max) * 0.5f);
+        return false;
+    });
+    return centers;
+}
+
+static bool Contains(const std::vector<glm::vec3> &centers, const glm::vec3 &center) {
+    return std::find(centers.begin(), centers.end(), center) != centers.end();
+}
+
+TEST(AxisParallelSegmentVisitsPiercedNodes) {
+    auto tree = OctantsTree();
+    auto centers = VisitedCenters(tree, glm::vec3(-10.0f, 4.0f, 4.0f), glm::vec3(10.0f, 4.0f, 4.0f));
+    EXPECT(centers.size() == 2);
+    EXPECT(Contains(centers, glm::vec3(-4.0f, 4.0f, 4.0f)));
+    EXPECT(Contains(centers, glm::vec3(4.0f, 4.0f, 4.0f)));
+}
+
+TEST(SegmentOnNodeBoundariesVisitsAdjacentNodes) {
+    auto tree = OctantsTree();
+    // Runs along the edge shared by four octants, where slab distances used to be 0 * inf
+    auto centers = VisitedCenters(tree, glm::vec3(-10.0f, 0.0f, 0.0f), glm::vec3(10.0f, 0.0f, 0.0f));
+    EXPECT(centers.size() == 8);
+
+    // Along the outer face of the root node
+    centers = VisitedCenters(tree, glm::vec3(-8.0f, -8.0f, -10.0f), glm::vec3(-8.0f, -8.0f, 10.0f));
+    EXPECT(centers.size() == 2);
+    EXPECT(Contains(centers, glm::vec3(-4.0f, -4.0f, -4.0f)));
+}
+
+TEST(AxisParallelSegmentOutsideMisses) {
+    auto tree = OctantsTree();
+    EXPECT(VisitedCenters(tree, glm::vec3(-10.0f, 9.0f, 4.0f), glm::vec3(10.0f, 9.0f, 4.0f)).empty());
+    // Points straight at the box, but ends before reaching it
+    EXPECT(VisitedCenters(tree, glm::vec3(-20.0f, 4.0f, 4.0f), glm::vec3(-9.0f, 4.0f, 4.0f)).empty());
+}
+
+TEST(DegenerateSegmentVisitsNothing) {
+    auto tree = OctantsTree();
+    EXPECT(VisitedCenters(tree, glm::vec3(4.0f), glm::vec3(4.0f)).empty());
+}
+
+TEST(RayFromFarAwayReachesAcrossTree) {
+    auto tree = OctantsTree();
+    std::vector<glm::vec3> centers;
+    tree.raymarch(Ray3D(glm::vec3(-100.0f, 4.0f, 4.0f), glm::vec3(1.0f, 0.0f, 0.0f)), [&](const AxisAlignedBox3D &box, const Ray3D &) {
+        centers.push_back((box.min + box.max) * 0.5f);
+        return false;
+    });
+    EXPECT(Contains(centers, glm::vec3(4.0f, 4.0f, 4.0f)));
+}
+
+TEST(NearestNodeIsVisitedFirst) {
+    auto tree = OctantsTree();
+    std::vector<glm::vec3> centers;
+    bool hit = tree.raymarch(glm::vec3(10.0f, -4.0f, -4.0f), glm::vec3(-10.0f, -4.0f, -4.0f), [&](const AxisAlignedBox3D &box, const Ray3D &) {
+        centers.push_back((box.min + box.max) * 0.5f);
+        return true;
+    });
+    EXPECT(hit);
+    EXPECT(centers.size() == 1);
+    EXPECT(centers[0] == glm::vec3(4.0f, -4.0f, -4.0f));
+}
+
+TEST_MAIN()
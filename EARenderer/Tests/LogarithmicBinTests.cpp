@@ -0,0 +1,118 @@
+//
+//  LogarithmicBinTests.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "TestUtils.hpp"
+#include "LogarithmicBin.hpp"
+
+#include <cmath>
+#include <vector>
+
+using namespace EARenderer;
+
+// Objects are their own indices, so that samples can be counted per object
+using Bin = LogarithmicBin<size_t>;
+
+// Upper critical value of the chi-square distribution for p = 0.001 (Wilson-Hilferty approximation)
+static double ChiSquareCriticalValue(size_t degreesOfFreedom) {
+    constexpr double z = 3.0902;
+    double k = degreesOfFreedom;
+    double t = 1.0 - 2.0 / (9.0 * k) + z * std::sqrt(2.0 / (9.0 * k));
+    return k * t * t * t;
+}
+
+// Samples the bin and compares frequencies of objects with their share of the weight.
+// Weights of erased objects have to be set to 0.
+static void CheckDistribution(Bin &bin, const std::vector<float> &weights, size_t sampleCount) {
+    std::vector<size_t> counts(weights.size(), 0);
+    for (size_t i = 0; i < sampleCount; i++) {
+        counts[*bin.random()]++;
+    }
+
+    double totalWeight = 0.0;
+    for (float weight : weights) {
+        totalWeight += weight;
+    }
+
+    double chiSquare = 0.0;
+    size_t degreesOfFreedom = 0;
+    for (size_t i = 0; i < weights.size(); i++) {
+        if (weights[i] == 0.0f) {
+            EXPECT(counts[i] == 0);
+            continue;
+        }
+        double expected = sampleCount * weights[i] / totalWeight;
+        chiSquare += (counts[i] - expected) * (counts[i] - expected) / expected;
+        degreesOfFreedom++;
+    }
+
+    EXPECT(chiSquare < ChiSquareCriticalValue(degreesOfFreedom - 1));
+}
+
+static std::vector<float> FillBin(Bin &bin, size_t count) {
+    std::vector<float> weights;
+    for (size_t i = 0; i < count; i++) {
+        // Skewed weights spanning several logarithmic bins
+        weights.push_back(1.0f + float(i % 7) * float(i % 7) * 2.5f);
+        bin.insert(i, weights.back());
+    }
+    return weights;
+}
+
+TEST(RejectionSamplingMatchesWeights) {
+    Bin bin(1.0f, 128.0f, 1);
+    auto weights = FillBin(bin, 50);
+    CheckDistribution(bin, weights, 200000);
+}
+
+TEST(AliasTableSamplingMatchesWeights) {
+    Bin bin(1.0f, 128.0f, 2);
+    bin.setSamplingMode(Bin::SamplingMode::AliasTable);
+    auto weights = FillBin(bin, 50);
+    CheckDistribution(bin, weights, 200000);
+}
+
+TEST(AliasTableSamplesObjectsInsertedAfterSnapshot) {
+    Bin bin(1.0f, 128.0f, 3);
+    bin.setSamplingMode(Bin::SamplingMode::AliasTable);
+    auto weights = FillBin(bin, 50);
+
+    // Builds the table
+    bin.random();
+
+    // Same changes as surfel generation makes: a sampled object goes away and lighter ones take its place,
+    // few enough for the table not to be rebuilt
+    for (size_t i = 0; i < 5; i++) {
+        auto it = bin.random();
+        weights[*it] = 0.0f;
+        bin.erase(it);
+
+        for (size_t j = 0; j < 4; j++) {
+            weights.push_back(1.0f + j);
+            bin.insert(weights.size() - 1, weights.back());
+        }
+    }
+
+    CheckDistribution(bin, weights, 200000);
+}
+
+TEST(AliasTableSurvivesErasingEverything) {
+    Bin bin(1.0f, 128.0f, 4);
+    bin.setSamplingMode(Bin::SamplingMode::AliasTable);
+    FillBin(bin, 20);
+
+    while (!bin.empty()) {
+        auto it = bin.random();
+        bin.insert(1000, 2.0f);
+        bin.erase(it);
+        bin.erase(bin.random());
+    }
+
+    EXPECT(!(bin.random() != bin.end()));
+}
+
+TEST_MAIN()
@@ -0,0 +1,107 @@
+//
+//  MeshLoadingBenchmark.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+//  Engine sources: Resource Management/WavefrontMeshLoader.cpp, Resource Management/WavefrontParser.cpp,
+//  Resource Management/CookedMesh.cpp, Serialization/BakedDataFile.cpp,
+//  Scene/Geometry/SubMesh.cpp, Scene/Geometry/MeshOptimizer.cpp, Math/Vertices/Vertex1P1N2UV.cpp, Math/Vertices/Vertex1P1N2UV1T1BT.cpp,
+//  Math/Vertices/PackedVertex1P1N2UV1T1BT.cpp, OpenGL/Core/Buffers/GLVertexAttribute.cpp, Math/AxisAlignedBox3D.cpp, Math/Triangle3D.cpp, Math/Ray3D.cpp,
+//  Scene/Geometry/Transformation.cpp, Foundation/ContentHash.cpp, Foundation/CRC32.cpp, Foundation/Measurement.cpp,
+//  Foundation/MemoryUtils.cpp
+//  Demo models are looked up relative to this file, so run the benchmark from the directory it was built in.
+//
+
+#include "WavefrontMeshLoader.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace EARenderer;
+
+template<class Function>
+static double Milliseconds(Function &&function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static std::string ModelsDirectory() {
+    std::string file = __FILE__;
+    return file.substr(0, file.find_last_of('/') + 1) + "../Tool/Resources/Models/";
+}
+
+static size_t FileSize(const std::string &path) {
+    std::ifstream stream(path, std::ios::binary | std::ios::ate);
+    return stream.is_open() ? (size_t) stream.tellg() : 0;
+}
+
+struct LoadResult {
+    double milliseconds = 0.0;
+    size_t subMeshCount = 0;
+    size_t triangleCount = 0;
+};
+
+static LoadResult Load(const std::string &path) {
+    LoadResult result;
+    std::vector<SubMesh> subMeshes;
+    std::string meshName;
+    AxisAlignedBox3D boundingBox;
+
+    result.milliseconds = Milliseconds([&] {
+        WavefrontMeshLoader(path).load(subMeshes, meshName, boundingBox);
+    });
+
+    result.subMeshCount = subMeshes.size();
+    for (auto &subMesh : subMeshes) {
+        result.triangleCount += subMesh.triangleCount();
+    }
+    return result;
+}
+
+int main() {
+    struct Row {
+        const char *model;
+        size_t sourceSize;
+        size_t cookedSize;
+        LoadResult cold;
+        LoadResult warm;
+    };
+    std::vector<Row> rows;
+
+    for (const char *model : {"cornell_box_covered.obj", "cornell_box_lux.obj", "floor.obj", "pbr_showroom.obj",
+                              "pbr_showroom_2.obj", "plane.obj", "sphere.obj", "street_light_e.obj", "suzanne.obj"}) {
+        // Meshes are cooked next to the source, so the sources are copied to keep the repository clean
+        std::string path = std::string("/tmp/") + model;
+        std::ifstream source(ModelsDirectory() + model, std::ios::binary);
+        std::ofstream(path, std::ios::binary) << source.rdbuf();
+
+        std::string cookedPath = path + ".cooked";
+        std::remove(cookedPath.c_str());
+
+        Row row = {model, FileSize(path), 0};
+        row.cold = Load(path);
+        row.cookedSize = FileSize(cookedPath);
+        row.warm = Load(path);
+        rows.push_back(row);
+
+        std::remove(cookedPath.c_str());
+        std::remove(path.c_str());
+    }
+
+    // Table goes after the loader's own log output
+    printf("\n%-24s %10s %10s %8s %10s %12s %12s %8s\n", "Model", "OBJ KB", "Cooked KB", "Meshes", "Triangles", "Cold ms", "Warm ms", "Speedup");
+    bool consistent = true;
+    for (auto &row : rows) {
+        printf("%-24s %10.1f %10.1f %8zu %10zu %12.2f %12.2f %7.1fx\n", row.model, row.sourceSize / 1024.0, row.cookedSize / 1024.0,
+                row.cold.subMeshCount, row.cold.triangleCount, row.cold.milliseconds, row.warm.milliseconds, row.cold.milliseconds / row.warm.milliseconds);
+        consistent &= row.cookedSize > 0 && row.cold.subMeshCount == row.warm.subMeshCount && row.cold.triangleCount == row.warm.triangleCount;
+    }
+
+    return consistent ? 0 : 1;
+}
@@ -0,0 +1,191 @@
+//
+//  OctreeBenchmark.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+//  Engine sources: Math/Collision.cpp, Math/Plane.cpp, Math/Parallelogram3D.cpp, Math/AxisAlignedBox3D.cpp, Math/Ray3D.cpp,
+//  Math/Triangle3D.cpp, Scene/Geometry/Transformation.cpp
+//
+
+#include "LinearOctree.hpp"
+#include "SparseOctree.hpp"
+#include "Collision.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace EARenderer;
+
+// Depth Scene builds its static geometry octree with
+static constexpr size_t Depth = 5;
+static constexpr size_t SegmentCount = 20000;
+
+// Keeps the optimizer from dropping the measured work
+static volatile size_t Sink = 0;
+
+template<class Function>
+static double Milliseconds(Function &&function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void Print(const char *operation, double sparseOctreeTime, double linearOctreeTime) {
+    printf("  %-30s %10.2f ms %10.2f ms %6.2fx\n", operation, sparseOctreeTime, linearOctreeTime, sparseOctreeTime / linearOctreeTime);
+}
+
+static bool Contains(const Triangle3D &triangle, const AxisAlignedBox3D &nodeBoundingBox) {
+    return nodeBoundingBox.contains(triangle);
+}
+
+/// Small triangles scattered over [0; 100]^3, sized like the ones of a tessellated scene
+static std::vector<Triangle3D> RandomTriangles(size_t count) {
+    std::mt19937 engine(12);
+    std::uniform_real_distribution<float> position(0.0f, 100.0f);
+    std::uniform_real_distribution<float> offset(-0.5f, 0.5f);
+
+    std::vector<Triangle3D> triangles;
+    triangles.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        glm::vec3 p(position(engine), position(engine), position(engine));
+        glm::vec3 a = glm::clamp(p + glm::vec3(offset(engine), offset(engine), offset(engine)), glm::vec3(0.0f), glm::vec3(100.0f));
+        glm::vec3 b = glm::clamp(p + glm::vec3(offset(engine), offset(engine), offset(engine)), glm::vec3(0.0f), glm::vec3(100.0f));
+        triangles.emplace_back(p, a, b);
+    }
+    return triangles;
+}
+
+/// Segments between random points on opposite faces of the box, the way picking and visibility rays cross a scene
+static std::vector<std::pair<glm::vec3, glm::vec3>> RandomSegments() {
+    std::mt19937 engine(13);
+    std::uniform_real_distribution<float> position(0.0f, 100.0f);
+
+    std::vector<std::pair<glm::vec3, glm::vec3>> segments;
+    for (size_t i = 0; i < SegmentCount; i++) {
+        glm::vec3 p0(-1.0f, position(engine), position(engine));
+        glm::vec3 p1(101.0f, position(engine), position(engine));
+        // Alternate the axis segments run along
+        size_t axis = i % 3;
+        std::swap(p0.x, p0[axis]);
+        std::swap(p1.x, p1[axis]);
+        segments.emplace_back(p0, p1);
+    }
+    return segments;
+}
+
+static bool RayHitsTriangle(const Triangle3D &triangle, const Ray3D &ray) {
+    float distance = 0.0f;
+    return Collision::RayTriangle(ray, triangle, distance);
+}
+
+// Triangles hit by any of the first segments, checked one by one
+static size_t BruteForceHitCount(const std::vector<Triangle3D> &triangles, const std::vector<std::pair<glm::vec3, glm::vec3>> &segments, size_t segmentCount) {
+    size_t hitCount = 0;
+    for (size_t i = 0; i < segmentCount; i++) {
+        Ray3D ray(segments[i].first, segments[i].second - segments[i].first);
+        hitCount += std::any_of(triangles.begin(), triangles.end(), [&](const Triangle3D &triangle) {
+            return RayHitsTriangle(triangle, ray);
+        });
+    }
+    return hitCount;
+}
+
+static bool Run(size_t triangleCount) {
+    AxisAlignedBox3D boundaries(glm::vec3(0.0f), glm::vec3(100.0f));
+    auto triangles = RandomTriangles(triangleCount);
+    auto segments = RandomSegments();
+
+    printf("%zu triangles, depth %zu, %zu segments    SparseOctree LinearOctree\n", triangleCount, Depth, SegmentCount);
+
+    // Reads every object it's given, so that visiting can't be folded into a count
+    float sparseChecksum = 0.0f;
+    size_t sparseVisitCount = 0;
+    SparseOctree<Triangle3D> sparseOctree(boundaries, Depth, Contains, [&](const Triangle3D &triangle, const Ray3D &) {
+        sparseChecksum += triangle.a.x;
+        sparseVisitCount++;
+        return false;
+    });
+    double sparseOctreeTime = Milliseconds([&] {
+        for (auto &triangle : triangles) {
+            sparseOctree.insert(triangle);
+        }
+    });
+
+    LinearOctree<Triangle3D> linearOctree(boundaries, Depth);
+    double linearOctreeTime = Milliseconds([&] {
+        linearOctree.build(triangles, Contains);
+    });
+    Print("Build", sparseOctreeTime, linearOctreeTime);
+
+    // Every object of every visited node is reported to the detector, which measures traversal alone
+    sparseOctreeTime = Milliseconds([&] {
+        for (auto &segment : segments) {
+            sparseOctree.raymarch(segment.first, segment.second);
+        }
+    });
+
+    float linearChecksum = 0.0f;
+    size_t linearVisitCount = 0;
+    linearOctreeTime = Milliseconds([&] {
+        for (auto &segment : segments) {
+            linearOctree.raymarch(segment.first, segment.second, [&](const Triangle3D &triangle, const Ray3D &) {
+                linearChecksum += triangle.a.x;
+                linearVisitCount++;
+                return false;
+            });
+        }
+    });
+    Print("Raymarch, visit all objects", sparseOctreeTime, linearOctreeTime);
+    Sink = size_t(sparseChecksum + linearChecksum);
+
+    // Stops at the first triangle hit, what occlusion queries do.
+    // A separate tree is needed, SparseOctree takes its detector at construction.
+    SparseOctree<Triangle3D> occlusionOctree(boundaries, Depth, Contains, RayHitsTriangle);
+    for (auto &triangle : triangles) {
+        occlusionOctree.insert(triangle);
+    }
+
+    size_t sparseHitCount = 0;
+    sparseOctreeTime = Milliseconds([&] {
+        for (auto &segment : segments) {
+            sparseHitCount += occlusionOctree.raymarch(segment.first, segment.second);
+        }
+    });
+
+    size_t linearHitCount = 0;
+    std::vector<bool> linearHits;
+    linearOctreeTime = Milliseconds([&] {
+        for (auto &segment : segments) {
+            bool hit = linearOctree.raymarch(segment.first, segment.second, RayHitsTriangle);
+            linearHits.push_back(hit);
+            linearHitCount += hit;
+        }
+    });
+    Print("Raymarch, first hit", sparseOctreeTime, linearOctreeTime);
+
+    printf("  LinearOctree: %.0f segments per second, %zu objects tested per segment\n",
+            SegmentCount / linearOctreeTime * 1000.0, linearVisitCount / SegmentCount);
+    printf("  Segments hitting a triangle: %zu by SparseOctree, %zu by LinearOctree\n", sparseHitCount, linearHitCount);
+    printf("  Objects tested: %zu by SparseOctree, %zu by LinearOctree\n", sparseVisitCount, linearVisitCount);
+
+    // Brute force is too slow for every segment of the larger sets
+    size_t checkedSegmentCount = std::min<size_t>(SegmentCount, 100000000 / triangleCount);
+    size_t expectedHitCount = BruteForceHitCount(triangles, segments, checkedSegmentCount);
+    size_t checkedHitCount = std::count(linearHits.begin(), linearHits.begin() + checkedSegmentCount, true);
+    printf("  Brute force over the first %zu segments: %zu hits, LinearOctree %s\n", checkedSegmentCount, expectedHitCount,
+            checkedHitCount == expectedHitCount ? "agrees" : "disagrees");
+    return checkedHitCount == expectedHitCount;
+}
+
+int main() {
+    bool matches = true;
+    matches &= Run(10000);
+    matches &= Run(100000);
+    matches &= Run(1000000);
+    return matches ? 0 : 1;
+}
@@ -0,0 +1,148 @@
+//
+//  PackedLookupTableBenchmark.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "PackedLookupTable.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using namespace EARenderer;
+
+// About the size of a light or a mesh instance
+struct Object {
+    float values[16];
+
+    Object(float value = 0.0f) {
+        std::fill(std::begin(values), std::end(values), value);
+    }
+};
+
+// Keeps the optimizer from dropping the measured work
+static volatile float Sink = 0.0f;
+
+template<class Function>
+static double Milliseconds(Function &&function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void Print(const char *operation, double tableTime, double mapTime) {
+    printf("  %-22s %9.2f ms %9.2f ms\n", operation, tableTime, mapTime);
+}
+
+static void Run(size_t objectCount) {
+    std::mt19937 engine(17);
+
+    PackedLookupTable<Object> table;
+    std::unordered_map<ID, Object> map;
+    std::vector<ID> tableIDs;
+    std::vector<ID> mapIDs;
+    tableIDs.reserve(objectCount);
+    mapIDs.reserve(objectCount);
+
+    printf("%zu objects             PackedLookupTable unordered_map\n", objectCount);
+
+    // Growing from an empty table, no reservation
+    double tableTime = Milliseconds([&] {
+        for (size_t i = 0; i < objectCount; i++) {
+            tableIDs.push_back(table.emplace(float(i)));
+        }
+    });
+    double mapTime = Milliseconds([&] {
+        for (size_t i = 0; i < objectCount; i++) {
+            mapIDs.push_back(i + 1);
+            map.emplace(i + 1, Object(float(i)));
+        }
+    });
+    Print("Insertion", tableTime, mapTime);
+
+    std::vector<size_t> order(objectCount);
+    for (size_t i = 0; i < objectCount; i++) {
+        order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), engine);
+
+    tableTime = Milliseconds([&] {
+        float sum = 0.0f;
+        for (size_t i : order) {
+            sum += table[tableIDs[i]].values[0];
+        }
+        Sink = sum;
+    });
+    mapTime = Milliseconds([&] {
+        float sum = 0.0f;
+        for (size_t i : order) {
+            sum += map.at(mapIDs[i]).values[0];
+        }
+        Sink = sum;
+    });
+    Print("Random lookup", tableTime, mapTime);
+
+    tableTime = Milliseconds([&] {
+        float sum = 0.0f;
+        for (ID id : table) {
+            sum += table[id].values[0];
+        }
+        Sink = sum;
+    });
+    mapTime = Milliseconds([&] {
+        float sum = 0.0f;
+        for (auto &entry : map) {
+            sum += entry.second.values[0];
+        }
+        Sink = sum;
+    });
+    Print("Iteration by ID", tableTime, mapTime);
+
+    tableTime = Milliseconds([&] {
+        float sum = 0.0f;
+        table.forEach([&](const Object &object) {
+            sum += object.values[0];
+        });
+        Sink = sum;
+    });
+    Print("Iteration by forEach", tableTime, mapTime);
+
+    // Every other object in random order
+    tableTime = Milliseconds([&] {
+        for (size_t i = 0; i < objectCount; i += 2) {
+            table.erase(tableIDs[order[i]]);
+        }
+    });
+    mapTime = Milliseconds([&] {
+        for (size_t i = 0; i < objectCount; i += 2) {
+            map.erase(mapIDs[order[i]]);
+        }
+    });
+    Print("Erasure of a half", tableTime, mapTime);
+
+    // Erased slots are reused
+    tableTime = Milliseconds([&] {
+        for (size_t i = 0; i < objectCount; i += 2) {
+            tableIDs[order[i]] = table.emplace(float(i));
+        }
+    });
+    mapTime = Milliseconds([&] {
+        for (size_t i = 0; i < objectCount; i += 2) {
+            map.emplace(mapIDs[order[i]], Object(float(i)));
+        }
+    });
+    Print("Reinsertion", tableTime, mapTime);
+}
+
+int main() {
+    for (size_t objectCount : {1000, 100000, 1000000}) {
+        Run(objectCount);
+    }
+    return 0;
+}
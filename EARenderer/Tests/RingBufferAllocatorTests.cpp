@@ -0,0 +1,105 @@
+//
+//  RingBufferAllocatorTests.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+//  Engine sources: Foundation/RingBufferAllocator.cpp, Foundation/MemoryUtils.cpp
+//
+
+#include "TestUtils.hpp"
+#include "RingBufferAllocator.hpp"
+
+#include <stdexcept>
+
+using namespace EARenderer;
+
+TEST(SegmentSizeIsRoundedUpToAlignment) {
+    RingBufferAllocator allocator(1000, 3, 256);
+    EXPECT(allocator.segmentSize() == 1024);
+    EXPECT(allocator.capacity() == 3072);
+    EXPECT(allocator.segmentOffset(2) == 2048);
+
+    RingBufferAllocator aligned(1024, 2, 256);
+    EXPECT(aligned.segmentSize() == 1024);
+}
+
+TEST(AllocationsAreAligned) {
+    RingBufferAllocator allocator(1024, 3, 256);
+    allocator.nextSegment();
+
+    EXPECT(allocator.allocate(100) == 0);
+    EXPECT(allocator.usedBytes() == 100);
+    EXPECT(allocator.allocate(10) == 256);
+    EXPECT(allocator.allocate(1) == 512);
+    // Padding counts towards used bytes
+    EXPECT(allocator.usedBytes() == 513);
+}
+
+TEST(SegmentsWrapAround) {
+    RingBufferAllocator allocator(1024, 3, 256);
+
+    // Starts at the last segment, so that the first frame gets segment 0
+    EXPECT(allocator.currentSegment() == 2);
+    EXPECT(allocator.nextSegment() == 0);
+    EXPECT(allocator.allocate(1) == 0);
+    EXPECT(allocator.nextSegment() == 1);
+    EXPECT(allocator.allocate(1) == 1024);
+    EXPECT(allocator.nextSegment() == 2);
+    EXPECT(allocator.allocate(1) == 2048);
+    EXPECT(allocator.nextSegment() == 0);
+    EXPECT(allocator.allocate(1) == 0);
+}
+
+TEST(NextSegmentResetsUsedBytes) {
+    RingBufferAllocator allocator(1024, 2, 256);
+    allocator.nextSegment();
+    allocator.allocate(700);
+    EXPECT(allocator.usedBytes() == 700);
+
+    allocator.nextSegment();
+    EXPECT(allocator.usedBytes() == 0);
+    // The whole segment is available again
+    EXPECT(allocator.allocate(1024) == 1024);
+}
+
+TEST(ExactFitSucceeds) {
+    RingBufferAllocator allocator(1024, 2, 256);
+    allocator.nextSegment();
+
+    EXPECT(allocator.allocate(1024) == 0);
+    EXPECT(allocator.usedBytes() == 1024);
+
+    allocator.nextSegment();
+    EXPECT(allocator.allocate(512) == 1024);
+    EXPECT(allocator.allocate(512) == 1536);
+}
+
+TEST(OverflowThrowsRangeError) {
+    RingBufferAllocator allocator(1024, 2, 256);
+    allocator.nextSegment();
+
+    EXPECT_THROWS(allocator.allocate(1025), std::range_error);
+    // Failed allocations leave the segment untouched
+    EXPECT(allocator.usedBytes() == 0);
+
+    allocator.allocate(1000);
+    EXPECT_THROWS(allocator.allocate(1), std::range_error);
+
+    allocator.nextSegment();
+    allocator.allocate(1);
+    // Fits in the remaining bytes, but not after aligning its offset
+    EXPECT_THROWS(allocator.allocate(1000), std::range_error);
+
+    // Sizes close to the maximum must not wrap around in the fit check
+    EXPECT_THROWS(allocator.allocate(SIZE_MAX), std::range_error);
+}
+
+TEST(ZeroParametersAreRejected) {
+    EXPECT_THROWS(RingBufferAllocator(0, 3, 256), std::invalid_argument);
+    EXPECT_THROWS(RingBufferAllocator(1024, 0, 256), std::invalid_argument);
+    EXPECT_THROWS(RingBufferAllocator(1024, 3, 0), std::invalid_argument);
+}
+
+TEST_MAIN()
@@ -0,0 +1,146 @@
+//
+//  SkyVisibilityProjectorTests.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+//  Engine sources: Rendering/Baking/SkyVisibilityProjector.cpp, Foundation/LowDiscrepancySequence.cpp,
+//  Math/SphericalHarmonics.cpp, Foundation/Color.cpp, Algorithm/EmbreeRayTracer/EmbreeRayTracer.cpp, Math/Ray3D.cpp,
+//  Math/Triangle3D.cpp, Math/AxisAlignedBox3D.cpp, Scene/Geometry/Transformation.cpp
+//  Links against Embree 3 (-lembree3)
+//
+
+#include "TestUtils.hpp"
+#include "SkyVisibilityProjector.hpp"
+
+#include <cmath>
+#include <functional>
+#include <vector>
+
+using namespace EARenderer;
+
+struct Projection {
+    SphericalHarmonics sphericalHarmonics;
+    float visibleFraction = 0.0f;
+};
+
+// The angular grid probes were baked with before Hammersley sampling, a single ray per grid point
+static Projection GridProjection(const std::function<bool(const glm::vec3 &)> &isVisible) {
+    Projection projection;
+    float sampleDelta = 0.025;
+    int32_t iterationCount = 0;
+    float visibleWeight = 0.0f;
+    float totalWeight = 0.0f;
+
+    for (float phi = 0.0; phi < M_PI * 2.0; phi += sampleDelta) {
+        for (float theta = 0.0; theta < M_PI; theta += sampleDelta) {
+            glm::vec3 direction(sin(theta) * cos(phi), sin(theta) * sin(phi), cos(theta));
+            if (isVisible(direction)) {
+                projection.sphericalHarmonics.contribute(direction, glm::vec3(1.0), sin(theta));
+                visibleWeight += sin(theta);
+            }
+            totalWeight += sin(theta);
+            iterationCount++;
+        }
+    }
+
+    projection.sphericalHarmonics.scale(glm::vec3(1.0 / iterationCount));
+    projection.sphericalHarmonics.convolve();
+    projection.visibleFraction = visibleWeight / totalWeight;
+    return projection;
+}
+
+static Projection GridProjection(const glm::vec3 &position, const EmbreeRayTracer &rayTracer) {
+    return GridProjection([&](const glm::vec3 &direction) {
+        float distance = 0.0f;
+        return !rayTracer.rayHit(Ray3D(position, direction), distance);
+    });
+}
+
+static Projection HammersleyProjection(const glm::vec3 &position, const EmbreeRayTracer &rayTracer, size_t sampleCount) {
+    Projection projection;
+    projection.visibleFraction = SkyVisibilityProjector(sampleCount).project(position, rayTracer, projection.sphericalHarmonics);
+    return projection;
+}
+
+/// Largest coefficient difference relative to the projection of the unobstructed sky
+static float RelativeDifference(const Projection &lhs, const Projection &rhs) {
+    static const float OpenSkyL00 = GridProjection([](const glm::vec3 &) { return true; }).sphericalHarmonics.L00().r;
+
+    auto lhsCoefficients = lhs.sphericalHarmonics.coefficients();
+    auto rhsCoefficients = rhs.sphericalHarmonics.coefficients();
+    float difference = 0.0f;
+    for (size_t i = 0; i < SphericalHarmonics::CoefficientCount; i++) {
+        difference = std::max(difference, std::abs(lhsCoefficients[i].r - rhsCoefficients[i].r));
+    }
+    return difference / OpenSkyL00;
+}
+
+static void AddQuad(std::vector<Triangle3D> &triangles, const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c, const glm::vec3 &d) {
+    triangles.emplace_back(a, b, c);
+    triangles.emplace_back(a, c, d);
+}
+
+// Square floor in the z = 0 plane, spanning [-10; 10] along x and y
+static std::vector<Triangle3D> FloorTriangles() {
+    std::vector<Triangle3D> triangles;
+    AddQuad(triangles, glm::vec3(-10.0f, -10.0f, 0.0f), glm::vec3(10.0f, -10.0f, 0.0f), glm::vec3(10.0f, 10.0f, 0.0f), glm::vec3(-10.0f, 10.0f, 0.0f));
+    return triangles;
+}
+
+// Cube spanning [-2; 2] on every axis with the top face missing, so the sky is only seen upwards
+static std::vector<Triangle3D> OpenBoxTriangles() {
+    std::vector<Triangle3D> triangles;
+    glm::vec3 v[] = {
+            {-2.0f, -2.0f, -2.0f}, {2.0f, -2.0f, -2.0f}, {2.0f, 2.0f, -2.0f}, {-2.0f, 2.0f, -2.0f},
+            {-2.0f, -2.0f, 2.0f}, {2.0f, -2.0f, 2.0f}, {2.0f, 2.0f, 2.0f}, {-2.0f, 2.0f, 2.0f}
+    };
+    AddQuad(triangles, v[0], v[1], v[2], v[3]);
+    AddQuad(triangles, v[0], v[1], v[5], v[4]);
+    AddQuad(triangles, v[1], v[2], v[6], v[5]);
+    AddQuad(triangles, v[2], v[3], v[7], v[6]);
+    AddQuad(triangles, v[3], v[0], v[4], v[7]);
+    return triangles;
+}
+
+TEST(SampleCountIsRoundedUpToPowerOfTwo) {
+    EXPECT(SkyVisibilityProjector(1).sampleCount() == EmbreeRayTracer::PacketSize);
+    EXPECT(SkyVisibilityProjector(2048).sampleCount() == 2048);
+    EXPECT(SkyVisibilityProjector(2049).sampleCount() == 4096);
+}
+
+TEST(ProjectionMatchesBruteForceGrid) {
+    EmbreeRayTracer floor(FloorTriangles());
+    EmbreeRayTracer openBox(OpenBoxTriangles());
+
+    struct Case {
+        const EmbreeRayTracer &rayTracer;
+        glm::vec3 position;
+    };
+
+    for (const Case &testCase : {Case{floor, glm::vec3(0.0f, 0.0f, 1.0f)}, Case{floor, glm::vec3(3.0f, -2.0f, 0.5f)},
+                                 Case{floor, glm::vec3(0.0f, 0.0f, 5.0f)}, Case{openBox, glm::vec3(0.0f)},
+                                 Case{openBox, glm::vec3(1.0f, 1.0f, -1.0f)}}) {
+        Projection grid = GridProjection(testCase.position, testCase.rayTracer);
+        Projection hammersley = HammersleyProjection(testCase.position, testCase.rayTracer, 2048);
+
+        EXPECT(RelativeDifference(hammersley, grid) < 0.02f);
+        // Reported error of the default sample count bounds the actual one
+        SkyVisibilityProjector projector(2048);
+        EXPECT(std::abs(hammersley.visibleFraction - grid.visibleFraction) < 3.0f * projector.standardError(grid.visibleFraction));
+    }
+}
+
+TEST(ProjectionConvergesToBruteForceGrid) {
+    EmbreeRayTracer openBox(OpenBoxTriangles());
+    glm::vec3 position(1.0f, 1.0f, -1.0f);
+    Projection grid = GridProjection(position, openBox);
+
+    float coarseDifference = RelativeDifference(HammersleyProjection(position, openBox, 64), grid);
+    float fineDifference = RelativeDifference(HammersleyProjection(position, openBox, 8192), grid);
+    EXPECT(fineDifference < coarseDifference);
+    EXPECT(fineDifference < 0.01f);
+}
+
+TEST_MAIN()
@@ -0,0 +1,122 @@
+//
+//  SpatialHashBenchmark.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+//  Engine sources: Math/AxisAlignedBox3D.cpp, Math/Ray3D.cpp, Math/Triangle3D.cpp, Scene/Geometry/Transformation.cpp
+//
+
+#include "SpatialHash.hpp"
+#include "FlatSpatialHash.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace EARenderer;
+
+// About the size of a surfel
+struct Object {
+    glm::vec3 position;
+    float values[9];
+};
+
+// Keeps the optimizer from dropping or merging the measured work
+static volatile size_t Sink = 0;
+
+template<class Function>
+static double Milliseconds(Function &&function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void Print(const char *operation, double spatialHashTime, double flatSpatialHashTime) {
+    printf("  %-26s %10.2f ms %10.2f ms %6.2fx\n", operation, spatialHashTime, flatSpatialHashTime, spatialHashTime / flatSpatialHashTime);
+}
+
+template<class Hash>
+static size_t NeighbourCount(Hash &hash, const std::vector<glm::vec3> &queries) {
+    size_t count = 0;
+    for (auto &query : queries) {
+        for (const Object &object : hash.neighbours(query)) {
+            count += object.values[0] >= 0.0f;
+        }
+    }
+    Sink = count;
+    return count;
+}
+
+// About 8 objects per cell, the density surfel generation queries at
+static bool Run(size_t objectCount, size_t queryCount) {
+    std::mt19937 engine(21);
+    std::uniform_real_distribution<float> distribution(0.0f, 100.0f);
+    AxisAlignedBox3D boundaries(glm::vec3(0.0f), glm::vec3(100.0f));
+    uint32_t resolution = std::cbrt(objectCount / 8.0);
+
+    std::vector<Object> objects(objectCount);
+    for (auto &object : objects) {
+        object.position = glm::vec3(distribution(engine), distribution(engine), distribution(engine));
+        object.values[0] = 1.0f;
+    }
+
+    std::vector<glm::vec3> queries(queryCount);
+    for (auto &query : queries) {
+        query = glm::vec3(distribution(engine), distribution(engine), distribution(engine));
+    }
+
+    printf("%zu objects, %u^3 cells, %zu queries    SpatialHash FlatSpatialHash\n", objectCount, resolution, queryCount);
+
+    SpatialHash<Object> spatialHash(boundaries, resolution);
+    double spatialHashTime = Milliseconds([&] {
+        for (auto &object : objects) {
+            spatialHash.insert(object, object.position);
+        }
+    });
+
+    FlatSpatialHash<Object> insertedHash(boundaries, resolution);
+    double flatSpatialHashTime = Milliseconds([&] {
+        for (auto &object : objects) {
+            insertedHash.insert(object, object.position);
+        }
+    });
+    Print("Insertion one by one", spatialHashTime, flatSpatialHashTime);
+
+    FlatSpatialHash<Object> builtHash(boundaries, resolution);
+    flatSpatialHashTime = Milliseconds([&] {
+        builtHash.build(objects, [](const Object &object) { return object.position; });
+    });
+    Print("Insertion vs build()", spatialHashTime, flatSpatialHashTime);
+
+    size_t spatialHashCount = 0;
+    size_t insertedCount = 0;
+    size_t builtCount = 0;
+    spatialHashTime = Milliseconds([&] {
+        spatialHashCount = NeighbourCount(spatialHash, queries);
+    });
+    flatSpatialHashTime = Milliseconds([&] {
+        insertedCount = NeighbourCount(insertedHash, queries);
+    });
+    Print("Neighbours, inserted", spatialHashTime, flatSpatialHashTime);
+
+    flatSpatialHashTime = Milliseconds([&] {
+        builtCount = NeighbourCount(builtHash, queries);
+    });
+    Print("Neighbours, built", spatialHashTime, flatSpatialHashTime);
+
+    bool matches = insertedCount == spatialHashCount && builtCount == spatialHashCount;
+    printf("  %zu neighbours visited%s\n", spatialHashCount, matches ? "" : ", hashes disagree");
+    return matches;
+}
+
+int main() {
+    bool matches = true;
+    matches &= Run(100000, 100000);
+    matches &= Run(1000000, 100000);
+    matches &= Run(10000000, 100000);
+    return matches ? 0 : 1;
+}
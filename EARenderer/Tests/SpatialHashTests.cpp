@@ -0,0 +1,177 @@
+//
+//  SpatialHashTests.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+//  Engine sources: Math/AxisAlignedBox3D.cpp, Math/Ray3D.cpp, Math/Triangle3D.cpp, Scene/Geometry/Transformation.cpp
+//
+
+#include "TestUtils.hpp"
+#include "SpatialHash.hpp"
+#include "FlatSpatialHash.hpp"
+#include "ConcurrentSpatialHash.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace EARenderer;
+
+static const AxisAlignedBox3D Boundaries(glm::vec3(0.0f), glm::vec3(10.0f));
+static constexpr uint32_t Resolution = 16;
+
+struct Point {
+    uint32_t index = 0;
+    glm::vec3 position;
+};
+
+static std::vector<Point> RandomPoints(size_t count) {
+    std::mt19937 engine(9);
+    std::uniform_real_distribution<float> distribution(0.0f, 10.0f);
+
+    std::vector<Point> points;
+    for (uint32_t i = 0; i < count; i++) {
+        points.push_back({i, glm::vec3(distribution(engine), distribution(engine), distribution(engine))});
+    }
+    // Points on the boundaries land in the first and the last cells
+    points.push_back({(uint32_t) points.size(), glm::vec3(0.0f)});
+    points.push_back({(uint32_t) points.size(), glm::vec3(10.0f)});
+    return points;
+}
+
+// Queries reach a cell and a half past the boundaries on every side
+static std::vector<glm::vec3> QueryPositions() {
+    std::mt19937 engine(10);
+    std::uniform_real_distribution<float> distribution(-1.0f, 11.0f);
+
+    std::vector<glm::vec3> positions = {glm::vec3(-0.3f), glm::vec3(10.3f), glm::vec3(-0.3f, 5.0f, 10.3f), glm::vec3(-5.0f)};
+    for (size_t i = 0; i < 500; i++) {
+        positions.emplace_back(distribution(engine), distribution(engine), distribution(engine));
+    }
+    return positions;
+}
+
+static glm::ivec3 ReferenceCell(const glm::vec3 &position) {
+    return glm::ivec3(glm::floor((position - Boundaries.min) / (Boundaries.max - Boundaries.min) * float(Resolution - 1)));
+}
+
+// Points of the query's cell and of its 26 neighbours
+static std::vector<uint32_t> BruteForceNeighbours(const std::vector<Point> &points, const glm::vec3 &position) {
+    glm::ivec3 center = ReferenceCell(position);
+    std::vector<uint32_t> neighbours;
+    for (auto &point : points) {
+        glm::ivec3 delta = glm::abs(ReferenceCell(point.position) - center);
+        if (delta.x <= 1 && delta.y <= 1 && delta.z <= 1) {
+            neighbours.push_back(point.index);
+        }
+    }
+    return neighbours;
+}
+
+template<class Hash>
+static bool NeighboursMatchBruteForce(Hash &hash, const std::vector<Point> &points) {
+    for (auto &position : QueryPositions()) {
+        std::vector<uint32_t> found;
+        for (const Point &point : hash.neighbours(position)) {
+            found.push_back(point.index);
+        }
+        std::sort(found.begin(), found.end());
+
+        if (found != BruteForceNeighbours(points, position)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST(SpatialHashNeighboursMatchBruteForce) {
+    auto points = RandomPoints(3000);
+    SpatialHash<Point> hash(Boundaries, Resolution);
+    for (auto &point : points) {
+        hash.insert(point, point.position);
+    }
+    EXPECT(hash.size() == points.size());
+    EXPECT(NeighboursMatchBruteForce(hash, points));
+}
+
+TEST(FlatSpatialHashNeighboursMatchBruteForce) {
+    auto points = RandomPoints(3000);
+
+    FlatSpatialHash<Point> inserted(Boundaries, Resolution);
+    for (auto &point : points) {
+        inserted.insert(point, point.position);
+    }
+    EXPECT(inserted.size() == points.size());
+    EXPECT(NeighboursMatchBruteForce(inserted, points));
+
+    inserted.compact();
+    EXPECT(NeighboursMatchBruteForce(inserted, points));
+
+    FlatSpatialHash<Point> built(Boundaries, Resolution);
+    built.build(points, [](const Point &point) { return point.position; });
+    EXPECT(built.size() == points.size());
+    EXPECT(NeighboursMatchBruteForce(built, points));
+}
+
+TEST(ConcurrentSpatialHashNeighboursMatchBruteForce) {
+    auto points = RandomPoints(3000);
+    ConcurrentSpatialHash<Point> hash(Boundaries, Resolution);
+    for (auto &point : points) {
+        hash.insert(point, point.position);
+    }
+
+    bool matches = true;
+    for (auto &position : QueryPositions()) {
+        std::vector<uint32_t> found;
+        hash.anyNeighbour(position, [&](const Point &point) {
+            found.push_back(point.index);
+            return false;
+        });
+        std::sort(found.begin(), found.end());
+        matches &= found == BruteForceNeighbours(points, position);
+    }
+    EXPECT(matches);
+}
+
+TEST(QueriesBelowBoundariesOnlyReachTheFirstCells) {
+    // One point per cell along the x axis
+    std::vector<Point> points;
+    float cellSize = 10.0f / (Resolution - 1);
+    for (uint32_t i = 0; i < Resolution - 1; i++) {
+        points.push_back({i, glm::vec3((i + 0.5f) * cellSize, 5.0f, 5.0f)});
+    }
+
+    SpatialHash<Point> hash(Boundaries, Resolution);
+    FlatSpatialHash<Point> flatHash(Boundaries, Resolution);
+    for (auto &point : points) {
+        hash.insert(point, point.position);
+        flatHash.insert(point, point.position);
+    }
+
+    // Half a cell below the minimum is cell -1, which only neighbours cell 0.
+    // Truncation towards zero used to put it into cell 0 and report cell 1 as well.
+    glm::vec3 position(-0.5f * cellSize, 5.0f, 5.0f);
+    std::vector<uint32_t> found;
+    for (const Point &point : hash.neighbours(position)) {
+        found.push_back(point.index);
+    }
+    EXPECT(found == std::vector<uint32_t>{0});
+
+    found.clear();
+    for (const Point &point : flatHash.neighbours(position)) {
+        found.push_back(point.index);
+    }
+    EXPECT(found == std::vector<uint32_t>{0});
+
+    // Two cells below reaches nothing
+    found.clear();
+    for (const Point &point : flatHash.neighbours(glm::vec3(-1.5f * cellSize, 5.0f, 5.0f))) {
+        found.push_back(point.index);
+    }
+    EXPECT(found.empty());
+}
+
+TEST_MAIN()
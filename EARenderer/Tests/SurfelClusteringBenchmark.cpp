@@ -0,0 +1,195 @@
+//
+//  SurfelClusteringBenchmark.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+//  Engine sources: Rendering/Baking/SurfelClusterBuilder.cpp, Algorithm/EmbreeRayTracer/EmbreeRayTracer.cpp,
+//  Scene/Lighting/Surfel.cpp, Scene/Lighting/SurfelCluster.cpp, Foundation/Color.cpp, Math/AxisAlignedBox3D.cpp,
+//  Math/Triangle3D.cpp, Math/Ray3D.cpp, Scene/Geometry/Transformation.cpp
+//  Links against Embree 3 (-lembree3)
+//
+
+#include "SurfelClusterBuilder.hpp"
+
+#include <glm/gtx/norm.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace EARenderer;
+
+// Same thresholds and occlusion test as SurfelClusterBuilder
+static constexpr float Cn = -0.3f;
+static constexpr float Cb = 0.04f;
+
+struct ClusteringStatistics {
+    size_t clusterCount = 0;
+    size_t maximumClusterSize = 0;
+    double meanClusterSize = 0.0;
+    double milliseconds = 0.0;
+};
+
+// Room of 20x20x4 units split in halves by a wall with a doorway, so that occlusion matters
+static std::vector<Triangle3D> RoomTriangles() {
+    std::vector<Triangle3D> triangles;
+    auto quad = [&](const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c, const glm::vec3 &d) {
+        triangles.emplace_back(a, b, c);
+        triangles.emplace_back(a, c, d);
+    };
+
+    quad({0, 0, 0}, {20, 0, 0}, {20, 0, 20}, {0, 0, 20});
+    quad({0, 4, 0}, {0, 4, 20}, {20, 4, 20}, {20, 4, 0});
+    quad({10, 0, 0}, {10, 4, 0}, {10, 4, 8}, {10, 0, 8});
+    quad({10, 0, 12}, {10, 4, 12}, {10, 4, 20}, {10, 0, 20});
+    return triangles;
+}
+
+// Surfels of the floor, the ceiling and both sides of the dividing wall
+static std::vector<Surfel> RoomSurfels(float spacing) {
+    std::vector<Surfel> surfels;
+    for (float x = spacing / 2; x < 20; x += spacing) {
+        for (float z = spacing / 2; z < 20; z += spacing) {
+            surfels.emplace_back(glm::vec3(x, 0.01f, z), glm::vec3(0, 1, 0));
+            surfels.emplace_back(glm::vec3(x, 3.99f, z), glm::vec3(0, -1, 0));
+        }
+    }
+    for (float y = spacing / 2; y < 4; y += spacing) {
+        for (float z = spacing / 2; z < 20; z += spacing) {
+            if (z > 8 && z < 12) {
+                continue;
+            }
+            surfels.emplace_back(glm::vec3(9.99f, y, z), glm::vec3(-1, 0, 0));
+            surfels.emplace_back(glm::vec3(10.01f, y, z), glm::vec3(1, 0, 0));
+        }
+    }
+    return surfels;
+}
+
+// Hall of rooms x rooms cells, each 10x10 units and walled off from its neighbours.
+// Clusters can't grow past the walls, so they stay smaller than the distance criterion allows.
+// Walls are high enough to separate visibility segments, which start and end well above the floor in a volume that large.
+static std::vector<Triangle3D> HallTriangles(int rooms) {
+    std::vector<Triangle3D> triangles;
+    auto quad = [&](const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c, const glm::vec3 &d) {
+        triangles.emplace_back(a, b, c);
+        triangles.emplace_back(a, c, d);
+    };
+
+    float size = rooms * 10.0f;
+    quad({0, 0, 0}, {size, 0, 0}, {size, 0, size}, {0, 0, size});
+    for (int i = 1; i < rooms; i++) {
+        float wall = i * 10.0f;
+        quad({wall, 0, 0}, {wall, 20, 0}, {wall, 20, size}, {wall, 0, size});
+        quad({0, 0, wall}, {0, 20, wall}, {size, 20, wall}, {size, 0, wall});
+    }
+    return triangles;
+}
+
+static std::vector<Surfel> HallSurfels(int rooms, float spacing) {
+    std::vector<Surfel> surfels;
+    for (float x = spacing / 2; x < rooms * 10.0f; x += spacing) {
+        for (float z = spacing / 2; z < rooms * 10.0f; z += spacing) {
+            surfels.emplace_back(glm::vec3(x, 0.01f, z), glm::vec3(0, 1, 0));
+        }
+    }
+    return surfels;
+}
+
+static ClusteringStatistics Statistics(const std::vector<size_t> &clusterSizes, std::chrono::steady_clock::duration duration) {
+    ClusteringStatistics statistics;
+    statistics.clusterCount = clusterSizes.size();
+    for (size_t size : clusterSizes) {
+        statistics.maximumClusterSize = std::max(statistics.maximumClusterSize, size);
+        statistics.meanClusterSize += size;
+    }
+    statistics.meanClusterSize /= std::max(clusterSizes.size(), (size_t) 1);
+    statistics.milliseconds = std::chrono::duration<double, std::milli>(duration).count();
+    return statistics;
+}
+
+// Clustering as SurfelGenerator did it before SurfelClusterBuilder: every remaining surfel is tested against every cluster
+static ClusteringStatistics ReferenceClustering(const EmbreeRayTracer &rayTracer, std::vector<Surfel> surfels, float extent2, size_t maximumClusterSize) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<size_t> clusterSizes;
+    float offset = extent2 * 0.001f;
+
+    while (!surfels.empty()) {
+        std::vector<Surfel> members{surfels.front()};
+        std::vector<Surfel> remaining;
+
+        for (size_t i = 1; i < surfels.size(); i++) {
+            const Surfel &candidate = surfels[i];
+            bool fits = members.size() < maximumClusterSize;
+
+            for (size_t m = 0; fits && m < members.size(); m++) {
+                const Surfel &member = members[m];
+                float normDistance2 = glm::length2(member.position - candidate.position) / extent2;
+                fits = normDistance2 <= Cb && glm::dot(member.normal, candidate.normal) > Cn &&
+                        !rayTracer.lineSegmentOccluded(member.position + member.normal * offset, candidate.position + candidate.normal * offset);
+            }
+
+            if (fits) {
+                members.push_back(candidate);
+            } else {
+                remaining.push_back(candidate);
+            }
+        }
+
+        clusterSizes.push_back(members.size());
+        surfels = std::move(remaining);
+    }
+
+    return Statistics(clusterSizes, std::chrono::steady_clock::now() - start);
+}
+
+static ClusteringStatistics GridClustering(const EmbreeRayTracer &rayTracer, const std::vector<Surfel> &surfels,
+        const AxisAlignedBox3D &volume, float spacing, size_t maximumClusterSize) {
+    auto start = std::chrono::steady_clock::now();
+    SurfelClusterBuilder builder(&rayTracer, volume, spacing, maximumClusterSize);
+    auto result = builder.build(surfels);
+    auto duration = std::chrono::steady_clock::now() - start;
+
+    std::vector<size_t> clusterSizes;
+    for (auto &cluster : result.clusters) {
+        clusterSizes.push_back(cluster.surfelCount);
+    }
+    return Statistics(clusterSizes, duration);
+}
+
+static void Print(const char *name, const ClusteringStatistics &statistics) {
+    printf("  %-10s %8.1f ms, %6zu clusters, %6.1f surfels on average, %4zu at most\n",
+            name, statistics.milliseconds, statistics.clusterCount, statistics.meanClusterSize, statistics.maximumClusterSize);
+}
+
+int main() {
+    EmbreeRayTracer rayTracer(RoomTriangles());
+    AxisAlignedBox3D volume(glm::vec3(0.0f), glm::vec3(20.0f, 4.0f, 20.0f));
+    float extent = volume.largestDimensionLength();
+    constexpr size_t MaximumClusterSize = 256;
+
+    for (float spacing : {0.5f, 0.35f, 0.25f}) {
+        auto surfels = RoomSurfels(spacing);
+        printf("%zu surfels, spacing %.2f\n", surfels.size(), spacing);
+        Print("Reference", ReferenceClustering(rayTracer, surfels, extent * extent, MaximumClusterSize));
+        Print("Grid", GridClustering(rayTracer, surfels, volume, spacing, MaximumClusterSize));
+    }
+
+    // Too many surfels for the reference clustering to finish in reasonable time
+    constexpr size_t HallMaximumClusterSize = 64;
+    for (int rooms : {6, 10}) {
+        EmbreeRayTracer hallRayTracer(HallTriangles(rooms));
+        AxisAlignedBox3D hallVolume(glm::vec3(0.0f), glm::vec3(rooms * 10.0f, 20.0f, rooms * 10.0f));
+
+        for (float hallSpacing : {1.0f, 0.5f}) {
+            auto surfels = HallSurfels(rooms, hallSpacing);
+            printf("%zu surfels in %dx%d walled off rooms, spacing %.2f\n", surfels.size(), rooms, rooms, hallSpacing);
+            Print("Grid", GridClustering(hallRayTracer, surfels, hallVolume, hallSpacing, HallMaximumClusterSize));
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,251 @@
+//
+//  SurfelLayoutBenchmark.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+//  Engine sources: Scene/Lighting/Surfel.cpp, Foundation/Color.cpp
+//
+
+#include "Surfel.hpp"
+#include "OctahedralEncoding.hpp"
+
+#include <glm/geometric.hpp>
+#include <glm/gtc/packing.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace EARenderer;
+
+// Keeps the optimizer from dropping the measured work
+static volatile float Sink = 0.0f;
+
+template<class Function>
+static double Milliseconds(Function &&function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Texel count of the surfel G-buffer layer, the way GLTexture::EstimatedSize() sizes it
+static size_t PaddedCount(size_t surfelCount) {
+    size_t dimensionLength = std::ceil(std::sqrt((float) surfelCount));
+    return dimensionLength * dimensionLength;
+}
+
+static std::vector<Surfel> RandomSurfels(size_t count) {
+    std::mt19937 engine(23);
+    std::uniform_real_distribution<float> position(-20.0f, 20.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::normal_distribution<float> normal;
+
+    std::vector<Surfel> surfels;
+    surfels.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        surfels.emplace_back(glm::vec3(position(engine), position(engine), position(engine)),
+                glm::normalize(glm::vec3(normal(engine), normal(engine), normal(engine))),
+                Color(unit(engine), unit(engine), unit(engine)), 0.002f + 0.001f * unit(engine));
+    }
+    return surfels;
+}
+
+/// Columns as SurfelData keeps them, padded to the G-buffer size
+struct SurfelColumns {
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> normals;
+    std::vector<glm::vec3> albedos;
+    std::vector<float> areas;
+
+    explicit SurfelColumns(size_t surfelCount)
+            :
+            positions(PaddedCount(surfelCount)),
+            normals(PaddedCount(surfelCount)),
+            albedos(PaddedCount(surfelCount)),
+            areas(PaddedCount(surfelCount)) {
+    }
+
+    size_t byteCount() const {
+        return (positions.size() + normals.size() + albedos.size()) * sizeof(glm::vec3) + areas.size() * sizeof(float);
+    }
+};
+
+/// Columns of the Compact quantization, 16 bytes per surfel
+struct CompactColumns {
+    glm::vec3 positionsMin;
+    glm::vec3 positionsMax;
+    std::vector<uint16_t> positions;
+    std::vector<uint32_t> normals;
+    std::vector<uint32_t> albedos;
+    std::vector<uint16_t> areas;
+
+    size_t byteCount() const {
+        return positions.size() * sizeof(uint16_t) + normals.size() * sizeof(uint32_t) + albedos.size() * sizeof(uint32_t) + areas.size() * sizeof(uint16_t);
+    }
+};
+
+static SurfelColumns Columns(const std::vector<Surfel> &surfels) {
+    SurfelColumns columns(surfels.size());
+    for (size_t i = 0; i < surfels.size(); i++) {
+        columns.positions[i] = surfels[i].position;
+        columns.normals[i] = surfels[i].normal;
+        columns.albedos[i] = surfels[i].albedo.rgb();
+        columns.areas[i] = surfels[i].area;
+    }
+    return columns;
+}
+
+// Same encoding SurfelData::serialize() applies
+static CompactColumns Compact(const SurfelColumns &columns, size_t surfelCount) {
+    CompactColumns compact;
+    compact.positionsMin = glm::vec3(INFINITY);
+    compact.positionsMax = glm::vec3(-INFINITY);
+    for (size_t i = 0; i < surfelCount; i++) {
+        compact.positionsMin = glm::min(compact.positionsMin, columns.positions[i]);
+        compact.positionsMax = glm::max(compact.positionsMax, columns.positions[i]);
+    }
+
+    glm::vec3 extent = compact.positionsMax - compact.positionsMin;
+    for (size_t i = 0; i < surfelCount; i++) {
+        glm::vec3 normalized = (columns.positions[i] - compact.positionsMin) / extent;
+        compact.positions.push_back(glm::packUnorm1x16(normalized.x));
+        compact.positions.push_back(glm::packUnorm1x16(normalized.y));
+        compact.positions.push_back(glm::packUnorm1x16(normalized.z));
+        compact.normals.push_back(glm::packSnorm2x16(OctahedralEncoding::Encode(columns.normals[i])));
+        compact.albedos.push_back(glm::packUnorm4x8(glm::vec4(glm::clamp(columns.albedos[i], 0.0f, 1.0f), 1.0f)));
+        compact.areas.push_back(glm::packHalf1x16(columns.areas[i]));
+    }
+    return compact;
+}
+
+#pragma mark - Upload preparation
+
+// Stands in for the copy the driver makes of the three G-buffer layers
+struct UploadDestination {
+    std::vector<glm::vec3> layers;
+
+    explicit UploadDestination(size_t surfelCount) : layers(PaddedCount(surfelCount) * 3) {}
+
+    void upload(const glm::vec3 *positions, const glm::vec3 *normals, const glm::vec3 *albedos, size_t paddedCount) {
+        std::memcpy(layers.data(), positions, paddedCount * sizeof(glm::vec3));
+        std::memcpy(layers.data() + paddedCount, normals, paddedCount * sizeof(glm::vec3));
+        std::memcpy(layers.data() + paddedCount * 2, albedos, paddedCount * sizeof(glm::vec3));
+        Sink = layers[paddedCount].x;
+    }
+};
+
+// What initializeBuffers() did before surfels were stored column-wise: repack into staging vectors, then upload
+static void UploadArrayOfStructures(const std::vector<Surfel> &surfels, UploadDestination &destination) {
+    size_t paddedCount = PaddedCount(surfels.size());
+    std::vector<glm::vec3> positions(paddedCount);
+    std::vector<glm::vec3> normals(paddedCount);
+    std::vector<glm::vec3> albedos(paddedCount);
+    for (size_t i = 0; i < surfels.size(); i++) {
+        positions[i] = surfels[i].position;
+        normals[i] = surfels[i].normal;
+        albedos[i] = surfels[i].albedo.rgb();
+    }
+    destination.upload(positions.data(), normals.data(), albedos.data(), paddedCount);
+}
+
+static void UploadColumns(const SurfelColumns &columns, UploadDestination &destination) {
+    destination.upload(columns.positions.data(), columns.normals.data(), columns.albedos.data(), columns.positions.size());
+}
+
+// Same decoding SurfelData::readColumns() applies, followed by the upload of the decoded columns
+static void UploadCompact(const CompactColumns &compact, size_t surfelCount, UploadDestination &destination) {
+    SurfelColumns columns(surfelCount);
+    for (size_t i = 0; i < surfelCount; i++) {
+        glm::vec3 normalized(glm::unpackUnorm1x16(compact.positions[i * 3 + 0]),
+                glm::unpackUnorm1x16(compact.positions[i * 3 + 1]),
+                glm::unpackUnorm1x16(compact.positions[i * 3 + 2]));
+        columns.positions[i] = compact.positionsMin + normalized * (compact.positionsMax - compact.positionsMin);
+        columns.areas[i] = glm::unpackHalf1x16(compact.areas[i]);
+        columns.normals[i] = OctahedralEncoding::Decode(glm::unpackSnorm2x16(compact.normals[i]));
+        columns.albedos[i] = glm::vec3(glm::unpackUnorm4x8(compact.albedos[i]));
+    }
+    UploadColumns(columns, destination);
+}
+
+#pragma mark - Projection
+
+// Irradiance-like sum the probe projection computes for every probe, reading normals, albedos and areas
+static float ProjectArrayOfStructures(const std::vector<Surfel> &surfels, const glm::vec3 &direction) {
+    float sum = 0.0f;
+    for (auto &surfel : surfels) {
+        sum += std::max(glm::dot(surfel.normal, direction), 0.0f) * surfel.area * surfel.albedo.r();
+    }
+    return sum;
+}
+
+static float ProjectColumns(const SurfelColumns &columns, size_t surfelCount, const glm::vec3 &direction) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < surfelCount; i++) {
+        sum += std::max(glm::dot(columns.normals[i], direction), 0.0f) * columns.areas[i] * columns.albedos[i].r;
+    }
+    return sum;
+}
+
+#pragma mark - Benchmark
+
+static void Run(size_t surfelCount) {
+    auto surfels = RandomSurfels(surfelCount);
+    auto columns = Columns(surfels);
+    auto compact = Compact(columns, surfelCount);
+    UploadDestination destination(surfelCount);
+
+    size_t paddedCount = PaddedCount(surfelCount);
+    size_t stagingBytes = paddedCount * 3 * sizeof(glm::vec3);
+    size_t arrayOfStructuresBytes = surfels.capacity() * sizeof(Surfel);
+
+    double arrayOfStructuresTime = Milliseconds([&] {
+        UploadArrayOfStructures(surfels, destination);
+    });
+    double columnsTime = Milliseconds([&] {
+        UploadColumns(columns, destination);
+    });
+    double compactTime = Milliseconds([&] {
+        UploadCompact(compact, surfelCount, destination);
+    });
+
+    // A few directions, like the handful of probes a cluster is projected onto
+    std::vector<glm::vec3> directions = {glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f),
+                                         glm::normalize(glm::vec3(1.0f)), glm::normalize(glm::vec3(-1.0f, 1.0f, -1.0f))};
+    float arrayOfStructuresSum = 0.0f;
+    double arrayOfStructuresProjectionTime = Milliseconds([&] {
+        for (auto &direction : directions) {
+            arrayOfStructuresSum += ProjectArrayOfStructures(surfels, direction);
+        }
+    });
+    float columnsSum = 0.0f;
+    double columnsProjectionTime = Milliseconds([&] {
+        for (auto &direction : directions) {
+            columnsSum += ProjectColumns(columns, surfelCount, direction);
+        }
+    });
+    Sink = arrayOfStructuresSum + columnsSum;
+
+    printf("%zu surfels, G-buffer layers of %zu texels\n", surfelCount, paddedCount);
+    printf("  %-34s %12s %14s %14s %14s\n", "Layout", "Stored B/sf", "Resident MB", "Peak MB", "Upload ms");
+    printf("  %-34s %12.1f %14.2f %14.2f %14.2f\n", "Array of structures (before)", double(sizeof(Surfel)),
+            arrayOfStructuresBytes / 1048576.0, (arrayOfStructuresBytes + stagingBytes) / 1048576.0, arrayOfStructuresTime);
+    printf("  %-34s %12.1f %14.2f %14.2f %14.2f\n", "Columns", double(columns.byteCount()) / surfelCount,
+            columns.byteCount() / 1048576.0, columns.byteCount() / 1048576.0, columnsTime);
+    // Compact columns are decoded into full precision ones and dropped afterwards
+    printf("  %-34s %12.1f %14.2f %14.2f %14.2f\n", "Compact file, decoded to columns", double(compact.byteCount()) / surfelCount,
+            columns.byteCount() / 1048576.0, (compact.byteCount() + columns.byteCount()) / 1048576.0, compactTime);
+    printf("  Projection onto %zu directions: %.2f ms array of structures, %.2f ms columns\n",
+            directions.size(), arrayOfStructuresProjectionTime, columnsProjectionTime);
+}
+
+int main() {
+    Run(100000);
+    Run(1000000);
+    Run(4000000);
+    return 0;
+}
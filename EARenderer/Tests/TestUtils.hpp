@@ -0,0 +1,85 @@
+//
+//  TestUtils.hpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef TestUtils_hpp
+#define TestUtils_hpp
+
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+namespace EARenderer {
+namespace Testing {
+
+    struct TestCase {
+        const char *name;
+        std::function<void()> body;
+    };
+
+    inline std::vector<TestCase> &Registry() {
+        static std::vector<TestCase> registry;
+        return registry;
+    }
+
+    inline size_t &FailureCount() {
+        static size_t count = 0;
+        return count;
+    }
+
+    struct Registrar {
+        Registrar(const char *name, std::function<void()> body) {
+            Registry().push_back({name, std::move(body)});
+        }
+    };
+
+    inline int RunAll() {
+        size_t failedTestCount = 0;
+        for (auto &test : Registry()) {
+            size_t failuresBefore = FailureCount();
+            test.body();
+            bool passed = FailureCount() == failuresBefore;
+            failedTestCount += passed ? 0 : 1;
+            printf("%s %s\n", passed ? "[ OK ]  " : "[ FAIL ]", test.name);
+        }
+        printf("%zu of %zu tests failed\n", failedTestCount, Registry().size());
+        return failedTestCount == 0 ? 0 : 1;
+    }
+
+}
+}
+
+/// Defines a test case, which is run by TEST_MAIN() in order of definition
+#define TEST(name) \
+    static void name(); \
+    static EARenderer::Testing::Registrar name##Registrar(#name, name); \
+    static void name()
+
+/// Reports a failed expectation without aborting the test
+#define EXPECT(condition) \
+    do { \
+        if (!(condition)) { \
+            printf("%s:%d: expectation failed: %s\n", __FILE__, __LINE__, #condition); \
+            EARenderer::Testing::FailureCount()++; \
+        } \
+    } while (false)
+
+/// Expects the statement to throw an exception of the given type
+#define EXPECT_THROWS(statement, exception) \
+    do { \
+        bool thrown = false; \
+        try { statement; } catch (const exception &) { thrown = true; } \
+        if (!thrown) { \
+            printf("%s:%d: expected %s from: %s\n", __FILE__, __LINE__, #exception, #statement); \
+            EARenderer::Testing::FailureCount()++; \
+        } \
+    } while (false)
+
+#define TEST_MAIN() \
+    int main() { return EARenderer::Testing::RunAll(); }
+
+#endif /* TestUtils_hpp */
@@ -0,0 +1,165 @@
+//
+//  TextureLoadingBenchmark.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+//  Engine sources: Resource Management/MipChain.cpp, Resource Management/CookedTexture.cpp, Serialization/BakedDataFile.cpp,
+//  Foundation/StbImage.cpp, Foundation/ContentHash.cpp, Foundation/CRC32.cpp, Foundation/MemoryUtils.cpp
+//  Textures are looked up relative to this file, so run the benchmark from the directory it was built in.
+//
+
+#include "MipChain.hpp"
+#include "CookedTexture.hpp"
+#include "ContentHash.hpp"
+#include "StbImage.hpp"
+#include "ThreadPool.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace EARenderer;
+
+struct Texture {
+    const char *path;
+    MipChain::Content content;
+};
+
+// Material maps of the PBR showroom and Sponza demo scenes that are present in the repository
+static const std::vector<Texture> Textures = {
+        {"Scuffed Titanium/Titanium-Scuffed_basecolor.png", MipChain::Content::Color},
+        {"Scuffed Titanium/Titanium-Scuffed_normal.png", MipChain::Content::NormalMap},
+        {"Scuffed Titanium/Titanium-Scuffed_metallic.png", MipChain::Content::Scalar},
+        {"Scuffed Titanium/Titanium-Scuffed_roughness.png", MipChain::Content::Scalar},
+        {"RedPlastic/plasticpattern1-albedo.png", MipChain::Content::Color},
+        {"RedPlastic/plasticpattern1-normal2b.png", MipChain::Content::NormalMap},
+        {"RedPlastic/plasticpattern1-roughness2.png", MipChain::Content::Scalar},
+        {"Floor/mahogfloor_basecolor.png", MipChain::Content::Color},
+        {"Floor/mahogfloor_roughness.png", MipChain::Content::Scalar},
+        {"test_bricks/bricks2.jpg", MipChain::Content::Color},
+        {"test_bricks/bricks2_normal.jpg", MipChain::Content::NormalMap},
+        {"test_bricks/bricks2_disp.jpg", MipChain::Content::Scalar},
+        {"Sponza PRB Texture Set/Sponza_Floor_roughness.tga", MipChain::Content::Scalar},
+        {"Sponza PRB Texture Set/Sponza_Column_a_roughness.tga", MipChain::Content::Scalar},
+        {"Sponza PRB Texture Set/Sponza_Curtain_roughness.tga", MipChain::Content::Scalar},
+        {"Sponza PRB Texture Set/Sponza_Fabric_metallic.tga", MipChain::Content::Scalar},
+};
+
+template<class Function>
+static double Milliseconds(Function &&function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static std::string TexturesDirectory() {
+    std::string file = __FILE__;
+    return file.substr(0, file.find_last_of('/') + 1) + "../Tool/Resources/Textures/";
+}
+
+// Cooked textures go to a temporary location instead of next to the sources
+static std::string CookedTexturePath(const Texture &texture) {
+    std::string path = texture.path;
+    return "/tmp/" + path.substr(path.find_last_of('/') + 1) + ".cooked";
+}
+
+static std::vector<uint8_t> ReadFile(const std::string &path) {
+    std::ifstream stream(path, std::ios::binary | std::ios::ate);
+    std::vector<uint8_t> bytes((size_t) stream.tellg());
+    stream.seekg(0);
+    stream.read(reinterpret_cast<char *>(bytes.data()), bytes.size());
+    return bytes;
+}
+
+static uint64_t SourceHash(const Texture &texture, const std::vector<uint8_t> &encodedImage) {
+    ContentHash hash;
+    hash.append(texture.content);
+    hash.append(encodedImage.data(), encodedImage.size());
+    return hash.value();
+}
+
+// What TextureStreamer does on a worker thread for every request
+static size_t LoadMipChain(const Texture &texture) {
+    std::vector<uint8_t> encodedImage = ReadFile(TexturesDirectory() + texture.path);
+    uint64_t hash = SourceHash(texture, encodedImage);
+
+    MipChain mipChain;
+    if (!CookedTexture::Read(CookedTexturePath(texture), hash, mipChain)) {
+        mipChain = MipChain::Build(encodedImage, texture.content);
+        CookedTexture::Write(CookedTexturePath(texture), hash, mipChain);
+    }
+    return mipChain.byteCount();
+}
+
+// Streams every texture through the default thread pool, returns uploaded byte count
+static size_t StreamTextures() {
+    std::vector<ThreadPool::TaskFuture<size_t>> futures;
+    for (auto &texture : Textures) {
+        futures.emplace_back(ThreadPool::Default().submit([&texture]() {
+            return LoadMipChain(texture);
+        }));
+    }
+
+    size_t byteCount = 0;
+    for (auto &future : futures) {
+        byteCount += future.get();
+    }
+    return byteCount;
+}
+
+int main() {
+    StbImage::EnableVerticalFlip();
+
+    size_t encodedByteCount = 0;
+    size_t decodedByteCount = 0;
+
+    // GLTextureFactory::LoadLDRImage decoded on the GL thread, then glGenerateMipmap filtered the levels on the GPU.
+    // Only the decoding part is measured, upload and mipmap generation need a GL context.
+    double synchronousTime = Milliseconds([&] {
+        for (auto &texture : Textures) {
+            std::string path = TexturesDirectory() + texture.path;
+            int32_t width = 0;
+            int32_t height = 0;
+            int32_t components = 0;
+            stbi_uc *pixelData = stbi_load(path.c_str(), &width, &height, &components, STBI_rgb_alpha);
+            if (!pixelData) {
+                printf("Failed to load %s\n", path.c_str());
+                exit(1);
+            }
+            decodedByteCount += size_t(width) * size_t(height) * 4;
+            stbi_image_free(pixelData);
+        }
+    });
+
+    for (auto &texture : Textures) {
+        encodedByteCount += ReadFile(TexturesDirectory() + texture.path).size();
+        std::remove(CookedTexturePath(texture).c_str());
+    }
+
+    size_t coldByteCount = 0;
+    double coldTime = Milliseconds([&] {
+        coldByteCount = StreamTextures();
+    });
+
+    size_t warmByteCount = 0;
+    double warmTime = Milliseconds([&] {
+        warmByteCount = StreamTextures();
+    });
+
+    for (auto &texture : Textures) {
+        std::remove(CookedTexturePath(texture).c_str());
+    }
+
+    printf("%zu textures, %.1f MB encoded, %u worker threads\n", Textures.size(), encodedByteCount / 1048576.0, std::max(std::thread::hardware_concurrency(), 2u) - 1u);
+    printf("  %-44s %9.1f ms  %7.1f MB of base levels\n", "Synchronous, GL thread decodes", synchronousTime, decodedByteCount / 1048576.0);
+    printf("  %-44s %9.1f ms  %7.1f MB of mip chains\n", "Streamed, decoded, filtered and cooked", coldTime, coldByteCount / 1048576.0);
+    printf("  %-44s %9.1f ms  %7.1f MB of mip chains\n", "Streamed, read from cooked textures", warmTime, warmByteCount / 1048576.0);
+    printf("GL thread is blocked for the whole synchronous time, streamed textures only cost it the per-frame upload budget\n");
+
+    return coldByteCount == warmByteCount ? 0 : 1;
+}
@@ -0,0 +1,200 @@
+//
+//  WavefrontParserBenchmark.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+//  Engine sources: Resource Management/WavefrontParser.cpp, ThirdParty/obj_loader/tiny_obj_loader.cpp,
+//  Math/AxisAlignedBox3D.cpp, Math/Triangle3D.cpp, Scene/Geometry/Transformation.cpp
+//  Demo models are looked up relative to this file, so run the benchmark from the directory it was built in.
+//
+
+#include "WavefrontParser.hpp"
+
+#include <obj_loader/tiny_obj_loader.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace EARenderer;
+
+// Keeps the optimizer from dropping the measured work
+static volatile size_t Sink = 0;
+
+static constexpr size_t RepetitionCount = 3;
+
+template<class Function>
+static double Milliseconds(Function &&function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Best of several runs, the first one also warms up the page cache
+template<class Function>
+static double BestMilliseconds(Function &&function) {
+    double best = INFINITY;
+    for (size_t i = 0; i < RepetitionCount; i++) {
+        best = std::min(best, Milliseconds(function));
+    }
+    return best;
+}
+
+static std::string ModelsDirectory() {
+    std::string file = __FILE__;
+    return file.substr(0, file.find_last_of('/') + 1) + "../Tool/Resources/Models/";
+}
+
+static size_t FileSize(const std::string &path) {
+    std::ifstream stream(path, std::ios::binary | std::ios::ate);
+    return stream.is_open() ? (size_t) stream.tellg() : 0;
+}
+
+/// Writes a wavy terrain of resolution x resolution quads, split into groups of rows with their own materials,
+/// the way exporters write large scanned or sculpted meshes
+static void WriteTerrain(const std::string &path, size_t resolution) {
+    FILE *file = fopen(path.c_str(), "w");
+    fprintf(file, "# Generated by WavefrontParserBenchmark\nmtllib terrain.mtl\no Terrain\n");
+
+    size_t vertexCount = resolution + 1;
+    for (size_t y = 0; y < vertexCount; y++) {
+        for (size_t x = 0; x < vertexCount; x++) {
+            float height = 0.25f * std::sin(x * 0.05f) * std::cos(y * 0.07f);
+            fprintf(file, "v %.6f %.6f %.6f\n", x / float(resolution), height, y / float(resolution));
+            fprintf(file, "vt %.6f %.6f\n", x / float(resolution), y / float(resolution));
+            fprintf(file, "vn %.6f %.6f %.6f\n", -0.0125f * std::cos(x * 0.05f), 1.0f, 0.0175f * std::sin(y * 0.07f));
+        }
+    }
+
+    for (size_t y = 0; y < resolution; y++) {
+        if (y % 64 == 0) {
+            fprintf(file, "g Rows_%zu\nusemtl Material_%zu\n", y / 64, y / 64 % 4);
+        }
+        for (size_t x = 0; x < resolution; x++) {
+            size_t a = y * vertexCount + x + 1;
+            size_t b = a + 1;
+            size_t c = a + vertexCount + 1;
+            size_t d = a + vertexCount;
+            fprintf(file, "f %zu/%zu/%zu %zu/%zu/%zu %zu/%zu/%zu %zu/%zu/%zu\n", a, a, a, b, b, b, c, c, c, d, d, d);
+        }
+    }
+
+    fclose(file);
+}
+
+#pragma mark - Parsers
+
+struct Counts {
+    size_t positionCount = 0;
+    size_t faceCount = 0;
+
+    bool operator==(const Counts &rhs) const {
+        return positionCount == rhs.positionCount && faceCount == rhs.faceCount;
+    }
+};
+
+struct TinyObjFile {
+    std::vector<glm::vec4> positions;
+    std::vector<glm::vec3> normals;
+    std::vector<glm::vec3> texCoords;
+    std::vector<tinyobj::index_t> indices;
+    size_t faceCount = 0;
+};
+
+// What WavefrontMeshLoader did before WavefrontParser: tinyobj callbacks filling the attribute arrays
+static Counts ParseWithTinyObj(const std::string &path) {
+    TinyObjFile file;
+    tinyobj::callback_t callback;
+
+    callback.vertex_cb = [](void *userData, float x, float y, float z, float w) {
+        static_cast<TinyObjFile *>(userData)->positions.emplace_back(x, y, z, w);
+    };
+    callback.normal_cb = [](void *userData, float x, float y, float z) {
+        static_cast<TinyObjFile *>(userData)->normals.emplace_back(x, y, z);
+    };
+    callback.texcoord_cb = [](void *userData, float x, float y, float z) {
+        static_cast<TinyObjFile *>(userData)->texCoords.emplace_back(x, y, z);
+    };
+    callback.index_cb = [](void *userData, tinyobj::index_t *indices, int indexCount) {
+        auto file = static_cast<TinyObjFile *>(userData);
+        file->indices.insert(file->indices.end(), indices, indices + indexCount);
+        file->faceCount += indexCount > 0;
+    };
+
+    std::ifstream stream(path);
+    std::string error;
+    tinyobj::LoadObjWithCallback(stream, callback, &file, nullptr, &error);
+
+    Sink = file.indices.size() + file.normals.size() + file.texCoords.size();
+    return {file.positions.size(), file.faceCount};
+}
+
+static Counts ParseWithWavefrontParser(const std::string &path, size_t minimumChunkSize) {
+    WavefrontParser parser(path);
+    parser.parse(minimumChunkSize);
+
+    Counts counts;
+    counts.positionCount = parser.positions().size();
+    for (auto &chunk : parser.chunks()) {
+        counts.faceCount += std::count_if(chunk.statements.begin(), chunk.statements.end(), [](const WavefrontParser::Statement &statement) {
+            return statement.type == WavefrontParser::Statement::Type::Face;
+        });
+    }
+
+    Sink = parser.normals().size() + parser.texCoords().size();
+    return counts;
+}
+
+#pragma mark - Benchmark
+
+static bool Run(const char *name, const std::string &path) {
+    double megabytes = FileSize(path) / 1048576.0;
+
+    Counts tinyObjCounts;
+    double tinyObjTime = BestMilliseconds([&] {
+        tinyObjCounts = ParseWithTinyObj(path);
+    });
+
+    // One chunk isolates the per-core speed of the parser from the parallel speedup
+    Counts serialCounts;
+    double serialTime = BestMilliseconds([&] {
+        serialCounts = ParseWithWavefrontParser(path, SIZE_MAX);
+    });
+
+    Counts parallelCounts;
+    double parallelTime = BestMilliseconds([&] {
+        parallelCounts = ParseWithWavefrontParser(path, WavefrontParser::MinimumChunkSize);
+    });
+
+    printf("%s, %.1f MB, %zu positions, %zu faces\n", name, megabytes, tinyObjCounts.positionCount, tinyObjCounts.faceCount);
+    printf("  %-36s %10.2f ms %10.1f MB/s\n", "tinyobjloader callbacks", tinyObjTime, megabytes / tinyObjTime * 1000.0);
+    printf("  %-36s %10.2f ms %10.1f MB/s %6.2fx\n", "WavefrontParser, one chunk", serialTime, megabytes / serialTime * 1000.0, tinyObjTime / serialTime);
+    printf("  %-36s %10.2f ms %10.1f MB/s %6.2fx\n", "WavefrontParser, 1 MB chunks", parallelTime, megabytes / parallelTime * 1000.0, tinyObjTime / parallelTime);
+
+    bool matches = serialCounts == tinyObjCounts && parallelCounts == tinyObjCounts;
+    if (!matches) {
+        printf("  Parsers disagree\n");
+    }
+    return matches;
+}
+
+int main() {
+    printf("%u hardware threads\n", std::thread::hardware_concurrency());
+
+    bool matches = Run("suzanne.obj", ModelsDirectory() + "suzanne.obj");
+
+    // About 150 MB, larger than any model in the repository
+    std::string terrainPath = "/tmp/WavefrontParserBenchmark.obj";
+    WriteTerrain(terrainPath, 1000);
+    matches &= Run("Generated terrain", terrainPath);
+    std::remove(terrainPath.c_str());
+
+    return matches ? 0 : 1;
+}
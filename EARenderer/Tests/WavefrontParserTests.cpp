@@ -0,0 +1,221 @@
+//
+//  WavefrontParserTests.cpp
+//  EARenderer
+//
+//  Created by Pavlo Muratov on 16.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+//  Engine sources: Resource Management/WavefrontParser.cpp, ThirdParty/obj_loader/tiny_obj_loader.cpp,
+//  Math/AxisAlignedBox3D.cpp, Math/Triangle3D.cpp, Scene/Geometry/Transformation.cpp
+//  Demo models are looked up relative to this file, so run the test from the directory it was built in.
+//
+
+#include "TestUtils.hpp"
+#include "WavefrontParser.hpp"
+
+#include <obj_loader/tiny_obj_loader.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace EARenderer;
+
+// Statements are compared as text, which makes the first mismatch easy to read
+struct ParsedFile {
+    std::vector<glm::vec4> positions;
+    std::vector<glm::vec3> normals;
+    std::vector<glm::vec3> texCoords;
+    std::vector<std::string> statements;
+};
+
+static std::string ModelsDirectory() {
+    std::string file = __FILE__;
+    return file.substr(0, file.find_last_of('/') + 1) + "../Tool/Resources/Models/";
+}
+
+static std::string FaceStatement(const std::vector<WavefrontParser::FaceVertex> &vertices) {
+    std::string statement = "f";
+    for (auto &vertex : vertices) {
+        statement += " " + std::to_string(vertex.position) + "/" + std::to_string(vertex.texCoord) + "/" + std::to_string(vertex.normal);
+    }
+    return statement;
+}
+
+#pragma mark - Reference
+
+static int32_t FixIndex(int idx, size_t count) {
+    if (idx > 0) return idx - 1;
+    if (idx == 0) return 0;
+    return static_cast<int32_t>(count) + idx;
+}
+
+// Same callbacks the loader used before WavefrontParser, resolving indices the same way
+static ParsedFile ReferenceParse(const std::string &path) {
+    ParsedFile file;
+    tinyobj::callback_t callback;
+
+    callback.vertex_cb = [](void *userData, float x, float y, float z, float w) {
+        static_cast<ParsedFile *>(userData)->positions.emplace_back(x, y, z, w);
+    };
+    callback.normal_cb = [](void *userData, float x, float y, float z) {
+        static_cast<ParsedFile *>(userData)->normals.emplace_back(x, y, z);
+    };
+    callback.texcoord_cb = [](void *userData, float x, float y, float z) {
+        static_cast<ParsedFile *>(userData)->texCoords.emplace_back(x, y, z);
+    };
+    callback.index_cb = [](void *userData, tinyobj::index_t *indices, int indexCount) {
+        auto file = static_cast<ParsedFile *>(userData);
+        std::vector<WavefrontParser::FaceVertex> vertices(indexCount);
+        for (int i = 0; i < indexCount; i++) {
+            vertices[i].position = FixIndex(indices[i].vertex_index, file->positions.size());
+            vertices[i].texCoord = indices[i].texcoord_index != 0 ? FixIndex(indices[i].texcoord_index, file->texCoords.size()) : -1;
+            vertices[i].normal = indices[i].normal_index != 0 ? FixIndex(indices[i].normal_index, file->normals.size()) : -1;
+        }
+        if (indexCount > 0) {
+            file->statements.push_back(FaceStatement(vertices));
+        }
+    };
+    callback.group_cb = [](void *userData, const char **names, int nameCount) {
+        static_cast<ParsedFile *>(userData)->statements.push_back(nameCount ? std::string("g ") + names[nameCount - 1] : "g");
+    };
+    callback.object_cb = [](void *userData, const char *name) {
+        static_cast<ParsedFile *>(userData)->statements.push_back(std::string("o ") + name);
+    };
+    callback.usemtl_cb = [](void *userData, const char *name, int materialID) {
+        static_cast<ParsedFile *>(userData)->statements.push_back(std::string("usemtl ") + name);
+    };
+
+    std::ifstream stream(path);
+    std::string error;
+    tinyobj::LoadObjWithCallback(stream, callback, &file, nullptr, &error);
+    return file;
+}
+
+#pragma mark - Parser
+
+static ParsedFile Parse(const std::string &path, size_t minimumChunkSize) {
+    WavefrontParser parser(path);
+    parser.parse(minimumChunkSize);
+
+    ParsedFile file;
+    file.positions = parser.positions();
+    file.normals = parser.normals();
+    file.texCoords = parser.texCoords();
+
+    for (auto &chunk : parser.chunks()) {
+        const WavefrontParser::FaceVertex *faceVertices = chunk.faceVertices.data();
+        for (auto &statement : chunk.statements) {
+            switch (statement.type) {
+                case WavefrontParser::Statement::Type::Face:
+                    file.statements.push_back(FaceStatement({faceVertices, faceVertices + statement.argument}));
+                    faceVertices += statement.argument;
+                    break;
+                case WavefrontParser::Statement::Type::Group:
+                    file.statements.push_back(statement.argument != WavefrontParser::Statement::NoName ? "g " + chunk.names[statement.argument] : "g");
+                    break;
+                case WavefrontParser::Statement::Type::Object:
+                    file.statements.push_back("o " + chunk.names[statement.argument]);
+                    break;
+                case WavefrontParser::Statement::Type::Material:
+                    file.statements.push_back("usemtl " + chunk.names[statement.argument]);
+                    break;
+            }
+        }
+    }
+
+    return file;
+}
+
+template<class Vector>
+static bool BitwiseEqual(const std::vector<Vector> &lhs, const std::vector<Vector> &rhs) {
+    return lhs.size() == rhs.size() && (lhs.empty() || std::memcmp(lhs.data(), rhs.data(), lhs.size() * sizeof(Vector)) == 0);
+}
+
+static bool MatchesReference(const std::string &path, size_t minimumChunkSize) {
+    ParsedFile expected = ReferenceParse(path);
+    ParsedFile parsed = Parse(path, minimumChunkSize);
+
+    bool matches = true;
+    matches &= BitwiseEqual(parsed.positions, expected.positions);
+    matches &= BitwiseEqual(parsed.normals, expected.normals);
+    matches &= BitwiseEqual(parsed.texCoords, expected.texCoords);
+    matches &= parsed.statements.size() == expected.statements.size();
+
+    for (size_t i = 0; i < std::min(parsed.statements.size(), expected.statements.size()); i++) {
+        if (parsed.statements[i] != expected.statements[i]) {
+            printf("%s, statement %zu: '%s', expected '%s'\n", path.c_str(), i, parsed.statements[i].c_str(), expected.statements[i].c_str());
+            return false;
+        }
+    }
+
+    return matches && !expected.positions.empty();
+}
+
+static std::string WriteTemporaryFile(const std::string &name, const std::string &contents) {
+    std::string path = "/tmp/" + name;
+    std::ofstream(path) << contents;
+    return path;
+}
+
+#pragma mark - Tests
+
+TEST(DemoModelsMatchTinyObjLoader) {
+    for (const char *model : {"cornell_box_covered.obj", "cornell_box_lux.obj", "floor.obj", "pbr_showroom.obj",
+                              "pbr_showroom_2.obj", "plane.obj", "sphere.obj", "street_light_e.obj", "suzanne.obj"}) {
+        std::string path = ModelsDirectory() + model;
+        EXPECT(MatchesReference(path, WavefrontParser::MinimumChunkSize));
+        // As many chunks as the thread pool takes, so statements and relative indices cross chunk boundaries
+        EXPECT(MatchesReference(path, 1));
+    }
+}
+
+TEST(SyntaxVariantsMatchTinyObjLoader) {
+    std::string path = WriteTemporaryFile("WavefrontParserSyntax.obj",
+            "# Comment\r\n"
+            "mtllib scene.mtl\n"
+            "o Object\n"
+            "v 1 2 3\nv -1.5e2 +2.25E-1 .5\nv 0.1 0.2 0.3 0.4\nv\t4  5\t6 \r\n"
+            "vt 0.5\nvt 0.25 0.75\nvt 1 1 1\n"
+            "vn 0 0 1\nvn 0 1 0\n"
+            "g\n"
+            "f 1 2 3\n"
+            "g first second\n"
+            "usemtl Material.001\n"
+            "f 1/1 2/2 3/3 4/1\n"
+            "f -4//-2 -3//-1 -2//-2\n"
+            "f -4/-3/-2 -3/-2/-1 -1/-1/-1\r\n"
+            "g single\n"
+            "f 1//1   2//2\t3//1\n");
+
+    EXPECT(MatchesReference(path, WavefrontParser::MinimumChunkSize));
+    EXPECT(MatchesReference(path, 1));
+    std::remove(path.c_str());
+}
+
+TEST(OutOfRangeFaceIndicesAreRejected) {
+    const char *attributes = "v 0 0 0\nv 1 0 0\nv 0 1 0\nvt 0 0\nvn 0 0 1\n";
+    const char *faces[] = {
+            "f 1 2 4\n",        // Past the last position
+            "f -4 -2 -1\n",     // Relative index before the first position
+            "f 1/1 2/2 3/1\n",  // Past the last texture coordinate
+            "f 1//1 2//1 3//-2\n", // Relative normal before the first one
+    };
+
+    for (const char *face : faces) {
+        std::string path = WriteTemporaryFile("WavefrontParserInvalid.obj", std::string(attributes) + face);
+        WavefrontParser parser(path);
+        EXPECT_THROWS(parser.parse(), std::runtime_error);
+        std::remove(path.c_str());
+    }
+
+    std::string path = WriteTemporaryFile("WavefrontParserValid.obj", std::string(attributes) + "f 1/1/1 -2/1/1 3/-1/-1\n");
+    WavefrontParser parser(path);
+    parser.parse();
+    EXPECT(parser.chunks().size() == 1 && parser.chunks()[0].faceVertices.size() == 3);
+    std::remove(path.c_str());
+}
+
+TEST_MAIN()
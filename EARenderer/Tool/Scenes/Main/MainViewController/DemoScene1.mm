@@ -231,6 +231,7 @@
     printf("Generating Embree BVH...\n");
     EARenderer::Measurement::ExecutionTime("Embree BVH generation took", [&]() {
         scene->buildStaticGeometryRaytracer(*resourcePool);
+        scene->buildDynamicGeometryRaytracer(*resourcePool);
     });
 
     scene->setName("sponza");
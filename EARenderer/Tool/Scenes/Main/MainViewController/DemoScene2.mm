@@ -76,6 +76,7 @@
     printf("Generating Embree BVH...\n");
     EARenderer::Measurement::ExecutionTime("Embree BVH generation took", [&]() {
         scene->buildStaticGeometryRaytracer(*resourcePool);
+        scene->buildDynamicGeometryRaytracer(*resourcePool);
     });
 
     scene->setName("cornell");
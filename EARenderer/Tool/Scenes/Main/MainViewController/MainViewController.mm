@@ -32,8 +32,10 @@
 #import "DiffuseLightProbeGenerator.hpp"
 #import "DiffuseLightProbeRenderer.hpp"
 #import "LogUtils.hpp"
+#import "TextureStreamer.hpp"
 
 static float const FrequentEventsThrottleCooldownMS = 100;
+static float const StatisticsReportThrottleCooldownMS = 1000;
 
 @interface MainViewController () <SceneGLViewDelegate, MeshListTabViewItemDelegate, SettingsTabViewItemDelegate>
 
@@ -59,6 +61,7 @@ static float const FrequentEventsThrottleCooldownMS = 100;
     std::unique_ptr<EARenderer::Cameraman> cameraman;
     std::unique_ptr<EARenderer::FrameMeter> frameMeter;
     std::unique_ptr<EARenderer::Throttle> frequentEventsThrottle;
+    std::unique_ptr<EARenderer::Throttle> statisticsReportThrottle;
     std::unique_ptr<EARenderer::SurfelRenderer> surfelRenderer;
     std::unique_ptr<EARenderer::DiffuseLightProbeRenderer> probeRenderer;
     std::unique_ptr<EARenderer::TriangleRenderer> triangleRenderer;
@@ -89,6 +92,7 @@ static float const FrequentEventsThrottleCooldownMS = 100;
     self->defaultRenderComponentsProvider = std::make_unique<DefaultRenderComponentsProvider>(&EARenderer::GLViewport::Main());
     self->frameMeter = std::make_unique<EARenderer::FrameMeter>();
     self->frequentEventsThrottle = std::make_unique<EARenderer::Throttle>(FrequentEventsThrottleCooldownMS);
+    self->statisticsReportThrottle = std::make_unique<EARenderer::Throttle>(StatisticsReportThrottleCooldownMS);
 
     auto camera = std::make_unique<EARenderer::Camera>(100.f, 0.05f, 25.f);
     self->cameraman = std::make_unique<EARenderer::Cameraman>(camera.get(), &EARenderer::Input::shared(), &EARenderer::GLViewport::Main());
@@ -98,14 +102,21 @@ static float const FrequentEventsThrottleCooldownMS = 100;
     self.demoScene = [[DemoScene1 alloc] init];
     [self.demoScene loadResourcesToPool:self->sharedResourceStorage.get() andComposeScene:self->scene.get()];
 
+    // Baked data is regenerated whenever anything it was computed from changes
+    uint64_t bakingInputsHash = self->scene->lightBakingInputsHash(*self->sharedResourceStorage);
+
     EARenderer::SurfelGenerator surfelGenerator(self->sharedResourceStorage.get(), self->scene.get());
     self->surfelData = std::make_unique<EARenderer::SurfelData>();
     std::string surfelStorageFileName = "surfels_" + self->scene->name();
 
     NSLog(@"Loading/generating surfels");
-    if (!self->surfelData->deserialize(surfelStorageFileName)) {
+    if (!self->surfelData->deserialize(surfelStorageFileName, bakingInputsHash)) {
+        NSLog(@"Surfels are missing or stale, regenerating");
+        // Surfel albedo is sampled from the final textures
+        EARenderer::TextureStreamer::Shared().finish();
         self->surfelData = surfelGenerator.generateStaticGeometrySurfels();
-        self->surfelData->serialize(surfelStorageFileName);
+        self->surfelData->setQuantization(EARenderer::SurfelData::Quantization::Compact);
+        self->surfelData->serialize(surfelStorageFileName, bakingInputsHash);
     }
 
     EARenderer::DiffuseLightProbeGenerator lightProbeGenerator;
@@ -113,9 +124,10 @@ static float const FrequentEventsThrottleCooldownMS = 100;
     std::string probeStorageFileName = "diffuse_light_probes_" + self->scene->name();
 
     NSLog(@"Loading/generating probes");
-    if (!self->diffuseProbeData->deserialize(probeStorageFileName)) {
+    if (!self->diffuseProbeData->deserialize(probeStorageFileName, bakingInputsHash)) {
+        NSLog(@"Probes are missing or stale, regenerating");
         self->diffuseProbeData = lightProbeGenerator.generateProbes(*self->scene, *self->surfelData);
-        self->diffuseProbeData->serialize(probeStorageFileName);
+        self->diffuseProbeData->serialize(probeStorageFileName, bakingInputsHash);
     }
 
     self->triangleRenderer = std::make_unique<EARenderer::TriangleRenderer>(
@@ -154,6 +166,7 @@ static float const FrequentEventsThrottleCooldownMS = 100;
 }
 
 - (void)glViewIsReadyToRenderFrame:(SceneGLView *)view {
+    EARenderer::TextureStreamer::Shared().update();
     self->cameraman->updateCamera();
     self->sceneGBufferRenderer->render();
     self->gpuResourceController->updateUniformBuffer(*self->sharedResourceStorage, *self->scene);
@@ -178,6 +191,20 @@ static float const FrequentEventsThrottleCooldownMS = 100;
 
     self->axesRenderer->render();
 
+    // Culling results and geometry traffic change every frame, a periodic update is enough to follow them while moving the camera
+    self->statisticsReportThrottle->attemptToPerformAction([=]() {
+        const EARenderer::GLUniformRingBuffer *uniformBuffer = self->gpuResourceController->uniformBuffer();
+        const EARenderer::ShadowMapper &shadowMapper = self->deferredSceneRenderer->shadowMapper();
+        self.fpsView.statistics = [NSString stringWithFormat:@"Uniform buffer stalls: %zu in %zu frames (%s)\nG-buffer pass culling: %s\n"
+                                                              "G-buffer pass traffic: %s\nCascaded shadow maps traffic: %s\nCube shadow maps traffic: %s",
+                        uniformBuffer->stallCount(), uniformBuffer->frameCount(),
+                        uniformBuffer->isPersistentlyMapped() ? "persistently mapped" : "mapped per frame",
+                        self->sceneGBufferRenderer->cullingStatistics().description().c_str(),
+                        self->sceneGBufferRenderer->geometryTraffic().description().c_str(),
+                        shadowMapper.directionalGeometryTraffic().description().c_str(),
+                        shadowMapper.omnidirectionalGeometryTraffic().description().c_str()];
+    });
+
     auto frameCharacteristics = self->frameMeter->tick();
     self.fpsView.frameCharacteristics = frameCharacteristics;
     self.fpsView.viewportResolution = view.bounds.size;
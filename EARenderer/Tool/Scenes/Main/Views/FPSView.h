@@ -14,5 +14,7 @@
 
 @property(assign, nonatomic) EARenderer::FrameMeter::FrameCharacteristics frameCharacteristics;
 @property(assign, nonatomic) CGSize viewportResolution;
+/// Detailed renderer statistics, shown when the pointer hovers over the view
+@property(copy, nonatomic) NSString *statistics;
 
 @end
@@ -48,4 +48,9 @@
     self.resolutionField.stringValue = [NSString stringWithFormat:@"%dx%d", (NSInteger) viewportResolution.width, (NSInteger) viewportResolution.height];
 }
 
+- (void)setStatistics:(NSString *)statistics {
+    _statistics = [statistics copy];
+    self.toolTip = statistics;
+}
+
 @end